@@ -0,0 +1,258 @@
+//
+//  AirportSearchIndex.swift
+//  FlyFunEuroAIP
+//
+//  Ranked typeahead search over airport codes, names and cities.
+//  Mirrors shared/indexing/search_index.py so web and app rank results the same way:
+//  - codes: sorted array, prefix = binary-search range
+//  - name/city words: sorted tokens with postings, every query word is a token prefix
+//  - trigram postings for substring matches inside words
+//
+
+import Foundation
+import RZFlight
+
+/// Match scores, best first (same values as the Python index)
+enum AirportSearchScore {
+    static let codeExact = 100
+    static let codePrefix = 80
+    static let nameStart = 60
+    static let nameWords = 50
+    static let cityWords = 40
+    static let substring = 20
+}
+
+private let trigramLength = 3
+
+final class AirportSearchIndex<Item>: @unchecked Sendable {
+
+    /// Searchable fields of one item
+    struct Fields {
+        let code: String
+        let name: String
+        let city: String
+        /// Tie-breaker within the same score (higher first), e.g. longest runway
+        let rank: Int
+    }
+
+    private typealias Score = AirportSearchScore
+
+    private let items: [Item]
+    private let codes: [String]
+    private let ranks: [Int]
+    private let nameText: [String]
+    private let text: [String]
+    private let sortedCodeRows: [Int]
+    private let names: TokenIndex
+    private let cities: TokenIndex
+    private let trigrams: [String: [Int]]
+
+    init(_ items: [Item], fields: (Item) -> Fields) {
+        self.items = items
+
+        var codes: [String] = []
+        var ranks: [Int] = []
+        var nameText: [String] = []
+        var text: [String] = []
+        var names = TokenIndex()
+        var cities = TokenIndex()
+        var trigrams: [String: [Int]] = [:]
+
+        for (row, item) in items.enumerated() {
+            let f = fields(item)
+            let code = Self.normalize(f.code)
+            let name = Self.normalize(f.name)
+            let city = Self.normalize(f.city)
+
+            codes.append(code)
+            ranks.append(f.rank)
+            nameText.append(name)
+            names.add(row: row, words: Self.words(name))
+            cities.add(row: row, words: Self.words(city))
+
+            // Fields separated by "|" so substrings never span two fields
+            let combined = [code, name, city].filter { !$0.isEmpty }.joined(separator: "|")
+            text.append(combined)
+            for trigram in Self.trigrams(of: combined) {
+                trigrams[trigram, default: []].append(row)
+            }
+        }
+        names.freeze()
+        cities.freeze()
+
+        self.codes = codes
+        self.ranks = ranks
+        self.nameText = nameText
+        self.text = text
+        self.sortedCodeRows = codes.indices.sorted { codes[$0] < codes[$1] }
+        self.names = names
+        self.cities = cities
+        self.trigrams = trigrams
+    }
+
+    var count: Int { items.count }
+
+    /// Best matching items, best first
+    func search(_ query: String, limit: Int) -> [Item] {
+        let normalized = Self.normalize(query)
+        guard !normalized.isEmpty, limit > 0 else { return [] }
+
+        var scores: [Int: Int] = [:]
+        func record(_ row: Int, _ score: Int) {
+            scores[row] = max(scores[row] ?? 0, score)
+        }
+
+        let queryWords = Self.words(normalized)
+
+        if queryWords.count == 1 {
+            let code = queryWords[0]
+            var position = lowerBound(code)
+            while position < sortedCodeRows.count {
+                let row = sortedCodeRows[position]
+                guard codes[row].hasPrefix(code) else { break }
+                record(row, codes[row] == code ? Score.codeExact : Score.codePrefix)
+                position += 1
+            }
+        }
+
+        for row in names.rowsMatchingAll(queryWords) {
+            record(row, nameText[row].hasPrefix(normalized) ? Score.nameStart : Score.nameWords)
+        }
+        for row in cities.rowsMatchingAll(queryWords) {
+            record(row, Score.cityWords)
+        }
+
+        if normalized.count >= trigramLength {
+            for row in substringCandidates(normalized) where scores[row] == nil && text[row].contains(normalized) {
+                scores[row] = Score.substring
+            }
+        }
+
+        let ranked = scores.keys.sorted { a, b in
+            if scores[a] != scores[b] { return scores[a]! > scores[b]! }
+            if ranks[a] != ranks[b] { return ranks[a] > ranks[b] }
+            return codes[a] < codes[b]
+        }
+        return ranked.prefix(limit).map { items[$0] }
+    }
+
+    // MARK: - Helpers
+
+    private func lowerBound(_ code: String) -> Int {
+        var low = 0
+        var high = sortedCodeRows.count
+        while low < high {
+            let mid = (low + high) / 2
+            if codes[sortedCodeRows[mid]] < code {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low
+    }
+
+    private func substringCandidates(_ query: String) -> Set<Int> {
+        let postings = Self.trigrams(of: query).map { trigrams[$0] ?? [] }.sorted { $0.count < $1.count }
+        guard let smallest = postings.first, !smallest.isEmpty else { return [] }
+        var candidates = Set(smallest)
+        for rows in postings.dropFirst() {
+            candidates.formIntersection(rows)
+            if candidates.isEmpty { break }
+        }
+        return candidates
+    }
+
+    /// Uppercase, strip accents, collapse punctuation/whitespace to single spaces
+    static func normalize(_ value: String) -> String {
+        let folded = value.folding(options: [.diacriticInsensitive, .caseInsensitive], locale: Locale(identifier: "en_US_POSIX"))
+            .uppercased()
+        var result = ""
+        var pendingSpace = false
+        for scalar in folded.unicodeScalars {
+            if (scalar >= "A" && scalar <= "Z") || (scalar >= "0" && scalar <= "9") {
+                if pendingSpace && !result.isEmpty { result.append(" ") }
+                pendingSpace = false
+                result.unicodeScalars.append(scalar)
+            } else {
+                pendingSpace = true
+            }
+        }
+        return result
+    }
+
+    private static func words(_ normalized: String) -> [String] {
+        normalized.split(separator: " ").map(String.init)
+    }
+
+    private static func trigrams(of value: String) -> Set<String> {
+        let characters = Array(value)
+        guard characters.count >= trigramLength else { return [] }
+        return Set((0...(characters.count - trigramLength)).map {
+            String(characters[$0..<($0 + trigramLength)])
+        })
+    }
+}
+
+// MARK: - Token Index
+
+/// Sorted word list with postings for word-prefix lookups
+private struct TokenIndex {
+    private var postings: [String: Set<Int>] = [:]
+    private var tokens: [String] = []
+
+    mutating func add(row: Int, words: [String]) {
+        for word in words {
+            postings[word, default: []].insert(row)
+        }
+    }
+
+    mutating func freeze() {
+        tokens = postings.keys.sorted()
+    }
+
+    /// Rows having a word starting with prefix
+    func rows(withPrefix prefix: String) -> Set<Int> {
+        var low = 0
+        var high = tokens.count
+        while low < high {
+            let mid = (low + high) / 2
+            if tokens[mid] < prefix { low = mid + 1 } else { high = mid }
+        }
+        var rows = Set<Int>()
+        while low < tokens.count, tokens[low].hasPrefix(prefix) {
+            rows.formUnion(postings[tokens[low]]!)
+            low += 1
+        }
+        return rows
+    }
+
+    /// Rows where every word is the prefix of some word
+    func rowsMatchingAll(_ words: [String]) -> Set<Int> {
+        var result: Set<Int>?
+        // Longest words first: they have the smallest postings
+        for word in words.sorted(by: { $0.count > $1.count }) {
+            let matched = rows(withPrefix: word)
+            result = result.map { $0.intersection(matched) } ?? matched
+            if result!.isEmpty { return [] }
+        }
+        return result ?? []
+    }
+}
+
+// MARK: - RZFlight
+
+extension AirportSearchIndex where Item == RZFlight.Airport {
+
+    /// Index over ICAO code, name and city, ranked by longest runway
+    convenience init(airports: [RZFlight.Airport]) {
+        self.init(airports) { airport in
+            Fields(
+                code: airport.icao,
+                name: airport.name,
+                city: airport.city,
+                rank: airport.runways.map(\.length_ft).max() ?? 0
+            )
+        }
+    }
+}
@@ -0,0 +1,114 @@
+//
+//  AirportTileCache.swift
+//  FlyFunEuroAIP
+//
+//  Tile-keyed cache for remote region loading.
+//  Mirrors AirportTileLoader in web/client/ts/adapters/airport-tile-loader.ts.
+//
+
+import Foundation
+import RZFlight
+
+/// Caches airports per map tile and filter set.
+/// - LRU with at most `maxTiles` entries; entries expire after `ttl` (server Cache-Control max-age)
+/// - One in-flight fetch per tile, shared by overlapping region loads
+/// - Fetches for tiles a newer region no longer needs can be cancelled
+/// - Thread-safe: fetch tasks update the cache concurrently with callers, all state is guarded by `lock`
+final class AirportTileCache: @unchecked Sendable {
+    typealias Fetch = (MapTile) async throws -> [RZFlight.Airport]
+
+    private struct Key: Hashable {
+        let filters: String
+        let tile: MapTile
+    }
+
+    private struct Entry {
+        let airports: [RZFlight.Airport]
+        let loadedAt: Date
+    }
+
+    private var entries: [Key: Entry] = [:]
+    /// Least recently used first
+    private var order: [Key] = []
+    /// Pending fetches, with an id so a superseded fetch can't clear a newer one
+    private var inFlight: [Key: (id: Int, task: Task<[RZFlight.Airport], Error>)] = [:]
+    private var nextLoadID = 0
+    private let lock = NSLock()
+    private let maxTiles: Int
+    private let ttl: TimeInterval
+
+    init(maxTiles: Int = 256, ttl: TimeInterval = 300) {
+        self.maxTiles = maxTiles
+        self.ttl = ttl
+    }
+
+    /// Cached result, pending fetch, or a new fetch for a tile.
+    /// Start all tiles of a region before awaiting them so their requests overlap.
+    func load(_ tile: MapTile, filterKey: String, fetch: @escaping Fetch) -> Task<[RZFlight.Airport], Error> {
+        let key = Key(filters: filterKey, tile: tile)
+        lock.lock()
+        defer { lock.unlock() }
+        if let entry = entries[key], Date().timeIntervalSince(entry.loadedAt) < ttl {
+            touch(key)
+            return Task { entry.airports }
+        }
+        if let pending = inFlight[key] {
+            return pending.task
+        }
+
+        nextLoadID += 1
+        let id = nextLoadID
+        let task = Task {
+            defer { self.finish(key, id: id) }
+            let airports = try await fetch(tile)
+            self.store(airports, for: key)
+            return airports
+        }
+        inFlight[key] = (id, task)
+        return task
+    }
+
+    /// Cancel pending fetches for tiles outside `tiles` (superseded by a newer region)
+    func cancelPending(keeping tiles: Set<MapTile>, filterKey: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        for (key, pending) in inFlight where key.filters != filterKey || !tiles.contains(key.tile) {
+            pending.task.cancel()
+            inFlight[key] = nil
+        }
+    }
+
+    /// Drop all cached tiles
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        entries.removeAll()
+        order.removeAll()
+    }
+
+    /// Clear the in-flight slot only if it still holds this fetch (it may have been
+    /// cancelled and replaced by a newer load of the same tile)
+    private func finish(_ key: Key, id: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+        if inFlight[key]?.id == id {
+            inFlight[key] = nil
+        }
+    }
+
+    private func store(_ airports: [RZFlight.Airport], for key: Key) {
+        lock.lock()
+        defer { lock.unlock() }
+        entries[key] = Entry(airports: airports, loadedAt: Date())
+        touch(key)
+        if order.count > maxTiles {
+            entries[order.removeFirst()] = nil
+        }
+    }
+
+    /// Caller holds `lock`
+    private func touch(_ key: Key) {
+        order.removeAll { $0 == key }
+        order.append(key)
+    }
+}
@@ -22,6 +22,10 @@ final class LocalAirportDataSource: AirportRepositoryProtocol, @unchecked Sendab
     private let db: FMDatabase
     private let knownAirports: KnownAirports
     
+    /// Typeahead index, built on first search (see AirportSearchIndex)
+    private var searchIndex: AirportSearchIndex<RZFlight.Airport>?
+    private let searchIndexLock = NSLock()
+    
     // MARK: - Init
     
     init(databasePath: String) throws {
@@ -80,7 +84,19 @@ final class LocalAirportDataSource: AirportRepositoryProtocol, @unchecked Sendab
     }
     
     func searchAirports(query: String, limit: Int) async throws -> [RZFlight.Airport] {
-        return Array(knownAirports.matching(needle: query).prefix(limit))
+        return getSearchIndex().search(query, limit: limit)
+    }
+    
+    private func getSearchIndex() -> AirportSearchIndex<RZFlight.Airport> {
+        searchIndexLock.lock()
+        defer { searchIndexLock.unlock() }
+        if let searchIndex {
+            return searchIndex
+        }
+        let index = AirportSearchIndex(airports: knownAirports.matching(needle: ""))
+        Logger.app.info("Built airport search index with \(index.count) airports")
+        searchIndex = index
+        return index
     }
     
     func airportDetail(icao: String) async throws -> RZFlight.Airport? {
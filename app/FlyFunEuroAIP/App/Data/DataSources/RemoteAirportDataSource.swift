@@ -36,6 +36,12 @@ final class RemoteAirportDataSource: AirportRepositoryProtocol, @unchecked Senda
     /// Cache border crossing ICAOs from API (loaded once)
     private var borderCrossingCache: Set<String>?
     
+    /// Region queries by map tile (repeated and overlapping regions reuse tiles)
+    private let tileCache = AirportTileCache()
+    
+    /// Max airports fetched per tile (largest runways first, as the API orders them)
+    private static let tileAirportLimit = 250
+    
     // MARK: - Init
     
     init(apiClient: APIClient) {
@@ -56,17 +62,38 @@ final class RemoteAirportDataSource: AirportRepositoryProtocol, @unchecked Senda
         filters: FilterConfig,
         limit: Int
     ) async throws -> [RZFlight.Airport] {
-        // API doesn't have bounding box endpoint yet
-        // For now, get all airports with filters and filter client-side
-        // TODO: Add bounding box endpoint to API
+        // Load the covering tiles (cached, requests overlap), then trim to the box
+        let tiles = MapTile.tiles(covering: boundingBox, zoom: MapTile.zoom(for: boundingBox))
+        // Sorted keys: equal filters always give the same tile-cache key
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+        let filterKey = String(decoding: try encoder.encode(filters), as: UTF8.self)
+        tileCache.cancelPending(keeping: Set(tiles), filterKey: filterKey)
         
-        let endpoint = Endpoint.airports(filters: filters, limit: limit)
-        let airports: [RZFlight.Airport] = try await apiClient.get(endpoint, decoder: rzflightDecoder)
+        let tasks = tiles.map { tile in
+            tileCache.load(tile, filterKey: filterKey) { [apiClient, rzflightDecoder] tile in
+                let endpoint = Endpoint.airports(filters: filters, limit: Self.tileAirportLimit, tile: tile)
+                return try await apiClient.get(endpoint, decoder: rzflightDecoder)
+            }
+        }
+        var tileResults: [[RZFlight.Airport]] = []
+        for task in tasks {
+            tileResults.append(try await task.value)
+        }
         
-        // Filter by bounding box client-side
-        return airports.filter { airport in
-            boundingBox.contains(airport.coord)
+        // Airports on shared tile edges come back from both tiles
+        var seen = Set<String>()
+        let airports = tileResults.joined().filter { airport in
+            boundingBox.contains(airport.coord) && seen.insert(airport.icao).inserted
         }
+        // Largest runways first across all tiles (as the web tile loader), so the
+        // limit drops small airports rather than whole tiles at the end of the region;
+        // ties keep tile order
+        let ranked = airports.enumerated()
+            .map { (offset: $0.offset, runway: $0.element.maxRunwayLength, airport: $0.element) }
+            .sorted { $0.runway != $1.runway ? $0.runway > $1.runway : $0.offset < $1.offset }
+            .map(\.airport)
+        return Array(ranked.prefix(limit))
     }
     
     // MARK: - General Queries
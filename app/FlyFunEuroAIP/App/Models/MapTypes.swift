@@ -89,6 +89,69 @@ extension MKCoordinateRegion {
     )
 }
 
+// MARK: - Map Tile
+
+/// Quadtree (Web Mercator z/x/y) tile used for cached region loading.
+/// Same numbering as web/server/api/tiles.py: x grows east from -180°, y grows south from 85.0511°N.
+struct MapTile: Hashable, Sendable {
+    let z: Int
+    let x: Int
+    let y: Int
+    
+    /// Latitude limit of the Web Mercator square
+    static let maxLatitude = 85.0511
+    
+    /// Server `tile` parameter ("z/x/y")
+    var id: String { "\(z)/\(x)/\(y)" }
+    
+    /// Tile level for a region: tiles about as wide as the region (2x2 tiles typically cover it),
+    /// clamped to the levels the web client uses
+    static func zoom(for box: BoundingBox) -> Int {
+        let span = max(box.maxLongitude - box.minLongitude, 0.01)
+        let level = Int(floor(log2(360.0 / span)))
+        return min(10, max(3, level))
+    }
+    
+    /// Tiles at level z covering a bounding box (longitudes clamped to [-180, 180])
+    static func tiles(covering box: BoundingBox, zoom z: Int) -> [MapTile] {
+        let west = max(-180, box.minLongitude)
+        let east = min(180, box.maxLongitude)
+        guard west <= east, box.minLatitude <= box.maxLatitude else { return [] }
+        
+        let xRange = column(for: west, zoom: z)...column(for: east, zoom: z)
+        let yRange = row(for: box.maxLatitude, zoom: z)...row(for: box.minLatitude, zoom: z)
+        return xRange.flatMap { x in yRange.map { y in MapTile(z: z, x: x, y: y) } }
+    }
+    
+    /// Geographic bounds of the tile
+    var boundingBox: BoundingBox {
+        let n = Double(1 << z)
+        return BoundingBox(
+            minLatitude: Self.latitude(ofRow: y + 1, zoom: z),
+            maxLatitude: Self.latitude(ofRow: y, zoom: z),
+            minLongitude: Double(x) / n * 360 - 180,
+            maxLongitude: Double(x + 1) / n * 360 - 180
+        )
+    }
+    
+    private static func column(for longitude: Double, zoom z: Int) -> Int {
+        let n = 1 << z
+        return min(n - 1, max(0, Int(floor((longitude + 180) / 360 * Double(n)))))
+    }
+    
+    private static func row(for latitude: Double, zoom z: Int) -> Int {
+        let n = 1 << z
+        let rad = min(maxLatitude, max(-maxLatitude, latitude)) * .pi / 180
+        let y = (1 - log(tan(rad) + 1 / cos(rad)) / .pi) / 2 * Double(n)
+        return min(n - 1, max(0, Int(floor(y))))
+    }
+    
+    private static func latitude(ofRow y: Int, zoom z: Int) -> Double {
+        let n = Double.pi - 2 * .pi * Double(y) / Double(1 << z)
+        return atan(sinh(n)) * 180 / .pi
+    }
+}
+
 // MARK: - Route Result
 
 /// Route search result wrapper
@@ -28,6 +28,7 @@ final class APIClient: Sendable {
         let decoder = JSONDecoder()
         decoder.keyDecodingStrategy = .convertFromSnakeCase
         decoder.dateDecodingStrategy = .iso8601
+        decoder.userInfo[ColumnarJSON.snakeCaseFieldsKey] = true
         self.decoder = decoder
     }
     
@@ -159,6 +160,10 @@ final class APIClient: Sendable {
         try validateResponse(response)
         
         do {
+            if ColumnarJSON.isRequested(by: request), let columnar = T.self as? ColumnarDecodable.Type {
+                // Force cast cannot fail: decodeColumnar returns Self, which is T
+                return try columnar.decodeColumnar(from: data, decoder: customDecoder) as! T
+            }
             return try customDecoder.decode(T.self, from: data)
         } catch {
             Logger.app.error("Decode error: \(error.localizedDescription)")
@@ -0,0 +1,218 @@
+//
+//  ColumnarJSON.swift
+//  FlyFunEuroAIP
+//
+//  Decoder support for the compact columnar wire format of bulk endpoints.
+//  Mirrors web/server/api/wire_format.py:
+//
+//      {"format": "columnar", "fields": ["ident", ...], "rows": [["EGKB", ...], ...]}
+//
+
+import Foundation
+
+/// Columnar wire format helpers
+///
+/// Rows are decoded in the same pass as the payload: each row is handed to the
+/// element's own `init(from:)` through a keyed container that maps coding keys
+/// to column positions, so existing Decodable models (including RZFlight.Airport
+/// with its own CodingKeys) decode unchanged, without expanding to objects first.
+enum ColumnarJSON {
+
+    static let format = "columnar"
+
+    /// Set to true in a decoder's userInfo when it uses `.convertFromSnakeCase`:
+    /// field names are converted the same way before matching coding keys
+    static let snakeCaseFieldsKey = CodingUserInfoKey(rawValue: "columnarSnakeCaseFields")!
+
+    /// Whether a request asked for the columnar format (`format=columnar` query item)
+    static func isRequested(by request: URLRequest) -> Bool {
+        guard let url = request.url,
+              let items = URLComponents(url: url, resolvingAgainstBaseURL: false)?.queryItems else {
+            return false
+        }
+        return items.contains { $0.name == "format" && $0.value == format }
+    }
+
+    /// Whether the payload is a JSON object (columnar) rather than a plain array,
+    /// from its first byte only
+    static func isObject(_ data: Data) -> Bool {
+        data.first(where: { !$0.isWhitespace }) == UInt8(ascii: "{")
+    }
+
+    /// `.convertFromSnakeCase` applied to a field name
+    static func camelCase(_ field: String) -> String {
+        guard field.contains("_") else { return field }
+        let leading = field.prefix { $0 == "_" }
+        let trailing = field.reversed().prefix { $0 == "_" }
+        let words = field.split(separator: "_")
+        guard let first = words.first else { return field }
+        return String(leading) + String(first) + words.dropFirst().map { $0.capitalized }.joined() + String(trailing)
+    }
+}
+
+// MARK: - Decoding
+
+/// Arrays that APIClient can decode from a columnar payload
+protocol ColumnarDecodable {
+    static func decodeColumnar(from data: Data, decoder: JSONDecoder) throws -> Self
+}
+
+extension Array: ColumnarDecodable where Element: Decodable {
+    static func decodeColumnar(from data: Data, decoder: JSONDecoder) throws -> [Element] {
+        // A plain array (server without columnar support) decodes as usual
+        guard ColumnarJSON.isObject(data) else {
+            return try decoder.decode([Element].self, from: data)
+        }
+        return try decoder.decode(ColumnarRows<Element>.self, from: data).elements
+    }
+}
+
+/// A columnar payload decoded straight into `[Element]`
+struct ColumnarRows<Element: Decodable>: Decodable {
+    let elements: [Element]
+
+    private enum CodingKeys: String, CodingKey {
+        case format, fields, rows
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        let format = try container.decode(String.self, forKey: .format)
+        guard format == ColumnarJSON.format else {
+            throw DecodingError.dataCorruptedError(
+                forKey: .format, in: container, debugDescription: "Not a columnar payload: \(format)"
+            )
+        }
+        var fields = try container.decode([String].self, forKey: .fields)
+        if decoder.userInfo[ColumnarJSON.snakeCaseFieldsKey] as? Bool == true {
+            fields = fields.map(ColumnarJSON.camelCase)
+        }
+        // First column wins if two names collide
+        var columns: [String: Int] = [:]
+        for (index, field) in fields.enumerated() where columns[field] == nil {
+            columns[field] = index
+        }
+
+        var rows = try container.nestedUnkeyedContainer(forKey: .rows)
+        var elements: [Element] = []
+        elements.reserveCapacity(rows.count ?? 0)
+        while !rows.isAtEnd {
+            var values = try rows.nestedUnkeyedContainer()
+            var cells: [Decoder] = []
+            cells.reserveCapacity(fields.count)
+            while !values.isAtEnd {
+                cells.append(try values.superDecoder())
+            }
+            let row = ColumnarRowDecoder(
+                columns: columns, cells: cells, codingPath: values.codingPath, userInfo: decoder.userInfo
+            )
+            elements.append(try Element(from: row))
+        }
+        self.elements = elements
+    }
+}
+
+/// One row seen as a keyed object: each key reads the cell of its column
+private struct ColumnarRowDecoder: Decoder {
+    let columns: [String: Int]
+    let cells: [Decoder]
+    let codingPath: [CodingKey]
+    let userInfo: [CodingUserInfoKey: Any]
+
+    func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+        KeyedDecodingContainer(ColumnarRowContainer<Key>(row: self))
+    }
+
+    func unkeyedContainer() throws -> UnkeyedDecodingContainer {
+        throw notAnObject([Any].self)
+    }
+
+    func singleValueContainer() throws -> SingleValueDecodingContainer {
+        throw notAnObject(Any.self)
+    }
+
+    private func notAnObject(_ type: Any.Type) -> DecodingError {
+        DecodingError.typeMismatch(type, .init(codingPath: codingPath, debugDescription: "Columnar rows decode as keyed objects"))
+    }
+}
+
+private struct ColumnarRowContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+    let row: ColumnarRowDecoder
+
+    var codingPath: [CodingKey] { row.codingPath }
+
+    var allKeys: [Key] {
+        row.columns.compactMap { name, index in index < row.cells.count ? Key(stringValue: name) : nil }
+    }
+
+    func contains(_ key: Key) -> Bool {
+        cell(for: key) != nil
+    }
+
+    private func cell(for key: Key) -> Decoder? {
+        guard let index = row.columns[key.stringValue], index < row.cells.count else { return nil }
+        return row.cells[index]
+    }
+
+    private func requireCell(for key: Key) throws -> Decoder {
+        guard let cell = cell(for: key) else {
+            throw DecodingError.keyNotFound(key, .init(codingPath: codingPath, debugDescription: "No column \"\(key.stringValue)\""))
+        }
+        return cell
+    }
+
+    func decodeNil(forKey key: Key) throws -> Bool {
+        try requireCell(for: key).singleValueContainer().decodeNil()
+    }
+
+    func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+        try decode(type, key)
+    }
+
+    func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool { try decode(type, key) }
+    func decode(_ type: String.Type, forKey key: Key) throws -> String { try decode(type, key) }
+    func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try decode(type, key) }
+    func decode(_ type: Float.Type, forKey key: Key) throws -> Float { try decode(type, key) }
+    func decode(_ type: Int.Type, forKey key: Key) throws -> Int { try decode(type, key) }
+    func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 { try decode(type, key) }
+    func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 { try decode(type, key) }
+    func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 { try decode(type, key) }
+    func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 { try decode(type, key) }
+    func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt { try decode(type, key) }
+    func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 { try decode(type, key) }
+    func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try decode(type, key) }
+    func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try decode(type, key) }
+    func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try decode(type, key) }
+
+    // Through the cell's single value container, so decoder strategies (dates, ...) apply
+    private func decode<T: Decodable>(_ type: T.Type, _ key: Key) throws -> T {
+        try requireCell(for: key).singleValueContainer().decode(T.self)
+    }
+
+    func nestedContainer<NestedKey: CodingKey>(
+        keyedBy type: NestedKey.Type, forKey key: Key
+    ) throws -> KeyedDecodingContainer<NestedKey> {
+        try requireCell(for: key).container(keyedBy: type)
+    }
+
+    func nestedUnkeyedContainer(forKey key: Key) throws -> UnkeyedDecodingContainer {
+        try requireCell(for: key).unkeyedContainer()
+    }
+
+    func superDecoder() throws -> Decoder {
+        guard let key = Key(stringValue: "super") else {
+            throw DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: "No super key"))
+        }
+        return try requireCell(for: key)
+    }
+
+    func superDecoder(forKey key: Key) throws -> Decoder {
+        try requireCell(for: key)
+    }
+}
+
+private extension UInt8 {
+    var isWhitespace: Bool {
+        self == 0x20 || self == 0x0A || self == 0x0D || self == 0x09
+    }
+}
@@ -33,17 +33,24 @@ struct Endpoint {
 extension Endpoint {
     
     /// GET /api/airports - List airports with filters
+    /// - Parameter tile: Restrict to one quadtree tile (cacheable region query)
     static func airports(
         filters: FilterConfig,
         limit: Int = 1000,
         offset: Int = 0,
-        includeGA: Bool = false
+        includeGA: Bool = false,
+        tile: MapTile? = nil
     ) -> Endpoint {
         var queryItems: [URLQueryItem] = [
             URLQueryItem(name: "limit", value: String(limit)),
             URLQueryItem(name: "offset", value: String(offset)),
-            URLQueryItem(name: "include_ga", value: String(includeGA))
+            URLQueryItem(name: "include_ga", value: String(includeGA)),
+            // Compact response, decoded by APIClient (see ColumnarJSON)
+            URLQueryItem(name: "format", value: ColumnarJSON.format)
         ]
+        if let tile {
+            queryItems.append(URLQueryItem(name: "tile", value: tile.id))
+        }
         
         // Add filter parameters
         if let country = filters.country {
@@ -87,11 +87,14 @@ final class AirportDomain {
         // Calculate bounding box with some padding for smooth panning
         let paddedRegion = region.paddedBy(factor: 1.3)
         
-        airports = try await repository.airportsInRegion(
+        let loaded = try await repository.airportsInRegion(
             boundingBox: paddedRegion.boundingBox,
             filters: filters,
             limit: 500  // Cap markers for performance
         )
+        // A newer region superseded this load while it was in flight
+        guard !Task.isCancelled else { return }
+        airports = loaded
         Logger.app.info("Loaded \(self.airports.count) airports in region")
         
         // Load procedure lines if in procedure legend mode
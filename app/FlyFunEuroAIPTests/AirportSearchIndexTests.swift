@@ -0,0 +1,77 @@
+//
+//  AirportSearchIndexTests.swift
+//  FlyFunEuroAIPTests
+//
+//  Tests for AirportSearchIndex ranking and matching.
+//
+
+import Testing
+import Foundation
+@testable import FlyFunEuroAIP
+
+struct AirportSearchIndexTests {
+
+    // MARK: - Setup
+
+    private struct Entry {
+        let icao: String
+        let name: String
+        let city: String
+        let runwayFt: Int
+    }
+
+    private let entries = [
+        Entry(icao: "EGLC", name: "London City Airport", city: "London", runwayFt: 4948),
+        Entry(icao: "EGLL", name: "London Heathrow Airport", city: "London", runwayFt: 12802),
+        Entry(icao: "EGKB", name: "London Biggin Hill Airport", city: "London", runwayFt: 5932),
+        Entry(icao: "LSZH", name: "Zürich Airport", city: "Zurich", runwayFt: 12139),
+        Entry(icao: "EGLD", name: "Denham Aerodrome", city: "Denham", runwayFt: 0),
+        Entry(icao: "LFAT", name: "Le Touquet-Côte d'Opale Airport", city: "Le Touquet-Paris-Plage", runwayFt: 6070),
+    ]
+
+    private func makeIndex() -> AirportSearchIndex<Entry> {
+        AirportSearchIndex(entries) { entry in
+            .init(code: entry.icao, name: entry.name, city: entry.city, rank: entry.runwayFt)
+        }
+    }
+
+    private func search(_ query: String, limit: Int = 20) -> [String] {
+        makeIndex().search(query, limit: limit).map(\.icao)
+    }
+
+    // MARK: - Normalization
+
+    @Test func normalizeFoldsCaseAccentsAndPunctuation() {
+        #expect(AirportSearchIndex<Entry>.normalize("Zürich  Côte-d'Opale") == "ZURICH COTE D OPALE")
+        #expect(AirportSearchIndex<Entry>.normalize("") == "")
+    }
+
+    // MARK: - Codes
+
+    @Test func exactCodeRanksFirst() {
+        #expect(search("egkb").first == "EGKB")
+    }
+
+    @Test func codePrefixOrderedByRunwayLength() {
+        #expect(search("EGL") == ["EGLL", "EGLC", "EGLD"])
+    }
+
+    // MARK: - Names and Cities
+
+    @Test func nameWordsMatchAsPrefixes() {
+        #expect(search("london") == ["EGLL", "EGKB", "EGLC"])
+        #expect(search("hill lond") == ["EGKB"])
+        #expect(search("zurich") == ["LSZH"])
+    }
+
+    @Test func cityAndSubstringMatches() {
+        #expect(search("plage").contains("LFAT"))
+        #expect(search("ouquet") == ["LFAT"])
+    }
+
+    @Test func limitAndEmptyQueries() {
+        #expect(search("london", limit: 2).count == 2)
+        #expect(search("   ").isEmpty)
+        #expect(search("nowhere").isEmpty)
+    }
+}
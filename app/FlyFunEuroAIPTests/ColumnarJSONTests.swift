@@ -0,0 +1,70 @@
+//
+//  ColumnarJSONTests.swift
+//  FlyFunEuroAIPTests
+//
+//  Tests for decoding the columnar wire format (see web/server/api/wire_format.py).
+//
+
+import Testing
+import Foundation
+@testable import FlyFunEuroAIP
+
+struct ColumnarJSONTests {
+
+    struct Row: Decodable, Equatable {
+        let ident: String
+        let runwayLengthFt: Int?
+        let tags: [String]
+    }
+
+    private func snakeCaseDecoder() -> JSONDecoder {
+        let decoder = JSONDecoder()
+        decoder.keyDecodingStrategy = .convertFromSnakeCase
+        decoder.userInfo[ColumnarJSON.snakeCaseFieldsKey] = true
+        return decoder
+    }
+
+    @Test func decodesRowsByField() throws {
+        let data = Data("""
+        {"format": "columnar", "fields": ["ident", "runway_length_ft", "tags"],
+         "rows": [["EGKB", 5905, ["ifr"]], ["LFAT", null, []]]}
+        """.utf8)
+
+        let rows = try [Row].decodeColumnar(from: data, decoder: snakeCaseDecoder())
+
+        #expect(rows == [
+            Row(ident: "EGKB", runwayLengthFt: 5905, tags: ["ifr"]),
+            Row(ident: "LFAT", runwayLengthFt: nil, tags: []),
+        ])
+    }
+
+    @Test func missingRequiredFieldThrows() throws {
+        let data = Data(#"{"format": "columnar", "fields": ["ident", "runway_length_ft", "tags"], "rows": [["EGKB", 5905]]}"#.utf8)
+
+        #expect(throws: DecodingError.self) {
+            try [Row].decodeColumnar(from: data, decoder: snakeCaseDecoder())
+        }
+    }
+
+    @Test func plainArrayStillDecodes() throws {
+        let data = Data(#"[{"ident": "EGKB", "runway_length_ft": 5905, "tags": []}]"#.utf8)
+
+        let rows = try [Row].decodeColumnar(from: data, decoder: snakeCaseDecoder())
+
+        #expect(rows == [Row(ident: "EGKB", runwayLengthFt: 5905, tags: [])])
+    }
+
+    @Test func camelCaseMatchesSnakeCaseStrategy() {
+        #expect(ColumnarJSON.camelCase("runway_length_ft") == "runwayLengthFt")
+        #expect(ColumnarJSON.camelCase("ident") == "ident")
+        #expect(ColumnarJSON.camelCase("_private_key") == "_privateKey")
+    }
+
+    @Test func requestedFromQuery() throws {
+        let columnar = URLRequest(url: try #require(URL(string: "https://example.com/api/airports?format=columnar&limit=5")))
+        let plain = URLRequest(url: try #require(URL(string: "https://example.com/api/airports?limit=5")))
+
+        #expect(ColumnarJSON.isRequested(by: columnar))
+        #expect(!ColumnarJSON.isRequested(by: plain))
+    }
+}
@@ -0,0 +1,46 @@
+//
+//  MapTileTests.swift
+//  FlyFunEuroAIPTests
+//
+//  Tests for MapTile quadtree math (must match web/server/api/tiles.py).
+//
+
+import Testing
+import Foundation
+@testable import FlyFunEuroAIP
+
+struct MapTileTests {
+
+    @Test func tileContainingParis() {
+        let box = BoundingBox(minLatitude: 48.86, maxLatitude: 48.86, minLongitude: 2.35, maxLongitude: 2.35)
+        let tiles = MapTile.tiles(covering: box, zoom: 8)
+
+        #expect(tiles == [MapTile(z: 8, x: 129, y: 88)])
+        #expect(tiles.first?.id == "8/129/88")
+    }
+
+    @Test func tileBoundsContainTile() {
+        let bounds = MapTile(z: 8, x: 129, y: 88).boundingBox
+
+        #expect(bounds.minLatitude <= 48.86 && 48.86 <= bounds.maxLatitude)
+        #expect(bounds.minLongitude <= 2.35 && 2.35 <= bounds.maxLongitude)
+    }
+
+    @Test func coveringTilesSpanBox() {
+        let box = BoundingBox(minLatitude: 45, maxLatitude: 50, minLongitude: -2, maxLongitude: 8)
+        let tiles = MapTile.tiles(covering: box, zoom: MapTile.zoom(for: box))
+
+        #expect(!tiles.isEmpty)
+        #expect(tiles.count <= 9)
+        #expect(tiles.contains { $0.boundingBox.minLongitude <= -2 })
+        #expect(tiles.contains { $0.boundingBox.maxLongitude >= 8 })
+    }
+
+    @Test func zoomIsClamped() {
+        let world = BoundingBox(minLatitude: -80, maxLatitude: 80, minLongitude: -180, maxLongitude: 180)
+        let airfield = BoundingBox(minLatitude: 48.0, maxLatitude: 48.001, minLongitude: 2.0, maxLongitude: 2.001)
+
+        #expect(MapTile.zoom(for: world) == 3)
+        #expect(MapTile.zoom(for: airfield) == 10)
+    }
+}
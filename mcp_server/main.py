@@ -95,13 +95,17 @@ async def lifespan(app: FastMCP):
     # Use ToolContext.create() for consistent initialization
     _tool_context = settings.build_tool_context(load_rules=True)
     _model = _tool_context.model
-    
+
+    # Build in-memory indexes (spatial, ...) before serving the first request
+    _tool_context.indexes.warm()
+
     if _tool_context.notification_service:
         logger.info(f"NotificationService initialized")
     else:
         logger.info("NotificationService not available")
     
     if _tool_context.ga_friendliness_service:
+        _tool_context.ga_friendliness_service.load_score_matrix()
         logger.info(f"GAFriendlinessService initialized")
     else:
         logger.info("GAFriendlinessService not configured (GA_PERSONA_DB not set)")
@@ -36,11 +36,12 @@ import json
 import urllib.request
 
 from euro_aip.models.airport import Airport
-from euro_aip.models.navpoint import NavPoint
 
 from .filtering import FilterEngine
+from .geocode_cache import get_geocode_cache
 from .prioritization import PriorityEngine
 from .tool_context import ToolContext
+from .tracing import span
 
 
 # =============================================================================
@@ -90,6 +91,8 @@ def _geoapify_geocode(query: str) -> Optional[Dict[str, Any]]:
     Forward-geocode a free-text location using Geoapify.
 
     Prefers European locations for ambiguous queries (e.g., "Bromley" returns UK, not USA).
+    Results (including "no match") are cached with a TTL; concurrent lookups of
+    the same query share one request (see shared/geocode_cache.py).
 
     Args:
         query: Free-text location name (e.g., "Paris", "Lake Geneva")
@@ -101,6 +104,20 @@ def _geoapify_geocode(query: str) -> Optional[Dict[str, Any]]:
     api_key = os.environ.get("GEOAPIFY_API_KEY")
     if not api_key:
         return None
+    try:
+        with span("geocode"):
+            return get_geocode_cache().get_or_fetch(query, lambda q: _geoapify_fetch(q, api_key))
+    except Exception:
+        return None
+
+
+def _geoapify_fetch(query: str, api_key: str) -> Optional[Dict[str, Any]]:
+    """
+    Uncached Geoapify lookup.
+
+    Returns None if nothing usable matched; raises on transport/HTTP errors so
+    they are not cached as "no match".
+    """
     base_url = "https://api.geoapify.com/v1/geocode/search"
     params = {
         "text": query,
@@ -109,38 +126,35 @@ def _geoapify_geocode(query: str) -> Optional[Dict[str, Any]]:
         "apiKey": api_key,
     }
     url = f"{base_url}?{urllib.parse.urlencode(params)}"
-    try:
-        with urllib.request.urlopen(url, timeout=10) as resp:
-            payload = resp.read()
-            data = json.loads(payload.decode("utf-8"))
-            results = data.get("results") or []
-            if not results:
-                return None
-
-            # Prefer European results for ambiguous queries like "Bromley"
-            selected = None
-            for result in results:
-                country_code = (result.get("country_code") or "").upper()
-                if country_code in EUROPEAN_COUNTRY_CODES:
-                    selected = result
-                    break
-
-            # Fall back to first result if no European match
-            if not selected:
-                selected = results[0]
+    with urllib.request.urlopen(url, timeout=10) as resp:
+        payload = resp.read()
+    data = json.loads(payload.decode("utf-8"))
+    results = data.get("results") or []
+    if not results:
+        return None
 
-            lat = selected.get("lat")
-            lon = selected.get("lon")
-            if lat is None or lon is None:
-                return None
-            return {
-                "lat": float(lat),
-                "lon": float(lon),
-                "formatted": selected.get("formatted") or query,
-                "country_code": selected.get("country_code"),
-            }
-    except Exception:
+    # Prefer European results for ambiguous queries like "Bromley"
+    selected = None
+    for result in results:
+        country_code = (result.get("country_code") or "").upper()
+        if country_code in EUROPEAN_COUNTRY_CODES:
+            selected = result
+            break
+
+    # Fall back to first result if no European match
+    if not selected:
+        selected = results[0]
+
+    lat = selected.get("lat")
+    lon = selected.get("lon")
+    if lat is None or lon is None:
         return None
+    return {
+        "lat": float(lat),
+        "lon": float(lon),
+        "formatted": selected.get("formatted") or query,
+        "country_code": selected.get("country_code"),
+    }
 
 
 def _find_nearest_airport_in_db(
@@ -186,37 +200,26 @@ def _find_nearest_airport_in_db(
     if not geocode:
         return None
 
-    center_point = NavPoint(latitude=geocode["lat"], longitude=geocode["lon"], name=geocode["formatted"])
     geocode_country = geocode.get("country_code")  # ISO-2 country code from Geoapify
 
-    # Find airports within radius, tracking both same-country and any-country nearest
+    # Find airports within radius (sorted by distance), tracking both same-country and any-country nearest
+    nearby = ctx.indexes.spatial.within_radius(geocode["lat"], geocode["lon"], max_search_radius_nm)
+
     nearest_same_country = None
     nearest_same_country_distance = float('inf')
     nearest_any = None
     nearest_any_distance = float('inf')
 
-    for apt in ctx.model.airports:
-        if not getattr(apt, "navpoint", None):
-            continue
-        try:
-            _, distance_nm = apt.navpoint.haversine_distance(center_point)
-        except Exception:
-            continue
+    if nearby:
+        nearest_any, nearest_any_distance = nearby[0]
 
-        if distance_nm > max_search_radius_nm:
-            continue
-
-        # Track nearest airport overall
-        if distance_nm < nearest_any_distance:
-            nearest_any_distance = distance_nm
-            nearest_any = apt
-
-        # Track nearest airport in same country (if country known)
-        if geocode_country and getattr(apt, "iso_country", None):
-            if apt.iso_country.upper() == geocode_country.upper():
-                if distance_nm < nearest_same_country_distance:
-                    nearest_same_country_distance = distance_nm
-                    nearest_same_country = apt
+    # Track nearest airport in same country (if country known)
+    if geocode_country:
+        for apt, distance_nm in nearby:
+            if (getattr(apt, "iso_country", None) or "").upper() == geocode_country.upper():
+                nearest_same_country = apt
+                nearest_same_country_distance = distance_nm
+                break
 
     # Prefer same-country airport if found, otherwise use nearest any
     if nearest_same_country:
@@ -630,7 +633,7 @@ def find_airports_near_location(
     Process:
     1) If location_query is an ICAO code, uses that airport's coordinates as center
     2) Otherwise geocodes the location via Geoapify (or uses pre-resolved center if provided)
-    3) Computes distance from each airport to that point and filters by max_distance_nm
+    3) Finds airports within max_distance_nm of that point (spatial index lookup)
     4) Applies optional filters (fuel, customs, runway, etc.) and priority sorting
     5) If max_hours_notice is set, filters to airports requiring at most that many hours notice
 
@@ -663,21 +666,12 @@ def find_airports_near_location(
                     "pretty": f"Could not geocode '{location_query}'. Ensure GEOAPIFY_API_KEY is set and the query is valid."
                 }
 
-    center_point = NavPoint(latitude=geocode["lat"], longitude=geocode["lon"], name=geocode["formatted"])
-
-    # Compute distances to all airports and filter by radius
+    # Find airports within radius using the spatial index
     candidate_airports: List[Airport] = []
     point_distances: Dict[str, float] = {}
-    for airport in ctx.model.airports:
-        if not getattr(airport, "navpoint", None):
-            continue
-        try:
-            _, distance_nm = airport.navpoint.haversine_distance(center_point)
-        except Exception:
-            continue
-        if distance_nm <= float(max_distance_nm):
-            candidate_airports.append(airport)
-            point_distances[airport.ident] = float(distance_nm)
+    for airport, distance_nm in ctx.indexes.spatial.within_radius(geocode["lat"], geocode["lon"], float(max_distance_nm)):
+        candidate_airports.append(airport)
+        point_distances[airport.ident] = distance_nm
 
     # Filter and sort using common pipeline
     persona_id = kwargs.pop("_persona_id", None)
@@ -808,9 +802,13 @@ def find_airports_near_route(
             f"Using nearest airport {to_airport.ident} ({to_airport.name}), {to_result['distance_nm']}nm away."
         )
 
-    results = ctx.model.find_airports_near_route(
+    # Cheap attribute-only filters run before the route geometry (corridor search
+    # via the spatial index); the remaining filters go through the common pipeline
+    prefilters, remaining_filters = FilterEngine.split_prefilters(filters)
+    results = ctx.indexes.find_airports_near_route(
         [from_airport.ident, to_airport.ident],
-        max_distance_nm
+        max_distance_nm,
+        candidate_filter=FilterEngine(context=ctx).predicate(prefilters),
     )
 
     # Calculate total route distance for position-based sorting
@@ -837,7 +835,7 @@ def find_airports_near_route(
     result = _filter_and_sort_airports(
         ctx=ctx,
         airports=airport_objects,
-        filters=filters,
+        filters=remaining_filters,
         include_large_airports=include_large_airports,
         priority_strategy=priority_strategy,
         priority_context_extra={
@@ -1,11 +1,12 @@
 from .fastapi_io import ChatMessage, ChatRequest, ChatResponse, build_chat_response
 from .langgraph_runner import build_agent, run_aviation_agent
 from .logging import (
+    close_log_writers,
     find_conversation_by_run_id,
     log_conversation_from_state,
     log_feedback,
 )
-from .streaming import stream_aviation_agent
+from .streaming import coalesce_stream, stream_aviation_agent
 
 __all__ = [
     "ChatMessage",
@@ -15,8 +16,10 @@ __all__ = [
     "build_agent",
     "run_aviation_agent",
     "log_conversation_from_state",
+    "close_log_writers",
     "find_conversation_by_run_id",
     "log_feedback",
     "stream_aviation_agent",
+    "coalesce_stream",
 ]
 
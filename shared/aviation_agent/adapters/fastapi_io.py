@@ -30,6 +30,10 @@ class ChatRequest(BaseModel):
         default=None,
         description="Thread ID for conversation memory. If provided, continues an existing conversation. If None, starts a new conversation (server will generate thread_id)."
     )
+    stream_mode: Literal["tokens", "coalesced"] = Field(
+        default="tokens",
+        description="Streaming only. 'coalesced' merges answer tokens into fewer message events and sends final_answer without fields already streamed."
+    )
 
     def to_langchain(self) -> List[BaseMessage]:
         if not self.messages:
@@ -71,6 +71,7 @@ def get_checkpointer(settings: AviationAgentSettings) -> Any:
 
 
 from ..execution import ToolRunner
+from ..prefetch import PrefetchCache, SpeculativePrefetcher
 from ..formatting import build_formatter_chain
 from ..graph import _build_agent_graph
 from ..planning import build_planner_runnable
@@ -127,7 +128,23 @@ def build_agent(
 
     tool_context = settings.build_tool_context()
     tool_client = AviationToolClient(tool_context)
-    tool_runner = ToolRunner(tool_client)
+    # Speculative prefetch (opt-in): predicted follow-up tool calls cached per thread
+    prefetch_config = behavior_config.speculative_prefetch
+    prefetch_cache = PrefetchCache(ttl_s=prefetch_config.ttl_seconds) if prefetch_config.enabled else None
+    tool_runner = ToolRunner(
+        tool_client,
+        max_parallel=behavior_config.tool_execution.max_parallel_tools,
+        timeout_s=behavior_config.tool_execution.timeout_seconds,
+        prefetch_cache=prefetch_cache,
+    )
+    prefetcher = None
+    if prefetch_cache is not None:
+        prefetcher = SpeculativePrefetcher(
+            tool_runner,
+            prefetch_cache,
+            max_calls=prefetch_config.max_calls,
+            tools=prefetch_config.tools,
+        )
     # Only expose LLM-visible tools to planner (filter out internal/MCP-only tools)
     llm_tools = tuple(t for t in tool_client.tools.values() if t.expose_to_llm)
 
@@ -147,6 +164,7 @@ def build_agent(
         formatter_llm,
         behavior_config=behavior_config,
         checkpointer=checkpointer,
+        prefetcher=prefetcher,
     )
     return graph
 
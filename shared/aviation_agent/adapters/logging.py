@@ -2,16 +2,23 @@
 Conversation logging adapter for aviation agent.
 
 Simple post-execution logging approach - extracts data from final agent state
-and saves to JSON log files (one file per day).
+and queues it for a background writer that appends batches to JSONL segment
+files (one per day and process), indexed by run_id for feedback lookups.
 """
 
 from __future__ import annotations
 
+import atexit
 import json
 import logging
-from datetime import datetime
+import os
+import queue
+import sqlite3
+import threading
+import time
+from datetime import datetime, timedelta
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import Any, Dict, List, Optional, Tuple
 
 from langchain_core.messages import BaseMessage
 
@@ -48,9 +55,12 @@ def log_conversation_from_state(
         ui_payload = state.get("ui_payload")
         error = state.get("error")
         
-        # Build tool_calls list
-        tool_calls = []
-        if plan and tool_result:
+        # Build tool_calls list (one entry per executed call when available)
+        tool_calls = [
+            {"name": r["tool"], "arguments": r["arguments"], "result": r["result"], "error": r["error"]}
+            for r in state.get("tool_results") or []
+        ]
+        if not tool_calls and plan and tool_result:
             # Handle both Pydantic model and dict
             if hasattr(plan, "selected_tool"):
                 tool_name = plan.selected_tool
@@ -102,62 +112,208 @@ def log_conversation_from_state(
         if error:
             log_entry["error"] = error
         
-        # Save to file
-        _save_log_entry(log_entry, log_dir)
+        # Queue for the background writer (no file I/O on the response path)
+        get_log_writer(log_dir).log_conversation(log_entry)
         
     except Exception as e:
         logger.error(f"Error logging conversation: {e}", exc_info=True)
         # Don't fail request if logging fails
 
 
-def _save_log_entry(log_entry: Dict[str, Any], log_dir: Path) -> None:
+class ConversationLogWriter:
     """
-    Save log entry to JSON file (one file per day).
-    
-    Format: conversation_logs/YYYY-MM-DD.json
+    Background writer for conversation and feedback logs.
+
+    Entries are queued by the request path and appended in batches by a daemon
+    thread to per-day, per-process JSONL segments:
+        YYYY-MM-DD.<pid>.jsonl            conversations
+        YYYY-MM-DD-feedback.<pid>.jsonl   feedback
+    Conversations with a run_id are indexed in index.sqlite (run_id -> segment,
+    offset, length), so feedback lookups read a single line. Per-process
+    segments keep offsets valid with several server workers sharing log_dir.
     """
-    try:
-        log_dir.mkdir(parents=True, exist_ok=True)
-        
-        # Create filename: YYYY-MM-DD.json (one file per day)
-        timestamp_str = log_entry["timestamp"]
-        if isinstance(timestamp_str, str):
-            timestamp = datetime.fromisoformat(timestamp_str)
-        else:
-            timestamp = datetime.fromtimestamp(timestamp_str)
-        
-        date_str = timestamp.strftime("%Y-%m-%d")
-        log_file = log_dir / f"{date_str}.json"
-        
-        # Read existing logs for today
-        logs = []
-        if log_file.exists():
+
+    INDEX_FILE = "index.sqlite"
+
+    def __init__(self, log_dir: Path, batch_size: int = 64, flush_interval_s: float = 1.0):
+        self.log_dir = Path(log_dir)
+        self.batch_size = batch_size
+        self.flush_interval_s = flush_interval_s
+        self._queue: "queue.Queue[Optional[Tuple[str, Dict[str, Any]]]]" = queue.Queue()
+        # Queued conversations by run_id, so feedback right after an answer finds them
+        self._pending: Dict[str, Dict[str, Any]] = {}
+        self._lock = threading.Lock()
+        self._closed = False
+        self._thread = threading.Thread(target=self._run, name="conversation-log-writer", daemon=True)
+        self._thread.start()
+
+    def log_conversation(self, entry: Dict[str, Any]) -> None:
+        self._enqueue("conversation", entry)
+
+    def log_feedback(self, entry: Dict[str, Any]) -> None:
+        self._enqueue("feedback", entry)
+
+    def find(self, run_id: str) -> Optional[Dict[str, Any]]:
+        """Conversation entry for run_id (queued or indexed), or None."""
+        with self._lock:
+            entry = self._pending.get(run_id)
+        if entry is not None:
+            return entry
+
+        index_path = self.log_dir / self.INDEX_FILE
+        if not index_path.exists():
+            return None
+        conn = sqlite3.connect(index_path, timeout=5)
+        try:
+            row = conn.execute(
+                "SELECT segment, offset, length FROM runs WHERE run_id = ?", (run_id,)
+            ).fetchone()
+        finally:
+            conn.close()
+        if row is None:
+            return None
+
+        segment, offset, length = row
+        with open(self.log_dir / segment, "rb") as f:
+            f.seek(offset)
+            return json.loads(f.read(length))
+
+    def flush(self) -> None:
+        """Block until everything queued so far is written."""
+        self._queue.join()
+
+    def close(self) -> None:
+        """Write remaining entries and stop the writer thread."""
+        with self._lock:
+            if self._closed:
+                return
+            self._closed = True
+        self._queue.put(None)
+        self._thread.join()
+
+    def _enqueue(self, kind: str, entry: Dict[str, Any]) -> None:
+        with self._lock:
+            if self._closed:
+                raise RuntimeError("ConversationLogWriter is closed")
+            if kind == "conversation" and entry.get("run_id"):
+                self._pending[entry["run_id"]] = entry
+            self._queue.put((kind, entry))
+
+    def _run(self) -> None:
+        while True:
+            item = self._queue.get()
+            batch = [item]
+            # The batch's first entry waits at most flush_interval_s, however often others arrive
+            deadline = time.monotonic() + self.flush_interval_s
+            while item is not None and len(batch) < self.batch_size:
+                remaining = deadline - time.monotonic()
+                if remaining <= 0:
+                    break
+                try:
+                    item = self._queue.get(timeout=remaining)
+                except queue.Empty:
+                    break
+                batch.append(item)
+
+            entries = [entry for entry in batch if entry is not None]
             try:
-                with open(log_file, 'r', encoding='utf-8') as f:
-                    logs = json.load(f)
-            except json.JSONDecodeError:
-                logger.warning(f"Could not read existing log file {log_file}, starting fresh")
-                logs = []
-        
-        # Append new entry
-        logs.append(log_entry)
-        
-        # Write back
-        with open(log_file, 'w', encoding='utf-8') as f:
-            json.dump(logs, f, indent=2, ensure_ascii=False)
-        
-        logger.info(f"💾 Conversation logged to {log_file} (duration: {log_entry['duration_seconds']:.2f}s)")
-        
-    except Exception as e:
-        logger.error(f"Error saving log entry: {e}", exc_info=True)
-        # Don't fail request if logging fails
+                if entries:
+                    self._write_batch(entries)
+            except Exception as e:
+                logger.error(f"Error writing {len(entries)} log entries: {e}", exc_info=True)
+            finally:
+                with self._lock:
+                    for kind, entry in entries:
+                        if kind == "conversation":
+                            self._pending.pop(entry.get("run_id"), None)
+                for _ in batch:
+                    self._queue.task_done()
+
+            if batch[-1] is None:
+                return
+
+    def _write_batch(self, entries: List[Tuple[str, Dict[str, Any]]]) -> None:
+        self.log_dir.mkdir(parents=True, exist_ok=True)
+        # Serialize up front: an entry that can't be encoded is dropped alone
+        by_segment: Dict[str, List[Tuple[str, Dict[str, Any], bytes]]] = {}
+        for kind, entry in entries:
+            try:
+                segment = self._segment_name(kind, entry)
+                line = json.dumps(entry, ensure_ascii=False).encode("utf-8")
+            except Exception as e:
+                logger.error(f"Skipping {kind} log entry {entry.get('run_id')}: {e}")
+                continue
+            by_segment.setdefault(segment, []).append((kind, entry, line))
+
+        index_rows = []
+        written = 0
+        try:
+            for segment, segment_entries in by_segment.items():
+                with open(self.log_dir / segment, "ab") as f:
+                    for kind, entry, line in segment_entries:
+                        offset = f.tell()
+                        f.write(line + b"\n")
+                        written += 1
+                        if kind == "conversation" and entry.get("run_id"):
+                            index_rows.append((entry["run_id"], segment, offset, len(line)))
+        finally:
+            # Index whatever reached the segments, even if a later write failed
+            if index_rows:
+                conn = sqlite3.connect(self.log_dir / self.INDEX_FILE, timeout=30)
+                try:
+                    with conn:
+                        conn.execute(
+                            "CREATE TABLE IF NOT EXISTS runs "
+                            "(run_id TEXT PRIMARY KEY, segment TEXT NOT NULL, offset INTEGER NOT NULL, length INTEGER NOT NULL)"
+                        )
+                        conn.executemany("INSERT OR REPLACE INTO runs VALUES (?, ?, ?, ?)", index_rows)
+                finally:
+                    conn.close()
+
+        logger.info(f"💾 Wrote {written} log entries to {', '.join(sorted(by_segment))}")
+
+    @staticmethod
+    def _segment_name(kind: str, entry: Dict[str, Any]) -> str:
+        timestamp = entry.get("timestamp")
+        date = datetime.fromisoformat(timestamp) if isinstance(timestamp, str) else datetime.now()
+        suffix = "-feedback" if kind == "feedback" else ""
+        return f"{date.strftime('%Y-%m-%d')}{suffix}.{os.getpid()}.jsonl"
+
+
+_writers: Dict[Path, ConversationLogWriter] = {}
+_writers_lock = threading.Lock()
+
+
+def get_log_writer(log_dir: Path) -> ConversationLogWriter:
+    """Shared writer for a log directory (started on first use, flushed at exit)."""
+    key = Path(log_dir).resolve()
+    with _writers_lock:
+        writer = _writers.get(key)
+        if writer is None:
+            writer = ConversationLogWriter(key)
+            _writers[key] = writer
+        return writer
+
+
+def close_log_writers() -> None:
+    """Flush and stop all writers (application shutdown)."""
+    with _writers_lock:
+        writers = list(_writers.values())
+        _writers.clear()
+    for writer in writers:
+        writer.close()
+
+
+atexit.register(close_log_writers)
 
 
 def find_conversation_by_run_id(run_id: str, log_dir: Path) -> Optional[Dict[str, Any]]:
     """
     Find a conversation log entry by run_id.
     
-    Searches through conversation log files to find the entry with the matching run_id.
+    Looks up the run_id index (or entries still queued for writing); logs
+    written before the index existed are found by scanning the last 7 days of
+    legacy YYYY-MM-DD.json files.
     
     Args:
         run_id: The run_id to search for
@@ -167,46 +323,55 @@ def find_conversation_by_run_id(run_id: str, log_dir: Path) -> Optional[Dict[str
         The conversation log entry if found, None otherwise
     """
     try:
+        entry = get_log_writer(log_dir).find(run_id)
+        if entry is not None:
+            return entry
+        
         if not log_dir.exists():
             logger.warning(f"Log directory {log_dir} does not exist")
             return None
         
-        # Search through recent log files (last 7 days)
-        from datetime import datetime, timedelta
-        today = datetime.now()
-        
-        for days_ago in range(7):
-            date = today - timedelta(days=days_ago)
-            date_str = date.strftime("%Y-%m-%d")
-            log_file = log_dir / f"{date_str}.json"
-            
-            if not log_file.exists():
-                continue
-            
-            try:
-                with open(log_file, 'r', encoding='utf-8') as f:
-                    logs = json.load(f)
-                    
-                # Search for entry with matching run_id
-                for entry in logs:
-                    if entry.get("run_id") == run_id:
-                        logger.info(f"Found conversation for run_id {run_id} in {log_file}")
-                        return entry
-            except json.JSONDecodeError:
-                logger.warning(f"Could not read log file {log_file}")
-                continue
-            except Exception as e:
-                logger.warning(f"Error reading log file {log_file}: {e}")
-                continue
-        
-        logger.warning(f"Could not find conversation for run_id {run_id}")
-        return None
+        entry = _find_in_legacy_logs(run_id, log_dir)
+        if entry is None:
+            logger.warning(f"Could not find conversation for run_id {run_id}")
+        return entry
         
     except Exception as e:
         logger.error(f"Error searching for conversation by run_id: {e}", exc_info=True)
         return None
 
 
+def _find_in_legacy_logs(run_id: str, log_dir: Path) -> Optional[Dict[str, Any]]:
+    """Scan legacy per-day JSON array files (last 7 days) for run_id."""
+    today = datetime.now()
+    
+    for days_ago in range(7):
+        date = today - timedelta(days=days_ago)
+        date_str = date.strftime("%Y-%m-%d")
+        log_file = log_dir / f"{date_str}.json"
+        
+        if not log_file.exists():
+            continue
+        
+        try:
+            with open(log_file, 'r', encoding='utf-8') as f:
+                logs = json.load(f)
+                
+            # Search for entry with matching run_id
+            for entry in logs:
+                if entry.get("run_id") == run_id:
+                    logger.info(f"Found conversation for run_id {run_id} in {log_file}")
+                    return entry
+        except json.JSONDecodeError:
+            logger.warning(f"Could not read log file {log_file}")
+            continue
+        except Exception as e:
+            logger.warning(f"Error reading log file {log_file}: {e}")
+            continue
+    
+    return None
+
+
 def log_feedback(
     run_id: str,
     score: int,
@@ -215,9 +380,9 @@ def log_feedback(
     log_dir: Path,
 ) -> None:
     """
-    Log user feedback to a separate feedback log file.
+    Log user feedback to separate feedback segments (queued, written in the background).
     
-    Format: conversation_logs/YYYY-MM-DD-feedback.json
+    Format: conversation_logs/YYYY-MM-DD-feedback.<pid>.jsonl
     
     Args:
         run_id: The run_id for the conversation
@@ -227,12 +392,6 @@ def log_feedback(
         log_dir: Directory to save log files
     """
     try:
-        log_dir.mkdir(parents=True, exist_ok=True)
-        
-        # Create filename: YYYY-MM-DD-feedback.json (one file per day)
-        date_str = datetime.now().strftime("%Y-%m-%d")
-        feedback_file = log_dir / f"{date_str}-feedback.json"
-        
         # Build feedback entry
         feedback_entry = {
             "run_id": run_id,
@@ -256,24 +415,9 @@ def log_feedback(
             feedback_entry["tool_calls"] = []
             logger.warning(f"Could not find conversation data for run_id {run_id}, logging feedback only")
         
-        # Read existing feedback logs for today
-        feedback_logs = []
-        if feedback_file.exists():
-            try:
-                with open(feedback_file, 'r', encoding='utf-8') as f:
-                    feedback_logs = json.load(f)
-            except json.JSONDecodeError:
-                logger.warning(f"Could not read existing feedback file {feedback_file}, starting fresh")
-                feedback_logs = []
-        
-        # Append new entry
-        feedback_logs.append(feedback_entry)
-        
-        # Write back
-        with open(feedback_file, 'w', encoding='utf-8') as f:
-            json.dump(feedback_logs, f, indent=2, ensure_ascii=False)
+        get_log_writer(log_dir).log_feedback(feedback_entry)
         
-        logger.info(f"💾 Feedback logged to {feedback_file} (run_id: {run_id}, score: {score})")
+        logger.info(f"Feedback queued for logging (run_id: {run_id}, score: {score})")
         
     except Exception as e:
         logger.error(f"Error saving feedback entry: {e}", exc_info=True)
@@ -1,13 +1,29 @@
 from __future__ import annotations
 
+import asyncio
 import logging
 import uuid
-from typing import Any, AsyncIterator, Dict, List, Optional
+from typing import Any, AsyncIterator, Dict, Iterable, List, Optional, Set
 
 from langchain_core.messages import BaseMessage
 
 logger = logging.getLogger(__name__)
 
+# Bounds for coalesced "message" events: flush after this long or this many characters
+COALESCE_MAX_DELAY_S = 0.05
+COALESCE_MAX_CHARS = 512
+
+# Final-state field carried by each streamed event. Other fields (combined
+# "thinking", additional "tool_results", an error-path "final_answer" without
+# message events) are never streamed and stay in the final state.
+STREAMED_EVENT_FIELDS = {
+    "message": "final_answer",
+    "thinking": "planning_reasoning",
+    "plan": "plan",
+    "tool_call_end": "tool_result",
+    "ui_payload": "ui_payload",
+}
+
 
 async def stream_aviation_agent(
     messages: List[BaseMessage],
@@ -37,7 +53,7 @@ async def stream_aviation_agent(
         - {"event": "thinking", "data": {"content": "..."}} - Planning reasoning
         - {"event": "tool_call_start", "data": {"name": "...", "arguments": {...}}}
         - {"event": "tool_call_end", "data": {"name": "...", "result": {...}}}
-        - {"event": "message", "data": {"content": "..."}} - Character-by-character answer
+        - {"event": "message", "data": {"content": "..."}} - Answer tokens as the LLM streams them
         - {"event": "thinking_done", "data": {}} - Thinking complete
         - {"event": "ui_payload", "data": {...}} - Visualization data
         - {"event": "final_answer", "data": {"state": {...}}} - Final complete state for logging
@@ -302,3 +318,97 @@ async def stream_aviation_agent(
             "data": {"message": str(e)}
         }
 
+
+
+def compact_final_state(state: Dict[str, Any], seen_events: Iterable[str] = ()) -> Dict[str, Any]:
+    """
+    final_answer payload without the fields earlier events already carried.
+
+    Only fields whose event was actually emitted (seen_events) are removed.
+    Returns {"state": <remaining fields>, "streamed": {field: event name}} so a
+    client can rebuild the full state from what it has received.
+    """
+    streamed = {
+        STREAMED_EVENT_FIELDS[event]: event
+        for event in seen_events
+        if event in STREAMED_EVENT_FIELDS and STREAMED_EVENT_FIELDS[event] in state
+    }
+    return {
+        "state": {k: v for k, v in state.items() if k not in streamed},
+        "streamed": {k: streamed[k] for k in state if k in streamed},
+    }
+
+
+async def coalesce_stream(
+    events: AsyncIterator[Dict[str, Any]],
+    max_delay_s: float = COALESCE_MAX_DELAY_S,
+    max_chars: int = COALESCE_MAX_CHARS,
+    compact_final: bool = True,
+) -> AsyncIterator[Dict[str, Any]]:
+    """
+    Lower-overhead view of stream_aviation_agent events for SSE transport.
+
+    - Consecutive "message" events are merged into one, flushed when it reaches
+      max_chars, max_delay_s after its first token, or before any other event
+      (so event order is preserved)
+    - With compact_final, "final_answer" carries compact_final_state() instead
+      of a full copy of the state, dropping only fields whose events passed through
+
+    Other events pass through unchanged.
+    """
+    loop = asyncio.get_running_loop()
+    iterator = events.__aiter__()
+    buffer: List[str] = []
+    buffered_chars = 0
+    deadline: Optional[float] = None
+    pending: Optional[asyncio.Future] = None
+    seen_events: Set[str] = set()
+
+    def flush() -> Dict[str, Any]:
+        nonlocal buffer, buffered_chars, deadline
+        event = {"event": "message", "data": {"content": "".join(buffer)}}
+        buffer, buffered_chars, deadline = [], 0, None
+        return event
+
+    try:
+        while True:
+            if pending is None:
+                pending = asyncio.ensure_future(iterator.__anext__())
+            if deadline is not None:
+                # Don't hold buffered tokens while the LLM is slow to produce the next one
+                done, _ = await asyncio.wait({pending}, timeout=max(0.0, deadline - loop.time()))
+                if not done:
+                    yield flush()
+                    continue
+            try:
+                event = await pending
+            except StopAsyncIteration:
+                break
+            finally:
+                pending = None
+
+            seen_events.add(event.get("event"))
+            if event.get("event") == "message":
+                content = (event.get("data") or {}).get("content") or ""
+                if not buffer:
+                    deadline = loop.time() + max_delay_s
+                buffer.append(content)
+                buffered_chars += len(content)
+                if buffered_chars >= max_chars:
+                    yield flush()
+                continue
+
+            if buffer:
+                yield flush()
+            if compact_final and event.get("event") == "final_answer":
+                event = {
+                    "event": "final_answer",
+                    "data": compact_final_state((event.get("data") or {}).get("state") or {}, seen_events),
+                }
+            yield event
+
+        if buffer:
+            yield flush()
+    finally:
+        if pending is not None:
+            pending.cancel()
@@ -7,6 +7,8 @@ from typing import Dict, List, Literal, Optional
 
 from pydantic import BaseModel, Field
 
+from .prefetch import DEFAULT_PREFETCH_TOOLS
+
 logger = logging.getLogger(__name__)
 
 
@@ -44,6 +46,10 @@ class RetrievalConfig(BaseModel):
     top_k: int = Field(default=5, gt=0, le=100)
     similarity_threshold: float = Field(default=0.3, ge=0.0, le=1.0)
     rerank_candidates_multiplier: int = Field(default=2, gt=0)
+    # Cache reformulations, query embeddings and results (see retrieval_cache.py)
+    cache_enabled: bool = True
+    cache_max_entries: int = Field(default=1024, gt=0)
+    cache_ttl_seconds: float = Field(default=86400.0, gt=0)
 
 
 class RAGConfig(BaseModel):
@@ -108,6 +114,23 @@ class NextQueryPredictionConfig(BaseModel):
     )
 
 
+class SpeculativePrefetchConfig(BaseModel):
+    """
+    Configuration for prefetching predicted follow-up tool calls (opt-in).
+
+    After each answer, the top-ranked suggestions whose arguments are known and
+    whose tool is in `tools` run in the background; the results are cached per
+    conversation thread for ttl_seconds. Requires next_query_prediction.
+    """
+    enabled: bool = False
+    max_calls: int = Field(default=2, ge=1, le=8, description="Suggestions prefetched per turn.")
+    ttl_seconds: float = Field(default=120.0, gt=0, le=3600)
+    tools: List[str] = Field(
+        default_factory=lambda: list(DEFAULT_PREFETCH_TOOLS),
+        description="Cheap, deterministic tools allowed to run speculatively (no LLM/RAG tools)."
+    )
+
+
 class ComparisonConfig(BaseModel):
     """
     Configuration for cross-country rule comparison feature.
@@ -150,6 +173,27 @@ class ComparisonConfig(BaseModel):
     )
 
 
+class ToolExecutionConfig(BaseModel):
+    """
+    Configuration for running the planned tool calls.
+
+    Independent calls from one plan run concurrently; each gets timeout_seconds
+    before it is reported as failed and the answer is formatted without it.
+    """
+    max_parallel_tools: int = Field(
+        default=4,
+        ge=1,
+        le=8,
+        description="Maximum tool calls executed per plan (primary + additional)."
+    )
+    timeout_seconds: float = Field(
+        default=30.0,
+        gt=0,
+        le=300,
+        description="Per-call timeout when several tools run concurrently."
+    )
+
+
 class PromptsConfig(BaseModel):
     planner: str  # Path to prompt file, e.g., "prompts/planner_v1.md"
     formatter: str
@@ -210,6 +254,8 @@ class AgentBehaviorConfig(BaseModel):
     reranking: RerankingConfig
     next_query_prediction: NextQueryPredictionConfig
     comparison: ComparisonConfig = ComparisonConfig()  # Cross-country comparison
+    tool_execution: ToolExecutionConfig = ToolExecutionConfig()  # Parallel tool calls
+    speculative_prefetch: SpeculativePrefetchConfig = SpeculativePrefetchConfig()  # Opt-in
     prompts: PromptsConfig
     examples: ExamplesConfig
     tools: Optional[ToolsConfig] = None  # Optional: tool description file paths
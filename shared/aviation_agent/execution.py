@@ -1,18 +1,129 @@
 from __future__ import annotations
 
-from typing import Any, Dict, Optional
+import contextvars
+import logging
+import time
+from concurrent.futures import ThreadPoolExecutor, TimeoutError as FutureTimeoutError
+from dataclasses import dataclass
+from typing import Any, Dict, List, Optional, Sequence
 
-from .planning import AviationPlan
+from shared import tracing
+
+from .planning import AviationPlan, ToolCall
+from .prefetch import PrefetchCache
 from .state import AgentState
 from .tools import AviationToolClient
 
+logger = logging.getLogger(__name__)
+
+
+@dataclass
+class ToolCallResult:
+    """Outcome of one planned tool call (result or error)."""
+    tool_name: str
+    arguments: Dict[str, Any]
+    result: Optional[Dict[str, Any]] = None
+    error: Optional[str] = None
+    duration_s: float = 0.0
+    prefetched: bool = False  # Served from the speculative prefetch cache
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {
+            "tool": self.tool_name,
+            "arguments": self.arguments,
+            "result": self.result,
+            "error": self.error,
+            "duration_s": round(self.duration_s, 3),
+            "prefetched": self.prefetched,
+        }
+
 
 class ToolRunner:
-    def __init__(self, tool_client: AviationToolClient):
+    """
+    Executes planned tool calls.
+
+    A single call runs inline. Independent calls (plan.additional_tool_calls)
+    run concurrently on worker threads, each bounded by timeout_s; results come
+    back in plan order whatever order the tools finish in. With a prefetch
+    cache, results speculatively computed for the thread are used first.
+    """
+
+    def __init__(
+        self,
+        tool_client: AviationToolClient,
+        max_parallel: int = 4,
+        timeout_s: float = 30.0,
+        prefetch_cache: Optional[PrefetchCache] = None,
+    ):
         self.tool_client = tool_client
+        self.max_parallel = max_parallel
+        self.timeout_s = timeout_s
+        self.prefetch_cache = prefetch_cache
 
     def run(self, plan: AviationPlan, state: Optional[AgentState] = None) -> Dict[str, Any]:
-        arguments = plan.arguments or {}
+        return self.tool_client.invoke(plan.selected_tool, self.prepare_arguments(plan.arguments, state))
+
+    def run_all(
+        self,
+        plan: AviationPlan,
+        state: Optional[AgentState] = None,
+        thread_id: Optional[str] = None,
+    ) -> List[ToolCallResult]:
+        """Run every planned call; failures and timeouts are reported per call, not raised."""
+        calls = plan.get_tool_calls()[: self.max_parallel]
+        if len(calls) <= 1:
+            return [self._run_call(call, state, thread_id) for call in calls]
+
+        executor = ThreadPoolExecutor(max_workers=len(calls), thread_name_prefix="aviation-tool")
+        try:
+            # Each call runs in a copy of this context so its spans join the current trace
+            futures = [
+                executor.submit(contextvars.copy_context().run, self._run_call, call, state, thread_id)
+                for call in calls
+            ]
+            # Calls start together, so one deadline gives each the full timeout
+            deadline = time.monotonic() + self.timeout_s
+            results: List[ToolCallResult] = []
+            for call, future in zip(calls, futures):
+                try:
+                    results.append(future.result(timeout=max(0.0, deadline - time.monotonic())))
+                except FutureTimeoutError:
+                    logger.warning(f"Tool '{call.tool_name}' timed out after {self.timeout_s}s")
+                    results.append(ToolCallResult(
+                        tool_name=call.tool_name,
+                        arguments=call.arguments,
+                        error=f"Tool '{call.tool_name}' timed out after {self.timeout_s}s",
+                        duration_s=self.timeout_s,
+                    ))
+            return results
+        finally:
+            # Don't wait for timed-out tools; their threads finish in the background
+            executor.shutdown(wait=False, cancel_futures=True)
+
+    def _run_call(self, call: ToolCall, state: Optional[AgentState], thread_id: Optional[str]) -> ToolCallResult:
+        start = time.perf_counter()
+        arguments = self.prepare_arguments(call.arguments, state)
+        if self.prefetch_cache is not None and thread_id:
+            cached = self.prefetch_cache.get(thread_id, call.tool_name, arguments)
+            if cached is not None:
+                logger.info(f"Using prefetched result for {call.tool_name}")
+                return ToolCallResult(call.tool_name, call.arguments, result=cached,
+                                      duration_s=time.perf_counter() - start, prefetched=True)
+        try:
+            result = self.tool_client.invoke(call.tool_name, arguments)
+            return ToolCallResult(call.tool_name, call.arguments, result=result,
+                                  duration_s=time.perf_counter() - start)
+        except Exception as e:
+            logger.error(f"Tool execution error: {e}", exc_info=True)
+            return ToolCallResult(call.tool_name, call.arguments, error=str(e),
+                                  duration_s=time.perf_counter() - start)
+        finally:
+            # Per-tool latency histogram (prefetch hits returned above are not counted)
+            tracing.record(f"tool.{call.tool_name}", time.perf_counter() - start)
+
+    @staticmethod
+    def prepare_arguments(arguments: Optional[Dict[str, Any]], state: Optional[AgentState]) -> Dict[str, Any]:
+        arguments = arguments or {}
         
         # Extract persona_id from state and inject into arguments for tools to use
         if state and "persona_id" in state:
@@ -21,5 +132,25 @@ class ToolRunner:
             arguments = dict(arguments)  # Make a copy to avoid mutating original
             arguments["_persona_id"] = state["persona_id"]
         
-        return self.tool_client.invoke(plan.selected_tool, arguments)
+        return arguments
+
+
+def merge_tool_results(primary: Dict[str, Any], additional: Sequence[ToolCallResult]) -> Dict[str, Any]:
+    """
+    Merge additional call results into the primary tool result.
+
+    The primary result keeps its shape (visualization and UI payload come from
+    it); the others are listed under "additional_results" in plan order and
+    their pretty text is appended, so the formatter sees everything.
+    """
+    merged = dict(primary)
+    merged["additional_results"] = [r.to_dict() for r in additional]
 
+    pretty_parts = [merged.get("pretty", "")]
+    for r in additional:
+        if r.error:
+            pretty_parts.append(f"**{r.tool_name}:** failed ({r.error})")
+        elif r.result and r.result.get("pretty"):
+            pretty_parts.append(f"**{r.tool_name}:**\n{r.result['pretty']}")
+    merged["pretty"] = "\n\n".join(part for part in pretty_parts if part)
+    return merged
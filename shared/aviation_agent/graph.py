@@ -5,13 +5,16 @@ import logging
 from pathlib import Path
 from typing import Any, Dict, Optional
 
+from langchain_core.runnables import RunnableConfig
 from langgraph.graph import END, StateGraph
 
 from .config import get_settings, get_behavior_config
 from shared.tool_context import get_tool_context_settings
-from .execution import ToolRunner
+from shared.tracing import span
+from .execution import ToolRunner, merge_tool_results
 from .formatting import build_formatter_chain
 from .planning import AviationPlan
+from .prefetch import SpeculativePrefetcher
 from .state import AgentState
 from .next_query_predictor import NextQueryPredictor, extract_context_from_plan
 
@@ -24,6 +27,7 @@ def _build_agent_graph(
     formatter_llm,
     behavior_config=None,
     checkpointer=None,
+    prefetcher: Optional[SpeculativePrefetcher] = None,
 ):
     """
     Internal: Assemble the LangGraph workflow.
@@ -38,9 +42,11 @@ def _build_agent_graph(
         behavior_config: AgentBehaviorConfig instance (loaded from JSON)
         checkpointer: Optional LangGraph checkpointer for conversation memory.
             When provided, enables multi-turn conversations via thread_id.
+        prefetcher: Optional speculative prefetcher (behavior_config.speculative_prefetch).
+            Needs next query prediction; tool results are cached per thread_id.
 
     Flow:
-        Planner → [Predict Next Queries] → Tool → Formatter → END
+        Planner → [Predict Next Queries] → Tool → Formatter → [Prefetch] → END
 
     The planner handles all tool selection including:
         - answer_rules_question: For specific questions about ONE country (uses RAG)
@@ -62,12 +68,15 @@ def _build_agent_graph(
             config=behavior_config.next_query_prediction
         )
         logger.info("✓ Next query predictor enabled")
+    if predictor is None:
+        prefetcher = None
 
     graph = StateGraph(AgentState)
 
     def planner_node(state: AgentState) -> Dict[str, Any]:
         try:
-            plan: AviationPlan = planner.invoke({"messages": state.get("messages") or []})
+            with span("llm.planner"):
+                plan: AviationPlan = planner.invoke({"messages": state.get("messages") or []})
             # Generate simple reasoning from plan
             reasoning_parts = [f"Selected tool: {plan.selected_tool}"]
             if plan.arguments.get("filters"):
@@ -128,14 +137,17 @@ def _build_agent_graph(
             logger.info(f"Generated {len(suggested_queries)} query suggestions")
 
             # Store in state for formatter to include in ui_payload
-            return {"suggested_queries": suggested_queries}
+            update: Dict[str, Any] = {"suggested_queries": suggested_queries}
+            if prefetcher is not None:
+                update["prefetch_calls"] = prefetcher.select_calls(suggestions)
+            return update
 
         except Exception as e:
             logger.error(f"Next query prediction failed: {e}", exc_info=True)
             return {}
 
 
-    def tool_node(state: AgentState) -> Dict[str, Any]:
+    def tool_node(state: AgentState, config: Optional[RunnableConfig] = None) -> Dict[str, Any]:
         if state.get("error"):
             return {}  # Skip if planner failed
         plan = state.get("plan")
@@ -149,8 +161,13 @@ def _build_agent_graph(
             if not tool_calls:
                 return {"error": "No tools selected in plan"}
             
-            # Single tool execution
-            result = tool_runner.run(plan, state)
+            # Primary and independent additional calls (concurrent when more than one)
+            thread_id = ((config or {}).get("configurable") or {}).get("thread_id")
+            call_results = tool_runner.run_all(plan, state, thread_id=thread_id)
+            primary = call_results[0]
+            if primary.error:
+                return {"error": primary.error, "tool_results": [r.to_dict() for r in call_results]}
+            result = primary.result
             
             # POST-PROCESSING: Enrich airport results with notification data
             # Check if this is a location/route tool and query mentions notifications
@@ -204,7 +221,10 @@ def _build_agent_graph(
                 
                 logger.info(f"📋 Enriched {len(notification_summaries)} airports with notification data")
             
-            return {"tool_result": result}
+            if len(call_results) > 1:
+                result = merge_tool_results(result, call_results[1:])
+            
+            return {"tool_result": result, "tool_results": [r.to_dict() for r in call_results]}
             
         except Exception as e:
             logger.error(f"Tool execution error: {e}", exc_info=True)
@@ -251,11 +271,12 @@ def _build_agent_graph(
                 topic_context = "\n".join(topic_parts) if topic_parts else ""
 
                 # Invoke comparison formatter with structured context
-                chain_result = comparison_formatter_chain.invoke({
-                    "countries": ", ".join(tool_result.get("countries", [])),
-                    "topic_context": topic_context,
-                    "rules_context": tool_result.get("rules_context", "No differences found."),
-                })
+                with span("llm.comparison_formatter"):
+                    chain_result = comparison_formatter_chain.invoke({
+                        "countries": ", ".join(tool_result.get("countries", [])),
+                        "topic_context": topic_context,
+                        "rules_context": tool_result.get("rules_context", "No differences found."),
+                    })
 
                 answer = chain_result if isinstance(chain_result, str) else str(
                     chain_result.content if hasattr(chain_result, 'content') else chain_result
@@ -271,14 +292,17 @@ def _build_agent_graph(
                     "ui_payload": ui_payload,
                 }
 
-            chain_result = formatter_chain.invoke(
-                {
-                    "messages": state.get("messages") or [],
-                    "answer_style": plan.answer_style if plan else "narrative_markdown",
-                    "tool_result_json": json.dumps(tool_result, indent=2, ensure_ascii=False),
-                    "pretty_text": tool_result.get("pretty", ""),
-                }
-            )
+            with span("serialize"):
+                tool_result_json = json.dumps(tool_result, indent=2, ensure_ascii=False)
+            with span("llm.formatter"):
+                chain_result = formatter_chain.invoke(
+                    {
+                        "messages": state.get("messages") or [],
+                        "answer_style": plan.answer_style if plan else "narrative_markdown",
+                        "tool_result_json": tool_result_json,
+                        "pretty_text": tool_result.get("pretty", ""),
+                    }
+                )
             
             # Process the answer and build UI payload
             from .formatting import build_ui_payload
@@ -323,14 +347,34 @@ def _build_agent_graph(
                 "thinking": state.get("planning_reasoning", ""),
             }
 
+    def prefetch_node(state: AgentState, config: Optional[RunnableConfig] = None) -> Dict[str, Any]:
+        """
+        Queue the predicted follow-up tool calls in the background (returns immediately).
+
+        Runs after the formatter, so the answer has already been produced.
+        """
+        calls = state.get("prefetch_calls")
+        thread_id = ((config or {}).get("configurable") or {}).get("thread_id")
+        if prefetcher is None or not calls or not thread_id or state.get("error"):
+            return {}
+        try:
+            queued = prefetcher.schedule(thread_id, calls, persona_id=state.get("persona_id"))
+            if queued:
+                logger.info(f"Prefetching {queued} predicted tool calls")
+        except Exception as e:
+            logger.warning(f"Prefetch scheduling failed: {e}")
+        return {}
+
     # Add nodes
     graph.add_node("planner", planner_node)
     if predictor:
         graph.add_node("predict_next_queries", predict_next_queries_node)
     graph.add_node("tool", tool_node)
     graph.add_node("formatter", formatter_node)
+    if prefetcher:
+        graph.add_node("prefetch", prefetch_node)
 
-    # Build graph: Planner → [Predict Next Queries] → Tool → Formatter → END
+    # Build graph: Planner → [Predict Next Queries] → Tool → Formatter → [Prefetch] → END
     graph.set_entry_point("planner")
     if predictor:
         graph.add_edge("planner", "predict_next_queries")
@@ -338,7 +382,11 @@ def _build_agent_graph(
     else:
         graph.add_edge("planner", "tool")
     graph.add_edge("tool", "formatter")
-    graph.add_edge("formatter", END)
+    if prefetcher:
+        graph.add_edge("formatter", "prefetch")
+        graph.add_edge("prefetch", END)
+    else:
+        graph.add_edge("formatter", END)
 
     # Compile with optional checkpointer for conversation memory
     return graph.compile(checkpointer=checkpointer)
@@ -80,6 +80,18 @@ class SuggestedQuery:
     tool_name: str
     category: str  # "rules", "route", "details", "pricing"
     priority: int  # 1-5, higher = more relevant
+    # Tool arguments the planner is expected to produce for this query, when they
+    # follow directly from the current plan (used for speculative prefetch)
+    arguments: Optional[Dict[str, Any]] = None
+
+
+# Argument receiving the entity value, per tool (entity-based suggestions)
+ENTITY_ARGUMENTS = {
+    ToolName.GET_AIRPORT_DETAILS: "icao_code",
+    ToolName.GET_NOTIFICATION_FOR_AIRPORT: "icao",
+    ToolName.BROWSE_RULES: "country_code",
+    ToolName.SEARCH_AIRPORTS: "query",
+}
 
 
 def extract_context_from_plan(
@@ -316,11 +328,17 @@ class NextQueryPredictor:
         for filter_config in filter_suggestions:
             filter_name = filter_config["filter"]
             if not context.filters_applied.get(filter_name):
+                # Same tool with one more filter: the current arguments plus that filter
+                arguments = None
+                if filter_config["tool_name"] == context.tool_used:
+                    arguments = dict(context.tool_arguments)
+                    arguments["filters"] = {**context.filters_applied, filter_name: True}
                 suggestions.append(SuggestedQuery(
                     query_text=filter_config["query_text"],
                     tool_name=filter_config["tool_name"],
                     category=filter_config["category"],
-                    priority=filter_config["priority"]
+                    priority=filter_config["priority"],
+                    arguments=arguments
                 ))
         return suggestions
 
@@ -359,11 +377,13 @@ class NextQueryPredictor:
                 # Format template with entity value
                 query_text = entity_config["query_template"].format(**{var_name: entity_value})
                 
+                argument_name = ENTITY_ARGUMENTS.get(entity_config["tool_name"])
                 suggestions.append(SuggestedQuery(
                     query_text=query_text,
                     tool_name=entity_config["tool_name"],
                     category=entity_config["category"],
-                    priority=entity_config["priority"]
+                    priority=entity_config["priority"],
+                    arguments={argument_name: entity_value} if argument_name else None
                 ))
         return suggestions
 
@@ -675,7 +695,8 @@ class NextQueryPredictor:
             query_text=f"What are the notification requirements for {icao}?",
             tool_name=ToolName.GET_NOTIFICATION_FOR_AIRPORT,
             category=SuggestionCategory.DETAILS,
-            priority=PRIORITY_MEDIUM_HIGH
+            priority=PRIORITY_MEDIUM_HIGH,
+            arguments={"icao": icao}
         ))
 
         # Entity-based suggestions (countries)
@@ -718,7 +739,8 @@ class NextQueryPredictor:
                 query_text=f"Which airports have customs in {country}?",
                 tool_name=ToolName.SEARCH_AIRPORTS,
                 category=SuggestionCategory.ROUTE,
-                priority=PRIORITY_HIGH
+                priority=PRIORITY_HIGH,
+                arguments={"query": country, "filters": {FilterName.POINT_OF_ENTRY: True}}
             ))
 
             # Suggest VFR rules if not already viewing them
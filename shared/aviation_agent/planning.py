@@ -25,9 +25,12 @@ class AviationPlan(BaseModel):
     """
     Structured representation of the planner's decision.
 
-    The planner selects exactly one tool name from the shared manifest and
-    provides the arguments that should be sent to that tool. The formatter can
-    use `answer_style` to decide between brief, narrative, checklist, etc.
+    The planner selects one primary tool name from the shared manifest and
+    provides the arguments that should be sent to that tool. When the question
+    needs more than one independent lookup (e.g. a route search plus a rules
+    question), the others go in `additional_tool_calls` and run concurrently
+    with the primary call. The formatter can use `answer_style` to decide
+    between brief, narrative, checklist, etc.
     """
 
     selected_tool: str = Field(..., description="Name of the tool to call.")
@@ -35,14 +38,28 @@ class AviationPlan(BaseModel):
         default_factory=dict,
         description="Arguments to call the selected tool with.",
     )
+    additional_tool_calls: List[ToolCall] = Field(
+        default_factory=list,
+        description=(
+            "Other tool calls needed to answer, independent of selected_tool "
+            "(they must not need its result). Leave empty when one tool is enough."
+        ),
+    )
     answer_style: str = Field(
         default="narrative_markdown",
         description="Preferred style for the final answer (hint for formatter).",
     )
     
     def get_tool_calls(self) -> List[ToolCall]:
-        """Get tool calls for compatibility with tool_node."""
-        return [ToolCall(tool_name=self.selected_tool, arguments=self.arguments)]
+        """Primary call first, then additional calls in plan order (exact duplicates dropped)."""
+        calls = [ToolCall(tool_name=self.selected_tool, arguments=self.arguments)]
+        seen = {(self.selected_tool, json.dumps(self.arguments, sort_keys=True, default=str))}
+        for call in self.additional_tool_calls:
+            key = (call.tool_name, json.dumps(call.arguments, sort_keys=True, default=str))
+            if key not in seen:
+                seen.add(key)
+                calls.append(call)
+        return calls
 
 
 def _build_planner_prompt_messages(
@@ -121,7 +138,8 @@ def build_planner_runnable(
             final_instruction = (
                 "Analyze the conversation above and select one tool from the manifest. "
                 "Do not invent tools. You MUST populate the 'arguments' field with ALL required arguments for the selected tool. "
-                "Extract any filters the user mentioned into arguments.filters."
+                "Extract any filters the user mentioned into arguments.filters. "
+                "Only if the question also needs other independent lookups, add them to 'additional_tool_calls'."
             )
             prompt_messages = _build_planner_prompt_messages(
                 system_prompt, example_messages, final_instruction
@@ -152,6 +170,7 @@ def build_planner_runnable(
     final_instruction = (
         "Analyze the conversation above and emit a JSON plan. You must use one tool "
         "from the manifest. Do not invent tools. You MUST populate the 'arguments' field with ALL required arguments for the selected tool. "
+        "Only if the question also needs other independent lookups, add them to 'additional_tool_calls'. "
         "Return an actual plan instance with 'selected_tool', 'arguments', and 'answer_style' fields, not the schema description.\n\n"
         "{format_instructions}"
     )
@@ -211,7 +230,7 @@ def _validate_plan(plan: "AviationPlan", tools: Sequence[AviationTool]) -> None:
     
     tool_calls = plan.get_tool_calls()
     if not tool_calls:
-        raise ValueError("Plan has no tool calls (neither selected_tool nor tool_calls populated).")
+        raise ValueError("Plan has no tool calls (neither selected_tool nor additional_tool_calls populated).")
     
     for tc in tool_calls:
         if tc.tool_name not in valid_names:
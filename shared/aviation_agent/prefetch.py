@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+Speculative prefetch of predicted follow-up tool calls.
+
+After a turn is answered, the top-ranked next-query suggestions whose tool
+arguments follow directly from the current plan (see SuggestedQuery.arguments)
+are executed in the background. Results are cached per conversation thread for
+a short time; ToolRunner checks the cache before invoking a tool, so clicking a
+suggestion chip only pays for planning and formatting.
+
+Only cheap, deterministic tools are prefetched (database and rules lookups, no
+LLM or RAG calls). Cached results are reused only when the planner produces the
+same arguments (after dropping None/empty values), for the same persona.
+"""
+import copy
+import logging
+import threading
+from concurrent.futures import ThreadPoolExecutor
+from typing import Any, Dict, Iterable, List, Optional
+
+from .retrieval_cache import RetrievalCache, cache_key
+
+logger = logging.getLogger(__name__)
+
+# Tools whose results depend only on their arguments and local data
+DEFAULT_PREFETCH_TOOLS = (
+    "search_airports",
+    "find_airports_near_route",
+    "get_airport_details",
+    "get_notification_for_airport",
+    "browse_rules",
+)
+
+CACHE_STAGE = "prefetch"
+
+
+def normalize_arguments(arguments: Any) -> Any:
+    """Arguments without None values or empty containers (planners differ on these)."""
+    if isinstance(arguments, dict):
+        normalized = {k: normalize_arguments(v) for k, v in arguments.items()}
+        return {k: v for k, v in normalized.items() if v is not None and v != {} and v != []}
+    if isinstance(arguments, list):
+        return [normalize_arguments(v) for v in arguments]
+    return arguments
+
+
+class PrefetchCache:
+    """
+    Short-lived tool results per conversation thread.
+
+    Usage:
+        cache = PrefetchCache(ttl_s=120)
+        cache.set(thread_id, "search_airports", arguments, result)
+        hit = cache.get(thread_id, "search_airports", arguments)
+    """
+
+    def __init__(self, ttl_s: float = 120.0, max_entries: int = 512):
+        self._cache = RetrievalCache(max_entries=max_entries, ttl_s=ttl_s)
+
+    def __len__(self) -> int:
+        return len(self._cache)
+
+    def get(self, thread_id: str, tool_name: str, arguments: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        """Copy of a cached result (callers may mutate results), or None."""
+        result = self._cache.get(CACHE_STAGE, thread_id, tool_name, normalize_arguments(arguments))
+        return copy.deepcopy(result) if result is not None else None
+
+    def contains(self, thread_id: str, tool_name: str, arguments: Dict[str, Any]) -> bool:
+        return self._cache.get(CACHE_STAGE, thread_id, tool_name, normalize_arguments(arguments)) is not None
+
+    def set(self, thread_id: str, tool_name: str, arguments: Dict[str, Any], result: Dict[str, Any]) -> None:
+        self._cache.set(result, CACHE_STAGE, thread_id, tool_name, normalize_arguments(arguments))
+
+
+class SpeculativePrefetcher:
+    """
+    Runs predicted tool calls on a small background pool and fills a PrefetchCache.
+
+    schedule() returns immediately; calls already cached or in flight for the
+    thread are skipped, and failures are only logged (the real turn will run
+    the tool itself).
+    """
+
+    def __init__(
+        self,
+        tool_runner: Any,  # ToolRunner (not imported: execution imports this module)
+        cache: PrefetchCache,
+        max_calls: int = 2,
+        tools: Iterable[str] = DEFAULT_PREFETCH_TOOLS,
+        max_workers: int = 2,
+    ):
+        self.tool_runner = tool_runner
+        self.cache = cache
+        self.max_calls = max_calls
+        self.tools = frozenset(tools)
+        self._executor = ThreadPoolExecutor(max_workers=max_workers, thread_name_prefix="aviation-prefetch")
+        self._pending: set = set()
+        self._lock = threading.Lock()
+
+    def select_calls(self, suggestions: Iterable[Any]) -> List[Dict[str, Any]]:
+        """{"tool", "arguments"} for the top-ranked suggestions that can be prefetched."""
+        calls: List[Dict[str, Any]] = []
+        for suggestion in suggestions:
+            if len(calls) >= self.max_calls:
+                break
+            if suggestion.arguments and suggestion.tool_name in self.tools:
+                calls.append({"tool": suggestion.tool_name, "arguments": suggestion.arguments})
+        return calls
+
+    def schedule(
+        self,
+        thread_id: str,
+        calls: Iterable[Dict[str, Any]],
+        persona_id: Optional[str] = None,
+    ) -> int:
+        """Queue calls (from select_calls) for a thread; returns how many were queued."""
+        state = {"persona_id": persona_id} if persona_id else None
+        queued = 0
+        for call in calls:
+            tool_name = call["tool"]
+            arguments = self.tool_runner.prepare_arguments(call["arguments"], state)
+            key = cache_key(CACHE_STAGE, thread_id, tool_name, normalize_arguments(arguments))
+            with self._lock:
+                if key in self._pending or self.cache.contains(thread_id, tool_name, arguments):
+                    continue
+                self._pending.add(key)
+            self._executor.submit(self._run, key, thread_id, tool_name, arguments)
+            queued += 1
+        return queued
+
+    def shutdown(self) -> None:
+        self._executor.shutdown(wait=True)
+
+    def _run(self, key: str, thread_id: str, tool_name: str, arguments: Dict[str, Any]) -> None:
+        try:
+            result = self.tool_runner.tool_client.invoke(tool_name, arguments)
+            self.cache.set(thread_id, tool_name, arguments, result)
+            logger.debug(f"Prefetched {tool_name} for thread {thread_id}")
+        except Exception as e:
+            logger.info(f"Prefetch of {tool_name} failed (will run on demand): {e}")
+        finally:
+            with self._lock:
+                self._pending.discard(key)
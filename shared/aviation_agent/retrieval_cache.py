@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""
+Content-addressed cache for rules retrieval.
+
+`RulesRAG.retrieve_rules` can make three network round trips per question
+(reformulation LLM, query embedding, rerank). Rules questions repeat a lot, so
+each stage's output is cached under a hash of everything it depends on:
+
+- reformulation: normalized query
+- embedding: embedding model + query text
+- results: normalized query + countries + retrieval settings + collection version
+
+The collection version changes whenever `build_vector_db` recreates the
+collection, which drops all cached results (embeddings stay valid).
+"""
+import hashlib
+import json
+import threading
+import time
+from collections import OrderedDict
+from typing import Any, Optional, Tuple
+
+# Entries kept across all stages
+DEFAULT_MAX_ENTRIES = 1024
+
+# Reformulations and rankings drift with prompt/model updates; refresh daily
+DEFAULT_TTL_S = 24 * 3600.0
+
+
+def normalize_query(query: str) -> str:
+    """Case- and whitespace-insensitive form of a query."""
+    return " ".join(query.lower().split())
+
+
+def cache_key(stage: str, *parts: Any) -> str:
+    """Stable hash of a stage name and its (JSON-serializable) inputs."""
+    payload = json.dumps([stage, *parts], sort_keys=True, separators=(",", ":"), default=str)
+    return hashlib.sha256(payload.encode("utf-8")).hexdigest()
+
+
+class RetrievalCache:
+    """
+    Thread-safe LRU with TTL, keyed by `cache_key`.
+
+    Usage:
+        cache = RetrievalCache()
+        hit = cache.get("embedding", model, text)
+        cache.set(embedding, "embedding", model, text)
+    """
+
+    def __init__(self, max_entries: int = DEFAULT_MAX_ENTRIES, ttl_s: float = DEFAULT_TTL_S):
+        self.max_entries = max_entries
+        self.ttl_s = ttl_s
+        self._entries: "OrderedDict[str, Tuple[Any, float]]" = OrderedDict()
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.misses = 0
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+    def get(self, stage: str, *parts: Any) -> Optional[Any]:
+        """Cached value, or None on a miss."""
+        key = cache_key(stage, *parts)
+        now = time.monotonic()
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is None or now - entry[1] > self.ttl_s:
+                if entry is not None:
+                    del self._entries[key]
+                self.misses += 1
+                return None
+            self._entries.move_to_end(key)
+            self.hits += 1
+            return entry[0]
+
+    def set(self, value: Any, stage: str, *parts: Any) -> None:
+        """Store a value for a stage and its inputs."""
+        key = cache_key(stage, *parts)
+        with self._lock:
+            self._entries[key] = (value, time.monotonic())
+            self._entries.move_to_end(key)
+            while len(self._entries) > self.max_entries:
+                self._entries.popitem(last=False)
+
+    def clear(self) -> None:
+        """Drop all entries."""
+        with self._lock:
+            self._entries.clear()
@@ -7,9 +7,13 @@ enabling efficient retrieval of relevant rules based on natural language queries
 """
 from __future__ import annotations
 
+import copy
 import json
 import logging
 import os
+import threading
+import time
+from datetime import datetime, timezone
 from pathlib import Path
 from typing import Any, Dict, List, Optional
 from urllib.parse import urlparse
@@ -17,8 +21,24 @@ from urllib.parse import urlparse
 import chromadb
 from chromadb.config import Settings
 
+from shared.tracing import span, traced
+
+from .retrieval_cache import RetrievalCache, normalize_query
+from .vector_index import MANIFEST_FILE, LocalVectorIndex, export_collection, read_manifest
+
 logger = logging.getLogger(__name__)
 
+# Seconds between checks whether the collection was rebuilt (retrieval cache version)
+COLLECTION_CHECK_INTERVAL_S = 60.0
+
+
+class _RetrievalUnavailable(Exception):
+    """Embedding or vector search failed; the (empty) result must not be cached."""
+
+
+class RetrievalFallback(Exception):
+    """An optional stage (reformulation, reranking) failed; raised instead of falling back when strict=True."""
+
 
 class EmbeddingProvider:
     """
@@ -140,13 +160,14 @@ class QueryReformulator:
         
         self._initialized = True
     
-    def reformulate(self, query: str, context: Optional[List[str]] = None) -> str:
+    def reformulate(self, query: str, context: Optional[List[str]] = None, strict: bool = False) -> str:
         """
         Reformulate a colloquial query into a formal aviation question.
         
         Args:
             query: User's original query
             context: Optional conversation context
+            strict: Raise RetrievalFallback instead of returning the original query on failure
             
         Returns:
             Reformulated formal question, or original if reformulation fails
@@ -181,6 +202,8 @@ Formal question:"""
                 
         except Exception as e:
             logger.warning(f"Query reformulation failed: {e}")
+            if strict:
+                raise RetrievalFallback("reformulation") from e
             return query
 
 
@@ -209,7 +232,8 @@ class OpenAIReranker:
         query: str,
         documents: List[Dict[str, Any]],
         text_key: str = "question_text",
-        top_k: Optional[int] = None
+        top_k: Optional[int] = None,
+        strict: bool = False
     ) -> List[Dict[str, Any]]:
         """
         Rerank documents using OpenAI embeddings.
@@ -219,6 +243,7 @@ class OpenAIReranker:
             documents: List of document dicts to rerank
             text_key: Key in document dict containing text to compare
             top_k: Number of top results to return (None = all)
+            strict: Raise RetrievalFallback instead of returning the original documents on failure
             
         Returns:
             Reranked list of documents with added 'rerank_score' field
@@ -265,6 +290,8 @@ class OpenAIReranker:
             
         except Exception as e:
             logger.warning(f"OpenAI reranking failed: {e}")
+            if strict:
+                raise RetrievalFallback("reranking") from e
             return documents
 
 
@@ -316,7 +343,8 @@ class Reranker:
         query: str, 
         documents: List[Dict[str, Any]], 
         text_key: str = "question_text",
-        top_k: int = None
+        top_k: int = None,
+        strict: bool = False
     ) -> List[Dict[str, Any]]:
         """
         Rerank documents using Cohere rerank API.
@@ -326,6 +354,7 @@ class Reranker:
             documents: List of document dicts to rerank
             text_key: Key in document dict containing text to compare
             top_k: Number of top results to return (None = all)
+            strict: Raise RetrievalFallback instead of returning the original documents on failure
             
         Returns:
             Reranked list of documents with added 'rerank_score' field
@@ -375,6 +404,8 @@ class Reranker:
             
         except Exception as e:
             logger.warning(f"Cohere reranking failed: {e}")
+            if strict:
+                raise RetrievalFallback("reranking") from e
             return documents
 
 
@@ -398,6 +429,7 @@ class RulesRAG:
         retrieval_config: Optional[Any] = None,
         llm: Optional[Any] = None,
         rules_manager: Optional[Any] = None,
+        vector_index_path: Optional[Path | str] = None,
     ):
         """
         Initialize RAG system.
@@ -413,9 +445,12 @@ class RulesRAG:
             retrieval_config: RetrievalConfig object with retrieval parameters (top_k, similarity_threshold, rerank_candidates_multiplier)
             llm: Optional LLM instance for reformulation
             rules_manager: Optional RulesManager instance for multi-country lookups
+            vector_index_path: Directory exported by build_vector_db(vector_index_path=...).
+                If provided, searches in-process (see vector_index.py) and takes precedence over ChromaDB.
         """
         self.vector_db_path = Path(vector_db_path) if vector_db_path else None
         self.vector_db_url = vector_db_url
+        self.vector_index_path = Path(vector_index_path) if vector_index_path else None
         self.embedding_model = embedding_model
         
         # Initialize embedding provider
@@ -455,8 +490,22 @@ class RulesRAG:
         # Store rules manager for multi-country lookups
         self.rules_manager = rules_manager
         
-        # Initialize ChromaDB - use service mode if URL is provided, otherwise local mode
-        if self.vector_db_url:
+        # Retrieval cache (reformulation, query embedding, results)
+        self._cache: Optional[RetrievalCache] = None
+        if retrieval_config is None or getattr(retrieval_config, "cache_enabled", True):
+            self._cache = RetrievalCache(
+                max_entries=getattr(retrieval_config, "cache_max_entries", 1024),
+                ttl_s=getattr(retrieval_config, "cache_ttl_seconds", 86400.0),
+            )
+        self._collection_version: Optional[str] = None
+        self._collection_checked_at = 0.0
+        self._collection_lock = threading.Lock()
+        
+        # Initialize backend - in-process index if exported, else ChromaDB service or local mode
+        self.client = None
+        if self.vector_index_path:
+            logger.info(f"Using in-process vector index at {self.vector_index_path}")
+        elif self.vector_db_url:
             logger.info(f"Initializing ChromaDB service at {self.vector_db_url}")
             # Parse URL to extract host and port
             parsed_url = urlparse(self.vector_db_url)
@@ -483,11 +532,10 @@ class RulesRAG:
         
         # Load collection
         try:
-            self.collection = self.client.get_collection(
-                name="aviation_rules",
-                embedding_function=None  # We provide embeddings manually
-            )
+            self.collection = self._open_collection()
             doc_count = self.collection.count()
+            self._collection_version = self._read_collection_version(self.collection)
+            self._collection_checked_at = time.monotonic()
             logger.info(f"✓ Loaded collection with {doc_count} documents")
         except Exception as e:
             logger.error(f"Failed to load collection: {e}")
@@ -508,6 +556,79 @@ class RulesRAG:
             return value
         return default
     
+    def _open_collection(self) -> Any:
+        """Rules collection from the configured backend."""
+        if self.vector_index_path:
+            return LocalVectorIndex.load(self.vector_index_path)
+        return self.client.get_collection(
+            name="aviation_rules",
+            embedding_function=None  # We provide embeddings manually
+        )
+
+    @staticmethod
+    def _read_collection_version(collection: Any) -> str:
+        """Identifies one build of the collection (changes when it is recreated)."""
+        metadata = collection.metadata or {}
+        return f"{collection.id}:{metadata.get('built_at', '')}:{collection.count()}"
+
+    def _current_collection_version(self) -> Optional[str]:
+        """
+        Collection version for cache keys, re-checked every COLLECTION_CHECK_INTERVAL_S.
+
+        A rebuild (possibly by another process) replaces the collection, so the
+        handle is reloaded too.
+        """
+        if time.monotonic() - self._collection_checked_at < COLLECTION_CHECK_INTERVAL_S:
+            return self._collection_version
+        with self._collection_lock:
+            if time.monotonic() - self._collection_checked_at < COLLECTION_CHECK_INTERVAL_S:
+                return self._collection_version
+            self._collection_checked_at = time.monotonic()
+            try:
+                if (
+                    isinstance(self.collection, LocalVectorIndex)
+                    and read_manifest(self.vector_index_path).get("built_at") == self.collection.metadata.get("built_at")
+                ):
+                    return self._collection_version  # Unchanged; skip reloading the index
+                collection = self._open_collection()
+                version = self._read_collection_version(collection)
+            except Exception as e:
+                logger.warning(f"Could not check rules collection version: {e}")
+                return self._collection_version
+            if version != self._collection_version:
+                if self._collection_version is not None:
+                    logger.info("Rules collection rebuilt, reloading and dropping cached results")
+                self.collection = collection
+                self._collection_version = version
+        return self._collection_version
+
+    @traced("llm.reformulate")
+    def _reformulate(self, query: str) -> str:
+        """Reformulated query (cached; raises RetrievalFallback if the reformulator failed)."""
+        if self._cache is None:
+            return self.reformulator.reformulate(query, strict=True)
+        normalized = normalize_query(query)
+        cached = self._cache.get("reformulation", normalized)
+        if cached is not None:
+            return cached
+        reformulated = self.reformulator.reformulate(query, strict=True)
+        # Unchanged queries (e.g. no LLM configured) are not worth an entry
+        if reformulated != query:
+            self._cache.set(reformulated, "reformulation", normalized)
+        return reformulated
+
+    @traced("rag.embed")
+    def _embed_query(self, query: str) -> List[float]:
+        """Query embedding (cached)."""
+        if self._cache is None:
+            return self.embedding_provider.embed_query(query)
+        cached = self._cache.get("embedding", self.embedding_model, query)
+        if cached is not None:
+            return cached
+        embedding = self.embedding_provider.embed_query(query)
+        self._cache.set(embedding, "embedding", self.embedding_model, query)
+        return embedding
+
     def retrieve_rules(
         self,
         query: str,
@@ -542,24 +663,76 @@ class RulesRAG:
         
         # Use provided rules_manager or fall back to instance variable
         rules_mgr = rules_manager or self.rules_manager
+        if reformulate is None:
+            reformulate = self.enable_reformulation
         
+        # Identical questions (same countries and settings) reuse the final results
+        results_key = None
+        if self._cache is not None:
+            multiplier = getattr(self.retrieval_config, "rerank_candidates_multiplier", 2)
+            results_key = (
+                self._current_collection_version(),
+                normalize_query(query),
+                sorted(c.upper() for c in countries) if countries else [],
+                top_k,
+                similarity_threshold,
+                bool(reformulate and self.reformulator),
+                self.reranking_provider,
+                multiplier,
+                rules_mgr is not None,
+            )
+            cached = self._cache.get("results", *results_key)
+            if cached is not None:
+                logger.info(f"Retrieved {len(cached)} rules from cache")
+                return copy.deepcopy(cached)
+        
+        fallbacks: List[str] = []
+        try:
+            matches = self._retrieve_rules_uncached(
+                query, countries, top_k, similarity_threshold, reformulate, rules_mgr, fallbacks
+            )
+        except _RetrievalUnavailable:
+            return []
+        
+        # Degraded results (a stage fell back) must not be served under the full key
+        if fallbacks:
+            logger.info(f"Not caching rules results: {', '.join(fallbacks)} fell back")
+        elif results_key is not None:
+            self._cache.set(copy.deepcopy(matches), "results", *results_key)
+        return matches
+
+    def _retrieve_rules_uncached(
+        self,
+        query: str,
+        countries: Optional[List[str]],
+        top_k: int,
+        similarity_threshold: float,
+        reformulate: bool,
+        rules_mgr: Optional[Any],
+        fallbacks: List[str],
+    ) -> List[Dict[str, Any]]:
+        """
+        retrieve_rules without the results cache (raises _RetrievalUnavailable on backend errors).
+
+        Stages that failed and were skipped (reformulation, reranking) are appended to `fallbacks`.
+        """
         # Determine if we have multiple countries
         has_multiple_countries = countries and len(countries) > 1
         
         # Query reformulation
         original_query = query
-        if reformulate is None:
-            reformulate = self.enable_reformulation
-        
         if reformulate and self.reformulator:
-            query = self.reformulator.reformulate(query)
+            try:
+                query = self._reformulate(query)
+            except RetrievalFallback as e:
+                fallbacks.append(str(e))
         
         # Generate query embedding
         try:
-            query_embedding = self.embedding_provider.embed_query(query)
+            query_embedding = self._embed_query(query)
         except Exception as e:
             logger.error(f"Failed to generate query embedding: {e}")
-            return []
+            raise _RetrievalUnavailable() from e
         
         # For multiple countries: query WITHOUT country filter to get globally best questions
         # Then use RulesManager to expand those questions to all requested countries
@@ -587,7 +760,7 @@ class RulesRAG:
             )
         except Exception as e:
             logger.error(f"ChromaDB query failed: {e}")
-            return []
+            raise _RetrievalUnavailable() from e
         
         # Extract top question IDs and their similarity scores
         question_matches = []
@@ -632,12 +805,18 @@ class RulesRAG:
                 multiplier = self.retrieval_config.rerank_candidates_multiplier
             candidates = question_matches[:top_k * multiplier]
             if candidates:
-                question_matches = self.reranker.rerank(
-                    query=original_query,  # Use original query, not reformulated
-                    documents=candidates,
-                    text_key="question_text",
-                    top_k=top_k
-                )
+                with span("rag.rerank"):
+                    try:
+                        question_matches = self.reranker.rerank(
+                            query=original_query,  # Use original query, not reformulated
+                            documents=candidates,
+                            text_key="question_text",
+                            top_k=top_k,
+                            strict=True
+                        )
+                    except RetrievalFallback as e:
+                        fallbacks.append(str(e))
+                        question_matches = candidates[:top_k]
                 logger.info(f"Reranked {len(candidates)} candidates to {len(question_matches)} results using {self.reranking_provider}")
         else:
             question_matches = question_matches[:top_k]
@@ -779,6 +958,7 @@ def build_vector_db(
     batch_size: int = 100,
     force_rebuild: bool = False,
     build_answer_embeddings: bool = True,
+    vector_index_path: Optional[Path | str] = None,
 ) -> int | Dict[str, int]:
     """
     Build vector database from rules.json.
@@ -795,6 +975,8 @@ def build_vector_db(
         batch_size: Number of documents to process per batch
         force_rebuild: If True, rebuild even if collection exists
         build_answer_embeddings: If True, also build answer embeddings collection
+        vector_index_path: If provided, also export the questions collection as an
+            in-process index (memory-mapped float32 matrix, see vector_index.py)
 
     Returns:
         If build_answer_embeddings=False: Number of documents added (int)
@@ -885,6 +1067,11 @@ def build_vector_db(
             doc_count = existing.count()
             logger.info(f"Collection already exists with {doc_count} documents")
             logger.info("Use force_rebuild=True to rebuild")
+            if vector_index_path and not (Path(vector_index_path) / MANIFEST_FILE).exists():
+                try:
+                    export_collection(existing, vector_index_path)
+                except Exception as e:
+                    logger.error(f"Failed to export vector index: {e}")
             return doc_count
         logger.info("Force rebuild: deleting existing collection")
         client.delete_collection(collection_name)
@@ -894,7 +1081,11 @@ def build_vector_db(
     # Create new collection
     collection = client.create_collection(
         name=collection_name,
-        metadata={"description": "Aviation rules and regulations by country"}
+        metadata={
+            "description": "Aviation rules and regulations by country",
+            # Identifies this build (RulesRAG drops cached retrieval results when it changes)
+            "built_at": datetime.now(timezone.utc).isoformat(),
+        }
     )
     logger.info(f"Created collection: {collection_name}")
 
@@ -963,6 +1154,9 @@ def build_vector_db(
     
     logger.info(f"✓ Questions collection built with {total_added} documents")
 
+    if vector_index_path:
+        export_collection(collection, vector_index_path)
+
     # Build answer embeddings collection if requested
     answers_added = 0
     if build_answer_embeddings:
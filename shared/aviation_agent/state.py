@@ -32,7 +32,8 @@ class AgentState(TypedDict, total=False):
     planning_reasoning: Optional[str]  # Planner's reasoning (why this tool/approach)
 
     # Tool execution
-    tool_result: Optional[Any]  # Result from tool execution
+    tool_result: Optional[Any]  # Result from tool execution (primary tool, additional results merged in)
+    tool_results: Optional[List[dict]]  # Per-call results in plan order (tool, arguments, result/error, duration_s)
 
     # Output
     formatting_reasoning: Optional[str]  # Formatter's reasoning (how to present results)
@@ -46,4 +47,5 @@ class AgentState(TypedDict, total=False):
 
     # Next query prediction
     suggested_queries: Optional[List[dict]]  # Suggested follow-up queries
+    prefetch_calls: Optional[List[dict]]  # {tool, arguments} to prefetch after answering
 
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+In-process vector index for rules retrieval.
+
+The rules corpus (one document per question and country) is a few thousand
+embeddings at most, so exact search over a float32 matrix is faster than a
+round trip to ChromaDB and avoids loading its client at startup:
+
+- embeddings live in one contiguous (n, dim) float32 matrix, memory-mapped
+  from `embeddings.npy`, so worker processes share the pages
+- a query is one matrix-vector product plus argpartition for the top k
+- country filters use boolean masks precomputed at load time
+
+`LocalVectorIndex` mimics the subset of the Chroma collection API used by
+`RulesRAG` (`query`, `count`, `id`, `metadata`), including squared L2
+distances, so retrieval scores are identical in both modes.
+
+Directory layout written by `export_collection`:
+    manifest.json   format version, built_at, count, dimension
+    documents.json  ids, documents, metadatas (row order of the matrix)
+    embeddings.npy  float32 matrix
+"""
+from __future__ import annotations
+
+import json
+import logging
+import os
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+import numpy as np
+
+logger = logging.getLogger(__name__)
+
+FORMAT_VERSION = 1
+
+MANIFEST_FILE = "manifest.json"
+DOCUMENTS_FILE = "documents.json"
+EMBEDDINGS_FILE = "embeddings.npy"
+
+# Metadata field with precomputed filter masks
+MASKED_FIELD = "country_code"
+
+
+def read_manifest(path: Path | str) -> Dict[str, Any]:
+    """Manifest of an exported index (cheap; does not load embeddings)."""
+    with open(Path(path) / MANIFEST_FILE, "r", encoding="utf-8") as f:
+        return json.load(f)
+
+
+class LocalVectorIndex:
+    """
+    Exact nearest-neighbour search over an exported rules collection.
+
+    Usage:
+        index = LocalVectorIndex.load("cache/rules_vector_index")
+        results = index.query(query_embeddings=[embedding], n_results=5,
+                              where={"country_code": {"$in": ["FR"]}})
+    """
+
+    def __init__(
+        self,
+        ids: List[str],
+        documents: List[str],
+        metadatas: List[Dict[str, Any]],
+        embeddings: np.ndarray,
+        metadata: Optional[Dict[str, Any]] = None,
+    ):
+        if embeddings.ndim != 2 or embeddings.shape[0] != len(ids):
+            raise ValueError(f"Embeddings shape {embeddings.shape} does not match {len(ids)} documents")
+        self.ids = ids
+        self.documents = documents
+        self.metadatas = metadatas
+        self.embeddings = embeddings
+        self.metadata = metadata or {}
+        self.id = f"local:{self.metadata.get('built_at', '')}"
+        # ||x||^2 for squared L2 distances: ||x||^2 - 2 x.q + ||q||^2
+        self._norms = np.einsum("ij,ij->i", embeddings, embeddings, dtype=np.float32)
+        self._masks: Dict[str, np.ndarray] = {}
+        values = np.array([str(m.get(MASKED_FIELD, "")) for m in metadatas], dtype=object)
+        for value in set(values):
+            self._masks[value] = values == value
+
+    @classmethod
+    def load(cls, path: Path | str) -> "LocalVectorIndex":
+        """Load an index written by `export_collection` (embeddings are memory-mapped)."""
+        path = Path(path)
+        manifest = read_manifest(path)
+        if manifest.get("format_version") != FORMAT_VERSION:
+            raise ValueError(f"Unsupported vector index format: {manifest.get('format_version')}")
+        with open(path / DOCUMENTS_FILE, "r", encoding="utf-8") as f:
+            docs = json.load(f)
+        embeddings = np.load(path / EMBEDDINGS_FILE, mmap_mode="r")
+        return cls(docs["ids"], docs["documents"], docs["metadatas"], embeddings, manifest)
+
+    def count(self) -> int:
+        return len(self.ids)
+
+    def _mask(self, where: Optional[Dict[str, Any]]) -> Optional[np.ndarray]:
+        """Row mask for a Chroma-style filter on MASKED_FIELD (None = all rows)."""
+        if not where:
+            return None
+        if set(where) != {MASKED_FIELD}:
+            raise ValueError(f"Unsupported filter: {where}")
+        condition = where[MASKED_FIELD]
+        if isinstance(condition, dict):
+            if "$in" in condition:
+                values = condition["$in"]
+            elif "$eq" in condition:
+                values = [condition["$eq"]]
+            else:
+                raise ValueError(f"Unsupported filter: {where}")
+        else:
+            values = [condition]
+        mask = np.zeros(len(self.ids), dtype=bool)
+        for value in values:
+            if value in self._masks:
+                mask |= self._masks[value]
+        return mask
+
+    def query(
+        self,
+        query_embeddings: List[List[float]],
+        n_results: int = 10,
+        where: Optional[Dict[str, Any]] = None,
+        include: Optional[List[str]] = None,
+    ) -> Dict[str, List[List[Any]]]:
+        """Top n_results per query embedding, in Chroma's result format."""
+        include = include or ["documents", "metadatas", "distances"]
+        queries = np.asarray(query_embeddings, dtype=np.float32)
+        mask = self._mask(where)
+        rows = np.arange(len(self.ids)) if mask is None else np.flatnonzero(mask)
+
+        results: Dict[str, List[List[Any]]] = {"ids": [], "documents": [], "metadatas": [], "distances": []}
+        for q in queries:
+            if len(rows) == 0 or n_results <= 0:
+                top, distances = rows[:0], np.empty(0, dtype=np.float32)
+            else:
+                # One matrix-vector product over all rows; the mask only selects candidates
+                distances = (self._norms - 2.0 * (self.embeddings @ q) + float(q @ q))[rows]
+                k = min(n_results, len(rows))
+                order = np.argpartition(distances, k - 1)[:k] if k < len(rows) else np.arange(len(rows))
+                order = order[np.argsort(distances[order], kind="stable")]
+                top, distances = rows[order], np.maximum(distances[order], 0.0)
+            results["ids"].append([self.ids[i] for i in top])
+            results["documents"].append([self.documents[i] for i in top])
+            results["metadatas"].append([self.metadatas[i] for i in top])
+            results["distances"].append([float(d) for d in distances])
+        return {key: value for key, value in results.items() if key == "ids" or key in include}
+
+
+def _write_atomic(path: Path, write) -> None:
+    tmp = path.with_name(path.name + ".tmp")
+    write(tmp)
+    os.replace(tmp, path)
+
+
+def export_collection(collection: Any, path: Path | str) -> int:
+    """
+    Export a Chroma collection (documents, metadatas, embeddings) as a LocalVectorIndex.
+
+    The manifest is written last; `RulesRAG` watches its built_at to pick up a rebuild.
+
+    Returns:
+        Number of exported documents
+    """
+    path = Path(path)
+    path.mkdir(parents=True, exist_ok=True)
+    data = collection.get(include=["documents", "metadatas", "embeddings"])
+    embeddings = np.ascontiguousarray(np.asarray(data["embeddings"], dtype=np.float32))
+    if embeddings.ndim != 2:
+        raise ValueError("Collection has no embeddings to export")
+
+    def save_embeddings(tmp: Path) -> None:
+        with open(tmp, "wb") as f:
+            np.save(f, embeddings)
+
+    def save_documents(tmp: Path) -> None:
+        with open(tmp, "w", encoding="utf-8") as f:
+            json.dump({"ids": data["ids"], "documents": data["documents"], "metadatas": data["metadatas"]}, f)
+
+    def save_manifest(tmp: Path) -> None:
+        manifest = {
+            "format_version": FORMAT_VERSION,
+            "name": collection.name,
+            "built_at": (collection.metadata or {}).get("built_at", ""),
+            "count": int(embeddings.shape[0]),
+            "dimension": int(embeddings.shape[1]),
+        }
+        with open(tmp, "w", encoding="utf-8") as f:
+            json.dump(manifest, f, indent=2)
+
+    _write_atomic(path / EMBEDDINGS_FILE, save_embeddings)
+    _write_atomic(path / DOCUMENTS_FILE, save_documents)
+    _write_atomic(path / MANIFEST_FILE, save_manifest)
+    logger.info(f"✓ Exported {embeddings.shape[0]} documents to local vector index at {path}")
+    return int(embeddings.shape[0])
@@ -3,9 +3,12 @@
 Filter engine for applying multiple filters to airports.
 """
 import logging
-from typing import Dict, Any, List, Iterable, Optional, TYPE_CHECKING
+from typing import Callable, Dict, Any, List, Iterable, Optional, Tuple, TYPE_CHECKING
 from euro_aip.models.airport import Airport
 
+from shared.indexing.feature_table import bitset_membership
+from shared.tracing import traced
+
 from .filters import (
     Filter,
     CountryFilter,
@@ -28,6 +31,7 @@ logger = logging.getLogger(__name__)
 
 if TYPE_CHECKING:
     from shared.tool_context import ToolContext
+    from shared.indexing.feature_table import AirportFeatureTable
 
 
 class FilterRegistry:
@@ -105,6 +109,7 @@ class FilterEngine:
         """
         self.context = context
 
+    @traced("filter_engine")
     def apply(
         self,
         airports: Iterable[Airport],
@@ -129,47 +134,133 @@ class FilterEngine:
                 "max_landing_fee": 50
             }
         """
+        airports = list(airports)
         if not filters:
-            return list(airports)
-
-        filtered: List[Airport] = []
-        filters_applied = []
-
-        for airport in airports:
-            passes_all_filters = True
-
-            for filter_name, filter_value in filters.items():
-                # Get the filter from registry
-                filter_obj = FilterRegistry.get(filter_name)
-
-                if not filter_obj:
-                    logger.warning(f"Unknown filter: {filter_name}, skipping")
-                    continue
-
-                # Track which filters are being applied (for logging)
-                if filter_name not in filters_applied:
-                    filters_applied.append(filter_name)
-
-                # Apply the filter
+            return airports
+        input_count = len(airports)
+
+        # Resolve filters once
+        resolved: List[Tuple[Filter, Any]] = []
+        for filter_name, filter_value in filters.items():
+            filter_obj = FilterRegistry.get(filter_name)
+            if not filter_obj:
+                logger.warning(f"Unknown filter: {filter_name}, skipping")
+                continue
+            resolved.append((filter_obj, filter_value))
+        filters_applied = [filter_obj.name for filter_obj, _ in resolved]
+
+        # 1. Vectorized path: AND the bitsets of all filters that support it
+        table = self._feature_table()
+        object_filters = resolved
+        if table is not None and resolved:
+            mask = table.all_mask
+            object_filters = []
+            for filter_obj, filter_value in resolved:
                 try:
-                    if not filter_obj.apply(
-                        airport,
-                        filter_value,
-                        self.context,
-                    ):
-                        passes_all_filters = False
-                        break  # Airport failed this filter, no need to check others
+                    filter_mask = filter_obj.apply_vectorized(table, filter_value, self.context)
                 except Exception as e:
-                    logger.error(f"Error applying filter {filter_name} to {airport.ident}: {e}")
-                    passes_all_filters = False
-                    break
+                    logger.error(f"Error applying vectorized filter {filter_obj.name}: {e}")
+                    filter_mask = None
+                if filter_mask is None:
+                    object_filters.append((filter_obj, filter_value))
+                else:
+                    mask &= filter_mask
+
+            if len(object_filters) < len(resolved):
+                # Byte lookup per candidate: decoding every set bit costs O(model) for a few candidates
+                selected = bitset_membership(mask)
+                positions = table.positions
+                candidates: List[Airport] = []
+                for airport in airports:
+                    row = positions.get(airport.ident)
+                    if row is not None and table.airports[row] is airport:
+                        if selected(row):
+                            candidates.append(airport)
+                    elif self._passes(airport, resolved):
+                        # Not part of the table's model - evaluate every filter per airport
+                        candidates.append(airport)
+                airports = candidates
+
+        # 2. Object path for filters without a vectorized implementation
+        if object_filters:
+            airports = [a for a in airports if self._passes(a, object_filters)]
+
+        logger.info(f"Filters applied: {filters_applied} | Input: {input_count} airports → Output: {len(airports)} airports")
+
+        return airports
+
+    def _feature_table(self) -> Optional["AirportFeatureTable"]:
+        """Feature table of the context's model, if available."""
+        model = getattr(self.context, "model", None)
+        if model is None:
+            return None
+        try:
+            return self.context.indexes.features
+        except Exception as e:
+            logger.debug(f"Feature table unavailable, using per-airport filters: {e}")
+            return None
+
+    def _passes(self, airport: Airport, resolved: List[Tuple[Filter, Any]]) -> bool:
+        """Object-based evaluation of resolved filters for one airport."""
+        for filter_obj, filter_value in resolved:
+            try:
+                if not filter_obj.apply(airport, filter_value, self.context):
+                    return False  # Airport failed this filter, no need to check others
+            except Exception as e:
+                logger.error(f"Error applying filter {filter_obj.name} to {airport.ident}: {e}")
+                return False
+        return True
+
+    @staticmethod
+    def split_prefilters(
+        filters: Optional[Dict[str, Any]] = None
+    ) -> Tuple[Dict[str, Any], Dict[str, Any]]:
+        """
+        Split filters into cheap attribute-only filters and the rest.
 
-            if passes_all_filters:
-                filtered.append(airport)
+        Attribute-only filters (country, point_of_entry, has_hard_runway, ...) do not
+        need the ToolContext and can run before expensive steps such as route
+        geometry. Unknown filter names stay in the second dict so apply() still
+        logs them.
 
-        logger.info(f"Filters applied: {filters_applied} | Input: {len(list(airports))} airports → Output: {len(filtered)} airports")
+        Returns:
+            (prefilters, remaining_filters)
+        """
+        prefilters: Dict[str, Any] = {}
+        remaining: Dict[str, Any] = {}
+        for filter_name, filter_value in (filters or {}).items():
+            filter_obj = FilterRegistry.get(filter_name)
+            if filter_obj and not filter_obj.uses_context:
+                prefilters[filter_name] = filter_value
+            else:
+                remaining[filter_name] = filter_value
+        return prefilters, remaining
+
+    def predicate(
+        self,
+        filters: Optional[Dict[str, Any]] = None
+    ) -> Optional[Callable[[Airport], bool]]:
+        """
+        Build a single-airport predicate for the given filters.
 
-        return filtered
+        Returns None when there is nothing to filter, so callers can skip the check.
+        """
+        if not filters:
+            return None
+        resolved = []
+        for filter_name, filter_value in filters.items():
+            filter_obj = FilterRegistry.get(filter_name)
+            if not filter_obj:
+                logger.warning(f"Unknown filter: {filter_name}, skipping")
+                continue
+            resolved.append((filter_obj, filter_value))
+        if not resolved:
+            return None
+
+        def passes(airport: Airport) -> bool:
+            return self._passes(airport, resolved)
+
+        return passes
 
     def get_available_filters(self) -> Dict[str, str]:
         """Get all available filters with descriptions."""
@@ -8,6 +8,7 @@ from euro_aip.models.airport import Airport
 
 if TYPE_CHECKING:
     from shared.tool_context import ToolContext
+    from shared.indexing.feature_table import AirportFeatureTable
 
 
 class Filter(ABC):
@@ -22,6 +23,11 @@ class Filter(ABC):
     name: str = "base_filter"
     description: str = "Base filter"
 
+    # True when the filter needs services from the ToolContext (GA db, model lookups).
+    # Filters that only read Airport attributes are cheap and can be applied
+    # before expensive steps such as route geometry.
+    uses_context: bool = False
+
     @abstractmethod
     def apply(
         self,
@@ -35,12 +41,40 @@ class Filter(ABC):
         Args:
             airport: Airport to check
             value: Filter value from user (e.g., country code, boolean, number)
-            enrichment_storage: Optional enrichment data (pricing, fuel, etc.)
+            context: Optional ToolContext for filters that need services
 
         Returns:
             True if airport passes filter, False otherwise
         """
         raise NotImplementedError
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        """
+        Optional vectorized path over the whole feature table.
+
+        Must select exactly the airports for which apply() returns True.
+
+        Args:
+            table: Feature table of the model being filtered
+            value: Filter value from user
+            context: Optional ToolContext for filters that need services
+
+        Returns:
+            Bitset of passing table rows, or None if this filter has no
+            vectorized path (FilterEngine then falls back to apply()).
+        """
+        return None
+
+    @staticmethod
+    def _boolean_mask(table: "AirportFeatureTable", column: str, value: Any) -> int:
+        """Mask for `bool(attribute) == bool(value)` on a boolean column."""
+        mask = table.column(column)
+        return mask if value else table.all_mask & ~mask
+
     def __repr__(self):
         return f"<Filter: {self.name}>"
@@ -8,6 +8,7 @@ from .base import Filter
 
 if TYPE_CHECKING:
     from shared.tool_context import ToolContext
+    from shared.indexing.feature_table import AirportFeatureTable
 
 class CountryFilter(Filter):
     """Filter airports by ISO country code."""
@@ -26,6 +27,16 @@ class CountryFilter(Filter):
         airport_country = (airport.iso_country or "").upper()
         return airport_country == country_code
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if not value:
+            return table.all_mask
+        return table.country_mask(str(value))
+
 
 class HasProceduresFilter(Filter):
     """Filter airports by procedure availability."""
@@ -43,6 +54,16 @@ class HasProceduresFilter(Filter):
         has_procedures = bool(airport.procedures)
         return has_procedures == bool(value)
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        return self._boolean_mask(table, "has_procedures", value)
+
 
 class HasAipDataFilter(Filter):
     """Filter airports by AIP data availability."""
@@ -60,6 +81,16 @@ class HasAipDataFilter(Filter):
         has_aip = bool(len(airport.aip_entries) > 0)
         return has_aip == bool(value)
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        return self._boolean_mask(table, "has_aip_data", value)
+
 
 class HasHardRunwayFilter(Filter):
     """Filter airports by hard surface runway availability."""
@@ -77,6 +108,16 @@ class HasHardRunwayFilter(Filter):
         has_hard = bool(getattr(airport, "has_hard_runway", False))
         return has_hard == bool(value)
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        return self._boolean_mask(table, "has_hard_runway", value)
+
 
 class PointOfEntryFilter(Filter):
     """Filter airports by border crossing (customs) capability."""
@@ -94,6 +135,16 @@ class PointOfEntryFilter(Filter):
         is_poe = bool(getattr(airport, "point_of_entry", False))
         return is_poe == bool(value)
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        return self._boolean_mask(table, "point_of_entry", value)
+
 
 class ExcludeLargeAirportsFilter(Filter):
     """Filter to exclude large airports (typically commercial hubs not suitable for GA)."""
@@ -111,3 +162,14 @@ class ExcludeLargeAirportsFilter(Filter):
         airport_type = getattr(airport, "type", "") or ""
         # Exclude if type is "large_airport"
         return airport_type.lower() != "large_airport"
+
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None or not value:
+            return table.all_mask
+        return table.all_mask & ~table.column("large_airport")
+
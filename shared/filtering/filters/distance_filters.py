@@ -14,6 +14,7 @@ class TripDistanceFilter(Filter):
     """Filter airports by trip distance (in nautical miles)."""
     name = "trip_distance"
     description = "Filter by trip distance range (dict with 'from' (ICAO code), and optional 'min'/'max' keys in NM)"
+    uses_context = True
 
     def apply(
         self,
@@ -8,6 +8,7 @@ from .base import Filter
 
 if TYPE_CHECKING:
     from shared.tool_context import ToolContext
+    from shared.indexing.feature_table import AirportFeatureTable
 
 
 class HasAvgasFilter(Filter):
@@ -26,6 +27,16 @@ class HasAvgasFilter(Filter):
         has_avgas = bool(getattr(airport, "avgas", False))
         return has_avgas == bool(value)
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        return self._boolean_mask(table, "avgas", value)
+
 
 class HasJetAFilter(Filter):
     """Filter airports by Jet-A fuel availability."""
@@ -42,3 +53,14 @@ class HasJetAFilter(Filter):
             return True
         has_jet_a = bool(getattr(airport, "jet_a", False))
         return has_jet_a == bool(value)
+
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        return self._boolean_mask(table, "jet_a", value)
+
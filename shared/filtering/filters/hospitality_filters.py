@@ -12,6 +12,7 @@ from .base import Filter
 
 if TYPE_CHECKING:
     from shared.tool_context import ToolContext
+    from shared.indexing.feature_table import AirportFeatureTable
 
 logger = logging.getLogger(__name__)
 
@@ -36,6 +37,7 @@ class HotelFilter(Filter):
 
     name = "hotel"
     description = "Filter by hotel availability (at_airport|vicinity)"
+    uses_context = True
 
     def apply(
         self,
@@ -74,6 +76,28 @@ class HotelFilter(Filter):
             logger.warning(f"Error applying hotel filter to {airport.ident}: {e}")
             return False  # Error - exclude (fail closed)
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+
+        if not context or not context.ga_friendliness_service:
+            return 0
+
+        if value not in ("at_airport", "vicinity", "any"):
+            return None  # Unknown value still requires known data, evaluate per airport
+
+        try:
+            icaos = context.ga_friendliness_service.get_icaos_by_hospitality(hotel=value)
+            return table.mask_for_idents(icaos)
+        except Exception as e:
+            logger.warning(f"Error applying vectorized hotel filter: {e}")
+            return None  # Fall back to per-airport evaluation
+
 
 class RestaurantFilter(Filter):
     """
@@ -95,6 +119,7 @@ class RestaurantFilter(Filter):
 
     name = "restaurant"
     description = "Filter by restaurant availability (at_airport|vicinity)"
+    uses_context = True
 
     def apply(
         self,
@@ -132,3 +157,26 @@ class RestaurantFilter(Filter):
         except Exception as e:
             logger.warning(f"Error applying restaurant filter to {airport.ident}: {e}")
             return False  # Error - exclude (fail closed)
+
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+
+        if not context or not context.ga_friendliness_service:
+            return 0
+
+        if value not in ("at_airport", "vicinity", "any"):
+            return None  # Unknown value still requires known data, evaluate per airport
+
+        try:
+            icaos = context.ga_friendliness_service.get_icaos_by_hospitality(restaurant=value)
+            return table.mask_for_idents(icaos)
+        except Exception as e:
+            logger.warning(f"Error applying vectorized restaurant filter: {e}")
+            return None  # Fall back to per-airport evaluation
+
@@ -8,12 +8,14 @@ from .base import Filter
 
 if TYPE_CHECKING:
     from shared.tool_context import ToolContext
+    from shared.indexing.feature_table import AirportFeatureTable
 
 
 class MaxLandingFeeFilter(Filter):
     """Filter airports by maximum landing fee (C172 equivalent)."""
     name = "max_landing_fee"
     description = "Filter by maximum landing fee (C172 equivalent) in local currency"
+    uses_context = True
 
     def apply(
         self,
@@ -52,3 +54,29 @@ class MaxLandingFeeFilter(Filter):
         except Exception:
             # Error getting fee data - don't filter (graceful degradation)
             return True
+
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+
+        if not context or not context.ga_friendliness_service:
+            return table.all_mask
+
+        try:
+            max_fee = float(value)
+        except (TypeError, ValueError):
+            return table.all_mask
+
+        try:
+            from shared.ga_friendliness.features import AIRCRAFT_MTOW_MAP
+            fees = table.landing_fee(context.ga_friendliness_service, AIRCRAFT_MTOW_MAP["c172"])
+            # Airports without fee data pass (graceful degradation, same as apply)
+            return (table.all_mask & ~fees.present) | fees.at_most(max_fee)
+        except Exception:
+            return table.all_mask
+
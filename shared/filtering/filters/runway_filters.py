@@ -8,6 +8,7 @@ from .base import Filter
 
 if TYPE_CHECKING:
     from shared.tool_context import ToolContext
+    from shared.indexing.feature_table import AirportFeatureTable
 
 
 class MaxRunwayLengthFilter(Filter):
@@ -35,6 +36,21 @@ class MaxRunwayLengthFilter(Filter):
 
         return longest_runway <= max_length
 
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        try:
+            max_length = float(value)
+        except (TypeError, ValueError):
+            return table.all_mask
+        # Airports without runway data are absent from the column (excluded)
+        return table.runway_length.at_most(max_length)
+
 
 class MinRunwayLengthFilter(Filter):
     """Filter airports by minimum runway length."""
@@ -60,3 +76,19 @@ class MinRunwayLengthFilter(Filter):
             return False  # No runway data, exclude
 
         return longest_runway >= min_length
+
+    def apply_vectorized(
+        self,
+        table: "AirportFeatureTable",
+        value: Any,
+        context: Optional["ToolContext"] = None,
+    ) -> Optional[int]:
+        if value is None:
+            return table.all_mask
+        try:
+            min_length = float(value)
+        except (TypeError, ValueError):
+            return table.all_mask
+        # Airports without runway data are absent from the column (excluded)
+        return table.runway_length.at_least(min_length)
+
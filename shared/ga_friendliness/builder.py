@@ -5,11 +5,19 @@ Coordinates all components to build ga_persona.db from review sources.
 """
 
 import logging
+from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime, timezone
 from pathlib import Path
-from typing import Any, Dict, List, Optional, Set
+from typing import Any, Dict, List, Optional, Set, Tuple
 
 from .config import GAFriendlinessSettings, get_default_ontology, get_default_personas
+from .content_hash import (
+    HASH_AIP,
+    HASH_REVIEWS,
+    aip_fields_hash,
+    content_hash,
+    review_set_hash,
+)
 from .exceptions import BuildError, StorageError
 from .features import (
     FeatureMapper,
@@ -36,6 +44,7 @@ from .storage import GAMetaStorage
 # Optional imports for NLP components
 try:
     from shared.ga_review_agent import ReviewExtractor, TagAggregator, SummaryGenerator
+    from shared.ga_review_agent.rate_limiter import RateLimiter
     HAS_REVIEW_AGENT = True
 except ImportError:
     HAS_REVIEW_AGENT = False
@@ -55,10 +64,13 @@ class GAFriendlinessBuilder:
         - Writing to database
     
     Features:
-        - Incremental updates (only process changed airports)
+        - Incremental updates (only process airports whose review set, fees or
+          AIP fields changed; exact via per-airport content hashes)
         - Resume capability (continue from last successful airport)
         - Configurable failure handling
         - LLM usage tracking
+        - Concurrent, rate-limited LLM calls; database writes stay ordered on
+          the calling thread (airports_per_batch airports at a time)
     """
 
     def __init__(
@@ -109,6 +121,12 @@ class GAFriendlinessBuilder:
         # Feature mapper
         self.feature_mapper = FeatureMapper(ontology=self.ontology)
         
+        # One limiter for extraction and summary calls (provider limits are per key)
+        self._rate_limiter = (
+            RateLimiter(self.settings.llm_requests_per_minute)
+            if HAS_REVIEW_AGENT and self.settings.llm_requests_per_minute > 0 else None
+        )
+        
         # Metrics
         self._metrics = BuildMetrics()
 
@@ -130,6 +148,9 @@ class GAFriendlinessBuilder:
                 api_key=self.settings.llm_api_key,
                 max_retries=self.settings.llm_max_retries,
                 mock_llm=self.settings.use_mock_llm,
+                max_concurrency=self.settings.llm_concurrency,
+                rate_limiter=self._rate_limiter,
+                reviews_per_call=self.settings.llm_reviews_per_call,
             )
         return self._extractor
 
@@ -142,6 +163,7 @@ class GAFriendlinessBuilder:
                 llm_temperature=self.settings.llm_temperature + 0.3,  # Slightly higher
                 api_key=self.settings.llm_api_key,
                 mock_llm=self.settings.use_mock_llm,
+                rate_limiter=self._rate_limiter,
             )
         return self._summarizer
 
@@ -201,6 +223,9 @@ class GAFriendlinessBuilder:
             # Process each airport
             failure_mode = FailureMode(self.settings.failure_mode)
             
+            # Airports waiting for concurrent extraction, in processing order
+            pending: List[Tuple[str, List[RawReview]]] = []
+            
             with self.storage:
                 for icao in airports_to_process_list:
                     try:
@@ -244,35 +269,47 @@ class GAFriendlinessBuilder:
                         fee_changes = False
                         
                         if incremental:
+                            aip_changes = False
+                            airport = None
                             if reviews:
-                                review_changes = self.storage.has_changes(icao, reviews, since)
+                                review_changes = self._has_review_changes(icao, reviews, since)
                             
                             if fee_data:
                                 fee_changes = self.storage.has_fee_changes(icao, fee_data)
                             
-                            # If neither reviews nor fees changed, skip
-                            if not review_changes and not fee_changes:
+                            # AIP fields only matter on their own when reviews are unchanged
+                            if airports_db is not None and not review_changes:
+                                airport = airports_db.get_airport(icao)
+                                aip_changes = airport is not None and (
+                                    self.storage.get_content_hash(HASH_AIP, icao) != self._aip_hash(airport)
+                                )
+                            
+                            # If neither reviews, fees nor AIP fields changed, skip
+                            if not review_changes and not fee_changes and not aip_changes:
                                 self._metrics.skipped_airports += 1
                                 continue
                             
-                            # If only fees changed (and no reviews), update fees only
-                            if not review_changes and fee_changes:
-                                logger.info(f"Updating fees only for {icao} (no reviews or reviews unchanged)")
-                                if fee_data:
-                                    # Check if airport exists in DB, if not we need full processing
-                                    existing_stats = self.storage.get_airfield_stats(icao)
-                                    if existing_stats is not None:
+                            # If only fees and/or AIP fields changed, update those columns only
+                            if not review_changes:
+                                # Keep resume progress in order: finish earlier airports first
+                                self._process_batch(pending, review_source, airports_db, failure_mode)
+                                pending = []
+                                # Check if airport exists in DB, if not we need full processing
+                                existing_stats = self.storage.get_airfield_stats(icao)
+                                if existing_stats is not None:
+                                    if fee_changes:
+                                        logger.info(f"Updating fees only for {icao} (no reviews or reviews unchanged)")
                                         self.storage.update_fees_only(icao, fee_data)
-                                        self._metrics.successful_airports += 1
-                                    else:
-                                        # New airport with fees only, do full processing
-                                        logger.info(f"Processing new airport {icao} with fees but no reviews")
-                                        self._process_airport(icao, reviews, review_source, airports_db)
-                                        self._metrics.successful_airports += 1
-                                        self._metrics.total_reviews += len(reviews)
+                                    if aip_changes:
+                                        logger.info(f"Updating AIP fields only for {icao} (reviews unchanged)")
+                                        self._update_airport_aip(icao, airport)
+                                    self._metrics.successful_airports += 1
                                 else:
-                                    # Should not happen, but handle gracefully
-                                    continue
+                                    # New airport without reviews, do full processing
+                                    logger.info(f"Processing new airport {icao} with fees/AIP data but no reviews")
+                                    self._process_airport(icao, reviews, review_source, airports_db)
+                                    self._metrics.successful_airports += 1
+                                    self._metrics.total_reviews += len(reviews)
                                 # Track progress for resume
                                 self.storage.set_last_successful_icao(icao)
                                 continue
@@ -283,29 +320,22 @@ class GAFriendlinessBuilder:
                         if not reviews:
                             logger.info(f"Processing {icao} with fees/AIP data but no reviews")
                         
-                        self._process_airport(icao, reviews, review_source, airports_db)
-                        
-                        self._metrics.successful_airports += 1
-                        self._metrics.total_reviews += len(reviews)
-                        
-                        # Track progress for resume
-                        self.storage.set_last_successful_icao(icao)
+                        pending.append((icao, reviews))
+                        if len(pending) >= self.settings.airports_per_batch:
+                            self._process_batch(pending, review_source, airports_db, failure_mode)
+                            pending = []
                         
+                    except BuildError:
+                        raise
                     except Exception as e:
-                        self._metrics.failed_airports += 1
-                        self._metrics.errors.append(f"{icao}: {str(e)}")
-                        
-                        logger.error(f"Airport {icao} processing failed: {e}")
-                        
-                        if failure_mode == FailureMode.FAIL_FAST:
-                            raise BuildError(f"Failed processing {icao}: {e}")
-                        elif failure_mode == FailureMode.SKIP:
-                            continue
-                        # CONTINUE: log and continue
+                        self._record_failure(icao, e, failure_mode)
+                
+                self._process_batch(pending, review_source, airports_db, failure_mode)
                 
                 # Store build metadata
                 self._store_build_metadata()
             
+            self._collect_llm_usage()
             self._metrics.end_time = datetime.now(timezone.utc)
             self._metrics.duration_seconds = (
                 self._metrics.end_time - self._metrics.start_time
@@ -339,6 +369,77 @@ class GAFriendlinessBuilder:
                 output_db_path=str(self.settings.ga_meta_db_path),
             )
 
+    def _record_failure(self, icao: str, error: Exception, failure_mode: FailureMode) -> None:
+        """Count a failed airport; raises BuildError in fail-fast mode."""
+        self._metrics.failed_airports += 1
+        self._metrics.errors.append(f"{icao}: {str(error)}")
+        
+        logger.error(f"Airport {icao} processing failed: {error}")
+        
+        if failure_mode == FailureMode.FAIL_FAST:
+            raise BuildError(f"Failed processing {icao}: {error}")
+        # CONTINUE / SKIP: log and move on to the next airport
+
+    def _process_batch(
+        self,
+        batch: List[Tuple[str, List[RawReview]]],
+        source: ReviewSource,
+        airports_db: Optional[AirportsDatabaseSource],
+        failure_mode: FailureMode,
+    ) -> None:
+        """
+        Process a batch of airports with concurrent LLM calls and ordered writes.
+        
+        Pipeline:
+            1. Extract tags for all reviews of the batch (parallel, see ReviewExtractor)
+            2. Build stats per airport (sources and airports.db are read on this thread)
+            3. Generate summaries (parallel)
+            4. Write tags in one batch, then stats/summaries and resume progress in order
+        """
+        if not batch:
+            return
+        
+        try:
+            extractions_by_icao = self._extract_reviews(batch)
+        except Exception as e:
+            for icao, _ in batch:
+                self._record_failure(icao, e, failure_mode)
+            return
+        
+        prepared: List[Tuple[str, List[RawReview], AirportStats, List[Any]]] = []
+        hashes: Dict[str, Dict[str, str]] = {}
+        for icao, reviews in batch:
+            try:
+                extractions = extractions_by_icao[icao]
+                stats = self._build_airport_stats(icao, reviews, extractions, source, airports_db)
+                prepared.append((icao, reviews, stats, extractions))
+                hashes[icao] = self._input_hashes(icao, reviews, airports_db)
+            except Exception as e:
+                self._record_failure(icao, e, failure_mode)
+        
+        summaries = self._generate_summaries(prepared)
+        
+        try:
+            tags_by_icao = {icao: ext for icao, _, _, ext in prepared if ext}
+            if tags_by_icao:
+                self.storage.write_review_tags_batch(tags_by_icao)
+        except Exception as e:
+            for icao, _, _, _ in prepared:
+                self._record_failure(icao, e, failure_mode)
+            return
+        
+        for icao, reviews, stats, extractions in prepared:
+            try:
+                self._write_airport(icao, stats, summaries.get(icao), hashes[icao])
+                
+                self._metrics.successful_airports += 1
+                self._metrics.total_reviews += len(reviews)
+                
+                # Track progress for resume
+                self.storage.set_last_successful_icao(icao)
+            except Exception as e:
+                self._record_failure(icao, e, failure_mode)
+
     def _process_airport(
         self,
         icao: str,
@@ -359,25 +460,112 @@ class GAFriendlinessBuilder:
         """
         logger.debug(f"Processing airport {icao} with {len(reviews)} reviews")
         
-        # Extract tags
-        extractions = []
-        if self.extractor:
-            review_data = [
-                (r.review_text, r.review_id, r.timestamp)
-                for r in reviews
-            ]
-            extractions = self.extractor.extract_batch(review_data)
-            
+        extractions = self._extract_reviews([(icao, reviews)])[icao]
+        stats = self._build_airport_stats(icao, reviews, extractions, source, airports_db)
+        summary = self._generate_summaries([(icao, reviews, stats, extractions)]).get(icao)
+        
+        if extractions:
+            self.storage.write_review_tags(icao, extractions)
+        self._write_airport(icao, stats, summary, self._input_hashes(icao, reviews, airports_db))
+
+    def _aip_hash(self, airport: Any) -> str:
+        """AIP fields hash; a scoring_version bump invalidates it."""
+        return content_hash([aip_fields_hash(airport), self.settings.scoring_version])
+
+    def _review_hash(self, reviews: List[RawReview]) -> str:
+        """
+        Review set hash; a scoring_version bump invalidates it.
+
+        source_version is left out: builds stamp it with the build date, which
+        would re-extract every airport on each later run.
+        """
+        return content_hash([review_set_hash(reviews), self.settings.scoring_version])
+
+    def _has_review_changes(
+        self, icao: str, reviews: List[RawReview], since: Optional[datetime]
+    ) -> bool:
+        """Exact check against the stored review set hash (timestamps for older databases)."""
+        stored = self.storage.get_content_hash(HASH_REVIEWS, icao)
+        if stored is None:
+            return self.storage.has_changes(icao, reviews, since)
+        return stored != self._review_hash(reviews)
+
+    def _input_hashes(
+        self,
+        icao: str,
+        reviews: List[RawReview],
+        airports_db: Optional[AirportsDatabaseSource],
+    ) -> Dict[str, str]:
+        """Content hashes of the inputs an airport's stats were built from."""
+        hashes = {HASH_REVIEWS: self._review_hash(reviews)}
+        if airports_db is not None:
+            try:
+                airport = airports_db.get_airport(icao)
+            except Exception:
+                airport = None
+            if airport:
+                hashes[HASH_AIP] = self._aip_hash(airport)
+        return hashes
+
+    def _extract_reviews(
+        self, batch: List[Tuple[str, List[RawReview]]]
+    ) -> Dict[str, List[Any]]:
+        """Filtered extractions per airport; one extract_batch call for the whole batch."""
+        if not self.extractor:
+            return {icao: [] for icao, _ in batch}
+        
+        review_data = [
+            (r.review_text, r.review_id, r.timestamp)
+            for _, reviews in batch
+            for r in reviews
+        ]
+        # Keyed by airport so packed calls only combine reviews of the same airport
+        group_keys = [icao for icao, reviews in batch for _ in reviews]
+        results = self.extractor.extract_batch(review_data, group_keys=group_keys) if review_data else []
+        
+        extractions_by_icao: Dict[str, List[Any]] = {}
+        offset = 0
+        for icao, reviews in batch:
             # Filter by ontology
-            extractions = [
+            extractions_by_icao[icao] = [
                 self.ontology_manager.filter_extraction(
                     e, confidence_threshold=self.settings.confidence_threshold
                 )
-                for e in extractions
+                for e in results[offset:offset + len(reviews)]
             ]
-            
-            self._metrics.total_extractions += len(extractions)
+            offset += len(reviews)
+            self._metrics.total_extractions += len(extractions_by_icao[icao])
+        return extractions_by_icao
+
+    def _generate_summaries(
+        self, prepared: List[Tuple[str, List[RawReview], AirportStats, List[Any]]]
+    ) -> Dict[str, Tuple[str, List[str]]]:
+        """Summaries for airports with extractions, generated concurrently."""
+        jobs = [(icao, extractions, stats) for icao, _, stats, extractions in prepared if extractions]
+        if not self.summarizer or not jobs:
+            return {}
+        
+        def generate(job: Tuple[str, List[Any], AirportStats]) -> Tuple[str, List[str]]:
+            icao, extractions, stats = job
+            return self.summarizer.generate_summary(icao, extractions, stats)
         
+        workers = min(self.settings.llm_concurrency, len(jobs))
+        if workers == 1:
+            results = [generate(job) for job in jobs]
+        else:
+            with ThreadPoolExecutor(max_workers=workers, thread_name_prefix="ga-summary") as pool:
+                results = list(pool.map(generate, jobs))
+        return {job[0]: result for job, result in zip(jobs, results)}
+
+    def _build_airport_stats(
+        self,
+        icao: str,
+        reviews: List[RawReview],
+        extractions: List[Any],
+        source: ReviewSource,
+        airports_db: Optional[AirportsDatabaseSource] = None,
+    ) -> AirportStats:
+        """Aggregate extractions and combine with AIP and fee data into AirportStats."""
         # Aggregate tags
         distributions = {}
         if self._aggregator and extractions:
@@ -472,7 +660,7 @@ class GAFriendlinessBuilder:
         last_review = max(timestamps) if timestamps else None
         
         # Build airport stats
-        stats = AirportStats(
+        return AirportStats(
             icao=icao,
             rating_avg=rating_avg,
             rating_count=rating_count,
@@ -502,30 +690,87 @@ class GAFriendlinessBuilder:
             source_version=self.settings.source_version,
             scoring_version=self.settings.scoring_version,
         )
-        
-        # Write to database
+
+    def _write_airport(
+        self,
+        icao: str,
+        stats: AirportStats,
+        summary: Optional[Tuple[str, List[str]]],
+        hashes: Optional[Dict[str, str]] = None,
+    ) -> None:
+        """Write stats and summary (review tags are written by the caller)."""
         self.storage.write_airfield_stats(stats)
         
-        # Write review tags
-        if extractions:
-            self.storage.write_review_tags(icao, extractions)
-        
-        # Generate and store summary
-        if self.summarizer and extractions:
-            summary_text, tags = self.summarizer.generate_summary(
-                icao, extractions, stats
-            )
+        if summary:
+            summary_text, tags = summary
             self.storage.write_review_summary(icao, summary_text, tags)
         
         # Update last processed timestamp
         self.storage.update_last_processed_timestamp(
             icao, datetime.now(timezone.utc)
         )
+        
+        # Stored last, so a failed write is retried on the next incremental run
+        for kind, value in (hashes or {}).items():
+            self.storage.set_content_hash(kind, icao, value)
+
+    def _update_airport_aip(self, icao: str, airport: Any) -> bool:
+        """
+        Recompute and upsert the aip_* fields of one airport.
+        
+        Returns:
+            True if a new row was inserted, False if an existing row was updated
+        """
+        # Get IFR permitted field (std_field_id=207)
+        ifr_permitted_text = None
+        for entry in airport.aip_entries:
+            if entry.std_field_id == 207:
+                ifr_permitted_text = entry.value
+                break
+
+        aip_ifr_available = compute_aip_ifr_score(
+            airport.procedures, ifr_permitted_text
+        )
+        aip_night_available = compute_aip_night_available()
+
+        # Parse hospitality fields
+        aip_hotel_info = None
+        aip_restaurant_info = None
+        for entry in airport.aip_entries:
+            if entry.std_field_id == 501:  # Hotels
+                aip_hotel_info = parse_hospitality_text_to_int(entry.value)
+            elif entry.std_field_id == 502:  # Restaurants
+                aip_restaurant_info = parse_hospitality_text_to_int(entry.value)
+
+        # Compute AIP feature scores
+        aip_data = {
+            "aip_ifr_available": aip_ifr_available,
+            "aip_hotel_info": aip_hotel_info,
+            "aip_restaurant_info": aip_restaurant_info,
+        }
+        aip_feature_scores = self.feature_mapper.compute_aip_feature_scores(
+            icao=icao,
+            aip_data=aip_data,
+        )
+
+        # Upsert to database
+        was_inserted = self.storage.upsert_aip_only(
+            icao=icao,
+            aip_ifr_available=aip_ifr_available,
+            aip_night_available=aip_night_available,
+            aip_hotel_info=aip_hotel_info,
+            aip_restaurant_info=aip_restaurant_info,
+            aip_ops_ifr_score=aip_feature_scores.get("aip_ops_ifr_score"),
+            aip_hospitality_score=aip_feature_scores.get("aip_hospitality_score"),
+        )
+        self.storage.set_content_hash(HASH_AIP, icao, self._aip_hash(airport))
+        return was_inserted
 
     def update_aip_only(
         self,
         airports_db: "AirportsDatabaseSource",
         icaos: Optional[List[str]] = None,
+        force: bool = False,
     ) -> BuildResult:
         """
         Update only AIP-derived fields without processing reviews.
@@ -535,6 +780,7 @@ class GAFriendlinessBuilder:
         - Only updates aip_* fields (ifr, night, hotel, restaurant)
         - Also updates computed aip_* scores
         - Works for airports not yet in ga_persona.db
+        - Skips airports whose AIP fields hash is unchanged (unless force)
 
         Use this when the AIP data has changed but reviews haven't.
 
@@ -543,6 +789,7 @@ class GAFriendlinessBuilder:
             icaos: Optional list of specific ICAOs to process.
                    If None, processes all airports in airports_db that have
                    hotel or restaurant fields.
+            force: Recompute airports even if their AIP fields are unchanged
 
         Returns:
             BuildResult with metrics and status
@@ -576,52 +823,12 @@ class GAFriendlinessBuilder:
                             self._metrics.skipped_airports += 1
                             continue
 
-                        # Extract AIP fields
-                        aip_ifr_available = 0
-                        aip_night_available = 0
-                        aip_hotel_info = None
-                        aip_restaurant_info = None
-
-                        # Get IFR permitted field (std_field_id=207)
-                        ifr_permitted_text = None
-                        for entry in airport.aip_entries:
-                            if entry.std_field_id == 207:
-                                ifr_permitted_text = entry.value
-                                break
-
-                        aip_ifr_available = compute_aip_ifr_score(
-                            airport.procedures, ifr_permitted_text
-                        )
-                        aip_night_available = compute_aip_night_available()
-
-                        # Parse hospitality fields
-                        for entry in airport.aip_entries:
-                            if entry.std_field_id == 501:  # Hotels
-                                aip_hotel_info = parse_hospitality_text_to_int(entry.value)
-                            elif entry.std_field_id == 502:  # Restaurants
-                                aip_restaurant_info = parse_hospitality_text_to_int(entry.value)
-
-                        # Compute AIP feature scores
-                        aip_data = {
-                            "aip_ifr_available": aip_ifr_available,
-                            "aip_hotel_info": aip_hotel_info,
-                            "aip_restaurant_info": aip_restaurant_info,
-                        }
-                        aip_feature_scores = self.feature_mapper.compute_aip_feature_scores(
-                            icao=icao,
-                            aip_data=aip_data,
-                        )
+                        # Unchanged since the last update: nothing to recompute
+                        if not force and self.storage.get_content_hash(HASH_AIP, icao) == self._aip_hash(airport):
+                            self._metrics.skipped_airports += 1
+                            continue
 
-                        # Upsert to database
-                        was_inserted = self.storage.upsert_aip_only(
-                            icao=icao,
-                            aip_ifr_available=aip_ifr_available,
-                            aip_night_available=aip_night_available,
-                            aip_hotel_info=aip_hotel_info,
-                            aip_restaurant_info=aip_restaurant_info,
-                            aip_ops_ifr_score=aip_feature_scores.get("aip_ops_ifr_score"),
-                            aip_hospitality_score=aip_feature_scores.get("aip_hospitality_score"),
-                        )
+                        was_inserted = self._update_airport_aip(icao, airport)
 
                         if was_inserted:
                             inserted_count += 1
@@ -671,6 +878,22 @@ class GAFriendlinessBuilder:
                 output_db_path=str(self.settings.ga_meta_db_path),
             )
 
+    def _collect_llm_usage(self) -> None:
+        """Copy extractor/summarizer token usage into build metrics."""
+        for component in (self._extractor, self._summarizer):
+            if component is None or not hasattr(component, "get_token_usage"):
+                continue
+            usage = component.get_token_usage()
+            self._metrics.llm_calls += usage.get("total_calls", 0)
+            self._metrics.llm_tokens_input += usage.get("input_tokens", 0)
+            self._metrics.llm_tokens_output += usage.get("output_tokens", 0)
+            if usage.get("packed_calls"):
+                logger.info(
+                    f"Packed extraction: {usage['reviews_extracted']} reviews in "
+                    f"{usage['total_calls']} calls, {usage['packed_fallbacks']} fallbacks, "
+                    f"~{usage['estimated_input_tokens_saved']} input tokens saved"
+                )
+
     def _store_build_metadata(self) -> None:
         """Store build metadata in ga_meta_info."""
         now = datetime.now(timezone.utc).isoformat()
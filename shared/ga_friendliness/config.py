@@ -54,12 +54,24 @@ class GAFriendlinessSettings(BaseSettings):
         default=False, description="Use mock LLM for testing (ignores API key)"
     )
     llm_max_retries: int = Field(default=3, ge=1, description="Max LLM retry attempts")
+    llm_concurrency: int = Field(
+        default=4, ge=1, description="Concurrent LLM requests (review extraction and summaries)"
+    )
+    llm_requests_per_minute: float = Field(
+        default=0.0, ge=0.0, description="Shared LLM request rate limit (0 = unlimited)"
+    )
+    llm_reviews_per_call: int = Field(
+        default=8, ge=1, description="Reviews of one airport packed into one extraction call (1 = no packing)"
+    )
 
     # Processing settings
     confidence_threshold: float = Field(
         default=0.5, ge=0.0, le=1.0, description="Min confidence for tag inclusion"
     )
     batch_size: int = Field(default=50, ge=1, description="Reviews per LLM batch")
+    airports_per_batch: int = Field(
+        default=20, ge=1, description="Airports extracted concurrently and written together"
+    )
 
     # Time decay settings (disabled by default)
     enable_time_decay: bool = Field(
@@ -0,0 +1,72 @@
+"""
+Content hashes for incremental rebuilds.
+
+Each airport input that drives a (re)computation gets a stable hash, stored
+in ga_meta_info under `content_hash_{kind}_{icao}`:
+
+- reviews: the review set (id, text, rating, timestamp), order-independent
+- aip: AIP fields behind the aip_* columns (IFR field 207, approach
+  procedures, hotel 501, restaurant 502)
+- notification: customs/immigration text (field 302), with the scoring
+  version and LLM mode (NotificationScorer.input_hash)
+
+A rebuild compares the current hash with the stored one and skips the airport
+when they match, so a new airports.db or review export only costs work for the
+airports whose inputs actually changed.
+"""
+
+import hashlib
+import json
+from typing import Any, Iterable, Optional
+
+# Hash kinds (part of the ga_meta_info key)
+HASH_REVIEWS = "reviews"
+HASH_AIP = "aip"
+HASH_NOTIFICATION = "notification"
+
+# AIP std_field_ids feeding the aip_* columns
+AIP_FIELD_IFR = 207
+AIP_FIELD_HOTEL = 501
+AIP_FIELD_RESTAURANT = 502
+
+
+def content_hash_key(kind: str, icao: str) -> str:
+    """ga_meta_info key for a content hash."""
+    return f"content_hash_{kind}_{icao.upper()}"
+
+
+def content_hash(value: Any) -> str:
+    """sha256 of the canonical JSON form of value."""
+    payload = json.dumps(value, sort_keys=True, separators=(",", ":"), default=str)
+    return hashlib.sha256(payload.encode("utf-8")).hexdigest()
+
+
+def text_hash(text: Optional[str]) -> str:
+    """Hash of a free-text field (surrounding whitespace ignored)."""
+    return content_hash((text or "").strip())
+
+
+def review_set_hash(reviews: Iterable[Any]) -> str:
+    """Order-independent hash of a set of RawReview-like objects."""
+    # Strings only: a None and a float rating must not be compared while sorting
+    items = sorted(
+        [str(r.review_id or ""), r.review_text or "", "" if r.rating is None else str(r.rating), str(r.timestamp or "")]
+        for r in reviews
+    )
+    return content_hash(items)
+
+
+def aip_fields_hash(airport: Any) -> str:
+    """Hash of the AIP inputs of compute_aip_ifr_score and the hospitality parsers."""
+    fields = {}
+    for entry in getattr(airport, "aip_entries", None) or []:
+        if entry.std_field_id in (AIP_FIELD_IFR, AIP_FIELD_HOTEL, AIP_FIELD_RESTAURANT):
+            # First entry wins for IFR, last for hospitality (matches the builder)
+            if entry.std_field_id == AIP_FIELD_IFR and AIP_FIELD_IFR in fields:
+                continue
+            fields[entry.std_field_id] = entry.value
+    procedures = sorted(
+        [str(getattr(p, "procedure_type", "") or ""), str(getattr(p, "approach_type", "") or "")]
+        for p in getattr(airport, "procedures", None) or []
+    )
+    return content_hash({"fields": fields, "procedures": procedures})
@@ -10,6 +10,7 @@ from datetime import datetime
 from pathlib import Path
 from typing import Any, Dict, Iterator, List, Optional, Set
 
+from .content_hash import content_hash_key
 from .models import (
     AirportStats,
     NotificationRule,
@@ -263,6 +264,14 @@ class StorageInterface(ABC):
         # Subclasses should override this for fee-only updates
         raise NotImplementedError("Fee-only updates not supported by this storage implementation")
 
+    def get_content_hash(self, kind: str, icao: str) -> Optional[str]:
+        """Stored content hash of an airport input (see content_hash.py), or None."""
+        return self.get_meta_info(content_hash_key(kind, icao))
+
+    def set_content_hash(self, kind: str, icao: str, value: str) -> None:
+        """Store the content hash of an airport input after processing it."""
+        self.write_meta_info(content_hash_key(kind, icao), value)
+
     # --- Resume Support ---
 
     @abstractmethod
@@ -0,0 +1,116 @@
+"""
+In-memory persona score matrix for read-only GA friendliness databases.
+
+Loads every airport's feature scores into an ICAO x feature table and computes
+an ICAO x persona score table once, so batch summary and ranking lookups are
+dictionary reads instead of per-airport SQLite queries and persona scoring.
+"""
+
+import logging
+from typing import Any, Dict, List, Optional, Tuple
+
+from .models import AirportFeatureScores
+from .personas import FEATURE_NAMES, PersonaManager
+from .storage import GAMetaStorage
+
+logger = logging.getLogger(__name__)
+
+# ga_meta_info keys written by the builder; any change means the db was rebuilt
+BUILD_SIGNATURE_KEYS = (
+    "build_timestamp",
+    "aip_only_update_timestamp",
+    "scoring_version",
+    "personas_version",
+)
+
+
+def feature_scores_from_stats(stats: Any) -> AirportFeatureScores:
+    """Build persona-scoring input from airfield stats."""
+    return AirportFeatureScores(
+        icao=stats.icao,
+        review_cost_score=stats.review_cost_score,
+        review_hassle_score=stats.review_hassle_score,
+        review_review_score=stats.review_review_score,
+        review_ops_ifr_score=stats.review_ops_ifr_score,
+        review_ops_vfr_score=stats.review_ops_vfr_score,
+        review_access_score=stats.review_access_score,
+        review_fun_score=stats.review_fun_score,
+        review_hospitality_score=stats.review_hospitality_score,
+        aip_ops_ifr_score=stats.aip_ops_ifr_score,
+        aip_hospitality_score=stats.aip_hospitality_score,
+    )
+
+
+def read_build_signature(storage: GAMetaStorage) -> Tuple[Optional[str], ...]:
+    """Build metadata identifying the current database contents."""
+    return tuple(storage.get_meta_info(key) for key in BUILD_SIGNATURE_KEYS)
+
+
+class PersonaScoreMatrix:
+    """
+    Dense feature and persona score tables for all airports with GA data.
+
+    Rows are airports (ICAO), columns are FEATURE_NAMES and persona IDs
+    respectively.
+    """
+
+    def __init__(self, storage: GAMetaStorage, persona_manager: PersonaManager):
+        self.signature = read_build_signature(storage)
+        self.persona_ids: List[str] = persona_manager.list_persona_ids()
+        self._persona_columns: Dict[str, int] = {pid: i for i, pid in enumerate(self.persona_ids)}
+
+        stats_by_icao = storage.get_all_airfield_stats()
+        try:
+            self._review_summaries = storage.get_all_review_summaries()
+        except Exception:
+            self._review_summaries = {}  # Summary table may not exist
+
+        self.rows: Dict[str, int] = {}
+        self.features: List[Tuple[Optional[float], ...]] = []
+        self.scores: List[Tuple[Optional[float], ...]] = []
+        self._review_info: List[Tuple[int, Optional[str]]] = []  # (review_count, last_review_utc)
+
+        for icao, stats in stats_by_icao.items():
+            feature_scores = feature_scores_from_stats(stats)
+            self.rows[icao] = len(self.features)
+            self.features.append(tuple(getattr(stats, name, None) for name in FEATURE_NAMES))
+            self.scores.append(tuple(
+                persona_manager.compute_score(pid, feature_scores) for pid in self.persona_ids
+            ))
+            self._review_info.append((stats.rating_count or 0, stats.last_review_utc))
+
+        logger.info(
+            f"Persona score matrix loaded: {len(self.rows)} airports x "
+            f"{len(self.persona_ids)} personas"
+        )
+
+    def __len__(self) -> int:
+        return len(self.rows)
+
+    def __contains__(self, icao: str) -> bool:
+        return icao in self.rows
+
+    def score(self, icao: str, persona_id: str) -> Optional[float]:
+        """Persona score for an airport, or None if unavailable."""
+        row = self.rows.get(icao)
+        column = self._persona_columns.get(persona_id)
+        if row is None or column is None:
+            return None
+        return self.scores[row][column]
+
+    def summary_dict(self, icao: str) -> Optional[Dict[str, Any]]:
+        """Batch summary dict (see GAFriendlinessService.get_summaries_batch_dict)."""
+        row = self.rows.get(icao)
+        if row is None:
+            return None
+        review_count, last_review_utc = self._review_info[row]
+        review_summary = self._review_summaries.get(icao) or {}
+        return {
+            "features": dict(zip(FEATURE_NAMES, self.features[row])),
+            "persona_scores": dict(zip(self.persona_ids, self.scores[row])),
+            "review_count": review_count,
+            "last_review_utc": last_review_utc,
+            "tags": review_summary.get("tags") or None,
+            "summary_text": review_summary.get("summary_text"),
+            "notification_hassle": None,
+        }
@@ -13,9 +13,11 @@ from typing import Dict, List, Optional, Any
 import logging
 import sqlite3
 import re
+import threading
+import time
 
 from .storage import GAMetaStorage
-from .models import AirportFeatureScores
+from .score_matrix import PersonaScoreMatrix, feature_scores_from_stats, read_build_signature
 from .personas import PersonaManager, FEATURE_NAMES
 from .config import get_default_personas
 from .ui_config import get_ui_config
@@ -23,6 +25,9 @@ from .features import get_fee_band_for_mtow
 
 logger = logging.getLogger(__name__)
 
+# How often (seconds) a loaded score matrix re-checks the db build metadata
+SCORE_MATRIX_CHECK_INTERVAL_S = 60.0
+
 
 def _get_notification_summary(icao: str) -> Optional[str]:
     """
@@ -113,6 +118,9 @@ class GAFriendlinessService:
         self.storage: Optional[GAMetaStorage] = None
         self.persona_manager: Optional[PersonaManager] = None
         self._enabled = False
+        self._score_matrix: Optional[PersonaScoreMatrix] = None
+        self._score_matrix_checked_at = 0.0
+        self._score_matrix_lock = threading.Lock()
         
         if db_path and Path(db_path).exists():
             try:
@@ -132,6 +140,55 @@ class GAFriendlinessService:
         """Check if service is enabled and functional."""
         return self._enabled
     
+    def load_score_matrix(self) -> bool:
+        """
+        Load the in-memory persona score matrix (read-only databases only).
+
+        Call at startup so the first batch request does not pay the load cost.
+
+        Returns:
+            True if the matrix is available
+        """
+        return self._get_score_matrix() is not None
+
+    @property
+    def data_version(self) -> Optional[str]:
+        """
+        Identifier of the GA data currently served, or None if not stable.
+
+        Only read-only services backed by the score matrix have a version;
+        it changes whenever the matrix is reloaded. Used for response caching.
+        """
+        matrix = self._get_score_matrix()
+        if matrix is None:
+            return None
+        return "|".join(str(value) for value in matrix.signature)
+
+    def _get_score_matrix(self) -> Optional[PersonaScoreMatrix]:
+        """Current score matrix, reloaded when the db build metadata changes."""
+        if not self._enabled or not self.readonly or not self.storage or not self.persona_manager:
+            return None
+
+        now = time.monotonic()
+        matrix = self._score_matrix
+        if matrix is not None and now - self._score_matrix_checked_at < SCORE_MATRIX_CHECK_INTERVAL_S:
+            return matrix
+
+        with self._score_matrix_lock:
+            matrix = self._score_matrix
+            if matrix is not None and now - self._score_matrix_checked_at < SCORE_MATRIX_CHECK_INTERVAL_S:
+                return matrix
+            try:
+                if matrix is None or read_build_signature(self.storage) != matrix.signature:
+                    if matrix is not None:
+                        logger.info("GA database changed, reloading persona score matrix")
+                    matrix = PersonaScoreMatrix(self.storage, self.persona_manager)
+                    self._score_matrix = matrix
+            except Exception as e:
+                logger.error(f"Failed to load persona score matrix: {e}")
+            self._score_matrix_checked_at = now
+            return self._score_matrix
+
     def get_config_dict(self) -> Dict[str, Any]:
         """
         Get complete UI configuration as a dictionary.
@@ -203,6 +260,15 @@ class GAFriendlinessService:
         """
         if not self._enabled or not self.storage or not self.persona_manager:
             return {}
+
+        matrix = self._get_score_matrix()
+        if matrix is not None:
+            results = {}
+            for icao in icaos:
+                summary = matrix.summary_dict(icao.upper())
+                if summary is not None:
+                    results[icao.upper()] = summary
+            return results
         
         # Get all persona IDs for pre-computing scores
         persona_ids = self.persona_manager.list_persona_ids()
@@ -221,19 +287,7 @@ class GAFriendlinessService:
                 }
                 
                 # Build AirportFeatureScores for persona scoring
-                features = AirportFeatureScores(
-                    icao=stats.icao,
-                    review_cost_score=stats.review_cost_score,
-                    review_hassle_score=stats.review_hassle_score,
-                    review_review_score=stats.review_review_score,
-                    review_ops_ifr_score=stats.review_ops_ifr_score,
-                    review_ops_vfr_score=stats.review_ops_vfr_score,
-                    review_access_score=stats.review_access_score,
-                    review_fun_score=stats.review_fun_score,
-                    review_hospitality_score=stats.review_hospitality_score,
-                    aip_ops_ifr_score=stats.aip_ops_ifr_score,
-                    aip_hospitality_score=stats.aip_hospitality_score,
-                )
+                features = feature_scores_from_stats(stats)
                 
                 # Pre-compute scores for ALL personas
                 persona_scores: Dict[str, Optional[float]] = {}
@@ -327,19 +381,7 @@ class GAFriendlinessService:
                 }
             
             # Build feature scores
-            features = AirportFeatureScores(
-                icao=stats.icao,
-                review_cost_score=stats.review_cost_score,
-                review_hassle_score=stats.review_hassle_score,
-                review_review_score=stats.review_review_score,
-                review_ops_ifr_score=stats.review_ops_ifr_score,
-                review_ops_vfr_score=stats.review_ops_vfr_score,
-                review_access_score=stats.review_access_score,
-                review_fun_score=stats.review_fun_score,
-                review_hospitality_score=stats.review_hospitality_score,
-                aip_ops_ifr_score=stats.aip_ops_ifr_score,
-                aip_hospitality_score=stats.aip_hospitality_score,
-            )
+            features = feature_scores_from_stats(stats)
             
             # Compute persona score
             score = self.persona_manager.compute_score(persona_id, features)
@@ -484,3 +526,68 @@ class GAFriendlinessService:
             logger.error(f"Error getting landing fee for {icao}: {e}")
             return None
 
+    def get_landing_fees_by_weight(self, mtow_kg: int) -> Dict[str, float]:
+        """
+        Get landing fees for a given MTOW for all airports with fee data.
+
+        Single-query counterpart of get_landing_fee_by_weight, used to build
+        vectorized filter columns.
+
+        Returns:
+            Dict mapping ICAO -> fee amount (airports without a fee are omitted)
+        """
+        if not self._enabled or not self.storage:
+            return {}
+
+        try:
+            return self.storage.get_fees_for_band(get_fee_band_for_mtow(mtow_kg))
+        except Exception as e:
+            logger.error(f"Error getting landing fees for {mtow_kg}kg: {e}")
+            return {}
+
+    def get_persona_scores_batch(
+        self,
+        icaos: List[str],
+        persona_id: str = "ifr_touring_sr22"
+    ) -> Dict[str, float]:
+        """
+        Get persona scores for many airports at once.
+
+        Scores-only counterpart of get_summary_dict for ranking: stats are read
+        in chunked queries and no summary, tags or notification data is fetched.
+
+        Args:
+            icaos: List of ICAO codes
+            persona_id: Persona to compute scores for
+
+        Returns:
+            Dict mapping ICAO -> score (airports without data or score are omitted)
+        """
+        if not self._enabled or not self.storage or not self.persona_manager:
+            return {}
+
+        matrix = self._get_score_matrix()
+        if matrix is not None:
+            scores: Dict[str, float] = {}
+            for icao in icaos:
+                score = matrix.score(icao.upper(), persona_id)
+                if score is not None:
+                    scores[icao.upper()] = float(score)
+            return scores
+
+        try:
+            stats_by_icao = self.storage.get_airfield_stats_batch([icao.upper() for icao in icaos])
+        except Exception as e:
+            logger.error(f"Error getting persona scores batch: {e}")
+            return {}
+
+        scores: Dict[str, float] = {}
+        for icao, stats in stats_by_icao.items():
+            try:
+                score = self.persona_manager.compute_score(persona_id, feature_scores_from_stats(stats))
+            except Exception as e:
+                logger.warning(f"Error computing persona score for {icao}: {e}")
+                continue
+            if score is not None:
+                scores[icao] = float(score)
+        return scores
@@ -22,6 +22,19 @@ from .models import (
     RuleSummary,
 )
 
+# Fee band columns of ga_airfield_stats (whitelist for column-name queries)
+FEE_BAND_COLUMNS = (
+    "fee_band_0_749kg",
+    "fee_band_750_1199kg",
+    "fee_band_1200_1499kg",
+    "fee_band_1500_1999kg",
+    "fee_band_2000_3999kg",
+    "fee_band_4000_plus_kg",
+)
+
+# ICAOs per IN (...) query; stays below SQLite's host parameter limit
+STATS_BATCH_SIZE = 500
+
 
 def parse_timestamp(timestamp_str: str) -> datetime:
     """Parse ISO format timestamp string to datetime.
@@ -188,39 +201,105 @@ class GAMetaStorage(StorageInterface):
             if row is None:
                 return None
 
-            return AirportStats(
-                icao=row["icao"],
-                rating_avg=row["rating_avg"],
-                rating_count=row["rating_count"] or 0,
-                last_review_utc=row["last_review_utc"],
-                fee_band_0_749kg=row["fee_band_0_749kg"],
-                fee_band_750_1199kg=row["fee_band_750_1199kg"],
-                fee_band_1200_1499kg=row["fee_band_1200_1499kg"],
-                fee_band_1500_1999kg=row["fee_band_1500_1999kg"],
-                fee_band_2000_3999kg=row["fee_band_2000_3999kg"],
-                fee_band_4000_plus_kg=row["fee_band_4000_plus_kg"],
-                fee_currency=row["fee_currency"],
-                fee_last_updated_utc=row["fee_last_updated_utc"],
-                aip_ifr_available=row["aip_ifr_available"] or 0,
-                aip_night_available=row["aip_night_available"] or 0,
-                aip_hotel_info=row["aip_hotel_info"],
-                aip_restaurant_info=row["aip_restaurant_info"],
-                review_cost_score=row["review_cost_score"],
-                review_hassle_score=row["review_hassle_score"],
-                review_review_score=row["review_review_score"],
-                review_ops_ifr_score=row["review_ops_ifr_score"],
-                review_ops_vfr_score=row["review_ops_vfr_score"],
-                review_access_score=row["review_access_score"],
-                review_fun_score=row["review_fun_score"],
-                review_hospitality_score=row["review_hospitality_score"],
-                aip_ops_ifr_score=row["aip_ops_ifr_score"],
-                aip_hospitality_score=row["aip_hospitality_score"],
-                source_version=row["source_version"] or "unknown",
-                scoring_version=row["scoring_version"] or "unknown",
-            )
+            return self._row_to_stats(row)
+        except sqlite3.Error as e:
+            raise StorageError(f"Failed to read airfield stats: {e}")
+
+    def get_airfield_stats_batch(self, icaos: List[str]) -> Dict[str, AirportStats]:
+        """Read stats for many airports in chunked queries (ICAO -> stats, missing omitted)."""
+        results: Dict[str, AirportStats] = {}
+        unique = list(dict.fromkeys(icaos))
+        try:
+            conn = self._get_connection()
+            for i in range(0, len(unique), STATS_BATCH_SIZE):
+                chunk = unique[i:i + STATS_BATCH_SIZE]
+                placeholders = ",".join("?" * len(chunk))
+                cursor = conn.execute(
+                    f"SELECT * FROM ga_airfield_stats WHERE icao IN ({placeholders})", chunk
+                )
+                for row in cursor:
+                    results[row["icao"]] = self._row_to_stats(row)
+            return results
+        except sqlite3.Error as e:
+            raise StorageError(f"Failed to read airfield stats: {e}")
+
+    def get_all_airfield_stats(self) -> Dict[str, AirportStats]:
+        """Read stats for every airport in a single query (ICAO -> stats)."""
+        try:
+            conn = self._get_connection()
+            cursor = conn.execute("SELECT * FROM ga_airfield_stats")
+            return {row["icao"]: self._row_to_stats(row) for row in cursor}
         except sqlite3.Error as e:
             raise StorageError(f"Failed to read airfield stats: {e}")
 
+    def get_all_review_summaries(self) -> Dict[str, Dict[str, Any]]:
+        """Read every review summary (ICAO -> {summary_text, tags})."""
+        try:
+            conn = self._get_connection()
+            cursor = conn.execute("SELECT icao, summary_text, tags_json FROM ga_review_summary")
+            return {
+                row["icao"]: {
+                    "summary_text": row["summary_text"],
+                    "tags": json.loads(row["tags_json"]) if row["tags_json"] else [],
+                }
+                for row in cursor
+            }
+        except sqlite3.Error as e:
+            raise StorageError(f"Failed to read review summaries: {e}")
+
+    @staticmethod
+    def _row_to_stats(row: sqlite3.Row) -> AirportStats:
+        """Build AirportStats from a ga_airfield_stats row."""
+        return AirportStats(
+            icao=row["icao"],
+            rating_avg=row["rating_avg"],
+            rating_count=row["rating_count"] or 0,
+            last_review_utc=row["last_review_utc"],
+            fee_band_0_749kg=row["fee_band_0_749kg"],
+            fee_band_750_1199kg=row["fee_band_750_1199kg"],
+            fee_band_1200_1499kg=row["fee_band_1200_1499kg"],
+            fee_band_1500_1999kg=row["fee_band_1500_1999kg"],
+            fee_band_2000_3999kg=row["fee_band_2000_3999kg"],
+            fee_band_4000_plus_kg=row["fee_band_4000_plus_kg"],
+            fee_currency=row["fee_currency"],
+            fee_last_updated_utc=row["fee_last_updated_utc"],
+            aip_ifr_available=row["aip_ifr_available"] or 0,
+            aip_night_available=row["aip_night_available"] or 0,
+            aip_hotel_info=row["aip_hotel_info"],
+            aip_restaurant_info=row["aip_restaurant_info"],
+            review_cost_score=row["review_cost_score"],
+            review_hassle_score=row["review_hassle_score"],
+            review_review_score=row["review_review_score"],
+            review_ops_ifr_score=row["review_ops_ifr_score"],
+            review_ops_vfr_score=row["review_ops_vfr_score"],
+            review_access_score=row["review_access_score"],
+            review_fun_score=row["review_fun_score"],
+            review_hospitality_score=row["review_hospitality_score"],
+            aip_ops_ifr_score=row["aip_ops_ifr_score"],
+            aip_hospitality_score=row["aip_hospitality_score"],
+            source_version=row["source_version"] or "unknown",
+            scoring_version=row["scoring_version"] or "unknown",
+        )
+
+    def get_fees_for_band(self, fee_band: str) -> Dict[str, float]:
+        """Get landing fees for one fee band column, for all airports that have one."""
+        if fee_band not in FEE_BAND_COLUMNS:
+            raise StorageError(f"Unknown fee band: {fee_band}")
+        try:
+            conn = self._get_connection()
+            cursor = conn.execute(
+                f"SELECT icao, {fee_band} FROM ga_airfield_stats WHERE {fee_band} IS NOT NULL"
+            )
+            fees: Dict[str, float] = {}
+            for row in cursor:
+                try:
+                    fees[row[0]] = float(row[1])
+                except (TypeError, ValueError):
+                    continue  # Invalid fee data - treat as missing
+            return fees
+        except sqlite3.Error as e:
+            raise StorageError(f"Failed to read fees for {fee_band}: {e}")
+
     def get_all_icaos(self) -> List[str]:
         """Get list of all ICAOs in ga_airfield_stats."""
         try:
@@ -14,6 +14,8 @@ from datetime import datetime
 from typing import List, Tuple, Optional, Dict, Any
 from dotenv import load_dotenv
 
+from shared.ga_friendliness.content_hash import text_hash
+
 # Load environment variables from .env file
 load_dotenv()
 
@@ -99,6 +101,17 @@ Return JSON:
         conn.commit()
         conn.close()
     
+    def get_extracted_text_hashes(self) -> Dict[str, str]:
+        """Text hashes of airports already extracted successfully (ICAO -> hash)."""
+        conn = sqlite3.connect(self.output_db_path)
+        try:
+            rows = conn.execute(
+                "SELECT icao, raw_text FROM ga_notification_requirements WHERE confidence > 0"
+            ).fetchall()
+        finally:
+            conn.close()
+        return {icao: text_hash(raw_text) for icao, raw_text in rows}
+    
     def extract_one(self, icao: str, text: str) -> Dict[str, Any]:
         """Extract notification requirements for one airport."""
         prompt = f"Airport: {icao}\nText: {text}"
@@ -187,9 +200,15 @@ Return JSON:
         airports_db_path: str, 
         icao_prefix: str = None,
         limit: int = None,
-        delay: float = 0.5
+        delay: float = 0.5,
+        skip_unchanged: bool = True,
     ) -> Dict[str, Any]:
-        """Process airports from source database."""
+        """Process airports from source database.
+        
+        With skip_unchanged, airports whose notification text is identical to the
+        last successful extraction are not sent to the LLM again, so a new
+        airports.db only costs calls for the airports whose text changed.
+        """
         
         # Get airports to process
         conn = sqlite3.connect(airports_db_path)
@@ -212,6 +231,14 @@ Return JSON:
         airports = [(row["airport_icao"], row["value"]) for row in cursor]
         conn.close()
         
+        unchanged = 0
+        if skip_unchanged:
+            known = self.get_extracted_text_hashes()
+            changed = [(icao, text) for icao, text in airports if known.get(icao) != text_hash(text)]
+            unchanged = len(airports) - len(changed)
+            airports = changed
+            print(f"Skipping {unchanged} airports with unchanged text")
+        
         print(f"Processing {len(airports)} airports...")
         
         success = 0
@@ -236,7 +263,8 @@ Return JSON:
         return {
             "total": len(airports),
             "success": success,
-            "failed": failed
+            "failed": failed,
+            "unchanged": unchanged,
         }
 
 
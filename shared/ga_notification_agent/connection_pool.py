@@ -0,0 +1,140 @@
+"""
+Read-only SQLite connection pool for notification data access.
+
+Connections are opened once with a read-only URI and reused across calls and
+threads, so hot paths (airport listings, route search) do not pay connection
+setup on every request. sqlite3 keeps a per-connection statement cache, so
+fixed-text queries are prepared once per pooled connection.
+"""
+
+import logging
+import os
+import queue
+import sqlite3
+import threading
+from contextlib import contextmanager
+from pathlib import Path
+from typing import Iterator, Optional, Tuple
+
+logger = logging.getLogger(__name__)
+
+# Idle connections kept per pool (roughly the number of concurrent readers)
+DEFAULT_POOL_SIZE = 4
+
+# Memory-map up to 256 MB of the database file
+MMAP_SIZE_BYTES = 256 * 1024 * 1024
+
+# Seconds to wait on a locked database (e.g. a writer checkpointing the WAL)
+BUSY_TIMEOUT_S = 5.0
+
+FileSignature = Tuple[int, int]  # (mtime_ns, size)
+
+
+def file_signature(path: str) -> Optional[FileSignature]:
+    """Modification time and size of a file, or None if it does not exist."""
+    try:
+        stat = os.stat(path)
+    except OSError:
+        return None
+    return stat.st_mtime_ns, stat.st_size
+
+
+class ReadOnlyConnectionPool:
+    """
+    Thread-safe pool of read-only SQLite connections.
+
+    When the database file is replaced (different mtime/size), idle connections
+    are discarded and new ones opened, so readers never keep serving a deleted file.
+
+    Usage:
+        pool = ReadOnlyConnectionPool("ga_notifications.db")
+        with pool.connection() as conn:
+            rows = conn.execute("SELECT ...").fetchall()
+    """
+
+    def __init__(self, db_path: str, size: int = DEFAULT_POOL_SIZE, immutable: bool = False):
+        """
+        Args:
+            db_path: Path to the SQLite database
+            size: Maximum number of idle connections kept
+            immutable: Open with immutable=1 (no locking or change detection by
+                SQLite). Only safe when the file is never modified in place.
+        """
+        self.db_path = db_path
+        self.size = size
+        self.immutable = immutable
+        self._idle: "queue.LifoQueue[sqlite3.Connection]" = queue.LifoQueue(maxsize=size)
+        self._lock = threading.Lock()
+        self._signature = file_signature(db_path)
+
+    def _uri(self) -> str:
+        uri = f"{Path(self.db_path).resolve().as_uri()}?mode=ro"
+        if self.immutable:
+            uri += "&immutable=1"
+        return uri
+
+    def _open(self) -> sqlite3.Connection:
+        conn = sqlite3.connect(
+            self._uri(),
+            uri=True,
+            timeout=BUSY_TIMEOUT_S,
+            check_same_thread=False,  # Pooled connections move between threads
+        )
+        conn.row_factory = sqlite3.Row
+        conn.execute("PRAGMA query_only = ON")
+        conn.execute(f"PRAGMA mmap_size = {MMAP_SIZE_BYTES}")
+        return conn
+
+    def _check_file(self) -> None:
+        """Drop idle connections if the database file changed."""
+        signature = file_signature(self.db_path)
+        if signature == self._signature:
+            return
+        with self._lock:
+            if signature == self._signature:
+                return
+            logger.info(f"Database changed on disk, reopening connections: {self.db_path}")
+            self._signature = signature
+            self._drain()
+
+    def _drain(self) -> None:
+        while True:
+            try:
+                self._idle.get_nowait().close()
+            except queue.Empty:
+                return
+
+    @contextmanager
+    def connection(self) -> Iterator[sqlite3.Connection]:
+        """Borrow a connection; it is returned to the pool afterwards."""
+        self._check_file()
+        signature = self._signature
+        try:
+            conn = self._idle.get_nowait()
+        except queue.Empty:
+            conn = self._open()
+
+        try:
+            yield conn
+        except Exception:
+            conn.close()  # Connection state unknown after an error
+            raise
+
+        if signature != self._signature:
+            conn.close()  # Opened against an older file
+            return
+        try:
+            self._idle.put_nowait(conn)
+        except queue.Full:
+            conn.close()
+
+    @property
+    def signature(self) -> Optional[FileSignature]:
+        """File signature the pool's connections were opened against."""
+        self._check_file()
+        return self._signature
+
+    def close(self) -> None:
+        """Close all idle connections."""
+        with self._lock:
+            self._drain()
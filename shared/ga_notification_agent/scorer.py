@@ -9,6 +9,8 @@ from typing import List, Optional, Dict, Any
 from pathlib import Path
 import sqlite3
 
+from shared.ga_friendliness.content_hash import HASH_NOTIFICATION, content_hash, content_hash_key
+
 from .models import (
     NotificationRule,
     NotificationType,
@@ -20,6 +22,10 @@ from .parser import NotificationParser
 
 logger = logging.getLogger(__name__)
 
+# Bump when the notification parser or hassle scoring changes, so stored
+# input hashes no longer match and every airport is re-scored
+NOTIFICATION_SCORING_VERSION = "1"
+
 
 class NotificationScorer:
     """
@@ -53,6 +59,14 @@ class NotificationScorer:
             llm_api_key=llm_api_key,
         )
     
+    def input_hash(self, text: Optional[str]) -> str:
+        """
+        Hash of everything a score depends on: the text, the scoring version and
+        the LLM mode (and model when it is on).
+        """
+        llm = self.parser.llm_model if self.parser.use_llm_fallback else None
+        return content_hash([(text or "").strip(), NOTIFICATION_SCORING_VERSION, llm])
+
     def score_from_text(self, icao: str, text: str) -> HassleScore:
         """
         Parse and score notification text.
@@ -84,6 +98,7 @@ class NotificationScorer:
         airports_db_path: Path,
         icaos: Optional[List[str]] = None,
         return_parsed: bool = False,
+        known_hashes: Optional[Dict[str, str]] = None,
     ) -> Dict[str, HassleScore]:
         """
         Load notification text from airports.db and score all airports.
@@ -92,6 +107,8 @@ class NotificationScorer:
             airports_db_path: Path to airports.db
             icaos: Optional list of ICAOs to process (all if None)
             return_parsed: If True, returns (scores, parsed_rules) tuple
+            known_hashes: ICAO -> input hash of the last parse (see read_text_hashes);
+                airports whose input_hash matches are skipped
             
         Returns:
             Dict mapping ICAO -> HassleScore
@@ -120,10 +137,15 @@ class NotificationScorer:
             
             scores = {}
             parsed_rules = {}
+            unchanged = 0
             for row in cursor:
                 icao = row["airport_icao"]
                 text = row["value"]
                 
+                if known_hashes and known_hashes.get(icao) == self.input_hash(text):
+                    unchanged += 1
+                    continue
+                
                 try:
                     parsed = self.parser.parse(icao, text)
                     score = HassleScore.from_parsed_rules(parsed)
@@ -132,7 +154,7 @@ class NotificationScorer:
                 except Exception as e:
                     logger.warning(f"Failed to score {icao}: {e}")
             
-            logger.info(f"Scored {len(scores)} airports from airports.db")
+            logger.info(f"Scored {len(scores)} airports from airports.db ({unchanged} unchanged, skipped)")
             
             if return_parsed:
                 return scores, parsed_rules
@@ -141,6 +163,30 @@ class NotificationScorer:
         finally:
             conn.close()
     
+    def read_text_hashes(self, ga_meta_db_path: Path) -> Dict[str, str]:
+        """
+        Input hashes (see input_hash) of the notifications scored into the GA persona database.
+        
+        Args:
+            ga_meta_db_path: Path to GA persona database
+            
+        Returns:
+            Dict mapping ICAO -> input hash (empty if the database does not exist yet)
+        """
+        if not Path(ga_meta_db_path).exists():
+            return {}
+        prefix = content_hash_key(HASH_NOTIFICATION, "")
+        conn = sqlite3.connect(ga_meta_db_path)
+        try:
+            rows = conn.execute(
+                "SELECT key, value FROM ga_meta_info WHERE key LIKE ?", (prefix + "%",)
+            ).fetchall()
+        except sqlite3.OperationalError:
+            return {}  # Table doesn't exist
+        finally:
+            conn.close()
+        return {key[len(prefix):]: value for key, value in rows}
+    
     def write_to_ga_meta(
         self,
         ga_meta_db_path: Path,
@@ -153,7 +199,8 @@ class NotificationScorer:
         Args:
             ga_meta_db_path: Path to GA persona database
             scores: Dict mapping ICAO -> HassleScore
-            parsed_rules: Optional dict of parsed rules to also store
+            parsed_rules: Optional dict of parsed rules; their input hashes are
+                stored so the next run can skip unchanged airports
             
         Returns:
             Number of airports updated
@@ -190,6 +237,14 @@ class NotificationScorer:
                     (icao, score.summary, score.level.value, score.score, now)
                 )
             
+            # Input hashes for the next incremental run
+            for icao, parsed in (parsed_rules or {}).items():
+                if icao in scores:
+                    conn.execute(
+                        "INSERT OR REPLACE INTO ga_meta_info (key, value) VALUES (?, ?)",
+                        (content_hash_key(HASH_NOTIFICATION, icao), self.input_hash(parsed.raw_text)),
+                    )
+            
             # Note: Detailed rules are no longer written to ga_persona.db
             # Notification data is now stored in ga_notifications.db (separate database)
             # The parsed_rules parameter is kept for backward compatibility but ignored.
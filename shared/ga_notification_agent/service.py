@@ -9,6 +9,7 @@ query functionality.
 import os
 import json
 import sqlite3
+import threading
 from typing import Optional, Dict, Any, List, TYPE_CHECKING
 
 if TYPE_CHECKING:
@@ -16,24 +17,37 @@ if TYPE_CHECKING:
 from pathlib import Path
 import logging
 
+from .connection_pool import ReadOnlyConnectionPool, FileSignature
+
 logger = logging.getLogger(__name__)
 
+# Column list shared by all NotificationInfo queries. Airports can have one row per
+# rule_type; queries order by (icao, rule_type) and keep the first row per ICAO (by rule_type).
+NOTIFICATION_INFO_COLUMNS = "icao, rule_type, notification_type, hours_notice, weekday_rules, summary, confidence"
+
 
 class NotificationService:
     """
     Service for accessing parsed notification/customs requirements.
     
-    This is the main entry point for all notification data. It owns the database
-    connection and provides all query methods.
+    This is the main entry point for all notification data. It owns a pool of
+    read-only database connections and provides all query methods.
     """
     
-    def __init__(self, db_path: Optional[str] = None, airports_db_path: Optional[str] = None):
+    def __init__(
+        self,
+        db_path: Optional[str] = None,
+        airports_db_path: Optional[str] = None,
+        cache_in_memory: bool = False,
+    ):
         """
         Initialize the notification service.
         
         Args:
             db_path: Path to ga_notifications.db. If None, uses centralized config.
             airports_db_path: Path to airports.db for airport lookups. If None, uses centralized config.
+            cache_in_memory: Keep all NotificationInfo objects in memory (reloaded
+                when the database file changes) instead of querying per call.
         """
         if db_path is None:
             from shared.aviation_agent.config import get_ga_notifications_db_path
@@ -41,6 +55,11 @@ class NotificationService:
         
         self.db_path = db_path
         self.airports_db_path = airports_db_path
+        self.cache_in_memory = cache_in_memory
+        self._pool = ReadOnlyConnectionPool(db_path)
+        self._info_cache: Optional[Dict[str, "NotificationInfo"]] = None
+        self._info_cache_signature: Optional[FileSignature] = None
+        self._info_cache_lock = threading.Lock()
         self._check_db()
     
     def _check_db(self):
@@ -51,6 +70,49 @@ class NotificationService:
         else:
             self.db_available = True
             logger.info(f"Notification database loaded: {self.db_path}")
+
+    def close(self) -> None:
+        """Close pooled database connections."""
+        self._pool.close()
+
+    @property
+    def data_version(self) -> Optional[str]:
+        """
+        Identifier of the notification data currently served, or None if not stable.
+
+        Based on the database file signature; only set with cache_in_memory.
+        Used for response caching.
+        """
+        if not self.cache_in_memory or not self.db_available:
+            return None
+        signature = self._pool.signature
+        return f"{signature[0]}:{signature[1]}" if signature else None
+
+    def _get_info_cache(self) -> Dict[str, "NotificationInfo"]:
+        """All NotificationInfo objects by ICAO, reloaded when the db file changes."""
+        from .models import NotificationInfo
+
+        signature = self._pool.signature
+        cache = self._info_cache
+        if cache is not None and signature == self._info_cache_signature:
+            return cache
+
+        with self._info_cache_lock:
+            if self._info_cache is None or signature != self._info_cache_signature:
+                with self._pool.connection() as conn:
+                    cursor = conn.execute(
+                        f"SELECT {NOTIFICATION_INFO_COLUMNS} FROM ga_notification_requirements "
+                        "ORDER BY icao, rule_type"
+                    )
+                    # First row per ICAO (by rule_type), as the uncached lookups return
+                    cache: Dict[str, NotificationInfo] = {}
+                    for row in cursor:
+                        if row["icao"] not in cache:
+                            cache[row["icao"]] = NotificationInfo.from_db_row(dict(row))
+                    self._info_cache = cache
+                self._info_cache_signature = signature
+                logger.info(f"Notification cache loaded: {len(self._info_cache)} airports")
+            return self._info_cache
     
     def _get_airports_db_path(self) -> Optional[str]:
         """Get airports database path for lookups."""
@@ -130,21 +192,18 @@ class NotificationService:
             return None
         
         try:
-            conn = sqlite3.connect(self.db_path)
-            conn.row_factory = sqlite3.Row
-            
-            cursor = conn.execute('''
-                SELECT 
-                    icao, rule_type, notification_type, hours_notice,
-                    operating_hours_start, operating_hours_end,
-                    weekday_rules, schengen_rules, contact_info,
-                    summary, confidence
-                FROM ga_notification_requirements
-                WHERE icao = ?
-            ''', (icao.upper(),))
-            
-            row = cursor.fetchone()
-            conn.close()
+            with self._pool.connection() as conn:
+                cursor = conn.execute('''
+                    SELECT 
+                        icao, rule_type, notification_type, hours_notice,
+                        operating_hours_start, operating_hours_end,
+                        weekday_rules, schengen_rules, contact_info,
+                        summary, confidence
+                    FROM ga_notification_requirements
+                    WHERE icao = ?
+                    ORDER BY rule_type
+                ''', (icao.upper(),))
+                row = cursor.fetchone()
             
             if row:
                 return {
@@ -186,6 +245,12 @@ class NotificationService:
         """
         from .models import NotificationInfo
 
+        if self.cache_in_memory and self.db_available:
+            try:
+                return self._get_info_cache().get(icao.upper())
+            except Exception as e:
+                logger.error(f"Error reading notification cache: {e}")
+
         row = self.get_notification_summary(icao)
         if row is None:
             return None
@@ -196,6 +261,9 @@ class NotificationService:
         """
         Get NotificationInfo objects for multiple airports in a single query.
 
+        The ICAO list is passed as one JSON parameter so the statement text is
+        the same for every batch size and stays in the connection's statement cache.
+
         Args:
             icaos: List of ICAO codes
 
@@ -208,25 +276,25 @@ class NotificationService:
             return {}
 
         try:
-            conn = sqlite3.connect(self.db_path)
-            conn.row_factory = sqlite3.Row
-
-            # Build query with placeholders
-            placeholders = ",".join("?" * len(icaos))
-            cursor = conn.execute(f'''
-                SELECT
-                    icao, rule_type, notification_type, hours_notice,
-                    weekday_rules, summary, confidence
-                FROM ga_notification_requirements
-                WHERE icao IN ({placeholders})
-            ''', [icao.upper() for icao in icaos])
-
-            results = {}
-            for row in cursor:
-                info = NotificationInfo.from_db_row(dict(row))
-                results[row["icao"]] = info
+            if self.cache_in_memory:
+                cache = self._get_info_cache()
+                results = {}
+                for icao in icaos:
+                    info = cache.get(icao.upper())
+                    if info is not None:
+                        results[info.icao] = info
+                return results
 
-            conn.close()
+            with self._pool.connection() as conn:
+                cursor = conn.execute(
+                    f"SELECT {NOTIFICATION_INFO_COLUMNS} FROM ga_notification_requirements "
+                    "WHERE icao IN (SELECT value FROM json_each(?)) ORDER BY icao, rule_type",
+                    (json.dumps([icao.upper() for icao in icaos]),),
+                )
+                results = {}
+                for row in cursor:
+                    if row["icao"] not in results:
+                        results[row["icao"]] = NotificationInfo.from_db_row(dict(row))
             return results
 
         except Exception as e:
@@ -298,21 +366,18 @@ class NotificationService:
             }
         
         try:
-            conn = sqlite3.connect(self.db_path)
-            conn.row_factory = sqlite3.Row
-            
-            cursor = conn.execute('''
-                SELECT 
-                    icao, rule_type, notification_type, hours_notice,
-                    operating_hours_start, operating_hours_end,
-                    weekday_rules, schengen_rules, contact_info,
-                    summary, confidence
-                FROM ga_notification_requirements
-                WHERE icao = ?
-            ''', (icao.upper(),))
-            
-            row = cursor.fetchone()
-            conn.close()
+            with self._pool.connection() as conn:
+                cursor = conn.execute('''
+                    SELECT 
+                        icao, rule_type, notification_type, hours_notice,
+                        operating_hours_start, operating_hours_end,
+                        weekday_rules, schengen_rules, contact_info,
+                        summary, confidence
+                    FROM ga_notification_requirements
+                    WHERE icao = ?
+                    ORDER BY rule_type
+                ''', (icao.upper(),))
+                row = cursor.fetchone()
             
             if not row:
                 return {
@@ -608,28 +673,24 @@ class NotificationService:
             }
         
         try:
-            conn = sqlite3.connect(self.db_path)
-            conn.row_factory = sqlite3.Row
-            
-            # Get counts by notification type
-            cursor = conn.execute("""
-                SELECT notification_type, COUNT(*) as count
-                FROM ga_notification_requirements
-                GROUP BY notification_type
-                ORDER BY count DESC
-            """)
-            by_type = {row["notification_type"]: row["count"] for row in cursor}
-            
-            # Get total and average confidence
-            cursor = conn.execute("""
-                SELECT COUNT(*) as total, 
-                       AVG(confidence) as avg_confidence,
-                       AVG(hours_notice) as avg_hours
-                FROM ga_notification_requirements
-            """)
-            stats = cursor.fetchone()
-            
-            conn.close()
+            with self._pool.connection() as conn:
+                # Get counts by notification type
+                cursor = conn.execute("""
+                    SELECT notification_type, COUNT(*) as count
+                    FROM ga_notification_requirements
+                    GROUP BY notification_type
+                    ORDER BY count DESC
+                """)
+                by_type = {row["notification_type"]: row["count"] for row in cursor}
+                
+                # Get total and average confidence
+                cursor = conn.execute("""
+                    SELECT COUNT(*) as total, 
+                           AVG(confidence) as avg_confidence,
+                           AVG(hours_notice) as avg_hours
+                    FROM ga_notification_requirements
+                """)
+                stats = cursor.fetchone()
             
             pretty_lines = [
                 "**Notification Parsing Statistics**",
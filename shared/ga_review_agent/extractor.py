@@ -6,9 +6,11 @@ Uses LangChain to extract structured aspect-label pairs from free-text reviews.
 
 import json
 import logging
-from typing import Any, Dict, List, Optional, Tuple
+import threading
+from concurrent.futures import ThreadPoolExecutor
+from typing import Any, Dict, Hashable, List, Optional, Sequence, Tuple
 
-from tenacity import retry, stop_after_attempt, wait_exponential, retry_if_exception_type
+from tenacity import Retrying, retry_if_exception_type, stop_after_attempt, wait_exponential, wait_random
 
 from shared.ga_friendliness.exceptions import ReviewExtractionError
 from shared.ga_friendliness.interfaces import ReviewExtractorInterface
@@ -18,6 +20,8 @@ from shared.ga_friendliness.models import (
     ReviewExtraction,
 )
 
+from .rate_limiter import RateLimiter
+
 logger = logging.getLogger(__name__)
 
 
@@ -47,12 +51,49 @@ Only include aspects that are actually mentioned or clearly implied in the revie
 Be conservative - only extract with high confidence when the text clearly supports it."""
 
 
+# Several reviews of one airport per call: the ontology context is sent once
+PACKED_EXTRACTION_PROMPT_TEMPLATE = """You are an expert at analyzing aviation reviews and extracting structured information.
+
+Given several numbered reviews of the same airfield/airport, extract relevant aspects and labels
+for EACH review separately, according to the ontology below.
+
+{ontology_context}
+
+For each aspect mentioned in a review, assign the most appropriate label.
+Only extract aspects that are clearly mentioned or implied in that review; never carry
+information over from one review to another.
+Assign a confidence score (0.0-1.0) based on how certain you are about the extraction.
+
+Reviews to analyze:
+{reviews_block}
+
+Respond with a JSON object containing exactly one entry per review, in this exact format:
+{{
+    "reviews": [
+        {{"index": <review number>, "aspects": [
+            {{"aspect": "<aspect_name>", "label": "<label>", "confidence": <0.0-1.0>}},
+            ...
+        ]}},
+        ...
+    ]
+}}
+
+Use an empty "aspects" list for reviews without relevant information.
+Be conservative - only extract with high confidence when the text clearly supports it."""
+
+# Rough chars-per-token ratio for estimating prompt tokens saved by packing
+CHARS_PER_TOKEN = 4
+
+
 class ReviewExtractor(ReviewExtractorInterface):
     """
     Extracts structured tags from free-text reviews using LLM.
     
     Features:
-        - Retry logic for transient failures
+        - Retry with jittered exponential backoff for transient failures
+        - Concurrent batch extraction with optional shared rate limiting
+        - Packed mode: several reviews of one airport per call (falls back to
+          single-review calls if the packed response does not validate)
         - Token usage tracking
         - Error handling with specific exceptions
         - Support for mock LLM for testing
@@ -66,6 +107,9 @@ class ReviewExtractor(ReviewExtractorInterface):
         api_key: Optional[str] = None,
         max_retries: int = 3,
         mock_llm: bool = False,
+        max_concurrency: int = 1,
+        rate_limiter: Optional[RateLimiter] = None,
+        reviews_per_call: int = 1,
     ):
         """
         Initialize extractor with LLM.
@@ -77,6 +121,9 @@ class ReviewExtractor(ReviewExtractorInterface):
             api_key: OpenAI API key (uses env var if not provided)
             max_retries: Maximum number of retry attempts for LLM calls
             mock_llm: If True, use mock LLM for testing
+            max_concurrency: Reviews extracted in parallel by extract_batch
+            rate_limiter: Optional limiter shared with other LLM clients
+            reviews_per_call: Reviews packed into one LLM call by extract_batch (1 = no packing)
         """
         self.ontology = ontology
         self.llm_model = llm_model
@@ -84,19 +131,24 @@ class ReviewExtractor(ReviewExtractorInterface):
         self.api_key = api_key
         self.max_retries = max_retries
         self.mock_llm = mock_llm
+        self.max_concurrency = max(1, max_concurrency)
+        self.rate_limiter = rate_limiter
+        self.reviews_per_call = max(1, reviews_per_call)
         
-        # Token usage tracking
-        self._token_usage = {
-            "input_tokens": 0,
-            "output_tokens": 0,
-            "total_calls": 0,
-        }
+        # Token usage tracking (updated from worker threads)
+        self._usage_lock = threading.Lock()
+        self._token_usage = self._empty_usage()
         
         # Build ontology context for prompt
         self._ontology_context = self._build_ontology_context()
+        # Prompt tokens repeated by every single-review call (what packing saves)
+        self._prompt_overhead_tokens = len(EXTRACTION_PROMPT_TEMPLATE.format(
+            ontology_context=self._ontology_context, review_text="",
+        )) // CHARS_PER_TOKEN
         
         # Initialize LLM chain if not mock
         self._chain = None
+        self._packed_chain = None
         if not mock_llm:
             self._init_chain()
 
@@ -129,6 +181,9 @@ class ReviewExtractor(ReviewExtractorInterface):
             
             # Create chain
             self._chain = self._prompt | self._llm
+            self._packed_chain = (
+                ChatPromptTemplate.from_template(PACKED_EXTRACTION_PROMPT_TEMPLATE) | self._llm
+            )
             
         except ImportError as e:
             raise ReviewExtractionError(
@@ -201,37 +256,68 @@ class ReviewExtractor(ReviewExtractorInterface):
         except json.JSONDecodeError as e:
             raise ReviewExtractionError(f"Failed to parse LLM response as JSON: {e}")
 
-    @retry(
-        stop=stop_after_attempt(3),
-        wait=wait_exponential(multiplier=1, min=2, max=10),
-        retry=retry_if_exception_type(Exception),
-        reraise=True,
-    )
     def _call_llm(self, review_text: str) -> Dict[str, Any]:
         """Call LLM with retry logic."""
         if self.mock_llm:
             return self._mock_extract(review_text)
         
-        if self._chain is None:
+        return self._invoke_with_retry(self._chain, {
+            "ontology_context": self._ontology_context,
+            "review_text": review_text,
+        })
+
+    def _call_llm_packed(self, review_texts: List[str]) -> Dict[str, Any]:
+        """Call LLM once for several reviews (response: {"reviews": [{"index", "aspects"}]})."""
+        if self.mock_llm:
+            return {"reviews": [
+                {"index": i, **self._mock_extract(text)}
+                for i, text in enumerate(review_texts, start=1)
+            ]}
+        
+        reviews_block = "\n".join(
+            f'{i}. "{text}"' for i, text in enumerate(review_texts, start=1)
+        )
+        return self._invoke_with_retry(self._packed_chain, {
+            "ontology_context": self._ontology_context,
+            "reviews_block": reviews_block,
+        })
+
+    def _invoke_with_retry(self, chain: Any, inputs: Dict[str, Any]) -> Dict[str, Any]:
+        """Invoke a chain with retries; returns the parsed JSON response."""
+        if chain is None:
             raise ReviewExtractionError("LLM chain not initialized")
         
+        # Jitter keeps parallel workers from retrying in lockstep after a 429
+        retrying = Retrying(
+            stop=stop_after_attempt(self.max_retries),
+            wait=wait_exponential(multiplier=1, min=2, max=30) + wait_random(0, 1),
+            retry=retry_if_exception_type(Exception),
+            reraise=True,
+        )
+        for attempt in retrying:
+            with attempt:
+                return self._invoke_once(chain, inputs)
+
+    def _invoke_once(self, chain: Any, inputs: Dict[str, Any]) -> Dict[str, Any]:
+        """Single rate-limited LLM request."""
+        if self.rate_limiter is not None:
+            self.rate_limiter.acquire()
+        
         try:
             # Invoke chain
-            response = self._chain.invoke({
-                "ontology_context": self._ontology_context,
-                "review_text": review_text,
-            })
+            response = chain.invoke(inputs)
             
             # Extract content from AIMessage
             content = response.content if hasattr(response, "content") else str(response)
             
             # Track token usage if available
-            if hasattr(response, "usage_metadata"):
-                usage = response.usage_metadata
-                self._token_usage["input_tokens"] += usage.get("input_tokens", 0)
-                self._token_usage["output_tokens"] += usage.get("output_tokens", 0)
-            
-            self._token_usage["total_calls"] += 1
+            with self._usage_lock:
+                if hasattr(response, "usage_metadata"):
+                    usage = response.usage_metadata
+                    self._token_usage["input_tokens"] += usage.get("input_tokens", 0)
+                    self._token_usage["output_tokens"] += usage.get("output_tokens", 0)
+                
+                self._token_usage["total_calls"] += 1
             
             return self._parse_llm_response(content)
             
@@ -239,6 +325,41 @@ class ReviewExtractor(ReviewExtractorInterface):
             logger.error(f"LLM call failed: {e}")
             raise
 
+    def _to_extraction(
+        self,
+        result: Dict[str, Any],
+        review_text: str,
+        review_id: Optional[str],
+        timestamp: Optional[str],
+    ) -> ReviewExtraction:
+        """Validate parsed aspects against the ontology."""
+        aspects = []
+        for item in result.get("aspects", []):
+            aspect = item.get("aspect", "")
+            label = item.get("label", "")
+            confidence = float(item.get("confidence", 0.0))
+            
+            # Validate against ontology
+            if not self.ontology.validate_aspect(aspect):
+                logger.warning(f"Unknown aspect '{aspect}' in extraction")
+                continue
+            if not self.ontology.validate_label(aspect, label):
+                logger.warning(f"Invalid label '{label}' for aspect '{aspect}'")
+                continue
+            
+            aspects.append(AspectLabel(
+                aspect=aspect,
+                label=label,
+                confidence=confidence,
+            ))
+        
+        return ReviewExtraction(
+            review_id=review_id,
+            aspects=aspects,
+            raw_text_excerpt=review_text[:200] if len(review_text) > 200 else review_text,
+            timestamp=timestamp,
+        )
+
     def extract(
         self,
         review_text: str,
@@ -261,75 +382,154 @@ class ReviewExtractor(ReviewExtractorInterface):
         """
         try:
             result = self._call_llm(review_text)
-            
-            # Parse aspects
-            aspects = []
-            for item in result.get("aspects", []):
-                aspect = item.get("aspect", "")
-                label = item.get("label", "")
-                confidence = float(item.get("confidence", 0.0))
-                
-                # Validate against ontology
-                if not self.ontology.validate_aspect(aspect):
-                    logger.warning(f"Unknown aspect '{aspect}' in extraction")
-                    continue
-                if not self.ontology.validate_label(aspect, label):
-                    logger.warning(f"Invalid label '{label}' for aspect '{aspect}'")
-                    continue
-                
-                aspects.append(AspectLabel(
-                    aspect=aspect,
-                    label=label,
-                    confidence=confidence,
-                ))
-            
-            return ReviewExtraction(
-                review_id=review_id,
-                aspects=aspects,
-                raw_text_excerpt=review_text[:200] if len(review_text) > 200 else review_text,
-                timestamp=timestamp,
-            )
-            
+            extraction = self._to_extraction(result, review_text, review_id, timestamp)
         except Exception as e:
             raise ReviewExtractionError(f"Failed to extract from review: {e}")
+        
+        with self._usage_lock:
+            self._token_usage["reviews_extracted"] += 1
+        return extraction
 
     def extract_batch(
         self,
         reviews: List[Tuple[str, Optional[str], Optional[str]]],
+        group_keys: Optional[Sequence[Hashable]] = None,
     ) -> List[ReviewExtraction]:
         """
         Extract tags from multiple reviews.
         
+        Consecutive reviews with the same group key (e.g. ICAO) are packed
+        reviews_per_call at a time; up to max_concurrency calls run in
+        parallel. Results keep the input order.
+        
         Args:
             reviews: List of (text, review_id, timestamp) tuples
+            group_keys: Optional key per review; packs never span two keys
+                (default: all reviews form one group)
         
         Returns:
             List of ReviewExtraction objects
         """
-        results = []
-        for text, review_id, timestamp in reviews:
-            try:
-                result = self.extract(text, review_id, timestamp)
-                results.append(result)
-            except ReviewExtractionError as e:
-                logger.error(f"Failed to extract review {review_id}: {e}")
-                # Return empty extraction for failed reviews
-                results.append(ReviewExtraction(
-                    review_id=review_id,
-                    aspects=[],
-                    timestamp=timestamp,
-                ))
-        return results
+        packs = self._make_packs(reviews, group_keys)
+        
+        if self.max_concurrency == 1 or len(packs) <= 1:
+            packed_results = [self._extract_pack(pack) for pack in packs]
+        else:
+            workers = min(self.max_concurrency, len(packs))
+            with ThreadPoolExecutor(max_workers=workers, thread_name_prefix="review-extract") as pool:
+                packed_results = list(pool.map(self._extract_pack, packs))
+        
+        return [extraction for results in packed_results for extraction in results]
 
-    def get_token_usage(self) -> Dict[str, int]:
-        """Get cumulative token usage stats."""
-        return self._token_usage.copy()
+    def _make_packs(
+        self,
+        reviews: List[Tuple[str, Optional[str], Optional[str]]],
+        group_keys: Optional[Sequence[Hashable]],
+    ) -> List[List[Tuple[str, Optional[str], Optional[str]]]]:
+        """Split reviews into in-order packs of up to reviews_per_call, one group each."""
+        if group_keys is not None and len(group_keys) != len(reviews):
+            raise ValueError("group_keys must have one entry per review")
+        
+        packs: List[List[Tuple[str, Optional[str], Optional[str]]]] = []
+        last_key: Any = object()
+        for i, review in enumerate(reviews):
+            key = group_keys[i] if group_keys is not None else None
+            if not packs or key != last_key or len(packs[-1]) >= self.reviews_per_call:
+                packs.append([])
+            packs[-1].append(review)
+            last_key = key
+        return packs
 
-    def reset_token_usage(self) -> None:
-        """Reset token usage counters."""
-        self._token_usage = {
+    def _extract_pack(
+        self, pack: List[Tuple[str, Optional[str], Optional[str]]]
+    ) -> List[ReviewExtraction]:
+        """Extract a pack in one call, falling back to one call per review."""
+        if len(pack) == 1:
+            return [self._extract_or_empty(pack[0])]
+        
+        try:
+            result = self._call_llm_packed([text for text, _, _ in pack])
+            aspects_by_index = self._demux_packed(result, len(pack))
+            extractions = [
+                self._to_extraction({"aspects": aspects_by_index[i]}, text, review_id, timestamp)
+                for i, (text, review_id, timestamp) in enumerate(pack, start=1)
+            ]
+        except Exception as e:
+            logger.warning(f"Packed extraction of {len(pack)} reviews failed, retrying one by one: {e}")
+            with self._usage_lock:
+                self._token_usage["packed_fallbacks"] += 1
+            return [self._extract_or_empty(review) for review in pack]
+        
+        with self._usage_lock:
+            self._token_usage["packed_calls"] += 1
+            self._token_usage["reviews_extracted"] += len(pack)
+            self._token_usage["estimated_input_tokens_saved"] += (
+                (len(pack) - 1) * self._prompt_overhead_tokens
+            )
+        return extractions
+
+    @staticmethod
+    def _demux_packed(result: Dict[str, Any], count: int) -> Dict[int, List[Dict[str, Any]]]:
+        """Aspects per review number (1-based); raises if any review is missing or malformed."""
+        entries = result.get("reviews")
+        if not isinstance(entries, list):
+            raise ReviewExtractionError("Packed response has no 'reviews' list")
+        
+        aspects_by_index: Dict[int, List[Dict[str, Any]]] = {}
+        for entry in entries:
+            if not isinstance(entry, dict) or not isinstance(entry.get("aspects"), list):
+                raise ReviewExtractionError(f"Malformed packed entry: {entry}")
+            index = int(entry.get("index"))
+            if not 1 <= index <= count or index in aspects_by_index:
+                raise ReviewExtractionError(f"Unexpected review index {index} in packed response")
+            aspects_by_index[index] = entry["aspects"]
+        
+        if len(aspects_by_index) != count:
+            raise ReviewExtractionError(
+                f"Packed response covers {len(aspects_by_index)} of {count} reviews"
+            )
+        return aspects_by_index
+
+    def _extract_or_empty(
+        self, review: Tuple[str, Optional[str], Optional[str]]
+    ) -> ReviewExtraction:
+        """Extract one review, returning an empty extraction on failure."""
+        text, review_id, timestamp = review
+        try:
+            return self.extract(text, review_id, timestamp)
+        except ReviewExtractionError as e:
+            logger.error(f"Failed to extract review {review_id}: {e}")
+            # Return empty extraction for failed reviews
+            return ReviewExtraction(
+                review_id=review_id,
+                aspects=[],
+                timestamp=timestamp,
+            )
+
+    @staticmethod
+    def _empty_usage() -> Dict[str, int]:
+        return {
             "input_tokens": 0,
             "output_tokens": 0,
             "total_calls": 0,
+            "reviews_extracted": 0,
+            "packed_calls": 0,
+            "packed_fallbacks": 0,
+            "estimated_input_tokens_saved": 0,
         }
 
+    def get_token_usage(self) -> Dict[str, int]:
+        """
+        Get cumulative token usage stats.
+        
+        Besides token counts, reports packing effect: reviews_extracted vs
+        total_calls, and estimated_input_tokens_saved (prompt overhead not
+        repeated thanks to packing).
+        """
+        with self._usage_lock:
+            return self._token_usage.copy()
+
+    def reset_token_usage(self) -> None:
+        """Reset token usage counters."""
+        with self._usage_lock:
+            self._token_usage = self._empty_usage()
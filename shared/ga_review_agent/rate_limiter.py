@@ -0,0 +1,61 @@
+"""
+Token-bucket rate limiting for concurrent LLM calls.
+
+Extraction and summary workers share one limiter so the combined request rate
+stays under the provider limit however many threads are running.
+"""
+
+import threading
+import time
+from typing import Optional
+
+
+class RateLimiter:
+    """
+    Thread-safe token bucket.
+
+    Tokens refill continuously at `requests_per_minute / 60` per second up to
+    `burst`; `acquire()` blocks until a token is available.
+
+    Usage:
+        limiter = RateLimiter(requests_per_minute=500)
+        limiter.acquire()  # before each request
+    """
+
+    def __init__(self, requests_per_minute: float, burst: Optional[int] = None):
+        """
+        Args:
+            requests_per_minute: Sustained request rate (must be > 0)
+            burst: Bucket capacity (default: one second of requests, at least 1)
+        """
+        if requests_per_minute <= 0:
+            raise ValueError("requests_per_minute must be positive")
+        self.rate_per_s = requests_per_minute / 60.0
+        self.capacity = float(burst if burst is not None else max(1, int(self.rate_per_s)))
+        self._tokens = self.capacity
+        self._updated = time.monotonic()
+        self._lock = threading.Lock()
+
+    def _refill(self, now: float) -> None:
+        self._tokens = min(self.capacity, self._tokens + (now - self._updated) * self.rate_per_s)
+        self._updated = now
+
+    def try_acquire(self) -> bool:
+        """Take a token if one is available (never blocks)."""
+        with self._lock:
+            self._refill(time.monotonic())
+            if self._tokens >= 1.0:
+                self._tokens -= 1.0
+                return True
+            return False
+
+    def acquire(self) -> None:
+        """Take a token, waiting for the bucket to refill if needed."""
+        while True:
+            with self._lock:
+                self._refill(time.monotonic())
+                if self._tokens >= 1.0:
+                    self._tokens -= 1.0
+                    return
+                wait_s = (1.0 - self._tokens) / self.rate_per_s
+            time.sleep(wait_s)
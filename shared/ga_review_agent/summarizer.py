@@ -6,6 +6,7 @@ Uses LLM to generate human-readable summaries from extracted tags.
 
 import json
 import logging
+import threading
 from typing import Any, Dict, List, Optional, Tuple
 
 from tenacity import retry, stop_after_attempt, wait_exponential, retry_if_exception_type
@@ -17,6 +18,8 @@ from shared.ga_friendliness.models import (
     ReviewExtraction,
 )
 
+from .rate_limiter import RateLimiter
+
 logger = logging.getLogger(__name__)
 
 
@@ -55,6 +58,7 @@ class SummaryGenerator(SummaryGeneratorInterface):
         llm_temperature: float = 0.3,  # Slightly higher for more natural text
         api_key: Optional[str] = None,
         mock_llm: bool = False,
+        rate_limiter: Optional[RateLimiter] = None,
     ):
         """
         Initialize summary generator.
@@ -64,13 +68,16 @@ class SummaryGenerator(SummaryGeneratorInterface):
             llm_temperature: LLM temperature
             api_key: OpenAI API key (uses env var if not provided)
             mock_llm: If True, use mock LLM for testing
+            rate_limiter: Optional limiter shared with other LLM clients
         """
         self.llm_model = llm_model
         self.llm_temperature = llm_temperature
         self.api_key = api_key
         self.mock_llm = mock_llm
+        self.rate_limiter = rate_limiter
         
-        # Token usage tracking
+        # Token usage tracking (generate_summary may run on worker threads)
+        self._usage_lock = threading.Lock()
         self._token_usage = {
             "input_tokens": 0,
             "output_tokens": 0,
@@ -227,6 +234,9 @@ class SummaryGenerator(SummaryGeneratorInterface):
         if self._chain is None:
             raise ReviewExtractionError("LLM chain not initialized")
         
+        if self.rate_limiter is not None:
+            self.rate_limiter.acquire()
+        
         try:
             response = self._chain.invoke({
                 "icao": icao,
@@ -238,12 +248,13 @@ class SummaryGenerator(SummaryGeneratorInterface):
             content = response.content if hasattr(response, "content") else str(response)
             
             # Track token usage
-            if hasattr(response, "usage_metadata"):
-                usage = response.usage_metadata
-                self._token_usage["input_tokens"] += usage.get("input_tokens", 0)
-                self._token_usage["output_tokens"] += usage.get("output_tokens", 0)
-            
-            self._token_usage["total_calls"] += 1
+            with self._usage_lock:
+                if hasattr(response, "usage_metadata"):
+                    usage = response.usage_metadata
+                    self._token_usage["input_tokens"] += usage.get("input_tokens", 0)
+                    self._token_usage["output_tokens"] += usage.get("output_tokens", 0)
+                
+                self._token_usage["total_calls"] += 1
             
             return self._parse_llm_response(content)
             
@@ -285,13 +296,15 @@ class SummaryGenerator(SummaryGeneratorInterface):
 
     def get_token_usage(self) -> Dict[str, int]:
         """Get cumulative token usage stats."""
-        return self._token_usage.copy()
+        with self._usage_lock:
+            return self._token_usage.copy()
 
     def reset_token_usage(self) -> None:
         """Reset token usage counters."""
-        self._token_usage = {
-            "input_tokens": 0,
-            "output_tokens": 0,
-            "total_calls": 0,
-        }
+        with self._usage_lock:
+            self._token_usage = {
+                "input_tokens": 0,
+                "output_tokens": 0,
+                "total_calls": 0,
+            }
 
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""
+Persistent cache for forward-geocoding results.
+
+Free-text tool calls resolve the same places over and over ("Paris", "Lyon",
+"Vik, Iceland"), and every Geoapify call is a blocking HTTP round trip that
+costs API quota. Results are cached in SQLite (shared by all workers on the
+host) with an in-memory front:
+
+- Found locations are kept for GEOCODE_TTL_S, "no match" answers for
+  GEOCODE_NEGATIVE_TTL_S. Transport errors are never cached.
+- Concurrent lookups of the same query share one in-flight call.
+
+Configure the database with GEOCODE_CACHE_DB (defaults to a file in the system
+temp directory). If the file cannot be opened, the cache runs in memory only.
+"""
+import json
+import logging
+import os
+import sqlite3
+import tempfile
+import threading
+import time
+from collections import OrderedDict
+from typing import Any, Callable, Dict, Optional, Tuple
+
+logger = logging.getLogger(__name__)
+
+# Found locations do not move; refresh monthly to pick up provider fixes
+GEOCODE_TTL_S = 30 * 24 * 3600.0
+
+# "No match" may be a typo today and a new place name tomorrow
+GEOCODE_NEGATIVE_TTL_S = 24 * 3600.0
+
+# Queries kept in the in-memory front
+MAX_MEMORY_ENTRIES = 1024
+
+# Seconds to wait on a locked database (another worker writing)
+BUSY_TIMEOUT_S = 5.0
+
+GeocodeResult = Optional[Dict[str, Any]]
+GeocodeFetcher = Callable[[str], GeocodeResult]
+
+_MISSING = object()
+
+
+def normalize_query(query: str) -> str:
+    """Cache key: case- and whitespace-insensitive."""
+    return " ".join(query.lower().split())
+
+
+def default_cache_path() -> str:
+    """GEOCODE_CACHE_DB, or a file in the system temp directory."""
+    return os.environ.get("GEOCODE_CACHE_DB") or os.path.join(tempfile.gettempdir(), "flyfun-geocode-cache.db")
+
+
+class _InFlight:
+    """One running fetch that other callers of the same query wait for."""
+
+    def __init__(self):
+        self.done = threading.Event()
+        self.result: GeocodeResult = None
+        self.error: Optional[BaseException] = None
+
+
+class GeocodeCache:
+    """
+    TTL cache with negative caching and request coalescing.
+
+    Usage:
+        cache = GeocodeCache("geocode_cache.db")
+        result = cache.get_or_fetch("Paris", fetch)
+
+    `fetch(query)` returns a result dict, None for "no match" (cached for
+    negative_ttl_s), or raises for transport errors (not cached, re-raised to
+    every waiting caller).
+    """
+
+    def __init__(
+        self,
+        db_path: Optional[str] = None,
+        ttl_s: float = GEOCODE_TTL_S,
+        negative_ttl_s: float = GEOCODE_NEGATIVE_TTL_S,
+        max_memory_entries: int = MAX_MEMORY_ENTRIES,
+    ):
+        """
+        Args:
+            db_path: SQLite file; None keeps the cache in memory only
+            ttl_s: Lifetime of found locations
+            negative_ttl_s: Lifetime of "no match" answers
+            max_memory_entries: Size of the in-memory front
+        """
+        self.ttl_s = ttl_s
+        self.negative_ttl_s = negative_ttl_s
+        self.max_memory_entries = max_memory_entries
+        self._memory: "OrderedDict[str, Tuple[GeocodeResult, float]]" = OrderedDict()
+        self._in_flight: Dict[str, _InFlight] = {}
+        self._lock = threading.Lock()
+        self._db_lock = threading.Lock()
+        self._conn = self._open(db_path) if db_path else None
+
+    @staticmethod
+    def _open(db_path: str) -> Optional[sqlite3.Connection]:
+        try:
+            conn = sqlite3.connect(db_path, timeout=BUSY_TIMEOUT_S, check_same_thread=False)
+            conn.execute("PRAGMA journal_mode = WAL")
+            conn.execute(
+                """
+                CREATE TABLE IF NOT EXISTS geocode_cache (
+                    query_key TEXT PRIMARY KEY,
+                    result_json TEXT,
+                    fetched_at REAL NOT NULL
+                )
+                """
+            )
+            conn.commit()
+            return conn
+        except sqlite3.Error as e:
+            logger.warning(f"Geocode cache database unavailable ({db_path}), using memory only: {e}")
+            return None
+
+    def _expired(self, result: GeocodeResult, fetched_at: float, now: float) -> bool:
+        ttl = self.ttl_s if result is not None else self.negative_ttl_s
+        return now - fetched_at > ttl
+
+    def _remember(self, key: str, result: GeocodeResult, fetched_at: float) -> None:
+        with self._lock:
+            self._memory[key] = (result, fetched_at)
+            self._memory.move_to_end(key)
+            while len(self._memory) > self.max_memory_entries:
+                self._memory.popitem(last=False)
+
+    def _lookup(self, key: str) -> Any:
+        """Cached result, or _MISSING."""
+        now = time.time()
+        with self._lock:
+            entry = self._memory.get(key)
+            if entry is not None:
+                self._memory.move_to_end(key)
+        if entry is None and self._conn is not None:
+            try:
+                with self._db_lock:
+                    row = self._conn.execute(
+                        "SELECT result_json, fetched_at FROM geocode_cache WHERE query_key = ?", (key,)
+                    ).fetchone()
+            except sqlite3.Error as e:
+                logger.warning(f"Geocode cache read failed: {e}")
+                row = None
+            if row is not None:
+                entry = (json.loads(row[0]) if row[0] is not None else None, row[1])
+                self._remember(key, *entry)
+        if entry is None or self._expired(entry[0], entry[1], now):
+            return _MISSING
+        return entry[0]
+
+    def _store(self, key: str, result: GeocodeResult) -> None:
+        fetched_at = time.time()
+        self._remember(key, result, fetched_at)
+        if self._conn is None:
+            return
+        try:
+            with self._db_lock:
+                self._conn.execute(
+                    "INSERT OR REPLACE INTO geocode_cache (query_key, result_json, fetched_at) VALUES (?, ?, ?)",
+                    (key, json.dumps(result) if result is not None else None, fetched_at),
+                )
+                self._conn.commit()
+        except sqlite3.Error as e:
+            logger.warning(f"Geocode cache write failed: {e}")
+
+    def get_or_fetch(self, query: str, fetch: GeocodeFetcher) -> GeocodeResult:
+        """Cached result for query, fetching (once across threads) on a miss."""
+        key = normalize_query(query)
+        if not key:
+            return None
+
+        cached = self._lookup(key)
+        if cached is not _MISSING:
+            return cached
+
+        with self._lock:
+            flight = self._in_flight.get(key)
+            leader = flight is None
+            if leader:
+                flight = _InFlight()
+                self._in_flight[key] = flight
+
+        if not leader:
+            flight.done.wait()
+            if flight.error is not None:
+                raise flight.error
+            return flight.result
+
+        try:
+            flight.result = fetch(query)
+            self._store(key, flight.result)
+            return flight.result
+        except BaseException as e:
+            flight.error = e
+            raise
+        finally:
+            with self._lock:
+                self._in_flight.pop(key, None)
+            flight.done.set()
+
+    def purge_expired(self) -> int:
+        """Delete expired rows from the database. Returns the number removed."""
+        if self._conn is None:
+            return 0
+        now = time.time()
+        with self._db_lock:
+            cursor = self._conn.execute(
+                """
+                DELETE FROM geocode_cache
+                WHERE (result_json IS NOT NULL AND fetched_at < ?)
+                   OR (result_json IS NULL AND fetched_at < ?)
+                """,
+                (now - self.ttl_s, now - self.negative_ttl_s),
+            )
+            self._conn.commit()
+        return cursor.rowcount
+
+
+_cache: Optional[GeocodeCache] = None
+_cache_lock = threading.Lock()
+
+
+def get_geocode_cache() -> GeocodeCache:
+    """Process-wide geocode cache (created on first use)."""
+    global _cache
+    if _cache is None:
+        with _cache_lock:
+            if _cache is None:
+                _cache = GeocodeCache(default_cache_path())
+    return _cache
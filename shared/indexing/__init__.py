@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+"""
+Derived in-memory indexes over the airports model.
+"""
+from .aip_field_index import AipFieldIndex
+from .feature_table import AirportFeatureTable, NumericColumn
+from .model_statistics import ModelStatistics
+from .model_indexes import ModelIndexes, get_model_indexes, invalidate_model_indexes, register_model_indexes
+from .procedure_lines import ProcedureLineCache
+from .search_index import AirportSearchIndex
+from .spatial_index import AirportSpatialIndex
+
+__all__ = [
+    "ModelIndexes",
+    "ModelStatistics",
+    "get_model_indexes",
+    "invalidate_model_indexes",
+    "register_model_indexes",
+    "AirportSpatialIndex",
+    "AirportFeatureTable",
+    "NumericColumn",
+    "AipFieldIndex",
+    "ProcedureLineCache",
+    "AirportSearchIndex",
+]
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+Inverted index over AIP entries, keyed by standardized field.
+
+Built once per model: every entry value is lowercased and classified at load time
+(negative values such as "nil" / "n/a" are dropped, AVGAS mentions are flagged),
+then indexed by exact value, sorted prefix/suffix and trigrams. AIP field filters
+(`aip_field` / `aip_value` / `aip_operator`) become lookups returning the set of
+matching ICAO codes instead of a scan over every airport's entries.
+"""
+import bisect
+import logging
+import threading
+from collections import OrderedDict
+from typing import Any, Dict, FrozenSet, Iterable, List, Optional, Set, Tuple
+
+from euro_aip.models.airport import Airport
+
+logger = logging.getLogger(__name__)
+
+# Entry values meaning "not available"; such entries never match
+NEGATIVE_VALUES = frozenset(["nil", "none", "na", "n/a", "no", "not available", "unavailable"])
+
+# Fields where an "avgas" search also matches 100LL spellings
+FUEL_FIELDS = frozenset(["fuel and oil types", "fuel types", "fuel"])
+AVGAS_TERMS = ("avgas", "100ll", "100 ll", "100/ll")
+
+OPERATORS = ("contains", "equals", "not_empty", "starts_with", "ends_with")
+
+# Distinct (field, value, operator) results kept in memory
+MAX_CACHED_QUERIES = 256
+
+TRIGRAM = 3
+
+
+def _trigrams(text: str) -> Set[str]:
+    return {text[i:i + TRIGRAM] for i in range(len(text) - TRIGRAM + 1)}
+
+
+class _FieldIndex:
+    """Index of the (non-negative) values of one std_field."""
+
+    def __init__(self, field_name: str, values: Dict[str, Set[str]]):
+        # value -> ICAOs having an entry with that (lowercased) value
+        self.by_value: Dict[str, FrozenSet[str]] = {v: frozenset(icaos) for v, icaos in values.items()}
+        self.sorted_values: List[str] = sorted(self.by_value)
+        self._reversed: List[Tuple[str, str]] = sorted((v[::-1], v) for v in self.by_value)
+        self._reversed_keys: List[str] = [r for r, _ in self._reversed]
+
+        self.trigrams: Dict[str, Set[str]] = {}
+        for value in self.by_value:
+            for gram in _trigrams(value):
+                self.trigrams.setdefault(gram, set()).add(value)
+
+        self.not_empty: FrozenSet[str] = self._icaos(v for v in self.by_value if v)
+        self.avgas: Optional[FrozenSet[str]] = None
+        if field_name.lower() in FUEL_FIELDS:
+            self.avgas = self._icaos(v for v in self.by_value if any(term in v for term in AVGAS_TERMS))
+
+    def _icaos(self, values: Iterable[str]) -> FrozenSet[str]:
+        result: Set[str] = set()
+        for value in values:
+            result |= self.by_value[value]
+        return frozenset(result)
+
+    def _prefix_values(self, keys: List[str], prefix: str) -> range:
+        start = bisect.bisect_left(keys, prefix)
+        # "\U0010ffff" sorts after any character that can follow the prefix
+        end = bisect.bisect_left(keys, prefix + "\U0010ffff")
+        return range(start, end)
+
+    def contains(self, search: str) -> FrozenSet[str]:
+        if len(search) < TRIGRAM:
+            return self._icaos(v for v in self.sorted_values if search in v)
+        grams = sorted(_trigrams(search), key=lambda g: len(self.trigrams.get(g, ())))
+        candidates = set(self.trigrams.get(grams[0], ()))
+        for gram in grams[1:]:
+            if not candidates:
+                break
+            candidates &= self.trigrams.get(gram, set())
+        return self._icaos(v for v in candidates if search in v)
+
+    def starts_with(self, prefix: str) -> FrozenSet[str]:
+        rows = self._prefix_values(self.sorted_values, prefix)
+        return self._icaos(self.sorted_values[i] for i in rows)
+
+    def ends_with(self, suffix: str) -> FrozenSet[str]:
+        rows = self._prefix_values(self._reversed_keys, suffix[::-1])
+        return self._icaos(self._reversed[i][1] for i in rows)
+
+
+class AipFieldIndex:
+    """
+    Per-std_field inverted index over airport AIP entries.
+
+    Usage:
+        index = get_model_indexes(model).aip_fields
+        icaos = index.match("Fuel and oil types", "avgas", "contains")
+        airports = [a for a in airports if a.ident in icaos]
+
+    Matching semantics (same as the former per-airport scan):
+        - only entries whose std_field equals field_name are considered
+        - values are compared lowercased; negative values ("nil", "n/a", ...) never match
+        - contains: substring; "avgas" on fuel fields also matches 100LL spellings
+        - equals / starts_with / ends_with: on the whole lowercased value
+        - not_empty: any non-empty, non-negative value
+        - unknown operators match nothing
+    """
+
+    def __init__(self, airports: Iterable[Airport]):
+        values: Dict[str, Dict[str, Set[str]]] = {}
+        entry_count = 0
+        for airport in airports:
+            for entry in getattr(airport, "aip_entries", None) or []:
+                field_name = getattr(entry, "std_field", None)
+                if not field_name:
+                    continue
+                value = entry.value.lower() if entry.value else ""
+                entry_count += 1
+                if value in NEGATIVE_VALUES:
+                    continue
+                values.setdefault(field_name, {}).setdefault(value, set()).add(airport.ident)
+
+        self._fields: Dict[str, _FieldIndex] = {name: _FieldIndex(name, v) for name, v in values.items()}
+        self._cache: "OrderedDict[Tuple[str, str, str], FrozenSet[str]]" = OrderedDict()
+        self._lock = threading.Lock()
+
+        logger.info(f"AIP field index built: {entry_count} entries over {len(self._fields)} fields")
+
+    def __getstate__(self) -> Dict[str, Any]:
+        # Query cache and lock are per process
+        state = self.__dict__.copy()
+        del state["_lock"]
+        state["_cache"] = OrderedDict()
+        return state
+
+    def __setstate__(self, state: Dict[str, Any]) -> None:
+        self.__dict__.update(state)
+        self._lock = threading.Lock()
+
+    @property
+    def fields(self) -> List[str]:
+        """Indexed std_field names."""
+        return sorted(self._fields)
+
+    def match(self, field_name: str, value: Optional[str] = None, operator: str = "contains") -> FrozenSet[str]:
+        """ICAO codes of airports matching the AIP field criteria."""
+        search = value.lower() if value else ""
+        key = (field_name, search, operator)
+        with self._lock:
+            if key in self._cache:
+                self._cache.move_to_end(key)
+                return self._cache[key]
+
+        result = self._match(field_name, search, operator)
+
+        with self._lock:
+            self._cache[key] = result
+            while len(self._cache) > MAX_CACHED_QUERIES:
+                self._cache.popitem(last=False)
+        return result
+
+    def _match(self, field_name: str, search: str, operator: str) -> FrozenSet[str]:
+        field = self._fields.get(field_name)
+        if field is None:
+            return frozenset()
+
+        if operator == "contains":
+            if search == "avgas" and field.avgas is not None:
+                return field.avgas
+            return field.contains(search)
+        if operator == "equals":
+            return field.by_value.get(search, frozenset())
+        if operator == "not_empty":
+            return field.not_empty
+        if operator == "starts_with":
+            return field.starts_with(search)
+        if operator == "ends_with":
+            return field.ends_with(search)
+        return frozenset()
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+"""
+Column-oriented feature table for vectorized airport filtering.
+
+Every airport of the model gets a fixed row position. Boolean attributes are
+stored as bitsets (Python ints, bit i = row i), so combining filters is a handful
+of big-int AND/OR operations instead of a Python loop over airports. Numeric
+attributes (runway length, landing fee) are stored sorted so threshold
+comparisons turn into a bisect plus a cached bitset.
+"""
+import bisect
+import logging
+import threading
+from collections import OrderedDict
+from typing import Any, Callable, Dict, Iterable, List, Tuple
+
+from euro_aip.models.airport import Airport
+
+logger = logging.getLogger(__name__)
+
+# Distinct thresholds cached per numeric column (users only ever pick a few)
+MAX_CACHED_THRESHOLDS = 64
+
+Bitset = int
+
+
+def rows_to_bitset(rows: Iterable[int]) -> Bitset:
+    """Build a bitset from row positions in linear time."""
+    rows = list(rows)
+    if not rows:
+        return 0
+    buffer = bytearray(max(rows) // 8 + 1)
+    for row in rows:
+        buffer[row >> 3] |= 1 << (row & 7)
+    return int.from_bytes(buffer, "little")
+
+
+def bitset_membership(mask: Bitset) -> Callable[[int], bool]:
+    """
+    O(1) row membership test for a mask.
+
+    One linear-time to_bytes copy, then a byte lookup per row: no big-int
+    allocation per test and no decoding of every set bit.
+    """
+    if mask <= 0:
+        return lambda row: False
+    buffer = mask.to_bytes((mask.bit_length() + 7) // 8, "little")
+    size = len(buffer)
+
+    def contains(row: int) -> bool:
+        index = row >> 3
+        return index < size and (buffer[index] >> (row & 7)) & 1 == 1
+
+    return contains
+
+
+def bitset_indices(mask: Bitset) -> List[int]:
+    """Row positions of the set bits, ascending."""
+    if mask <= 0:
+        return []
+    bits = bin(mask)[:1:-1]  # least significant bit first, without the "0b" prefix
+    indices: List[int] = []
+    i = bits.find("1")
+    while i != -1:
+        indices.append(i)
+        i = bits.find("1", i + 1)
+    return indices
+
+
+class NumericColumn:
+    """
+    Sorted numeric column supporting threshold masks.
+
+    Rows without a value are excluded from both `at_most` and `at_least`;
+    `present` is the mask of rows that have a value.
+    """
+
+    def __init__(self, values: Iterable[Tuple[int, float]]):
+        pairs = sorted((float(value), row) for row, value in values)
+        self._values = [value for value, _ in pairs]
+        self._rows = [row for _, row in pairs]
+        self.present: Bitset = rows_to_bitset(self._rows)
+        self._cache: "OrderedDict[Tuple[str, float], Bitset]" = OrderedDict()
+        self._lock = threading.Lock()
+
+    def __getstate__(self) -> Dict[str, Any]:
+        # Threshold cache and lock are per process
+        state = self.__dict__.copy()
+        del state["_lock"]
+        state["_cache"] = OrderedDict()
+        return state
+
+    def __setstate__(self, state: Dict[str, Any]) -> None:
+        self.__dict__.update(state)
+        self._lock = threading.Lock()
+
+    def __len__(self) -> int:
+        return len(self._values)
+
+    def _cached(self, key: Tuple[str, float], build: Callable[[], Bitset]) -> Bitset:
+        with self._lock:
+            if key in self._cache:
+                self._cache.move_to_end(key)
+                return self._cache[key]
+        mask = build()
+        with self._lock:
+            self._cache[key] = mask
+            while len(self._cache) > MAX_CACHED_THRESHOLDS:
+                self._cache.popitem(last=False)
+        return mask
+
+    def at_most(self, threshold: float) -> Bitset:
+        """Rows with value <= threshold."""
+        threshold = float(threshold)
+        return self._cached(
+            ("le", threshold),
+            lambda: rows_to_bitset(self._rows[:bisect.bisect_right(self._values, threshold)]),
+        )
+
+    def at_least(self, threshold: float) -> Bitset:
+        """Rows with value >= threshold."""
+        threshold = float(threshold)
+        return self._cached(
+            ("ge", threshold),
+            lambda: rows_to_bitset(self._rows[bisect.bisect_left(self._values, threshold):]),
+        )
+
+
+class AirportFeatureTable:
+    """
+    Startup-built feature table over all airports of a model.
+
+    Usage:
+        table = get_model_indexes(model).features
+        mask = table.column("has_hard_runway") & table.country_mask("FR")
+        mask &= table.runway_length.at_least(3000)
+        airports = table.airports_for(mask)
+    """
+
+    # Boolean columns: name -> extractor
+    BOOLEAN_COLUMNS: Dict[str, Callable[[Airport], bool]] = {
+        "has_procedures": lambda a: bool(a.procedures),
+        "has_aip_data": lambda a: bool(a.aip_entries),
+        "has_hard_runway": lambda a: bool(getattr(a, "has_hard_runway", False)),
+        "point_of_entry": lambda a: bool(getattr(a, "point_of_entry", False)),
+        "large_airport": lambda a: (getattr(a, "type", "") or "").lower() == "large_airport",
+        "avgas": lambda a: bool(getattr(a, "avgas", False)),
+        "jet_a": lambda a: bool(getattr(a, "jet_a", False)),
+    }
+
+    def __init__(self, airports: Iterable[Airport]):
+        self.airports: List[Airport] = list(airports)
+        self.positions: Dict[str, int] = {}
+        for row, airport in enumerate(self.airports):
+            self.positions.setdefault(airport.ident, row)
+        self.all_mask: Bitset = (1 << len(self.airports)) - 1
+
+        column_rows: Dict[str, List[int]] = {name: [] for name in self.BOOLEAN_COLUMNS}
+        country_rows: Dict[str, List[int]] = {}
+        runway_lengths: List[Tuple[int, float]] = []
+
+        for row, airport in enumerate(self.airports):
+            for name, extractor in self.BOOLEAN_COLUMNS.items():
+                try:
+                    if extractor(airport):
+                        column_rows[name].append(row)
+                except Exception:
+                    pass  # Missing attribute - leave bit unset
+            country = (airport.iso_country or "").upper()
+            country_rows.setdefault(country, []).append(row)
+            length = getattr(airport, "longest_runway_length_ft", None)
+            if length is not None:
+                runway_lengths.append((row, length))
+
+        self._columns: Dict[str, Bitset] = {name: rows_to_bitset(rows) for name, rows in column_rows.items()}
+        self._countries: Dict[str, Bitset] = {code: rows_to_bitset(rows) for code, rows in country_rows.items()}
+        self.runway_length = NumericColumn(runway_lengths)
+
+        # Landing fee columns depend on the GA service and its data, built on first use
+        self._fee_columns: Dict[Tuple[int, int], Tuple[Any, str, NumericColumn]] = {}
+        self._fee_lock = threading.Lock()
+
+        logger.info(
+            f"Feature table built: {len(self.airports)} airports, "
+            f"{len(self._columns)} boolean columns, {len(self._countries)} countries"
+        )
+
+    def __getstate__(self) -> Dict[str, Any]:
+        # Fee columns reference the GA service; rebuilt on first use
+        state = self.__dict__.copy()
+        del state["_fee_lock"]
+        state["_fee_columns"] = {}
+        return state
+
+    def __setstate__(self, state: Dict[str, Any]) -> None:
+        self.__dict__.update(state)
+        self._fee_lock = threading.Lock()
+
+    def __len__(self) -> int:
+        return len(self.airports)
+
+    def column(self, name: str) -> Bitset:
+        """Bitset for a boolean column (KeyError if unknown)."""
+        return self._columns[name]
+
+    def country_mask(self, country_code: str) -> Bitset:
+        """Rows whose iso_country matches (case-insensitive)."""
+        return self._countries.get(str(country_code).upper(), 0)
+
+    def mask_for_idents(self, idents: Iterable[str]) -> Bitset:
+        """Rows for a set of ICAO codes (unknown codes ignored)."""
+        positions = self.positions
+        return rows_to_bitset(positions[ident] for ident in idents if ident in positions)
+
+    def landing_fee(self, ga_service, mtow_kg: int) -> NumericColumn:
+        """
+        Landing fee column for an aircraft weight.
+
+        Cached per GA service and its data_version, so a GA database reload
+        rebuilds the column; services without a stable version (writable
+        databases) are queried on every call. Rows without fee data for the
+        weight band are absent from the column.
+        """
+        version = getattr(ga_service, "data_version", None)
+        if version is None:
+            return self._build_fee_column(ga_service, mtow_kg)
+        key = (id(ga_service), int(mtow_kg))
+        entry = self._fee_columns.get(key)
+        if entry is None or entry[0] is not ga_service or entry[1] != version:
+            with self._fee_lock:
+                entry = self._fee_columns.get(key)
+                if entry is None or entry[0] is not ga_service or entry[1] != version:
+                    entry = (ga_service, version, self._build_fee_column(ga_service, mtow_kg))
+                    self._fee_columns[key] = entry
+        return entry[2]
+
+    def _build_fee_column(self, ga_service, mtow_kg: int) -> NumericColumn:
+        fees = ga_service.get_landing_fees_by_weight(mtow_kg)
+        return NumericColumn(
+            (self.positions[icao], fee)
+            for icao, fee in fees.items()
+            if icao in self.positions
+        )
+
+    def indices(self, mask: Bitset) -> List[int]:
+        """Row positions selected by a mask."""
+        return bitset_indices(mask & self.all_mask)
+
+    def airports_for(self, mask: Bitset) -> List[Airport]:
+        """Airports selected by a mask, in model order."""
+        return [self.airports[row] for row in self.indices(mask)]
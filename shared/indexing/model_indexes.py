@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+Per-model registry of derived indexes.
+
+The airports model is static once loaded, so indexes are built once per model
+instance and shared by every caller (web API routes, shared tools, MCP server).
+Indexes are built lazily on first access; servers call `warm()` at startup so the
+first request does not pay the build cost.
+"""
+import logging
+import threading
+from typing import Any, Dict, List, Optional, Sequence
+
+from euro_aip.models.airport import Airport
+from euro_aip.models.euro_aip_model import EuroAipModel
+
+from .aip_field_index import AipFieldIndex
+from .feature_table import AirportFeatureTable
+from .model_statistics import ModelStatistics
+from .procedure_lines import ProcedureLineCache
+from .route_corridor import AirportPredicate, RouteItem, find_airports_near_route
+from .search_index import AirportSearchIndex
+from .spatial_index import AirportSpatialIndex
+
+logger = logging.getLogger(__name__)
+
+
+class ModelIndexes:
+    """
+    Lazily built indexes for one EuroAipModel instance.
+
+    Usage:
+        indexes = get_model_indexes(model)
+        airports = indexes.spatial.within_bbox(north, south, east, west)
+    """
+
+    def __init__(self, model: EuroAipModel):
+        self.model = model
+        self._lock = threading.Lock()
+        self._spatial: Optional[AirportSpatialIndex] = None
+        self._features: Optional[AirportFeatureTable] = None
+        self._aip_fields: Optional[AipFieldIndex] = None
+        self._by_ident: Optional[Dict[str, Airport]] = None
+        self._search: Optional[AirportSearchIndex] = None
+        self._statistics: Optional[ModelStatistics] = None
+        self.procedure_lines = ProcedureLineCache()
+
+    def __getstate__(self) -> Dict[str, Any]:
+        # Pickled into model snapshots: built indexes only, no lock or geometry cache
+        state = self.__dict__.copy()
+        del state["_lock"]
+        del state["procedure_lines"]
+        return state
+
+    def __setstate__(self, state: Dict[str, Any]) -> None:
+        self.__dict__.update(state)
+        self._lock = threading.Lock()
+        self.procedure_lines = ProcedureLineCache()
+
+    @property
+    def spatial(self) -> AirportSpatialIndex:
+        """Spatial index over airport navpoints."""
+        if self._spatial is None:
+            with self._lock:
+                if self._spatial is None:
+                    self._spatial = AirportSpatialIndex(self.model.airports)
+        return self._spatial
+
+    @property
+    def features(self) -> AirportFeatureTable:
+        """Column-oriented feature table for vectorized filtering."""
+        if self._features is None:
+            with self._lock:
+                if self._features is None:
+                    self._features = AirportFeatureTable(self.model.airports)
+        return self._features
+
+    @property
+    def aip_fields(self) -> AipFieldIndex:
+        """Inverted index over AIP entries for aip_field / aip_value filters."""
+        if self._aip_fields is None:
+            with self._lock:
+                if self._aip_fields is None:
+                    self._aip_fields = AipFieldIndex(self.model.airports)
+        return self._aip_fields
+
+    @property
+    def search(self) -> AirportSearchIndex:
+        """Ranked typeahead search over codes, names and municipalities."""
+        if self._search is None:
+            with self._lock:
+                if self._search is None:
+                    self._search = AirportSearchIndex(self.model.airports)
+        return self._search
+
+    @property
+    def statistics(self) -> ModelStatistics:
+        """Dataset-wide aggregates for the statistics and filter-option endpoints."""
+        if self._statistics is None:
+            with self._lock:
+                if self._statistics is None:
+                    self._statistics = ModelStatistics(self.model.airports)
+        return self._statistics
+
+    @property
+    def by_ident(self) -> Dict[str, Airport]:
+        """ICAO code -> airport."""
+        if self._by_ident is None:
+            with self._lock:
+                if self._by_ident is None:
+                    self._by_ident = {airport.ident: airport for airport in self.model.airports}
+        return self._by_ident
+
+    def airport(self, icao: str) -> Optional[Airport]:
+        """Airport by ICAO code (case-insensitive), or None."""
+        return self.by_ident.get(icao.strip().upper())
+
+    def find_airports_near_route(
+        self,
+        route: Sequence[RouteItem],
+        distance_nm: float,
+        candidate_filter: Optional[AirportPredicate] = None,
+    ) -> List[Dict[str, Any]]:
+        """Corridor search along a route (see route_corridor.find_airports_near_route)."""
+        return find_airports_near_route(self, route, distance_nm, candidate_filter)
+
+    def warm(self) -> "ModelIndexes":
+        """Build all indexes now (call once the model is final, e.g. in lifespan)."""
+        _ = self.spatial
+        _ = self.features
+        _ = self.aip_fields
+        _ = self.by_ident
+        _ = self.search
+        _ = self.statistics
+        return self
+
+
+_registry: Dict[int, ModelIndexes] = {}
+_registry_lock = threading.Lock()
+
+
+def get_model_indexes(model: EuroAipModel) -> ModelIndexes:
+    """Get (or create) the shared indexes for a model instance."""
+    key = id(model)
+    indexes = _registry.get(key)
+    # Guard against id() reuse after a previous model was garbage collected
+    if indexes is None or indexes.model is not model:
+        with _registry_lock:
+            indexes = _registry.get(key)
+            if indexes is None or indexes.model is not model:
+                indexes = ModelIndexes(model)
+                _registry[key] = indexes
+    return indexes
+
+
+def register_model_indexes(indexes: ModelIndexes) -> None:
+    """Use prebuilt indexes (e.g. from a model snapshot) for their model."""
+    with _registry_lock:
+        _registry[id(indexes.model)] = indexes
+
+
+def invalidate_model_indexes(model: EuroAipModel) -> None:
+    """
+    Drop cached indexes for a model.
+
+    Call after mutating the model (e.g. remove_airports_by_country) if indexes
+    may already have been built.
+    """
+    with _registry_lock:
+        indexes = _registry.get(id(model))
+        if indexes is not None and indexes.model is model:
+            del _registry[id(model)]
+            logger.debug("Invalidated model indexes")
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""
+Dataset-wide aggregates over the airports model.
+
+The statistics dashboards and filter options (/api/statistics/*, /api/filters/*)
+only change with a new airports.db, so all of their counts are computed in one
+pass when the model is indexed (and pickled with the model snapshot, see
+model_snapshot.py). Payloads have exactly the shape the endpoints return.
+
+`version` hashes every payload, so it is identical across workers serving the
+same data and changes whenever any aggregate does; HTTP caches key on it.
+"""
+import hashlib
+import json
+import logging
+from collections import Counter
+from typing import Any, Dict, Iterable, List
+
+from euro_aip.models.airport import Airport
+
+logger = logging.getLogger(__name__)
+
+# Runway length categories of the length distribution: (name, min inclusive, max exclusive)
+LENGTH_CATEGORIES = (
+    ("Short (< 3000 ft)", 0, 3000),
+    ("Medium (3000-6000 ft)", 3000, 6000),
+    ("Long (6000-9000 ft)", 6000, 9000),
+    ("Very Long (> 9000 ft)", 9000, float("inf")),
+)
+
+
+def _counts(counter: Counter, key: str) -> List[Dict[str, Any]]:
+    """[{key: value, "count": n}] sorted by value."""
+    return [{key: value, "count": count} for value, count in sorted(counter.items())]
+
+
+def _range(values: List[int]) -> Dict[str, Any]:
+    return {
+        "min": min(values) if values else None,
+        "max": max(values) if values else None,
+        "average": sum(values) / len(values) if values else None,
+        "count": len(values),
+    }
+
+
+def _coverage(count: int, total: int) -> Dict[str, Any]:
+    return {"count": count, "percentage": round((count / total) * 100, 1) if total else 0.0}
+
+
+def length_distribution(lengths: List[int]) -> List[Dict[str, Any]]:
+    """Runway length distribution in categories (empty categories omitted)."""
+    distribution = []
+    for name, low, high in LENGTH_CATEGORIES:
+        count = sum(1 for length in lengths if low <= length < high)
+        if count > 0:
+            distribution.append({
+                "category": name,
+                "count": count,
+                "percentage": round((count / len(lengths)) * 100, 1),
+            })
+    return distribution
+
+
+class ModelStatistics:
+    """
+    Aggregates computed once per model.
+
+    Usage:
+        stats = get_model_indexes(model).statistics
+        stats.by_country, stats.runway_statistics, stats.country_counts
+    """
+
+    def __init__(self, airports: Iterable[Airport]):
+        by_country: Dict[str, Counter] = {}
+        country_counts: Counter = Counter()
+        procedure_types: Counter = Counter()
+        approach_types: Counter = Counter()
+        sections: Counter = Counter()
+        fields: Counter = Counter()
+        entry_sources: Counter = Counter()
+        airport_sources: Counter = Counter()
+        lengths: List[int] = []
+        widths: List[int] = []
+        surfaces: Counter = Counter()
+        lighting: Counter = Counter()
+        lighted_only: Counter = Counter()
+        coverage: Counter = Counter()
+        total_airports = 0
+
+        for airport in airports:
+            total_airports += 1
+            if airport.iso_country:
+                country_counts[airport.iso_country] += 1
+
+            country = by_country.setdefault(airport.iso_country or "Unknown", Counter())
+            country["total_airports"] += 1
+            if airport.procedures:
+                country["airports_with_procedures"] += 1
+                country["total_procedures"] += len(airport.procedures)
+            if airport.runways:
+                country["airports_with_runways"] += 1
+                country["total_runways"] += len(airport.runways)
+            if airport.aip_entries:
+                country["airports_with_aip_data"] += 1
+                country["total_aip_entries"] += len(airport.aip_entries)
+            if airport.point_of_entry:
+                country["border_crossing_airports"] += 1
+
+            for procedure in airport.procedures:
+                procedure_types[procedure.procedure_type.lower()] += 1
+                if procedure.is_approach() and procedure.approach_type:
+                    approach_types[procedure.approach_type.upper()] += 1
+
+            for entry in airport.aip_entries:
+                sections[entry.section] += 1
+                if entry.std_field:
+                    fields[entry.std_field] += 1
+                if entry.source:
+                    entry_sources[entry.source] += 1
+
+            for source in airport.sources:
+                airport_sources[source] += 1
+
+            for runway in airport.runways:
+                if runway.length_ft:
+                    lengths.append(runway.length_ft)
+                if runway.width_ft:
+                    widths.append(runway.width_ft)
+                if runway.surface:
+                    surfaces[runway.surface.lower()] += 1
+                if runway.lighted is not None:
+                    lighting["lighted" if runway.lighted else "unlighted"] += 1
+                if runway.lighted:
+                    lighted_only["lighted"] += 1
+
+            has_coordinates = airport.latitude_deg is not None and airport.longitude_deg is not None
+            flags = {
+                "coordinates": has_coordinates,
+                "runways": len(airport.runways) > 0,
+                "procedures": len(airport.procedures) > 0,
+                "aip_data": len(airport.aip_entries) > 0,
+            }
+            for name, present in flags.items():
+                if present:
+                    coverage[name] += 1
+            if all(flags.values()):
+                coverage["complete_data"] += 1
+
+        country_fields = (
+            "total_airports", "airports_with_procedures", "airports_with_runways", "airports_with_aip_data",
+            "border_crossing_airports", "total_procedures", "total_runways", "total_aip_entries",
+        )
+        self.by_country: List[Dict[str, Any]] = [
+            {"country": code, **{name: counts[name] for name in country_fields}}
+            for code, counts in sorted(by_country.items())
+        ]
+        self.country_counts: Dict[str, int] = dict(country_counts)
+        self.procedure_types = _counts(procedure_types, "type")
+        self.procedure_distribution = {
+            "procedure_types": self.procedure_types,
+            "approach_types": _counts(approach_types, "type"),
+        }
+        self.aip_sections = _counts(sections, "section")
+        self.aip_fields = _counts(fields, "field")
+        self.aip_data_distribution = {
+            "sections": self.aip_sections,
+            "fields": self.aip_fields,
+            "sources": _counts(entry_sources, "source"),
+        }
+        self.sources = _counts(airport_sources, "source")
+        self.runway_statistics = {
+            "lengths": {**_range(lengths), "distribution": length_distribution(lengths)},
+            "widths": _range(widths),
+            "surfaces": _counts(surfaces, "surface"),
+            "lighting": _counts(lighting, "lighting"),
+        }
+        # Filter options only ever listed lighted runways
+        self.runway_characteristics = {
+            "lengths": _range(lengths),
+            "surfaces": self.runway_statistics["surfaces"],
+            "lighting": _counts(lighted_only, "lighting"),
+        }
+        self.data_quality = {
+            "total_airports": total_airports,
+            "coverage": {
+                name: _coverage(coverage[name], total_airports)
+                for name in ("coordinates", "runways", "procedures", "aip_data", "complete_data")
+            },
+        }
+
+        digest = hashlib.sha1()
+        for payload in (
+            self.by_country, self.country_counts, self.procedure_distribution,
+            self.aip_data_distribution, self.sources, self.runway_statistics,
+            self.runway_characteristics, self.data_quality,
+        ):
+            digest.update(json.dumps(payload, sort_keys=True).encode("utf-8"))
+        self.version: str = digest.hexdigest()[:16]
+        logger.info(f"Model statistics computed for {total_airports} airports (version {self.version})")
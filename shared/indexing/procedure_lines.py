@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""
+Memoized procedure-line geometry.
+
+`Airport.get_procedure_lines(distance_nm)` recomputes approach lines from
+runway ends and procedures on every call. The model is static, so results are
+cached per (ICAO, distance). Misses are computed inline: the geometry is
+pure-Python CPU work, so threads would only add GIL contention.
+"""
+import logging
+import threading
+from collections import OrderedDict
+from typing import Any, Dict, Iterable, List, Optional, Tuple
+
+from euro_aip.models.airport import Airport
+
+logger = logging.getLogger(__name__)
+
+# (icao, distance) entries kept; a few thousand airports have procedures and the
+# map only requests a handful of distances
+MAX_CACHED_PROCEDURE_LINES = 20000
+
+CacheKey = Tuple[str, float]
+
+
+def _cache_key(icao: str, distance_nm: float) -> CacheKey:
+    # Distances come from query/body floats; 0.01 NM is far below line precision
+    return icao.upper(), round(float(distance_nm), 2)
+
+
+class ProcedureLineCache:
+    """
+    LRU cache of `get_procedure_lines` results for one model.
+
+    Cached results are shared between requests and must be treated as read-only.
+
+    Usage:
+        lines, errors = indexes.procedure_lines.get_many(airports, 10.0)
+    """
+
+    def __init__(self, max_entries: int = MAX_CACHED_PROCEDURE_LINES):
+        self.max_entries = max_entries
+        self._entries: "OrderedDict[CacheKey, Dict[str, Any]]" = OrderedDict()
+        self._lock = threading.Lock()
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+    def _lookup(self, key: CacheKey) -> Optional[Dict[str, Any]]:
+        with self._lock:
+            result = self._entries.get(key)
+            if result is not None:
+                self._entries.move_to_end(key)
+            return result
+
+    def _store(self, key: CacheKey, result: Dict[str, Any]) -> None:
+        with self._lock:
+            self._entries[key] = result
+            self._entries.move_to_end(key)
+            while len(self._entries) > self.max_entries:
+                self._entries.popitem(last=False)
+
+    def get(self, airport: Airport, distance_nm: float) -> Dict[str, Any]:
+        """Procedure lines for one airport (computed on a miss)."""
+        key = _cache_key(airport.ident, distance_nm)
+        result = self._lookup(key)
+        if result is None:
+            result = airport.get_procedure_lines(key[1])
+            self._store(key, result)
+        return result
+
+    def get_many(
+        self,
+        airports: Iterable[Airport],
+        distance_nm: float,
+    ) -> Tuple[Dict[str, Dict[str, Any]], Dict[str, Exception]]:
+        """
+        Procedure lines for many airports.
+
+        Returns:
+            (results, errors): ICAO -> procedure lines, and ICAO -> exception for
+            airports whose computation failed (not cached, retried next time)
+        """
+        results: Dict[str, Dict[str, Any]] = {}
+        misses: List[Tuple[CacheKey, Airport]] = []
+        for airport in airports:
+            key = _cache_key(airport.ident, distance_nm)
+            cached = self._lookup(key)
+            if cached is not None:
+                results[key[0]] = cached
+            else:
+                misses.append((key, airport))
+
+        errors: Dict[str, Exception] = {}
+        if not misses:
+            return results, errors
+        hits = len(results)
+
+        for key, airport in misses:
+            try:
+                result = airport.get_procedure_lines(key[1])
+            except Exception as e:
+                errors[key[0]] = e
+                continue
+            self._store(key, result)
+            results[key[0]] = result
+
+        logger.debug(f"Procedure lines: {hits} cached, {len(misses)} computed, {len(errors)} failed")
+        return results, errors
+
+    def clear(self) -> None:
+        """Drop all cached results."""
+        with self._lock:
+            self._entries.clear()
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+Route corridor search backed by the spatial index.
+
+Each route leg is covered by a chain of padded circles along its great circle, so
+only airports in the grid cells near the route are considered. Exact cross-track
+distance to the leg is then computed for those candidates only.
+"""
+import math
+from dataclasses import dataclass
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple, Union, TYPE_CHECKING
+
+from euro_aip.models.airport import Airport
+from euro_aip.models.navpoint import NavPoint
+
+if TYPE_CHECKING:
+    from .model_indexes import ModelIndexes
+
+# Mean earth radius in nautical miles
+EARTH_RADIUS_NM = 3440.065
+
+# Spacing between coverage circles along a leg. The coverage radius is
+# corridor + spacing / 2, so any point within the corridor is inside a circle.
+MAX_COVERAGE_STEP_NM = 60.0
+
+RouteItem = Union[str, NavPoint]
+AirportPredicate = Callable[[Airport], bool]
+
+
+@dataclass(frozen=True)
+class _RoutePoint:
+    name: str
+    lat: float  # radians
+    lon: float  # radians
+
+
+def _angular_distance(lat1: float, lon1: float, lat2: float, lon2: float) -> float:
+    """Great-circle angular distance (radians) between two points given in radians."""
+    sin_dlat = math.sin((lat2 - lat1) / 2.0)
+    sin_dlon = math.sin((lon2 - lon1) / 2.0)
+    a = sin_dlat * sin_dlat + math.cos(lat1) * math.cos(lat2) * sin_dlon * sin_dlon
+    return 2.0 * math.asin(min(1.0, math.sqrt(a)))
+
+
+def _bearing(lat1: float, lon1: float, lat2: float, lon2: float) -> float:
+    """Initial great-circle bearing (radians) from point 1 to point 2."""
+    dlon = lon2 - lon1
+    y = math.sin(dlon) * math.cos(lat2)
+    x = math.cos(lat1) * math.sin(lat2) - math.sin(lat1) * math.cos(lat2) * math.cos(dlon)
+    return math.atan2(y, x)
+
+
+def _intermediate_point(start: _RoutePoint, end: _RoutePoint, d12: float, fraction: float) -> Tuple[float, float]:
+    """Point (degrees) at `fraction` along the great circle from start to end."""
+    if d12 == 0.0:
+        return math.degrees(start.lat), math.degrees(start.lon)
+    a = math.sin((1.0 - fraction) * d12) / math.sin(d12)
+    b = math.sin(fraction * d12) / math.sin(d12)
+    x = a * math.cos(start.lat) * math.cos(start.lon) + b * math.cos(end.lat) * math.cos(end.lon)
+    y = a * math.cos(start.lat) * math.sin(start.lon) + b * math.cos(end.lat) * math.sin(end.lon)
+    z = a * math.sin(start.lat) + b * math.sin(end.lat)
+    return math.degrees(math.atan2(z, math.hypot(x, y))), math.degrees(math.atan2(y, x))
+
+
+def _distance_to_leg(lat: float, lon: float, start: _RoutePoint, end: _RoutePoint, d12: float) -> Tuple[float, float]:
+    """
+    Distance from a point to a great-circle leg, and along-track position.
+
+    Returns (distance_nm, along_track_nm) where the along-track position is
+    clamped to [0, leg length]. Points beyond either end of the leg measure to
+    the nearest endpoint.
+    """
+    d13 = _angular_distance(start.lat, start.lon, lat, lon)
+    if d12 == 0.0:
+        return d13 * EARTH_RADIUS_NM, 0.0
+
+    theta13 = _bearing(start.lat, start.lon, lat, lon)
+    theta12 = _bearing(start.lat, start.lon, end.lat, end.lon)
+    cross_track = math.asin(max(-1.0, min(1.0, math.sin(d13) * math.sin(theta13 - theta12))))
+
+    cos_xt = math.cos(cross_track)
+    along_track = math.acos(max(-1.0, min(1.0, math.cos(d13) / cos_xt))) if cos_xt > 0.0 else 0.0
+    if math.cos(theta13 - theta12) < 0.0:
+        along_track = -along_track
+
+    if along_track <= 0.0:
+        return d13 * EARTH_RADIUS_NM, 0.0
+    if along_track >= d12:
+        return _angular_distance(end.lat, end.lon, lat, lon) * EARTH_RADIUS_NM, d12 * EARTH_RADIUS_NM
+    return abs(cross_track) * EARTH_RADIUS_NM, along_track * EARTH_RADIUS_NM
+
+
+def _resolve_route(indexes: "ModelIndexes", route: Sequence[RouteItem]) -> List[_RoutePoint]:
+    points: List[_RoutePoint] = []
+    for item in route:
+        if isinstance(item, str):
+            airport = indexes.model.airports.get(item.strip().upper())
+            navpoint = getattr(airport, "navpoint", None) if airport else None
+            if navpoint is None:
+                continue  # Unknown airports are skipped, like the model's own route search
+            name = airport.ident
+        else:
+            navpoint = item
+            name = getattr(item, "name", None) or f"{item.latitude:.4f},{item.longitude:.4f}"
+        points.append(_RoutePoint(name, math.radians(navpoint.latitude), math.radians(navpoint.longitude)))
+    return points
+
+
+def find_airports_near_route(
+    indexes: "ModelIndexes",
+    route: Sequence[RouteItem],
+    distance_nm: float,
+    candidate_filter: Optional[AirportPredicate] = None,
+) -> List[Dict[str, Any]]:
+    """
+    Airports within distance_nm of a multi-leg route.
+
+    Drop-in replacement for EuroAipModel.find_airports_near_route that only
+    evaluates airports near the route.
+
+    Args:
+        indexes: ModelIndexes for the model being searched
+        route: ICAO codes and/or NavPoints defining the route
+        distance_nm: Maximum distance from the route (corridor half-width)
+        candidate_filter: Optional cheap predicate applied before any geometry
+            (e.g. country / point_of_entry / has_hard_runway filters)
+
+    Returns:
+        List of dicts sorted by segment distance, each with:
+            airport, segment_distance_nm, enroute_distance_nm (along-route
+            position of the closest point), closest_segment ([from, to]).
+    """
+    points = _resolve_route(indexes, route)
+    if not points:
+        return []
+
+    spatial = indexes.spatial
+    legs: List[Tuple[_RoutePoint, _RoutePoint, float, float]] = []  # (start, end, d12, cumulative_nm)
+    if len(points) == 1:
+        legs.append((points[0], points[0], 0.0, 0.0))
+    cumulative_nm = 0.0
+    for start, end in zip(points, points[1:]):
+        d12 = _angular_distance(start.lat, start.lon, end.lat, end.lon)
+        legs.append((start, end, d12, cumulative_nm))
+        cumulative_nm += d12 * EARTH_RADIUS_NM
+
+    # 1. Candidate selection: cover each leg with padded circles
+    step_nm = min(MAX_COVERAGE_STEP_NM, max(distance_nm, 1.0))
+    coverage_radius_nm = distance_nm + step_nm / 2.0
+    candidates: Dict[str, Airport] = {}
+    rejected: set = set()
+    for start, end, d12, _ in legs:
+        leg_nm = d12 * EARTH_RADIUS_NM
+        steps = max(1, int(math.ceil(leg_nm / step_nm)))
+        for i in range(steps + 1):
+            lat, lon = _intermediate_point(start, end, d12, i / steps)
+            for airport in spatial.candidates_within_radius(lat, lon, coverage_radius_nm):
+                ident = airport.ident
+                if ident in candidates or ident in rejected:
+                    continue
+                if candidate_filter is not None and not candidate_filter(airport):
+                    rejected.add(ident)
+                    continue
+                candidates[ident] = airport
+
+    # 2. Exact cross-track distance for candidates only
+    results: List[Dict[str, Any]] = []
+    for airport in candidates.values():
+        lat = math.radians(airport.navpoint.latitude)
+        lon = math.radians(airport.navpoint.longitude)
+        best: Optional[Tuple[float, float, _RoutePoint, _RoutePoint]] = None
+        for start, end, d12, leg_offset_nm in legs:
+            leg_distance_nm, along_nm = _distance_to_leg(lat, lon, start, end, d12)
+            if best is None or leg_distance_nm < best[0]:
+                best = (leg_distance_nm, leg_offset_nm + along_nm, start, end)
+        if best is not None and best[0] <= distance_nm:
+            results.append({
+                "airport": airport,
+                "segment_distance_nm": round(best[0], 2),
+                "enroute_distance_nm": round(best[1], 2),
+                "closest_segment": [best[2].name, best[3].name],
+            })
+
+    results.sort(key=lambda item: item["segment_distance_nm"])
+    return results
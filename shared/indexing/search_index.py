@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""
+Ranked typeahead search over airport codes, names and municipalities.
+
+Built once per model:
+
+- ICAO and IATA codes are kept in one sorted list, so a code prefix is a bisect
+  range (equivalent to walking a prefix trie).
+- Name and municipality words are kept as sorted tokens with postings, so every
+  query word is a token-prefix lookup.
+- Trigram postings over the combined text find substring matches ("ONDON")
+  without scanning every airport.
+
+Text is matched case- and accent-insensitively ("zurich" finds "Zürich").
+"""
+import bisect
+import heapq
+import logging
+import re
+import unicodedata
+from typing import Dict, Iterable, List, Optional, Set, Tuple
+
+from euro_aip.models.airport import Airport
+
+logger = logging.getLogger(__name__)
+
+TRIGRAM = 3
+
+# Match scores, best first. Ties are broken by longest runway, then ICAO.
+SCORE_ICAO_EXACT = 100
+SCORE_IATA_EXACT = 90
+SCORE_ICAO_PREFIX = 80
+SCORE_IATA_PREFIX = 70
+SCORE_NAME_START = 60  # Name starts with the query words
+SCORE_NAME_WORDS = 50  # Every query word starts a word of the name
+SCORE_MUNICIPALITY_WORDS = 40
+SCORE_SUBSTRING = 20
+
+_NON_ALNUM = re.compile(r"[^A-Z0-9]+")
+
+
+def normalize_text(text: Optional[str]) -> str:
+    """Uppercase, strip accents, collapse punctuation/whitespace to single spaces."""
+    if not text:
+        return ""
+    decomposed = unicodedata.normalize("NFKD", text)
+    ascii_only = "".join(c for c in decomposed if not unicodedata.combining(c))
+    return _NON_ALNUM.sub(" ", ascii_only.upper()).strip()
+
+
+def _trigrams(text: str) -> Set[str]:
+    return {text[i:i + TRIGRAM] for i in range(len(text) - TRIGRAM + 1)}
+
+
+class _TokenIndex:
+    """Sorted word list with postings for word-prefix lookups."""
+
+    def __init__(self):
+        self._postings: Dict[str, Set[int]] = {}
+        self._tokens: List[str] = []
+
+    def add(self, row: int, words: Iterable[str]) -> None:
+        for word in words:
+            self._postings.setdefault(word, set()).add(row)
+
+    def freeze(self) -> None:
+        self._tokens = sorted(self._postings)
+
+    def prefix(self, prefix: str) -> Set[int]:
+        """Rows having a word starting with prefix."""
+        start = bisect.bisect_left(self._tokens, prefix)
+        rows: Set[int] = set()
+        for token in self._tokens[start:]:
+            if not token.startswith(prefix):
+                break
+            rows |= self._postings[token]
+        return rows
+
+    def all_prefixes(self, words: List[str]) -> Set[int]:
+        """Rows where every word is the prefix of some word."""
+        rows: Optional[Set[int]] = None
+        # Longest words first: they have the smallest postings
+        for word in sorted(words, key=len, reverse=True):
+            matched = self.prefix(word)
+            rows = matched if rows is None else rows & matched
+            if not rows:
+                return set()
+        return rows or set()
+
+
+class AirportSearchIndex:
+    """
+    Search index for one set of airports.
+
+    Usage:
+        index = AirportSearchIndex(model.airports)
+        airports = index.search("biggin", limit=20)
+    """
+
+    def __init__(self, airports: Iterable[Airport]):
+        self._airports: List[Airport] = list(airports)
+        self._runway_ft: List[int] = [a.longest_runway_length_ft or 0 for a in self._airports]
+
+        codes: List[Tuple[str, int, int]] = []  # (code, exact score, row)
+        self._names = _TokenIndex()
+        self._municipalities = _TokenIndex()
+        self._name_text: List[str] = []
+        self._text: List[str] = []
+        self._trigrams: Dict[str, Set[int]] = {}
+
+        for row, airport in enumerate(self._airports):
+            ident = normalize_text(airport.ident)
+            iata = normalize_text(getattr(airport, "iata_code", None))
+            name = normalize_text(airport.name)
+            municipality = normalize_text(airport.municipality)
+
+            if ident:
+                codes.append((ident, SCORE_ICAO_EXACT, row))
+            if iata:
+                codes.append((iata, SCORE_IATA_EXACT, row))
+            self._names.add(row, name.split())
+            self._municipalities.add(row, municipality.split())
+            self._name_text.append(name)
+
+            # Fields separated by "|" so substrings never span two fields
+            text = "|".join(part for part in (ident, iata, name, municipality) if part)
+            self._text.append(text)
+            for trigram in _trigrams(text):
+                self._trigrams.setdefault(trigram, set()).add(row)
+
+        codes.sort()
+        self._codes = codes
+        self._code_keys = [code for code, _, _ in codes]
+        self._names.freeze()
+        self._municipalities.freeze()
+
+        logger.info(
+            f"Airport search index built: {len(self._airports)} airports, "
+            f"{len(self._trigrams)} trigrams"
+        )
+
+    def __len__(self) -> int:
+        return len(self._airports)
+
+    def _match_codes(self, code: str, scores: Dict[int, int]) -> None:
+        start = bisect.bisect_left(self._code_keys, code)
+        for key, exact_score, row in self._codes[start:]:
+            if not key.startswith(code):
+                break
+            if key == code:
+                score = exact_score
+            else:
+                score = SCORE_ICAO_PREFIX if exact_score == SCORE_ICAO_EXACT else SCORE_IATA_PREFIX
+            scores[row] = max(scores.get(row, 0), score)
+
+    def _match_substring(self, query: str, scores: Dict[int, int]) -> None:
+        candidates: Optional[Set[int]] = None
+        for trigram in sorted(_trigrams(query), key=lambda t: len(self._trigrams.get(t, ()))):
+            rows = self._trigrams.get(trigram)
+            if not rows:
+                return
+            candidates = set(rows) if candidates is None else candidates & rows
+            if not candidates:
+                return
+        for row in candidates or ():
+            if row not in scores and query in self._text[row]:
+                scores[row] = SCORE_SUBSTRING
+
+    def search(self, query: str, limit: int = 20) -> List[Airport]:
+        """Best matching airports, best first."""
+        normalized = normalize_text(query)
+        if not normalized or limit <= 0:
+            return []
+
+        scores: Dict[int, int] = {}
+        words = normalized.split()
+
+        if len(words) == 1:
+            self._match_codes(words[0], scores)
+
+        for row in self._names.all_prefixes(words):
+            score = SCORE_NAME_START if self._name_text[row].startswith(normalized) else SCORE_NAME_WORDS
+            scores[row] = max(scores.get(row, 0), score)
+        for row in self._municipalities.all_prefixes(words):
+            scores[row] = max(scores.get(row, 0), SCORE_MUNICIPALITY_WORDS)
+
+        if len(normalized) >= TRIGRAM:
+            self._match_substring(normalized, scores)
+
+        ranked = heapq.nsmallest(
+            limit,
+            scores,
+            key=lambda row: (-scores[row], -self._runway_ft[row], self._airports[row].ident),
+        )
+        return [self._airports[row] for row in ranked]
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+Grid-based spatial index over airport navpoint coordinates.
+
+Airports are bucketed into fixed-size latitude/longitude cells at build time.
+Viewport (bbox) and radius queries only visit the cells overlapping the query
+area, so the cost scales with the number of airports near the query instead of
+the size of the whole model.
+"""
+import logging
+import math
+from collections import defaultdict
+from typing import Dict, Iterable, List, Optional, Tuple
+
+from euro_aip.models.airport import Airport
+from euro_aip.models.navpoint import NavPoint
+
+logger = logging.getLogger(__name__)
+
+# One degree of latitude is 60 NM
+NM_PER_DEGREE_LAT = 60.0
+
+# Default cell size in degrees (~30 NM north-south); a good fit for map
+# viewports and the 10-100 NM search radii used by the tools
+DEFAULT_CELL_SIZE_DEG = 0.5
+
+CellKey = Tuple[int, int]
+IndexedPoint = Tuple[float, float, Airport]
+
+
+class AirportSpatialIndex:
+    """
+    Uniform lat/lon grid over airports with a navpoint.
+
+    Usage:
+        index = AirportSpatialIndex(model.airports)
+        in_view = index.within_bbox(north=51, south=48, east=3, west=-1)
+        nearby = index.within_radius(48.85, 2.35, radius_nm=50)  # [(airport, distance_nm)]
+        nearest = index.nearest(48.85, 2.35, max_distance_nm=100)
+    """
+
+    def __init__(self, airports: Iterable[Airport], cell_size_deg: float = DEFAULT_CELL_SIZE_DEG):
+        if cell_size_deg <= 0:
+            raise ValueError("cell_size_deg must be positive")
+        self.cell_size_deg = cell_size_deg
+        self._cells: Dict[CellKey, List[IndexedPoint]] = defaultdict(list)
+        self._size = 0
+
+        for airport in airports:
+            navpoint = getattr(airport, "navpoint", None)
+            if navpoint is None or navpoint.latitude is None or navpoint.longitude is None:
+                continue
+            lat = float(navpoint.latitude)
+            lon = float(navpoint.longitude)
+            self._cells[self._cell_key(lat, lon)].append((lat, lon, airport))
+            self._size += 1
+
+        # Freeze into a plain dict so lookups of empty cells do not grow it
+        self._cells = dict(self._cells)
+        logger.info(f"Spatial index built: {self._size} airports in {len(self._cells)} cells")
+
+    def __len__(self) -> int:
+        return self._size
+
+    def _cell_coord(self, value: float) -> int:
+        return int(math.floor(value / self.cell_size_deg))
+
+    def _cell_key(self, lat: float, lon: float) -> CellKey:
+        return (self._cell_coord(lat), self._cell_coord(lon))
+
+    def _candidates(self, north: float, south: float, east: float, west: float) -> Iterable[IndexedPoint]:
+        """Yield points in all cells overlapping the box (no exact bounds check)."""
+        lat_min, lat_max = self._cell_coord(south), self._cell_coord(north)
+        lon_min, lon_max = self._cell_coord(west), self._cell_coord(east)
+
+        # Very large boxes touch more cells than exist, walk the cells instead
+        if (lat_max - lat_min + 1) * (lon_max - lon_min + 1) > len(self._cells):
+            for (lat_cell, lon_cell), points in self._cells.items():
+                if lat_min <= lat_cell <= lat_max and lon_min <= lon_cell <= lon_max:
+                    yield from points
+            return
+
+        for lat_cell in range(lat_min, lat_max + 1):
+            for lon_cell in range(lon_min, lon_max + 1):
+                points = self._cells.get((lat_cell, lon_cell))
+                if points:
+                    yield from points
+
+    def within_bbox(self, north: float, south: float, east: float, west: float) -> List[Airport]:
+        """
+        Airports whose navpoint lies inside the box (bounds inclusive).
+
+        Matches the semantics of the previous full scan: latitude in [south, north]
+        and longitude in [west, east]; no antimeridian wrapping.
+        """
+        if south > north or west > east:
+            return []
+        return [
+            airport
+            for lat, lon, airport in self._candidates(north, south, east, west)
+            if south <= lat <= north and west <= lon <= east
+        ]
+
+    def within_radius(self, lat: float, lon: float, radius_nm: float) -> List[Tuple[Airport, float]]:
+        """
+        Airports within radius_nm of (lat, lon), with their great-circle distance.
+
+        The grid narrows candidates with a padded bounding box; exact distances come
+        from NavPoint.haversine_distance so results match the model's own geometry.
+        Results are sorted by distance.
+        """
+        if radius_nm < 0:
+            return []
+        center = NavPoint(latitude=lat, longitude=lon)
+        results: List[Tuple[Airport, float]] = []
+
+        for _, _, airport in self._radius_candidates(lat, lon, radius_nm):
+            try:
+                _, distance_nm = airport.navpoint.haversine_distance(center)
+            except Exception:
+                continue
+            if distance_nm <= radius_nm:
+                results.append((airport, float(distance_nm)))
+
+        results.sort(key=lambda item: item[1])
+        return results
+
+    def nearest(self, lat: float, lon: float, max_distance_nm: float) -> Optional[Tuple[Airport, float]]:
+        """Nearest airport within max_distance_nm, or None."""
+        results = self.within_radius(lat, lon, max_distance_nm)
+        return results[0] if results else None
+
+    def candidates_within_radius(self, lat: float, lon: float, radius_nm: float) -> Iterable[Airport]:
+        """
+        Airports in grid cells covering the circle, without the exact distance check.
+
+        A cheap superset of `within_radius` for callers that apply their own
+        geometry (e.g. route corridor cross-track distance).
+        """
+        for _, _, airport in self._radius_candidates(lat, lon, radius_nm):
+            yield airport
+
+    def _radius_candidates(self, lat: float, lon: float, radius_nm: float) -> Iterable[IndexedPoint]:
+        # Small padding so points sitting exactly on the circle are not lost to rounding
+        dlat = radius_nm / NM_PER_DEGREE_LAT + 1e-6
+        north = min(90.0, lat + dlat)
+        south = max(-90.0, lat - dlat)
+
+        # Longitude degrees shrink with latitude; use the widest latitude in range
+        widest_lat = max(abs(north), abs(south))
+        cos_lat = math.cos(math.radians(widest_lat))
+        if cos_lat < 1e-6 or north >= 90.0 or south <= -90.0:
+            yield from self._candidates(north, south, 180.0, -180.0)
+            return
+
+        dlon = dlat / cos_lat
+        if dlon >= 180.0:
+            yield from self._candidates(north, south, 180.0, -180.0)
+            return
+
+        west, east = lon - dlon, lon + dlon
+        yield from self._candidates(north, south, min(east, 180.0), max(west, -180.0))
+        # Wrap around the antimeridian
+        if west < -180.0:
+            yield from self._candidates(north, south, 180.0, west + 360.0)
+        if east > 180.0:
+            yield from self._candidates(north, south, east - 360.0, -180.0)
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+Prebuilt snapshot of the airports model for fast server startup.
+
+`DatabaseStorage.load_model()` rebuilds every Airport object from airports.db
+and recomputes derived fields; servers then drop excluded countries and build
+the in-memory indexes. A snapshot stores the result of all of that (model plus
+warmed `ModelIndexes`) as one pickle, so a cold start or worker restart only
+has to unpickle it.
+
+File layout (`airports_model[-excl-RU].pkl` in the snapshot directory):
+    manifest   small pickle read first: format version, euro_aip version, source db
+               size/mtime/sha256, excluded countries
+    payload    pickle of {"model": EuroAipModel, "indexes": ModelIndexes}
+
+The snapshot is used only when its manifest matches the installed euro_aip
+version (pickles hold its class layouts) and the source database (size and
+mtime, or the sha256 if those changed, e.g. after a copy into a container);
+otherwise the model is loaded from airports.db and the snapshot is
+rewritten atomically.
+"""
+from __future__ import annotations
+
+import gc
+import hashlib
+import importlib.metadata
+import logging
+import os
+import pickle
+from pathlib import Path
+from typing import Any, Dict, Optional, Sequence
+
+import euro_aip
+from euro_aip.models.euro_aip_model import EuroAipModel
+from euro_aip.storage.database_storage import DatabaseStorage
+
+from .indexing import get_model_indexes
+from .indexing.model_indexes import register_model_indexes
+
+logger = logging.getLogger(__name__)
+
+# Bump when the pickled classes change incompatibly (model or index layout)
+FORMAT_VERSION = 2
+
+# Read size for hashing the source database
+HASH_CHUNK_BYTES = 1 << 20
+
+
+def file_sha256(path: Path) -> str:
+    """sha256 of a file's contents."""
+    digest = hashlib.sha256()
+    with open(path, "rb") as f:
+        for chunk in iter(lambda: f.read(HASH_CHUNK_BYTES), b""):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+
+def euro_aip_version() -> Optional[str]:
+    """Installed euro_aip version (distribution metadata, else the module's __version__)."""
+    try:
+        return importlib.metadata.version("euro_aip")
+    except importlib.metadata.PackageNotFoundError:
+        return getattr(euro_aip, "__version__", None)
+
+
+def snapshot_file(snapshot_dir: Path, exclude_countries: Sequence[str] = ()) -> Path:
+    """Snapshot path for a set of excluded countries (one file per variant)."""
+    countries = sorted({c.upper() for c in exclude_countries})
+    suffix = f"-excl-{'-'.join(countries)}" if countries else ""
+    return Path(snapshot_dir) / f"airports_model{suffix}.pkl"
+
+
+def _source_manifest(db_path: Path, exclude_countries: Sequence[str], sha256: Optional[str] = None) -> Dict[str, Any]:
+    stat = db_path.stat()
+    return {
+        "format_version": FORMAT_VERSION,
+        "euro_aip_version": euro_aip_version(),
+        "source_size": stat.st_size,
+        "source_mtime_ns": stat.st_mtime_ns,
+        "source_sha256": sha256 or file_sha256(db_path),
+        "exclude_countries": sorted({c.upper() for c in exclude_countries}),
+    }
+
+
+def _matches(manifest: Dict[str, Any], db_path: Path, exclude_countries: Sequence[str]) -> bool:
+    """Whether a snapshot manifest was built from this database and exclusion set."""
+    if manifest.get("format_version") != FORMAT_VERSION:
+        return False
+    if manifest.get("euro_aip_version") != euro_aip_version():
+        return False  # Library upgraded: pickled class layouts may have changed
+    if manifest.get("exclude_countries") != sorted({c.upper() for c in exclude_countries}):
+        return False
+    stat = db_path.stat()
+    if manifest.get("source_size") != stat.st_size:
+        return False
+    if manifest.get("source_mtime_ns") == stat.st_mtime_ns:
+        return True
+    # Same size, new mtime (copied or touched): compare contents
+    return manifest.get("source_sha256") == file_sha256(db_path)
+
+
+def read_snapshot(path: Path, db_path: Path, exclude_countries: Sequence[str] = ()) -> Optional[EuroAipModel]:
+    """
+    Load a snapshot if it matches the source database.
+
+    Registers the snapshot's prebuilt indexes for the returned model.
+
+    Returns:
+        The model, or None if the snapshot is missing, stale or unreadable
+    """
+    if not path.exists():
+        return None
+    try:
+        with open(path, "rb") as f:
+            manifest = pickle.load(f)
+            if not _matches(manifest, db_path, exclude_countries):
+                logger.info(f"Model snapshot {path} is stale, reloading from {db_path}")
+                return None
+            # The payload is millions of small objects; collection passes only slow loading down
+            gc_enabled = gc.isenabled()
+            gc.disable()
+            try:
+                payload = pickle.load(f)
+            finally:
+                if gc_enabled:
+                    gc.enable()
+    except Exception as e:
+        logger.warning(f"Failed to read model snapshot {path}: {e}")
+        return None
+
+    model = payload["model"]
+    register_model_indexes(payload["indexes"])
+    logger.info(f"✓ Loaded model snapshot {path} ({model.airports.count()} airports)")
+    return model
+
+
+def write_snapshot(path: Path, model: EuroAipModel, db_path: Path, exclude_countries: Sequence[str] = ()) -> None:
+    """Write model and its warmed indexes atomically (readers never see a partial file)."""
+    path.parent.mkdir(parents=True, exist_ok=True)
+    manifest = _source_manifest(db_path, exclude_countries)
+    indexes = get_model_indexes(model).warm()
+    tmp = path.with_name(f"{path.name}.{os.getpid()}.tmp")
+    try:
+        with open(tmp, "wb") as f:
+            pickle.dump(manifest, f, protocol=pickle.HIGHEST_PROTOCOL)
+            pickle.dump({"model": model, "indexes": indexes}, f, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(tmp, path)
+    finally:
+        if tmp.exists():
+            tmp.unlink()
+    logger.info(f"✓ Wrote model snapshot {path}")
+
+
+def load_airports_model(
+    db_path: Path,
+    snapshot_dir: Optional[Path] = None,
+    exclude_countries: Sequence[str] = (),
+) -> EuroAipModel:
+    """
+    Load the airports model, from a matching snapshot when available.
+
+    Args:
+        db_path: Path to airports.db
+        snapshot_dir: Directory for snapshots (None = always load from airports.db)
+        exclude_countries: ISO country codes removed from the model (e.g. ["RU"])
+
+    Returns:
+        Final model (countries removed, derived fields and indexes built)
+    """
+    db_path = Path(db_path)
+    path = snapshot_file(snapshot_dir, exclude_countries) if snapshot_dir else None
+    if path is not None:
+        model = read_snapshot(path, db_path, exclude_countries)
+        if model is not None:
+            return model
+
+    model = DatabaseStorage(str(db_path)).load_model()
+    for country in exclude_countries:
+        model.remove_airports_by_country(country)
+
+    if path is not None:
+        try:
+            write_snapshot(path, model, db_path, exclude_countries)
+        except Exception as e:
+            logger.warning(f"Failed to write model snapshot {path}: {e}")
+    return model
@@ -6,6 +6,8 @@ import logging
 from typing import List, Dict, Any, Optional, TYPE_CHECKING
 from euro_aip.models.airport import Airport
 
+from shared.tracing import span, traced
+
 from .strategies import PriorityStrategy, PersonaOptimizedStrategy
 
 logger = logging.getLogger(__name__)
@@ -55,6 +57,7 @@ class PriorityEngine:
         """Initialize priority engine."""
         self.context = context
 
+    @traced("priority_engine")
     def apply(
         self,
         airports: List[Airport],
@@ -83,6 +86,10 @@ class PriorityEngine:
             logger.warning(f"Unknown strategy: {strategy}, using persona_optimized")
             strategy_obj = StrategyRegistry.get("persona_optimized")
 
+        # Fetch persona scores for all candidates in one batch
+        if strategy_obj.uses_ga_scores:
+            context = self._with_ga_scores(airports, context)
+
         # Score airports
         scored = strategy_obj.score(
             airports,
@@ -104,3 +111,27 @@ class PriorityEngine:
 
         # Return top N airports
         return [item.airport for item in scored[:max_results]]
+
+    def _with_ga_scores(
+        self,
+        airports: List[Airport],
+        context: Optional[Dict[str, Any]],
+    ) -> Optional[Dict[str, Any]]:
+        """Return context with "ga_scores" prefetched (unchanged if unavailable)."""
+        if context and "ga_scores" in context:
+            return context
+        service = self.context.ga_friendliness_service if self.context else None
+        if not service:
+            return context
+
+        persona_id = (context or {}).get("persona_id", "ifr_touring_sr22")
+        try:
+            with span("ga.batch"):
+                ga_scores = service.get_persona_scores_batch([a.ident for a in airports], persona_id)
+        except Exception as e:
+            logger.warning(f"Error prefetching GA scores: {e}")
+            return context
+
+        context = dict(context or {})
+        context["ga_scores"] = ga_scores
+        return context
@@ -30,6 +30,8 @@ class PriorityStrategy(ABC):
 
     name: str = "base_strategy"
     description: str = "Base priority strategy"
+    # Strategies ranking by persona score get context["ga_scores"] prefetched by PriorityEngine
+    uses_ga_scores: bool = False
 
     @abstractmethod
     def score(
@@ -32,6 +32,8 @@ class PersonaOptimizedStrategy(PriorityStrategy):
 
     Context parameters:
         persona_id: str - Persona for GA scoring (default: "ifr_touring_sr22")
+        ga_scores: Dict[str, float] - Prefetched persona scores (set by PriorityEngine);
+            when present, airports missing from it have no GA data
 
         For location search:
             point_distances: Dict[str, float] - Distance from point to each airport
@@ -44,6 +46,7 @@ class PersonaOptimizedStrategy(PriorityStrategy):
 
     name = "persona_optimized"
     description = "Rank airports by distance buckets with persona score sorting"
+    uses_ga_scores = True
 
     # Distance buckets for location search (nm)
     # Results in buckets: 0-15, 15-30, 30-50, 50-100, 100+
@@ -75,9 +78,12 @@ class PersonaOptimizedStrategy(PriorityStrategy):
         self,
         airport: Airport,
         persona_id: str,
-        tool_context: Optional["ToolContext"]
+        tool_context: Optional["ToolContext"],
+        ga_scores: Optional[Dict[str, float]] = None,
     ) -> Optional[float]:
         """Get GA friendliness score for airport, or None if unavailable."""
+        if ga_scores is not None:
+            return ga_scores.get(airport.ident)
         if not tool_context or not tool_context.ga_friendliness_service:
             return None
         try:
@@ -137,13 +143,14 @@ class PersonaOptimizedStrategy(PriorityStrategy):
         scored: List[ScoredAirport] = []
         point_distances = context.get("point_distances", {})
         persona_id = context.get("persona_id", "ifr_touring_sr22")
+        ga_scores = context.get("ga_scores")
 
         for airport in airports:
             distance_nm = point_distances.get(airport.ident, 9999.0)
             bucket = self._get_distance_bucket(distance_nm)
 
             # Get persona score (or fallback)
-            ga_score = self._get_ga_score(airport, persona_id, tool_context)
+            ga_score = self._get_ga_score(airport, persona_id, tool_context, ga_scores)
             effective_score = ga_score if ga_score is not None else self._get_basic_score(airport)
 
             scored.append(ScoredAirport(
@@ -183,6 +190,7 @@ class PersonaOptimizedStrategy(PriorityStrategy):
         total_distance = context.get("total_route_distance_nm", 0.0)
         sort_by = context.get("sort_by", "halfway")
         persona_id = context.get("persona_id", "ifr_touring_sr22")
+        ga_scores = context.get("ga_scores")
 
         # Calculate target position based on sort_by
         if sort_by == "near_origin":
@@ -204,7 +212,7 @@ class PersonaOptimizedStrategy(PriorityStrategy):
             bucket = self._get_position_bucket(position_deviation, total_distance)
 
             # Get persona score (or fallback)
-            ga_score = self._get_ga_score(airport, persona_id, tool_context)
+            ga_score = self._get_ga_score(airport, persona_id, tool_context, ga_scores)
             effective_score = ga_score if ga_score is not None else self._get_basic_score(airport)
 
             scored.append(ScoredAirport(
@@ -239,9 +247,10 @@ class PersonaOptimizedStrategy(PriorityStrategy):
         """Fallback scoring when no distance info available. Sort by persona only."""
         scored: List[ScoredAirport] = []
         persona_id = context.get("persona_id", "ifr_touring_sr22")
+        ga_scores = context.get("ga_scores")
 
         for airport in airports:
-            ga_score = self._get_ga_score(airport, persona_id, tool_context)
+            ga_score = self._get_ga_score(airport, persona_id, tool_context, ga_scores)
             effective_score = ga_score if ga_score is not None else self._get_basic_score(airport)
 
             scored.append(ScoredAirport(
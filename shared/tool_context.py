@@ -11,13 +11,14 @@ from __future__ import annotations
 from dataclasses import dataclass
 from functools import lru_cache
 from pathlib import Path
-from typing import Any, Optional
+from typing import Any, Optional, Sequence
 
 from euro_aip.models.euro_aip_model import EuroAipModel
-from euro_aip.storage.database_storage import DatabaseStorage
 from pydantic import Field
 from pydantic_settings import BaseSettings, SettingsConfigDict
 
+from .indexing import ModelIndexes, get_model_indexes
+from .model_snapshot import load_airports_model
 from .rules_manager import RulesManager
 
 
@@ -66,6 +67,16 @@ class ToolContextSettings(BaseSettings):
         description="URL to ChromaDB service. If set, takes precedence over vector_db_path.",
         alias="VECTOR_DB_URL",
     )
+    vector_index_path: Optional[Path] = Field(
+        default=None,
+        description="Path to exported in-process rules vector index. If it exists, RulesRAG uses it instead of ChromaDB.",
+        alias="VECTOR_INDEX_PATH",
+    )
+    model_snapshot_dir: Optional[Path] = Field(
+        default=None,
+        description="Directory for prebuilt airports model snapshots (see model_snapshot.py). Unset = always load airports.db.",
+        alias="MODEL_SNAPSHOT_DIR",
+    )
 
 
 @lru_cache(maxsize=1)
@@ -100,6 +111,8 @@ class ToolContext:
         load_ga_friendliness: bool = True,
         load_comparison: bool = True,
         load_rag: bool = True,
+        exclude_countries: Sequence[str] = (),
+        model: Optional[EuroAipModel] = None,
     ) -> "ToolContext":
         """
         Create ToolContext with all paths resolved from settings.
@@ -112,6 +125,8 @@ class ToolContext:
             load_ga_friendliness: Load GA friendliness service (default: True)
             load_comparison: Load comparison service for cross-country analysis (default: True)
             load_rag: Load RulesRAG for semantic search (default: True)
+            exclude_countries: ISO country codes removed from the model (part of the snapshot key)
+            model: Already loaded model (e.g. preloaded before forking workers); skips loading
 
         Returns:
             ToolContext instance with requested services loaded
@@ -123,12 +138,14 @@ class ToolContext:
         settings = settings or get_tool_context_settings()
 
         # Load core model (required if load_airports is True)
-        model = None
-        if load_airports:
-            storage = DatabaseStorage(str(settings.airports_db))
-            model = storage.load_model()
-        else:
-            raise ValueError("load_airports must be True - airports database is required")
+        if model is None:
+            if not load_airports:
+                raise ValueError("load_airports must be True - airports database is required")
+            model = load_airports_model(
+                settings.airports_db,
+                snapshot_dir=settings.model_snapshot_dir,
+                exclude_countries=exclude_countries,
+            )
 
         # Initialize NotificationService (optional)
         notification_service = None
@@ -137,7 +154,10 @@ class ToolContext:
                 from shared.ga_notification_agent.service import NotificationService
                 ga_notifications_db = settings.ga_notifications_db
                 if ga_notifications_db and ga_notifications_db.exists():
-                    notification_service = NotificationService(db_path=str(ga_notifications_db))
+                    notification_service = NotificationService(
+                        db_path=str(ga_notifications_db),
+                        cache_in_memory=True,  # Read-only at runtime; reloads if the file changes
+                    )
             except Exception:
                 pass  # Service is optional
 
@@ -182,13 +202,17 @@ class ToolContext:
         if load_rag and rules_manager:
             vector_db_path = settings.vector_db_path
             vector_db_url = settings.vector_db_url
-            if vector_db_url or (vector_db_path and vector_db_path.exists()):
+            vector_index_path = settings.vector_index_path
+            if vector_index_path and not vector_index_path.exists():
+                vector_index_path = None
+            if vector_index_path or vector_db_url or (vector_db_path and vector_db_path.exists()):
                 try:
                     from shared.aviation_agent.rules_rag import RulesRAG
                     rules_rag = RulesRAG(
                         vector_db_path=str(vector_db_path) if vector_db_path and not vector_db_url else None,
                         vector_db_url=vector_db_url,
                         rules_manager=rules_manager,
+                        vector_index_path=str(vector_index_path) if vector_index_path else None,
                     )
                     logger.info("✓ RulesRAG initialized")
                 except Exception as e:
@@ -204,6 +228,11 @@ class ToolContext:
             rules_rag=rules_rag,
         )
 
+    @property
+    def indexes(self) -> ModelIndexes:
+        """Derived indexes (spatial, ...) shared by all contexts on the same model."""
+        return get_model_indexes(self.model)
+
     def ensure_rules_manager(self) -> RulesManager:
         if not self.rules_manager:
             self.rules_manager = RulesManager()
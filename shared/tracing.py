@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""
+Latency tracing for agent and API hot paths.
+
+Named spans are timed with `span()` (or the `traced()` decorator). Every span
+feeds a process-wide latency histogram, exposed in Prometheus text format by
+`render_prometheus()` (served at /metrics by the web server). Spans that run
+inside `start_trace()` are also aggregated per request, which the web server
+returns as a `Server-Timing` header.
+
+Histograms live in each process. With several server workers, set
+METRICS_MULTIPROC_DIR to a directory shared by all of them (emptied at server
+start): a background thread in each process writes its histograms there every
+MULTIPROC_FLUSH_S (never on the request path) and `render_prometheus()` sums every process's file, so any
+worker serves the totals and counters stay monotonic across scrapes.
+
+Span names follow "<area>.<step>" (e.g. "geocode", "filter_engine",
+"priority_engine", "ga.batch", "rag.embed", "llm.planner", "tool.search_airports")
+so they are valid Server-Timing metric names.
+
+Usage:
+    with span("priority_engine"):
+        scored = strategy.score(airports)
+
+    with start_trace() as trace:
+        handle_request()
+    response.headers["Server-Timing"] = trace.server_timing()
+"""
+from __future__ import annotations
+
+import functools
+import json
+import logging
+import os
+import threading
+import time
+import uuid
+from contextlib import contextmanager
+from contextvars import ContextVar
+from pathlib import Path
+from typing import Callable, Dict, Iterable, Iterator, List, Optional, Tuple, TypeVar
+
+logger = logging.getLogger(__name__)
+
+T = TypeVar("T")
+
+# Histogram bucket upper bounds in seconds (Prometheus "le"), +Inf is implicit
+BUCKETS_S = (0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0)
+
+SPAN_METRIC = "flyfun_span_duration_seconds"
+REQUEST_METRIC = "flyfun_http_request_duration_seconds"
+
+# Max seconds a process's observations wait before reaching METRICS_MULTIPROC_DIR
+MULTIPROC_FLUSH_S = 1.0
+
+
+class _Histogram:
+    __slots__ = ("counts", "total", "count")
+
+    def __init__(self):
+        self.counts = [0] * len(BUCKETS_S)
+        self.total = 0.0
+        self.count = 0
+
+    def observe(self, value: float) -> None:
+        for i, bound in enumerate(BUCKETS_S):
+            if value <= bound:
+                self.counts[i] += 1
+                break
+        self.total += value
+        self.count += 1
+
+
+HistogramKey = Tuple[str, Tuple[Tuple[str, str], ...]]
+
+
+class LatencyRegistry:
+    """
+    Thread-safe latency histograms keyed by metric name and label values.
+
+    With multiproc_dir, the histograms of this process are also written to
+    `<multiproc_dir>/latency.<pid>.<token>.json` and render_prometheus()
+    aggregates every file there (files of exited workers are kept, so totals
+    never go backwards).
+    """
+
+    def __init__(self, multiproc_dir: Optional[str] = None, flush_interval_s: float = MULTIPROC_FLUSH_S):
+        self._histograms: Dict[HistogramKey, _Histogram] = {}
+        self._lock = threading.Lock()
+        self.multiproc_dir = Path(multiproc_dir) if multiproc_dir else None
+        self.flush_interval_s = flush_interval_s
+        self._pid = os.getpid()
+        self._token = uuid.uuid4().hex[:8]
+        self._flusher_pid: Optional[int] = None
+        self._write_lock = threading.Lock()
+
+    def observe(self, metric: str, duration_s: float, **labels: str) -> None:
+        key = (metric, tuple(sorted(labels.items())))
+        with self._lock:
+            self._check_fork()
+            histogram = self._histograms.get(key)
+            if histogram is None:
+                histogram = self._histograms[key] = _Histogram()
+            histogram.observe(duration_s)
+            if self.multiproc_dir and self._flusher_pid != self._pid:
+                self._start_flusher()
+
+    def _check_fork(self) -> None:
+        # A forked worker starts empty: the parent's observations are in the parent's file
+        if os.getpid() != self._pid:
+            self._pid = os.getpid()
+            self._token = uuid.uuid4().hex[:8]
+            self._histograms = {}
+
+    def _start_flusher(self) -> None:
+        """Start this process's flush thread (caller holds the lock; threads don't survive fork)."""
+        self._flusher_pid = self._pid
+        threading.Thread(target=self._flush_loop, name="latency-flush", daemon=True).start()
+
+    def _flush_loop(self) -> None:
+        while True:
+            time.sleep(self.flush_interval_s)
+            self.flush()
+
+    def flush(self) -> None:
+        """Write this process's histograms to multiproc_dir (errors are logged, not raised)."""
+        if not self.multiproc_dir:
+            return
+        # The write lock keeps snapshots in order; the registry lock is only held to copy
+        with self._write_lock:
+            with self._lock:
+                self._check_fork()
+                rows = [
+                    [metric, list(labels), list(h.counts), h.total, h.count]
+                    for (metric, labels), h in self._histograms.items()
+                ]
+                path = self.multiproc_dir / f"latency.{self._pid}.{self._token}.json"
+            try:
+                self.multiproc_dir.mkdir(parents=True, exist_ok=True)
+                tmp = path.with_suffix(".tmp")
+                tmp.write_text(json.dumps(rows), encoding="utf-8")
+                os.replace(tmp, path)
+            except OSError as e:
+                logger.warning(f"Failed to write latency histograms to {path}: {e}")
+
+    def summary(self, metric: str = SPAN_METRIC) -> Dict[str, Dict[str, float]]:
+        """{label values: {"count", "sum_s"}} for one metric (tests, debugging)."""
+        with self._lock:
+            return {
+                ",".join(v for _, v in labels): {"count": h.count, "sum_s": h.total}
+                for (name, labels), h in self._histograms.items()
+                if name == metric
+            }
+
+    def reset(self) -> None:
+        with self._lock:
+            self._histograms.clear()
+
+    def _aggregate_files(self) -> Dict[HistogramKey, _Histogram]:
+        """Sum of the histograms of every process in multiproc_dir."""
+        merged: Dict[HistogramKey, _Histogram] = {}
+        for path in sorted(self.multiproc_dir.glob("latency.*.json")):
+            try:
+                rows = json.loads(path.read_text(encoding="utf-8"))
+            except (OSError, ValueError):
+                continue  # Replaced or removed while reading
+            for metric, labels, counts, total, count in rows:
+                key = (metric, tuple(tuple(pair) for pair in labels))
+                histogram = merged.setdefault(key, _Histogram())
+                histogram.counts = [a + b for a, b in zip(histogram.counts, counts)]
+                histogram.total += total
+                histogram.count += count
+        return merged
+
+    def render_prometheus(self) -> str:
+        """Prometheus text exposition (cumulative buckets, _sum and _count)."""
+        if self.multiproc_dir:
+            self.flush()
+            histograms = self._aggregate_files()
+            items = sorted((key, h.counts, h.total, h.count) for key, h in histograms.items())
+        else:
+            with self._lock:
+                items = sorted(
+                    (key, list(h.counts), h.total, h.count) for key, h in self._histograms.items()
+                )
+        return _render(items)
+
+
+def _render(items: Iterable[Tuple[HistogramKey, List[int], float, int]]) -> str:
+    lines: List[str] = []
+    current_metric = None
+    for (metric, labels), counts, total, count in items:
+        if metric != current_metric:
+            lines.append(f"# TYPE {metric} histogram")
+            current_metric = metric
+        base = ",".join(f'{k}="{_escape_label(v)}"' for k, v in labels)
+        prefix = f"{base}," if base else ""
+        cumulative = 0
+        for bound, bucket_count in zip(BUCKETS_S, counts):
+            cumulative += bucket_count
+            lines.append(f'{metric}_bucket{{{prefix}le="{bound}"}} {cumulative}')
+        lines.append(f'{metric}_bucket{{{prefix}le="+Inf"}} {count}')
+        suffix = f"{{{base}}}" if base else ""
+        lines.append(f"{metric}_sum{suffix} {total:.6f}")
+        lines.append(f"{metric}_count{suffix} {count}")
+    return "\n".join(lines) + "\n" if lines else ""
+
+
+def _escape_label(value: str) -> str:
+    return value.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
+
+
+class Trace:
+    """Span durations of one request, aggregated by name (spans may run on worker threads)."""
+
+    def __init__(self):
+        self._spans: Dict[str, List[float]] = {}  # name -> [total_s, count]
+        self._lock = threading.Lock()
+
+    def add(self, name: str, duration_s: float) -> None:
+        with self._lock:
+            entry = self._spans.setdefault(name, [0.0, 0])
+            entry[0] += duration_s
+            entry[1] += 1
+
+    @property
+    def spans(self) -> Dict[str, Tuple[float, int]]:
+        """{name: (total_s, count)} in first-seen order."""
+        with self._lock:
+            return {name: (total, int(count)) for name, (total, count) in self._spans.items()}
+
+    def server_timing(self, total_s: Optional[float] = None) -> str:
+        """Server-Timing header value ("name;dur=ms" entries, plus "total" when given)."""
+        entries = [f"{name};dur={total * 1000:.1f}" for name, (total, _) in self.spans.items()]
+        if total_s is not None:
+            entries.append(f"total;dur={total_s * 1000:.1f}")
+        return ", ".join(entries)
+
+
+registry = LatencyRegistry(os.getenv("METRICS_MULTIPROC_DIR") or None)
+_current_trace: ContextVar[Optional[Trace]] = ContextVar("flyfun_trace", default=None)
+
+
+def current_trace() -> Optional[Trace]:
+    return _current_trace.get()
+
+
+@contextmanager
+def start_trace() -> Iterator[Trace]:
+    """Collect spans of the enclosed work (and of tasks/threads that copy this context)."""
+    trace = Trace()
+    token = _current_trace.set(trace)
+    try:
+        yield trace
+    finally:
+        _current_trace.reset(token)
+
+
+def record(name: str, duration_s: float) -> None:
+    """Record a span measured elsewhere (e.g. an existing perf_counter reading)."""
+    registry.observe(SPAN_METRIC, duration_s, span=name)
+    trace = _current_trace.get()
+    if trace is not None:
+        trace.add(name, duration_s)
+
+
+@contextmanager
+def span(name: str) -> Iterator[None]:
+    """Time the enclosed block as span `name` (recorded even if it raises)."""
+    start = time.perf_counter()
+    try:
+        yield
+    finally:
+        record(name, time.perf_counter() - start)
+
+
+def traced(name: str) -> Callable[[Callable[..., T]], Callable[..., T]]:
+    """Decorator form of span()."""
+    def decorator(func: Callable[..., T]) -> Callable[..., T]:
+        @functools.wraps(func)
+        def wrapper(*args, **kwargs):
+            with span(name):
+                return func(*args, **kwargs)
+        return wrapper
+    return decorator
+
+
+def render_prometheus() -> str:
+    return registry.render_prometheus()
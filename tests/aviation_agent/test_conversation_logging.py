@@ -0,0 +1,149 @@
+"""
+Tests for the background conversation/feedback log writer.
+
+Writes to tmp_path only; no agent or LLM is involved.
+"""
+
+from __future__ import annotations
+
+import json
+import time
+
+import pytest
+
+from shared.aviation_agent.adapters.logging import (
+    ConversationLogWriter,
+    find_conversation_by_run_id,
+    get_log_writer,
+    log_conversation_from_state,
+    log_feedback,
+)
+
+
+def _entry(run_id, question="Find airports near Paris"):
+    return {
+        "session_id": "s1",
+        "timestamp": "2025-01-15T10:30:00",
+        "question": question,
+        "answer": "LFPG, LFPO",
+        "run_id": run_id,
+    }
+
+
+def _read_segments(log_dir, pattern):
+    lines = []
+    for path in sorted(log_dir.glob(pattern)):
+        lines.extend(json.loads(line) for line in path.read_text(encoding="utf-8").splitlines())
+    return lines
+
+
+@pytest.mark.unit
+class TestConversationLogWriter:
+    def test_batches_append_to_daily_segment(self, tmp_path):
+        writer = ConversationLogWriter(tmp_path)
+        for i in range(5):
+            writer.log_conversation(_entry(f"run-{i}"))
+        writer.close()
+
+        entries = _read_segments(tmp_path, "2025-01-15.*.jsonl")
+        assert [e["run_id"] for e in entries] == [f"run-{i}" for i in range(5)]
+
+    def test_find_uses_index(self, tmp_path):
+        writer = ConversationLogWriter(tmp_path)
+        writer.log_conversation(_entry("run-a", "first"))
+        writer.log_conversation(_entry("run-b", "second, with ünïcode"))
+        writer.close()
+
+        reader = ConversationLogWriter(tmp_path)
+        assert reader.find("run-b")["question"] == "second, with ünïcode"
+        assert reader.find("run-a")["question"] == "first"
+        assert reader.find("missing") is None
+        reader.close()
+
+    def test_find_sees_queued_entries(self, tmp_path):
+        writer = ConversationLogWriter(tmp_path, flush_interval_s=5.0)
+        writer.log_conversation(_entry("run-q"))
+        # Possibly not written yet, but feedback can already attach to it
+        assert writer.find("run-q")["run_id"] == "run-q"
+        writer.close()
+        assert writer.find("run-q")["run_id"] == "run-q"
+
+    def test_feedback_goes_to_feedback_segment_and_is_not_indexed(self, tmp_path):
+        writer = ConversationLogWriter(tmp_path)
+        writer.log_feedback({"run_id": "run-f", "timestamp": "2025-01-15T11:00:00", "score": 1})
+        writer.close()
+
+        assert [e["score"] for e in _read_segments(tmp_path, "2025-01-15-feedback.*.jsonl")] == [1]
+        assert _read_segments(tmp_path, "2025-01-15.*.jsonl") == []
+        assert ConversationLogWriter(tmp_path).find("run-f") is None
+
+    def test_steady_trickle_flushes_within_interval(self, tmp_path):
+        writer = ConversationLogWriter(tmp_path, flush_interval_s=0.2, batch_size=1000)
+        start = time.monotonic()
+        # Entries keep arriving faster than the interval; the first must not wait for a gap
+        while not _read_segments(tmp_path, "2025-01-15.*.jsonl") and time.monotonic() - start < 2.0:
+            writer.log_conversation(_entry(f"run-{time.monotonic()}"))
+            time.sleep(0.05)
+        elapsed = time.monotonic() - start
+        writer.close()
+
+        assert elapsed < 1.0
+
+    def test_unserializable_entry_only_drops_itself(self, tmp_path):
+        writer = ConversationLogWriter(tmp_path, flush_interval_s=5.0)
+        writer.log_conversation(_entry("run-1"))
+        writer.log_conversation({**_entry("run-bad"), "answer": object()})
+        writer.log_conversation(_entry("run-3"))
+        writer.close()
+
+        entries = _read_segments(tmp_path, "2025-01-15.*.jsonl")
+        assert [e["run_id"] for e in entries] == ["run-1", "run-3"]
+        reader = ConversationLogWriter(tmp_path)
+        assert reader.find("run-3")["run_id"] == "run-3"
+        assert reader.find("run-bad") is None
+        reader.close()
+
+    def test_closed_writer_rejects_entries(self, tmp_path):
+        writer = ConversationLogWriter(tmp_path)
+        writer.close()
+        with pytest.raises(RuntimeError):
+            writer.log_conversation(_entry("late"))
+
+
+@pytest.mark.unit
+class TestLoggingFunctions:
+    def test_log_and_find_round_trip(self, tmp_path):
+        now = time.time()
+        log_conversation_from_state(
+            session_id="s1",
+            state={"final_answer": "Try LFPN", "tool_results": []},
+            messages=[{"role": "user", "content": "Airports near Paris?"}],
+            start_time=now,
+            end_time=now + 1.5,
+            log_dir=tmp_path,
+            run_id="run-1",
+        )
+        get_log_writer(tmp_path).flush()
+
+        entry = find_conversation_by_run_id("run-1", tmp_path)
+        assert entry["question"] == "Airports near Paris?"
+        assert entry["answer"] == "Try LFPN"
+        assert entry["duration_seconds"] == 1.5
+
+    def test_feedback_includes_conversation(self, tmp_path):
+        log_feedback("run-2", 0, "wrong airport", _entry("run-2"), tmp_path)
+        get_log_writer(tmp_path).flush()
+
+        [feedback] = _read_segments(tmp_path, "*-feedback.*.jsonl")
+        assert feedback["feedback"] == "down"
+        assert feedback["comment"] == "wrong airport"
+        assert feedback["question"] == "Find airports near Paris"
+
+    def test_falls_back_to_legacy_json_logs(self, tmp_path):
+        from datetime import datetime
+
+        legacy = tmp_path / f"{datetime.now().strftime('%Y-%m-%d')}.json"
+        legacy.write_text(json.dumps([_entry("old-run", "legacy question")]), encoding="utf-8")
+
+        assert find_conversation_by_run_id("old-run", tmp_path)["question"] == "legacy question"
+        assert find_conversation_by_run_id("unknown", tmp_path) is None
@@ -0,0 +1,130 @@
+"""
+Tests for ToolRunner: concurrent execution of independent tool calls.
+
+Uses a fake tool client, so no airports.db or LLM is needed.
+"""
+
+from __future__ import annotations
+
+import threading
+import time
+
+import pytest
+
+from shared import tracing
+from shared.aviation_agent.execution import ToolRunner, merge_tool_results
+from shared.aviation_agent.planning import AviationPlan, ToolCall
+
+
+class FakeToolClient:
+    """Tool client whose tools sleep for `delays[tool_name]` seconds."""
+
+    def __init__(self, delays=None, failing=()):
+        self.delays = delays or {}
+        self.failing = set(failing)
+        self.calls = []
+        self._lock = threading.Lock()
+
+    def invoke(self, tool_name, arguments):
+        with self._lock:
+            self.calls.append((tool_name, arguments))
+        time.sleep(self.delays.get(tool_name, 0))
+        if tool_name in self.failing:
+            raise RuntimeError(f"{tool_name} failed")
+        return {"tool": tool_name, "pretty": f"{tool_name} output"}
+
+
+def _plan(*extra: str) -> AviationPlan:
+    return AviationPlan(
+        selected_tool="find_airports_near_route",
+        arguments={"from_location": "EGTF", "to_location": "LFMN"},
+        additional_tool_calls=[ToolCall(tool_name=name, arguments={"n": i}) for i, name in enumerate(extra)],
+    )
+
+
+@pytest.mark.unit
+class TestToolRunner:
+    """Tests for ToolRunner.run_all and merge_tool_results."""
+
+    def test_single_call_runs_inline(self):
+        client = FakeToolClient()
+        results = ToolRunner(client).run_all(_plan())
+
+        assert [r.tool_name for r in results] == ["find_airports_near_route"]
+        assert results[0].result["tool"] == "find_airports_near_route"
+
+    def test_independent_calls_run_concurrently(self):
+        client = FakeToolClient(delays={
+            "find_airports_near_route": 0.3,
+            "answer_rules_question": 0.3,
+            "get_notification_for_airport": 0.3,
+        })
+        start = time.perf_counter()
+        results = ToolRunner(client).run_all(_plan("answer_rules_question", "get_notification_for_airport"))
+        elapsed = time.perf_counter() - start
+
+        assert len(results) == 3
+        assert elapsed < 0.6  # Sequential would be ~0.9s
+
+    def test_results_keep_plan_order(self):
+        # Later calls finish first
+        client = FakeToolClient(delays={"find_airports_near_route": 0.2, "answer_rules_question": 0.1})
+        results = ToolRunner(client).run_all(_plan("answer_rules_question", "browse_rules"))
+
+        assert [r.tool_name for r in results] == [
+            "find_airports_near_route", "answer_rules_question", "browse_rules",
+        ]
+
+    def test_timeout_reported_per_call(self):
+        client = FakeToolClient(delays={"answer_rules_question": 1.0})
+        results = ToolRunner(client, timeout_s=0.2).run_all(_plan("answer_rules_question"))
+
+        assert results[0].error is None
+        assert "timed out" in results[1].error
+
+    def test_failure_reported_per_call(self):
+        client = FakeToolClient(failing={"answer_rules_question"})
+        results = ToolRunner(client).run_all(_plan("answer_rules_question"))
+
+        assert results[0].result is not None
+        assert results[1].result is None
+        assert "failed" in results[1].error
+
+    def test_max_parallel_caps_calls(self):
+        client = FakeToolClient()
+        results = ToolRunner(client, max_parallel=2).run_all(_plan("answer_rules_question", "browse_rules"))
+
+        assert len(results) == 2
+        assert len(client.calls) == 2
+
+    def test_duplicate_calls_dropped(self):
+        plan = _plan("answer_rules_question", "answer_rules_question")
+        plan.additional_tool_calls[1].arguments = {"n": 0}
+
+        assert [c.tool_name for c in plan.get_tool_calls()] == [
+            "find_airports_near_route", "answer_rules_question",
+        ]
+
+    def test_persona_injected_into_every_call(self):
+        client = FakeToolClient()
+        ToolRunner(client).run_all(_plan("answer_rules_question"), {"persona_id": "ifr_touring"})
+
+        assert all(args["_persona_id"] == "ifr_touring" for _, args in client.calls)
+
+    def test_tool_spans_join_request_trace(self):
+        client = FakeToolClient(failing={"browse_rules"})
+        with tracing.start_trace() as trace:
+            ToolRunner(client).run_all(_plan("browse_rules"))
+
+        assert set(trace.spans) == {"tool.find_airports_near_route", "tool.browse_rules"}
+
+    def test_merge_keeps_primary_shape(self):
+        client = FakeToolClient(failing={"browse_rules"})
+        results = ToolRunner(client).run_all(_plan("answer_rules_question", "browse_rules"))
+        merged = merge_tool_results(results[0].result, results[1:])
+
+        assert merged["tool"] == "find_airports_near_route"
+        assert [r["tool"] for r in merged["additional_results"]] == ["answer_rules_question", "browse_rules"]
+        assert merged["pretty"].startswith("find_airports_near_route output")
+        assert "**answer_rules_question:**\nanswer_rules_question output" in merged["pretty"]
+        assert "**browse_rules:** failed" in merged["pretty"]
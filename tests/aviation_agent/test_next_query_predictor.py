@@ -253,6 +253,44 @@ class TestNextQueryPredictor:
         assert len(notification_suggestions) > 0
         assert any(s.tool_name == ToolName.GET_NOTIFICATION_FOR_AIRPORT for s in notification_suggestions)
 
+    def test_filter_suggestion_carries_plan_arguments(self, predictor):
+        """Same-tool filter suggestions carry the current arguments plus the filter (for prefetch)."""
+        context = QueryContext(
+            user_query="Find airports from EGTF to LFMD",
+            tool_used=ToolName.FIND_AIRPORTS_NEAR_ROUTE,
+            tool_arguments={"from_location": "EGTF", "to_location": "LFMD"},
+            filters_applied={},
+            locations_mentioned=["EGTF", "LFMD"],
+            icao_codes_mentioned=["EGTF", "LFMD"],
+            countries_mentioned=[]
+        )
+
+        suggestions = predictor.predict_next_queries(context, max_suggestions=10)
+
+        customs = next(s for s in suggestions if "customs" in s.query_text.lower())
+        assert customs.arguments == {
+            "from_location": "EGTF",
+            "to_location": "LFMD",
+            "filters": {FilterName.POINT_OF_ENTRY: True},
+        }
+
+    def test_notification_suggestion_carries_icao(self, predictor):
+        """Notification suggestion after airport details has the ICAO as its argument."""
+        context = QueryContext(
+            user_query="Details for EGLL",
+            tool_used=ToolName.GET_AIRPORT_DETAILS,
+            tool_arguments={"icao_code": "EGLL"},
+            filters_applied={},
+            locations_mentioned=[],
+            icao_codes_mentioned=["EGLL"],
+            countries_mentioned=[]
+        )
+
+        suggestions = predictor.predict_next_queries(context, max_suggestions=10)
+
+        notification = next(s for s in suggestions if s.tool_name == ToolName.GET_NOTIFICATION_FOR_AIRPORT)
+        assert notification.arguments == {"icao": "EGLL"}
+
     def test_rules_query_suggests_customs_airports(self, predictor):
         """Rules queries suggest border crossing airports."""
         context = QueryContext(
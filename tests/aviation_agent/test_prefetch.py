@@ -0,0 +1,102 @@
+"""
+Tests for speculative prefetch of predicted follow-up tool calls.
+
+Uses a fake tool client, so no airports.db or LLM is needed.
+"""
+
+from __future__ import annotations
+
+import pytest
+
+from shared.aviation_agent.execution import ToolRunner
+from shared.aviation_agent.next_query_predictor import SuggestedQuery
+from shared.aviation_agent.planning import AviationPlan
+from shared.aviation_agent.prefetch import PrefetchCache, SpeculativePrefetcher, normalize_arguments
+
+
+class CountingToolClient:
+    def __init__(self):
+        self.calls = []
+
+    def invoke(self, tool_name, arguments):
+        self.calls.append((tool_name, dict(arguments)))
+        return {"tool": tool_name, "airports": [{"ident": "LFPG"}]}
+
+
+def _suggestion(tool_name, arguments, priority=5):
+    return SuggestedQuery(query_text=f"{tool_name}?", tool_name=tool_name, category="route",
+                          priority=priority, arguments=arguments)
+
+
+@pytest.fixture
+def setup():
+    client = CountingToolClient()
+    cache = PrefetchCache(ttl_s=60)
+    runner = ToolRunner(client, prefetch_cache=cache)
+    prefetcher = SpeculativePrefetcher(runner, cache, max_calls=2)
+    return client, cache, runner, prefetcher
+
+
+@pytest.mark.unit
+class TestPrefetch:
+    """Tests for PrefetchCache, SpeculativePrefetcher and the ToolRunner cache check."""
+
+    def test_normalize_drops_empty_values(self):
+        assert normalize_arguments({"query": "FR", "filters": {}, "tags": [], "country": None}) == {"query": "FR"}
+        assert normalize_arguments({"filters": {"has_avgas": False}}) == {"filters": {"has_avgas": False}}
+
+    def test_select_calls_skips_unknown_arguments_and_expensive_tools(self, setup):
+        _, _, _, prefetcher = setup
+        calls = prefetcher.select_calls([
+            _suggestion("answer_rules_question", {"country_code": "FR"}),
+            _suggestion("get_airport_details", None),
+            _suggestion("get_notification_for_airport", {"icao": "LFQA"}),
+            _suggestion("search_airports", {"query": "FR"}),
+            _suggestion("browse_rules", {"country_code": "FR"}),
+        ])
+
+        assert calls == [
+            {"tool": "get_notification_for_airport", "arguments": {"icao": "LFQA"}},
+            {"tool": "search_airports", "arguments": {"query": "FR"}},
+        ]
+
+    def test_prefetched_result_used_by_tool_runner(self, setup):
+        client, _, runner, prefetcher = setup
+        prefetcher.schedule("thread-1", [{"tool": "search_airports", "arguments": {"query": "FR"}}])
+        prefetcher.shutdown()
+        assert len(client.calls) == 1
+
+        plan = AviationPlan(selected_tool="search_airports", arguments={"query": "FR", "filters": {}})
+        results = runner.run_all(plan, thread_id="thread-1")
+
+        assert results[0].prefetched
+        assert results[0].result["tool"] == "search_airports"
+        assert len(client.calls) == 1
+
+    def test_cache_is_per_thread_and_persona(self, setup):
+        client, _, runner, prefetcher = setup
+        prefetcher.schedule("thread-1", [{"tool": "search_airports", "arguments": {"query": "FR"}}],
+                            persona_id="ifr_touring")
+        prefetcher.shutdown()
+
+        plan = AviationPlan(selected_tool="search_airports", arguments={"query": "FR"})
+        assert not runner.run_all(plan, thread_id="thread-2")[0].prefetched
+        assert not runner.run_all(plan, {"persona_id": "vfr_budget"}, thread_id="thread-1")[0].prefetched
+        assert runner.run_all(plan, {"persona_id": "ifr_touring"}, thread_id="thread-1")[0].prefetched
+
+    def test_cached_result_is_copied(self, setup):
+        _, cache, _, _ = setup
+        cache.set("thread-1", "search_airports", {"query": "FR"}, {"airports": [{"ident": "LFPG"}]})
+
+        cache.get("thread-1", "search_airports", {"query": "FR"})["airports"].clear()
+
+        assert cache.get("thread-1", "search_airports", {"query": "FR"})["airports"] == [{"ident": "LFPG"}]
+
+    def test_schedule_skips_cached_calls(self, setup):
+        client, _, _, prefetcher = setup
+        call = {"tool": "get_airport_details", "arguments": {"icao_code": "LFPG"}}
+        prefetcher.schedule("thread-1", [call])
+        prefetcher._executor.shutdown(wait=True)
+
+        assert prefetcher.schedule("thread-1", [call]) == 0
+        assert len(client.calls) == 1
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""
+Unit tests for the rules retrieval cache (retrieval_cache.py).
+"""
+import pytest
+
+from shared.aviation_agent.retrieval_cache import RetrievalCache, cache_key, normalize_query
+
+
+@pytest.mark.unit
+class TestRetrievalCache:
+    """Tests for RetrievalCache."""
+
+    def test_key_depends_on_stage_and_parts(self):
+        assert normalize_query("  Flight   PLAN ") == "flight plan"
+        assert cache_key("results", "q", ["FR"]) == cache_key("results", "q", ["FR"])
+        assert cache_key("results", "q", ["FR"]) != cache_key("results", "q", ["GB"])
+        assert cache_key("embedding", "q") != cache_key("reformulation", "q")
+
+    def test_get_set_and_counters(self):
+        cache = RetrievalCache()
+        assert cache.get("embedding", "model", "q") is None
+        cache.set([0.1, 0.2], "embedding", "model", "q")
+        assert cache.get("embedding", "model", "q") == [0.1, 0.2]
+        assert (cache.hits, cache.misses) == (1, 1)
+
+    def test_lru_eviction_and_ttl(self):
+        cache = RetrievalCache(max_entries=2)
+        cache.set(1, "s", "a")
+        cache.set(2, "s", "b")
+        cache.get("s", "a")  # "b" is now least recently used
+        cache.set(3, "s", "c")
+        assert len(cache) == 2
+        assert cache.get("s", "b") is None
+        assert cache.get("s", "a") == 1
+
+        expired = RetrievalCache(ttl_s=0)
+        expired.set(1, "s", "a")
+        assert expired.get("s", "a") is None
+        assert len(expired) == 0
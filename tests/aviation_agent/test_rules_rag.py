@@ -13,6 +13,7 @@ import pytest
 from shared.aviation_agent.rules_rag import (
     EmbeddingProvider,
     QueryReformulator,
+    RetrievalFallback,
     RulesRAG,
     build_vector_db,
 )
@@ -155,6 +156,15 @@ class TestQueryReformulator:
         result = reformulator.reformulate(original)
         
         assert result == original
+    
+    def test_reformulation_failure_strict(self):
+        """Test that strict mode signals the fallback instead of returning the query."""
+        mock_llm = Mock()
+        mock_llm.invoke.side_effect = Exception("API error")
+        
+        reformulator = QueryReformulator(llm=mock_llm)
+        with pytest.raises(RetrievalFallback):
+            reformulator.reformulate("Test query", strict=True)
 
 
 class TestBuildVectorDB:
@@ -327,6 +337,37 @@ class TestRulesRAG:
         assert isinstance(result['links'], list)
         assert 0 <= result['similarity'] <= 1
 
+    
+    def test_repeated_query_served_from_cache(self, rag_system):
+        """Test that identical questions skip embedding and vector search."""
+        first = rag_system.retrieve_rules(query="Flight plan", countries=["FR"], top_k=2)
+        
+        with patch.object(rag_system.embedding_provider, "embed_query") as embed:
+            second = rag_system.retrieve_rules(query="  flight PLAN ", countries=["fr"], top_k=2)
+            embed.assert_not_called()
+        
+        assert second == first
+        second.clear()  # Callers get copies
+        assert rag_system.retrieve_rules(query="Flight plan", countries=["FR"], top_k=2) == first
+    
+    def test_reranker_fallback_not_cached(self, rag_system):
+        """Test that results are not cached when reranking fell back."""
+        rag_system.enable_reranking = True
+        rag_system.reranker = Mock()
+        rag_system.reranker.rerank.side_effect = RetrievalFallback("reranking")
+        
+        first = rag_system.retrieve_rules(query="Flight plan", countries=["FR"], top_k=1)
+        assert len(first) == 1
+        
+        rag_system.reranker.rerank.side_effect = lambda documents, top_k, **kwargs: documents[:top_k]
+        second = rag_system.retrieve_rules(query="Flight plan", countries=["FR"], top_k=1)
+        
+        # Second call ran retrieval again (reranker called), then its results are cached
+        assert second == first
+        assert rag_system.reranker.rerank.call_count == 2
+        rag_system.retrieve_rules(query="Flight plan", countries=["FR"], top_k=1)
+        assert rag_system.reranker.rerank.call_count == 2
+
 
 @pytest.mark.integration
 class TestRulesRAGIntegration:
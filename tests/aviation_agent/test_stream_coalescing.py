@@ -0,0 +1,113 @@
+"""
+Tests for coalesced SSE streaming (coalesce_stream, compact_final_state).
+
+Feeds synthetic event sequences, so no agent or LLM is needed.
+"""
+
+from __future__ import annotations
+
+import asyncio
+
+import pytest
+
+from shared.aviation_agent.adapters.streaming import coalesce_stream, compact_final_state
+
+
+async def _events(events, delays=None):
+    for i, event in enumerate(events):
+        if delays and delays[i]:
+            await asyncio.sleep(delays[i])
+        yield event
+
+
+def _collect(events, **kwargs):
+    async def run():
+        return [event async for event in coalesce_stream(events, **kwargs)]
+    return asyncio.run(run())
+
+
+def _message(text):
+    return {"event": "message", "data": {"content": text}}
+
+
+@pytest.mark.unit
+class TestCoalesceStream:
+    """Tests for token coalescing and final-state compaction."""
+
+    def test_merges_consecutive_tokens(self):
+        out = _collect(_events([_message("Hel"), _message("lo "), _message("pilot"), {"event": "done", "data": {}}]))
+
+        assert out == [_message("Hello pilot"), {"event": "done", "data": {}}]
+
+    def test_flushes_before_other_events(self):
+        out = _collect(_events([
+            _message("a"), {"event": "ui_payload", "data": {"kind": "route"}}, _message("b"),
+        ]))
+
+        assert [e["event"] for e in out] == ["message", "ui_payload", "message"]
+        assert out[0]["data"]["content"] == "a"
+        assert out[2]["data"]["content"] == "b"
+
+    def test_size_bound(self):
+        out = _collect(_events([_message("x" * 5)] * 4), max_chars=10)
+
+        assert [e["data"]["content"] for e in out] == ["x" * 10, "x" * 10]
+
+    def test_time_bound_while_next_token_is_slow(self):
+        events = _events([_message("first"), _message("second")], delays=[0, 0.3])
+        out = _collect(events, max_delay_s=0.05)
+
+        assert [e["data"]["content"] for e in out] == ["first", "second"]
+
+    def test_final_answer_compacted(self):
+        state = {
+            "final_answer": "Long answer",
+            "tool_result": {"airports": [{"ident": "LFPG"}] * 50},
+            "ui_payload": {"kind": "airport"},
+            "persona_id": "ifr_touring",
+            "error": None,
+        }
+        out = _collect(_events([
+            {"event": "tool_call_end", "data": {"result": state["tool_result"]}},
+            _message("Long answer"),
+            {"event": "ui_payload", "data": state["ui_payload"]},
+            {"event": "final_answer", "data": {"state": state}},
+        ]))
+
+        assert out[-1]["data"] == {
+            "state": {"persona_id": "ifr_touring", "error": None},
+            "streamed": {"final_answer": "message", "tool_result": "tool_call_end", "ui_payload": "ui_payload"},
+        }
+
+    def test_unstreamed_fields_kept(self):
+        state = {
+            "final_answer": "Error formatting response",
+            "thinking": "planning + formatting",
+            "planning_reasoning": "planning",
+            "tool_result": {"airports": []},
+            "tool_results": [{"airports": []}, {"rules": []}],
+        }
+        out = _collect(_events([
+            {"event": "thinking", "data": {"content": "planning"}},
+            {"event": "tool_call_end", "data": {"result": state["tool_result"]}},
+            {"event": "final_answer", "data": {"state": state}},
+        ]))
+
+        # No message events (error path): the answer, combined thinking and extra results stay
+        assert out[-1]["data"] == {
+            "state": {
+                "final_answer": "Error formatting response",
+                "thinking": "planning + formatting",
+                "tool_results": [{"airports": []}, {"rules": []}],
+            },
+            "streamed": {"planning_reasoning": "thinking", "tool_result": "tool_call_end"},
+        }
+
+    def test_final_answer_kept_without_compaction(self):
+        state = {"final_answer": "Answer", "persona_id": "ifr_touring"}
+        out = _collect(_events([{"event": "final_answer", "data": {"state": state}}]), compact_final=False)
+
+        assert out[0]["data"]["state"] == state
+
+    def test_compact_final_state_empty(self):
+        assert compact_final_state({}) == {"state": {}, "streamed": {}}
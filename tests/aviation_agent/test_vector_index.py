@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+Unit tests for the in-process rules vector index (vector_index.py).
+"""
+import numpy as np
+import pytest
+
+from shared.aviation_agent.vector_index import LocalVectorIndex, export_collection, read_manifest
+
+BUILT_AT = "2025-01-01T00:00:00+00:00"
+
+
+class FakeCollection:
+    """Chroma collection stand-in for export."""
+
+    name = "aviation_rules"
+    metadata = {"built_at": BUILT_AT}
+
+    def get(self, include=None):
+        return {
+            "ids": ["q1_FR", "q1_GB", "q2_FR"],
+            "documents": ["Flight plan?", "Flight plan?", "Customs?"],
+            "metadatas": [
+                {"question_id": "q1", "country_code": "FR"},
+                {"question_id": "q1", "country_code": "GB"},
+                {"question_id": "q2", "country_code": "FR"},
+            ],
+            "embeddings": [[1.0, 0.0], [0.0, 1.0], [0.6, 0.8]],
+        }
+
+
+@pytest.fixture
+def index():
+    data = FakeCollection().get()
+    return LocalVectorIndex(
+        data["ids"], data["documents"], data["metadatas"],
+        np.asarray(data["embeddings"], dtype=np.float32), {"built_at": BUILT_AT},
+    )
+
+
+@pytest.mark.unit
+class TestLocalVectorIndex:
+    """Tests for LocalVectorIndex."""
+
+    def test_query_returns_nearest_with_l2_distances(self, index):
+        results = index.query(query_embeddings=[[1.0, 0.0]], n_results=2)
+
+        assert results["ids"] == [["q1_FR", "q2_FR"]]
+        assert results["distances"][0] == pytest.approx([0.0, 0.8], abs=1e-6)
+        assert results["documents"][0] == ["Flight plan?", "Customs?"]
+
+    def test_country_filter(self, index):
+        gb = index.query(query_embeddings=[[1.0, 0.0]], n_results=5, where={"country_code": {"$in": ["GB"]}})
+        assert gb["ids"] == [["q1_GB"]]
+
+        none = index.query(query_embeddings=[[1.0, 0.0]], n_results=5, where={"country_code": {"$in": ["DE"]}})
+        assert none["ids"] == [[]]
+
+        with pytest.raises(ValueError):
+            index.query(query_embeddings=[[1.0, 0.0]], where={"category": "VFR"})
+
+    def test_export_and_load(self, tmp_path):
+        path = tmp_path / "rules_vector_index"
+        assert export_collection(FakeCollection(), path) == 3
+        assert read_manifest(path)["built_at"] == BUILT_AT
+
+        loaded = LocalVectorIndex.load(path)
+        assert loaded.count() == 3
+        assert loaded.embeddings.dtype == np.float32
+        assert loaded.metadata["built_at"] == BUILT_AT
+        assert loaded.query(query_embeddings=[[0.0, 1.0]], n_results=1)["ids"] == [["q1_GB"]]
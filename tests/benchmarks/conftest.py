@@ -0,0 +1,97 @@
+"""
+Fixtures for the performance benchmarks.
+
+Every benchmark runs once per airports database (data/airports_small.db and
+data/airports.db, whichever exist). Geoapify is replaced by a fixed table of
+places and no LLM or embedding API is called, so runs are reproducible offline.
+
+    RUN_BENCHMARKS=1 pytest -m benchmark tests/benchmarks -s
+"""
+
+from __future__ import annotations
+
+import os
+from pathlib import Path
+from typing import Any, Dict, Optional
+
+import pytest
+
+from shared.tool_context import ToolContext, ToolContextSettings
+
+from . import harness
+
+DATA_DIR = Path(__file__).resolve().parents[2] / "data"
+DATABASES = ("airports_small.db", "airports.db")
+
+# Stand-in geocoder results for the locations used by the benchmarks
+PLACES: Dict[str, Dict[str, Any]] = {
+    "paris": {"lat": 48.8566, "lon": 2.3522, "formatted": "Paris, France", "country_code": "fr"},
+    "lyon": {"lat": 45.7640, "lon": 4.8357, "formatted": "Lyon, France", "country_code": "fr"},
+    "munich": {"lat": 48.1351, "lon": 11.5820, "formatted": "Munich, Germany", "country_code": "de"},
+    "lake geneva": {"lat": 46.4531, "lon": 6.5530, "formatted": "Lake Geneva", "country_code": "ch"},
+    "bromley": {"lat": 51.4039, "lon": 0.0198, "formatted": "Bromley, UK", "country_code": "gb"},
+}
+
+
+def _stub_geocode(query: str) -> Optional[Dict[str, Any]]:
+    return PLACES.get(query.strip().lower())
+
+
+@pytest.fixture(scope="session", autouse=True)
+def stub_geocoding():
+    """Resolve locations from PLACES instead of calling Geoapify."""
+    with pytest.MonkeyPatch.context() as mp:
+        mp.setattr("shared.airport_tools._geoapify_geocode", _stub_geocode)
+        yield
+
+
+def _existing_databases():
+    return [name for name in DATABASES if (DATA_DIR / name).exists()]
+
+
+@pytest.fixture(scope="session", params=_existing_databases() or [None])
+def bench_db(request) -> Path:
+    if request.param is None:
+        pytest.skip(f"No airports database in {DATA_DIR}")
+    return DATA_DIR / request.param
+
+
+def bench_settings(airports_db: Path) -> ToolContextSettings:
+    """Settings pointing at the repository data files (optional services only if present)."""
+    def optional(name: str) -> Optional[Path]:
+        path = DATA_DIR / name
+        return path if path.exists() else None
+
+    return ToolContextSettings(
+        airports_db=airports_db,
+        rules_json=DATA_DIR / "rules.json",
+        ga_notifications_db=optional("ga_notifications.db") or Path("ga_notifications.db"),
+        ga_meta_db=optional("ga_persona.db"),
+    )
+
+
+@pytest.fixture(scope="session")
+def bench_context(bench_db: Path) -> ToolContext:
+    """ToolContext on one database, without RAG/comparison (no vector DB needed)."""
+    context = ToolContext.create(bench_settings(bench_db), load_rag=False, load_comparison=False)
+    context.indexes.warm()
+    return context
+
+
+@pytest.fixture(scope="session")
+def bench_label(bench_db: Path) -> str:
+    """Prefix for result names, e.g. "airports_small" """
+    return bench_db.stem
+
+
+def pytest_terminal_summary(terminalreporter, exitstatus, config):
+    if not harness.results:
+        return
+    terminalreporter.section("benchmarks")
+    terminalreporter.write_line(harness.HEADER)
+    for result in harness.results:
+        terminalreporter.write_line(result.row())
+    output = os.getenv("BENCHMARK_OUTPUT")
+    if output:
+        harness.write_results(output)
+        terminalreporter.write_line(f"Results written to {output}")
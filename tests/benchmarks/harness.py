@@ -0,0 +1,147 @@
+"""
+Timing harness for the benchmark suite.
+
+measure() runs a callable repeatedly (optionally from several threads) and
+reports latency percentiles, throughput and the process's peak RSS. Results
+are collected for the end-of-session table and can be written to / compared
+against a JSON baseline:
+
+    BENCHMARK_OUTPUT=bench.json       write results after the run
+    BENCHMARK_BASELINE=bench.json     fail benchmarks whose p99 regressed
+    BENCHMARK_TOLERANCE=0.25          allowed p99 slowdown vs baseline (default 25%)
+"""
+
+from __future__ import annotations
+
+import json
+import math
+import os
+import resource
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import asdict, dataclass
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional
+
+RUN_BENCHMARKS = os.getenv("RUN_BENCHMARKS") == "1"
+SKIP_REASON = "Set RUN_BENCHMARKS=1 to run performance benchmarks"
+
+
+@dataclass
+class BenchmarkResult:
+    name: str
+    iterations: int
+    concurrency: int
+    p50_ms: float
+    p99_ms: float
+    mean_ms: float
+    throughput_per_s: float
+    peak_rss_mb: float
+
+    def row(self) -> str:
+        return (
+            f"{self.name:<58} {self.p50_ms:>9.2f} {self.p99_ms:>9.2f} "
+            f"{self.throughput_per_s:>10.1f} {self.concurrency:>4} {self.peak_rss_mb:>9.1f}"
+        )
+
+
+HEADER = f"{'benchmark':<58} {'p50 ms':>9} {'p99 ms':>9} {'ops/s':>10} {'thr':>4} {'rss MB':>9}"
+
+results: List[BenchmarkResult] = []
+
+
+def peak_rss_mb() -> float:
+    """Peak resident set size of this process (ru_maxrss is KiB on Linux, bytes on macOS)."""
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak / (1024 * 1024) if sys.platform == "darwin" else peak / 1024
+
+
+def percentile(sorted_values: List[float], fraction: float) -> float:
+    """Nearest-rank percentile of an ascending list."""
+    return sorted_values[max(0, math.ceil(fraction * len(sorted_values)) - 1)]
+
+
+def measure(
+    name: str,
+    func: Callable[[int], Any],
+    iterations: int = 50,
+    concurrency: int = 1,
+    warmup: int = 3,
+) -> BenchmarkResult:
+    """
+    Time `iterations` calls of func(i), spread over `concurrency` threads.
+
+    func receives the iteration number so it can rotate through inputs.
+    Warmup calls (caches, lazy indexes) are not timed.
+    """
+    for i in range(warmup):
+        func(i)
+
+    durations: List[float] = []
+    lock = threading.Lock()
+
+    def timed(i: int) -> None:
+        start = time.perf_counter()
+        func(i)
+        elapsed = time.perf_counter() - start
+        with lock:
+            durations.append(elapsed)
+
+    wall_start = time.perf_counter()
+    if concurrency <= 1:
+        for i in range(iterations):
+            timed(i)
+    else:
+        with ThreadPoolExecutor(max_workers=concurrency) as pool:
+            for future in [pool.submit(timed, i) for i in range(iterations)]:
+                future.result()
+    wall = time.perf_counter() - wall_start
+
+    durations.sort()
+    result = BenchmarkResult(
+        name=name,
+        iterations=iterations,
+        concurrency=concurrency,
+        p50_ms=percentile(durations, 0.50) * 1000,
+        p99_ms=percentile(durations, 0.99) * 1000,
+        mean_ms=sum(durations) / len(durations) * 1000,
+        throughput_per_s=iterations / wall if wall > 0 else float("inf"),
+        peak_rss_mb=peak_rss_mb(),
+    )
+    results.append(result)
+    check_regression(result)
+    return result
+
+
+def _load_baseline() -> Dict[str, Dict[str, Any]]:
+    path = os.getenv("BENCHMARK_BASELINE")
+    if not path or not Path(path).exists():
+        return {}
+    with open(path, encoding="utf-8") as f:
+        return {entry["name"]: entry for entry in json.load(f)}
+
+
+_baseline: Optional[Dict[str, Dict[str, Any]]] = None
+
+
+def check_regression(result: BenchmarkResult) -> None:
+    """Fail if p99 exceeds the baseline's by more than BENCHMARK_TOLERANCE."""
+    global _baseline
+    if _baseline is None:
+        _baseline = _load_baseline()
+    previous = _baseline.get(result.name)
+    if not previous:
+        return
+    tolerance = float(os.getenv("BENCHMARK_TOLERANCE", "0.25"))
+    limit = previous["p99_ms"] * (1 + tolerance)
+    assert result.p99_ms <= limit, (
+        f"{result.name}: p99 {result.p99_ms:.2f} ms exceeds baseline "
+        f"{previous['p99_ms']:.2f} ms by more than {tolerance:.0%}"
+    )
+
+
+def write_results(path: str) -> None:
+    with open(path, "w", encoding="utf-8") as f:
+        json.dump([asdict(r) for r in results], f, indent=2)
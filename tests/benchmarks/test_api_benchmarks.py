@@ -0,0 +1,92 @@
+"""
+Concurrent-load benchmarks for the main FastAPI endpoints.
+
+Runs the real app (lifespan included) in-process through TestClient, on each
+airports database. Rate limiting is disabled and geocoding is stubbed; the
+aviation agent chat endpoint is not covered (it needs an LLM).
+"""
+
+from __future__ import annotations
+
+import sys
+from pathlib import Path
+
+import pytest
+
+from .conftest import DATA_DIR
+from .harness import RUN_BENCHMARKS, SKIP_REASON, measure
+
+pytestmark = [pytest.mark.benchmark, pytest.mark.skipif(not RUN_BENCHMARKS, reason=SKIP_REASON)]
+
+WEB_SERVER_DIR = Path(__file__).resolve().parents[2] / "web" / "server"
+
+# (name, paths rotated through by the benchmark)
+ENDPOINTS = [
+    ("airports[country]", ["/api/airports/?country=FR", "/api/airports/?country=DE", "/api/airports/?country=GB"]),
+    ("airports[bbox]", ["/api/airports/?bbox=50,45,5,-1", "/api/airports/?bbox=52,47,12,6"]),
+    ("airports[tile]", ["/api/airports/?tile=6/32/22", "/api/airports/?tile=6/33/22", "/api/airports/?tile=6/32/21"]),
+    ("airports[columnar]", ["/api/airports/?limit=10000&format=columnar"]),
+    ("route-search", ["/api/airports/route-search?airports=EGTF,LFMD", "/api/airports/route-search?airports=EGKB,LFPN,LSGG"]),
+    ("locate", ["/api/airports/locate?q=Paris", "/api/airports/locate?q=Munich&radius_nm=30"]),
+    ("search", ["/api/airports/search/LFP", "/api/airports/search/Lyon"]),
+    ("detail", ["/api/airports/LFPG", "/api/airports/EGLL", "/api/airports/EDDM"]),
+    ("statistics", ["/api/statistics/overview"]),
+]
+
+
+def _import_fresh_main():
+    """
+    Import main for the current environment.
+
+    main, the api modules and the cached settings are module-level singletons, so
+    without this the second bench_db would reuse the first database.
+    """
+    from shared.tool_context import get_tool_context_settings
+    from shared.aviation_agent import config as agent_config
+
+    for name, module in list(sys.modules.items()):
+        if (getattr(module, "__file__", None) or "").startswith(str(WEB_SERVER_DIR)):
+            del sys.modules[name]
+    get_tool_context_settings.cache_clear()
+    agent_config.get_settings.cache_clear()
+    agent_config._cached_tool_context.cache_clear()
+
+    import main
+    return main
+
+
+@pytest.fixture(scope="module")
+def client(bench_db):
+    pytest.importorskip("fastapi.testclient")
+    if str(WEB_SERVER_DIR) not in sys.path:
+        sys.path.insert(0, str(WEB_SERVER_DIR))
+    pytest.importorskip("security_config", reason="web/server/security_config.py not configured")
+
+    from fastapi.testclient import TestClient
+
+    with pytest.MonkeyPatch.context() as mp:
+        mp.setenv("AIRPORTS_DB", str(bench_db))
+        mp.setenv("RULES_JSON", str(DATA_DIR / "rules.json"))
+        for env, name in (("GA_PERSONA_DB", "ga_persona.db"), ("GA_NOTIFICATIONS_DB", "ga_notifications.db")):
+            if (DATA_DIR / name).exists():
+                mp.setenv(env, str(DATA_DIR / name))
+
+        main = _import_fresh_main()
+
+        async def allow(client, path):
+            return True, None
+
+        mp.setattr(main.rate_limiter, "check_async", allow)
+        with TestClient(main.app, base_url="http://localhost") as test_client:
+            yield test_client
+
+
+@pytest.mark.parametrize("name,paths", ENDPOINTS, ids=[name for name, _ in ENDPOINTS])
+@pytest.mark.parametrize("concurrency", [1, 16])
+def test_endpoint(client, bench_label, name, paths, concurrency):
+    def request(i):
+        response = client.get(paths[i % len(paths)])
+        assert response.status_code == 200, f"{response.request.url}: {response.status_code}"
+
+    measure(f"{bench_label}/GET {name}[thr={concurrency}]", request,
+            iterations=200 if concurrency > 1 else 50, concurrency=concurrency)
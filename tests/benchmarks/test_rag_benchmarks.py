@@ -0,0 +1,89 @@
+"""
+Latency benchmark for RulesRAG.retrieve_rules on the real rules.json.
+
+OpenAI embeddings are replaced by a deterministic hashed bag-of-words
+embedder, so the vector index is built offline; what is measured is the
+retrieval path (embedding lookup, in-process vector search, multi-country
+expansion), not embedding quality.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import math
+from unittest.mock import patch
+
+import pytest
+
+from shared.aviation_agent.behavior_config import RetrievalConfig
+from shared.aviation_agent.rules_rag import RulesRAG, build_vector_db
+from shared.rules_manager import RulesManager
+
+from .conftest import DATA_DIR
+from .harness import RUN_BENCHMARKS, SKIP_REASON, measure
+
+pytestmark = [pytest.mark.benchmark, pytest.mark.skipif(not RUN_BENCHMARKS, reason=SKIP_REASON)]
+
+DIMENSIONS = 256
+QUERIES = [
+    "Do I need a flight plan for VFR flights?",
+    "What are the customs requirements when arriving from outside Schengen?",
+    "Is night VFR allowed?",
+    "Which documents must be carried on board?",
+    "How do I file a PPR for a private airfield?",
+]
+COUNTRIES = [["FR"], ["GB"], ["FR", "DE", "CH"], ["IT", "ES"], None]
+
+
+class HashedEmbeddings:
+    """Offline stand-in for OpenAIEmbeddings (unit vectors of hashed tokens)."""
+
+    def __init__(self, model=None, **kwargs):
+        self.model = model
+
+    def embed_query(self, text):
+        vector = [0.0] * DIMENSIONS
+        for token in text.lower().split():
+            digest = hashlib.blake2b(token.encode("utf-8"), digest_size=4).digest()
+            vector[int.from_bytes(digest, "little") % DIMENSIONS] += 1.0
+        norm = math.sqrt(sum(v * v for v in vector)) or 1.0
+        return [v / norm for v in vector]
+
+    def embed_documents(self, texts):
+        return [self.embed_query(text) for text in texts]
+
+
+@pytest.fixture(scope="module")
+def rules_rag(tmp_path_factory):
+    rules_json = DATA_DIR / "rules.json"
+    if not rules_json.exists():
+        pytest.skip("data/rules.json not available")
+    out = tmp_path_factory.mktemp("rules_rag")
+    with patch("langchain_openai.OpenAIEmbeddings", HashedEmbeddings):
+        build_vector_db(
+            rules_json_path=rules_json,
+            vector_db_path=out / "chroma",
+            force_rebuild=True,
+            build_answer_embeddings=False,
+            vector_index_path=out / "index",
+        )
+        rules_manager = RulesManager(str(rules_json))
+        rules_manager.load_rules()
+        yield lambda cache: RulesRAG(
+            vector_index_path=out / "index",
+            enable_reformulation=False,
+            rules_manager=rules_manager,
+            retrieval_config=RetrievalConfig(cache_enabled=cache),
+        )
+
+
+@pytest.mark.parametrize("cache", [False, True], ids=["uncached", "cached"])
+@pytest.mark.parametrize("concurrency", [1, 8])
+def test_retrieve_rules(rules_rag, cache, concurrency):
+    rag = rules_rag(cache)
+    measure(
+        f"rules/RulesRAG.retrieve_rules[{'cached' if cache else 'uncached'},thr={concurrency}]",
+        lambda i: rag.retrieve_rules(QUERIES[i % len(QUERIES)], countries=COUNTRIES[i % len(COUNTRIES)]),
+        iterations=100,
+        concurrency=concurrency,
+    )
@@ -0,0 +1,94 @@
+"""
+Latency benchmarks for the shared airport tools and engines.
+
+Single-threaded and concurrent runs on each airports database; geocoding is
+stubbed (see conftest.py).
+"""
+
+from __future__ import annotations
+
+import pytest
+
+from shared.airport_tools import find_airports_near_location, find_airports_near_route, search_airports
+from shared.filtering import FilterEngine
+from shared.prioritization import PriorityEngine
+
+from .harness import RUN_BENCHMARKS, SKIP_REASON, measure
+
+pytestmark = [pytest.mark.benchmark, pytest.mark.skipif(not RUN_BENCHMARKS, reason=SKIP_REASON)]
+
+SEARCH_QUERIES = ["LFPG", "EGKB", "Paris", "Munich", "Le Touquet", "LSGG"]
+ROUTES = [("EGTF", "LFMD"), ("EGKB", "LFPN"), ("EDDM", "LIRQ"), ("LFPN", "LSGG")]
+LOCATIONS = ["Paris", "Lyon", "Munich", "Lake Geneva", "Bromley"]
+FILTER_SETS = [
+    {"country": "FR", "has_hard_runway": True},
+    {"has_avgas": True, "min_runway_length_ft": 2500},
+    {"point_of_entry": True, "exclude_large_airports": True},
+    {"country": "DE", "has_procedures": True, "max_landing_fee": 50},
+]
+
+
+@pytest.mark.parametrize("concurrency", [1, 8])
+def test_search_airports(bench_context, bench_label, concurrency):
+    measure(
+        f"{bench_label}/search_airports[thr={concurrency}]",
+        lambda i: search_airports(bench_context, SEARCH_QUERIES[i % len(SEARCH_QUERIES)], max_results=10),
+        iterations=100,
+        concurrency=concurrency,
+    )
+
+
+@pytest.mark.parametrize("concurrency", [1, 8])
+def test_find_airports_near_route(bench_context, bench_label, concurrency):
+    def run(i):
+        origin, destination = ROUTES[i % len(ROUTES)]
+        return find_airports_near_route(bench_context, origin, destination, max_distance_nm=30, max_results=20)
+
+    measure(f"{bench_label}/find_airports_near_route[thr={concurrency}]", run,
+            iterations=60, concurrency=concurrency)
+
+
+@pytest.mark.parametrize("concurrency", [1, 8])
+def test_find_airports_near_location(bench_context, bench_label, concurrency):
+    measure(
+        f"{bench_label}/find_airports_near_location[thr={concurrency}]",
+        lambda i: find_airports_near_location(bench_context, LOCATIONS[i % len(LOCATIONS)], max_distance_nm=50),
+        iterations=100,
+        concurrency=concurrency,
+    )
+
+
+def test_filter_engine_apply(bench_context, bench_label):
+    airports = bench_context.model.airports.all()
+    engine = FilterEngine(context=bench_context)
+    measure(
+        f"{bench_label}/FilterEngine.apply[all airports]",
+        lambda i: engine.apply(airports, FILTER_SETS[i % len(FILTER_SETS)]),
+        iterations=40,
+    )
+
+
+def test_priority_engine_apply(bench_context, bench_label):
+    candidates = FilterEngine(context=bench_context).apply(
+        bench_context.model.airports.all(), {"exclude_large_airports": True}
+    )[:500]
+    engine = PriorityEngine(context=bench_context)
+    personas = ["ifr_touring_sr22", "vfr_budget", "lunch_stop"]
+    measure(
+        f"{bench_label}/PriorityEngine.apply[500 candidates]",
+        lambda i: engine.apply(candidates, context={"persona_id": personas[i % len(personas)]}, max_results=20),
+        iterations=60,
+    )
+
+
+def test_ga_summaries_batch_dict(bench_context, bench_label):
+    service = bench_context.ga_friendliness_service
+    if not service or not service.enabled:
+        pytest.skip("GA friendliness database not available")
+    icaos = [airport.ident for airport in bench_context.model.airports.all()]
+    batches = [icaos[start:start + 1000] for start in range(0, len(icaos), 1000)] or [[]]
+    measure(
+        f"{bench_label}/get_summaries_batch_dict[1000 icaos]",
+        lambda i: service.get_summaries_batch_dict(batches[i % len(batches)]),
+        iterations=40,
+    )
@@ -0,0 +1,169 @@
+"""
+Unit tests for GAFriendlinessBuilder batch processing.
+"""
+
+from types import SimpleNamespace
+from typing import Dict, List, Set
+
+import pytest
+
+from shared.ga_friendliness import GAFriendlinessSettings, RawReview
+from shared.ga_friendliness.builder import GAFriendlinessBuilder
+from shared.ga_friendliness.interfaces import ReviewSource
+
+
+class InMemoryReviewSource(ReviewSource):
+    """Review source over a fixed list of reviews."""
+
+    def __init__(self, reviews: List[RawReview]):
+        self._by_icao: Dict[str, List[RawReview]] = {}
+        for review in reviews:
+            self._by_icao.setdefault(review.icao, []).append(review)
+
+    def get_reviews(self) -> List[RawReview]:
+        return [r for reviews in self._by_icao.values() for r in reviews]
+
+    def get_reviews_for_icao(self, icao: str) -> List[RawReview]:
+        return self._by_icao.get(icao, [])
+
+    def get_icaos(self) -> Set[str]:
+        return set(self._by_icao)
+
+
+@pytest.fixture
+def reviews(sample_reviews) -> List[RawReview]:
+    """Sample reviews plus a third airport."""
+    return sample_reviews + [
+        RawReview(
+            icao="LFQA",
+            review_text="Friendly staff and a good restaurant on site.",
+            review_id="review_004",
+            rating=5.0,
+            timestamp="2024-07-01T12:00:00Z",
+            source="airfield.directory",
+        ),
+    ]
+
+
+class FakeAirportsDatabase:
+    """airports.db stand-in with hotel fields (501) per airport."""
+
+    def __init__(self, hotels: Dict[str, str]):
+        self.hotels = hotels
+
+    def get_airport(self, icao: str):
+        if icao not in self.hotels:
+            return None
+        entries = [SimpleNamespace(std_field_id=501, value=self.hotels[icao])]
+        return SimpleNamespace(aip_entries=entries, procedures=[])
+
+    def get_airports_with_hospitality_fields(self) -> List[str]:
+        return list(self.hotels)
+
+
+def make_builder(temp_db_path, temp_storage, sample_ontology, sample_personas, **settings):
+    return GAFriendlinessBuilder(
+        settings=GAFriendlinessSettings(ga_meta_db_path=temp_db_path, use_mock_llm=True, **settings),
+        ontology=sample_ontology,
+        personas=sample_personas,
+        storage=temp_storage,
+    )
+
+
+@pytest.mark.unit
+class TestBuilderBatches:
+    """Tests for concurrent extraction with ordered, batched writes."""
+
+    def test_batched_build_writes_all_airports(
+        self, reviews, temp_db_path, temp_storage, sample_ontology, sample_personas
+    ):
+        """Test that batches smaller than the airport count still process everything in order."""
+        builder = make_builder(
+            temp_db_path, temp_storage, sample_ontology, sample_personas,
+            airports_per_batch=2, llm_concurrency=4,
+        )
+        
+        result = builder.build(InMemoryReviewSource(reviews))
+        
+        assert result.success
+        assert result.metrics.successful_airports == 3
+        assert result.metrics.total_reviews == 4
+        assert temp_storage.get_last_successful_icao() == "LFQA"
+        for icao in ("EGKB", "LFAT", "LFQA"):
+            assert temp_storage.get_airfield_stats(icao) is not None
+
+    def test_resume_skips_processed_airports(
+        self, reviews, temp_db_path, temp_storage, sample_ontology, sample_personas
+    ):
+        """Test that resume starts after the last airport written."""
+        temp_storage.set_last_successful_icao("EGKB")
+        builder = make_builder(temp_db_path, temp_storage, sample_ontology, sample_personas)
+        
+        result = builder.build(InMemoryReviewSource(reviews), resume=True)
+        
+        assert result.metrics.total_airports == 2
+        assert temp_storage.get_airfield_stats("EGKB") is None
+        assert temp_storage.get_last_successful_icao() == "LFQA"
+
+
+@pytest.mark.unit
+class TestContentHashIncremental:
+    """Tests for content-hash based incremental rebuilds."""
+
+    def test_unchanged_reviews_are_skipped(
+        self, reviews, temp_db_path, temp_storage, sample_ontology, sample_personas
+    ):
+        """Test that an incremental rebuild only reprocesses the airport whose reviews changed."""
+        make_builder(temp_db_path, temp_storage, sample_ontology, sample_personas).build(
+            InMemoryReviewSource(reviews)
+        )
+        
+        builder = make_builder(temp_db_path, temp_storage, sample_ontology, sample_personas)
+        result = builder.build(InMemoryReviewSource(reviews), incremental=True)
+        assert result.metrics.skipped_airports == 3
+        assert result.metrics.successful_airports == 0
+        
+        edited = [
+            r.model_copy(update={"review_text": "Now with landing fees."}) if r.icao == "LFQA" else r
+            for r in reviews
+        ]
+        result = builder.build(InMemoryReviewSource(edited), incremental=True)
+        assert result.metrics.skipped_airports == 2
+        assert result.metrics.successful_airports == 1
+
+    def test_source_version_change_keeps_hashes(
+        self, reviews, temp_db_path, temp_storage, sample_ontology, sample_personas
+    ):
+        """Test that a new build date (source_version) does not re-extract unchanged airports."""
+        make_builder(
+            temp_db_path, temp_storage, sample_ontology, sample_personas, source_version="build-20250101"
+        ).build(InMemoryReviewSource(reviews))
+        
+        builder = make_builder(
+            temp_db_path, temp_storage, sample_ontology, sample_personas, source_version="build-20250102"
+        )
+        result = builder.build(InMemoryReviewSource(reviews), incremental=True)
+        assert result.metrics.skipped_airports == 3
+        
+        builder = make_builder(
+            temp_db_path, temp_storage, sample_ontology, sample_personas, scoring_version="ga_scores_v2"
+        )
+        result = builder.build(InMemoryReviewSource(reviews), incremental=True)
+        assert result.metrics.successful_airports == 3
+
+    def test_aip_only_skips_unchanged_fields(
+        self, temp_db_path, temp_storage, sample_ontology, sample_personas
+    ):
+        """Test that update_aip_only only recomputes airports whose AIP fields changed."""
+        airports_db = FakeAirportsDatabase({"EGKB": "At the airport", "LFAT": "In the vicinity"})
+        builder = make_builder(temp_db_path, temp_storage, sample_ontology, sample_personas)
+        
+        assert builder.update_aip_only(airports_db).metrics.successful_airports == 2
+        
+        airports_db.hotels["LFAT"] = "At the airport"
+        result = builder.update_aip_only(airports_db)
+        assert result.metrics.successful_airports == 1
+        assert result.metrics.skipped_airports == 1
+        
+        result = builder.update_aip_only(airports_db, force=True)
+        assert result.metrics.successful_airports == 2
@@ -10,6 +10,7 @@ from shared.ga_friendliness import (
     ReviewExtraction,
 )
 from shared.ga_review_agent import ReviewExtractor
+from shared.ga_review_agent.rate_limiter import RateLimiter
 
 
 @pytest.mark.unit
@@ -139,3 +140,74 @@ class TestExtractorValidation:
         for aspect in result.aspects:
             assert sample_ontology.validate_label(aspect.aspect, aspect.label)
 
+
+
+@pytest.mark.unit
+class TestConcurrentExtraction:
+    """Tests for concurrent batch extraction and rate limiting."""
+
+    def test_concurrent_batch_keeps_order(self, sample_ontology):
+        """Test that parallel extraction returns results in input order."""
+        extractor = ReviewExtractor(
+            ontology=sample_ontology,
+            mock_llm=True,
+            max_concurrency=4,
+        )
+        reviews = [(f"Cheap fees, review {i}.", f"r{i}", None) for i in range(12)]
+        
+        results = extractor.extract_batch(reviews)
+        
+        assert [r.review_id for r in results] == [f"r{i}" for i in range(12)]
+        assert all(any(a.aspect == "cost" for a in r.aspects) for r in results)
+
+    def test_rate_limiter_burst(self):
+        """Test that the token bucket allows a burst, then throttles."""
+        limiter = RateLimiter(requests_per_minute=60, burst=2)
+        
+        assert limiter.try_acquire()
+        assert limiter.try_acquire()
+        assert not limiter.try_acquire()  # Refills at one token per second
+        
+        with pytest.raises(ValueError):
+            RateLimiter(requests_per_minute=0)
+
+
+@pytest.mark.unit
+class TestPackedExtraction:
+    """Tests for packing several reviews into one LLM call."""
+
+    def test_packs_follow_groups_and_keep_order(self, sample_ontology):
+        """Test that packs never span airports and results are demultiplexed in order."""
+        extractor = ReviewExtractor(
+            ontology=sample_ontology,
+            mock_llm=True,
+            reviews_per_call=3,
+        )
+        reviews = [(f"Cheap fees, review {i}.", f"r{i}", None) for i in range(7)]
+        groups = ["EGKB"] * 4 + ["LFAT"] * 3
+        
+        results = extractor.extract_batch(reviews, group_keys=groups)
+        
+        assert [r.review_id for r in results] == [f"r{i}" for i in range(7)]
+        assert all(any(a.aspect == "cost" for a in r.aspects) for r in results)
+        
+        usage = extractor.get_token_usage()
+        assert usage["packed_calls"] == 2  # EGKB 3+1, LFAT 3
+        assert usage["reviews_extracted"] == 7
+        assert usage["estimated_input_tokens_saved"] > 0
+
+    def test_invalid_packed_response_falls_back(self, sample_ontology):
+        """Test that a packed response missing reviews triggers single-review extraction."""
+        extractor = ReviewExtractor(
+            ontology=sample_ontology,
+            mock_llm=True,
+            reviews_per_call=4,
+        )
+        extractor._call_llm_packed = lambda texts: {"reviews": [{"index": 1, "aspects": []}]}
+        reviews = [("Very cheap landing fees.", "r1", None), ("Rude and unhelpful staff.", "r2", None)]
+        
+        results = extractor.extract_batch(reviews)
+        
+        assert [r.review_id for r in results] == ["r1", "r2"]
+        assert any(a.aspect == "cost" for a in results[0].aspects)
+        assert extractor.get_token_usage()["packed_fallbacks"] == 1
@@ -0,0 +1,86 @@
+"""
+Unit tests for the in-memory persona score matrix.
+"""
+
+import pytest
+
+from shared.ga_friendliness import PersonaManager
+from shared.ga_friendliness.score_matrix import PersonaScoreMatrix, feature_scores_from_stats
+from shared.ga_friendliness.service import GAFriendlinessService
+
+
+@pytest.fixture
+def populated_storage(temp_storage, sample_airport_stats):
+    """Storage with two airports and one review summary."""
+    temp_storage.write_airfield_stats(sample_airport_stats)
+    temp_storage.write_airfield_stats(
+        sample_airport_stats.model_copy(update={"icao": "LFAT", "review_cost_score": None, "rating_count": 0})
+    )
+    temp_storage.write_review_summary("EGKB", "Friendly staff.", ["GA friendly"])
+    temp_storage.write_meta_info("build_timestamp", "2024-06-01T00:00:00+00:00")
+    return temp_storage
+
+
+@pytest.mark.unit
+class TestPersonaScoreMatrix:
+    """Tests for PersonaScoreMatrix."""
+
+    def test_scores_match_persona_manager(self, populated_storage, sample_personas, sample_airport_stats):
+        """Matrix scores equal direct persona scoring."""
+        manager = PersonaManager(sample_personas)
+        matrix = PersonaScoreMatrix(populated_storage, manager)
+
+        assert len(matrix) == 2
+        features = feature_scores_from_stats(sample_airport_stats)
+        for persona_id in manager.list_persona_ids():
+            assert matrix.score("EGKB", persona_id) == manager.compute_score(persona_id, features)
+        assert matrix.score("XXXX", manager.list_persona_ids()[0]) is None
+        assert matrix.score("EGKB", "unknown_persona") is None
+
+    def test_summary_dict(self, populated_storage, sample_personas):
+        """Summary dicts carry features, all persona scores and review summary."""
+        matrix = PersonaScoreMatrix(populated_storage, PersonaManager(sample_personas))
+
+        summary = matrix.summary_dict("EGKB")
+        assert summary["features"]["review_cost_score"] == 0.65
+        assert set(summary["persona_scores"]) == set(matrix.persona_ids)
+        assert summary["review_count"] == 2
+        assert summary["tags"] == ["GA friendly"]
+        assert summary["summary_text"] == "Friendly staff."
+
+        other = matrix.summary_dict("LFAT")
+        assert other["features"]["review_cost_score"] is None
+        assert other["tags"] is None
+        assert matrix.summary_dict("XXXX") is None
+
+
+@pytest.mark.unit
+class TestServiceScoreMatrix:
+    """GAFriendlinessService batch methods backed by the matrix."""
+
+    def test_batch_matches_per_airport_path(self, populated_storage, temp_db_path):
+        """Readonly (matrix) and writable (SQLite) services return the same batch data."""
+        readonly = GAFriendlinessService(str(temp_db_path), readonly=True)
+        writable = GAFriendlinessService(str(temp_db_path), readonly=False)
+        assert readonly.load_score_matrix()
+        assert not writable.load_score_matrix()
+
+        icaos = ["EGKB", "lfat", "XXXX"]
+        assert readonly.get_summaries_batch_dict(icaos) == writable.get_summaries_batch_dict(icaos)
+        assert readonly.get_persona_scores_batch(icaos) == writable.get_persona_scores_batch(icaos)
+
+    def test_reload_on_build_change(self, populated_storage, temp_db_path, sample_airport_stats):
+        """Matrix reloads only when the build metadata changes."""
+        service = GAFriendlinessService(str(temp_db_path), readonly=True)
+        service.load_score_matrix()
+        first = service._score_matrix
+
+        service._score_matrix_checked_at = 0.0  # Force a metadata check
+        assert service._get_score_matrix() is first
+
+        populated_storage.write_airfield_stats(sample_airport_stats.model_copy(update={"icao": "EDDS"}))
+        populated_storage.write_meta_info("build_timestamp", "2024-07-01T00:00:00+00:00")
+        service._score_matrix_checked_at = 0.0
+        reloaded = service._get_score_matrix()
+        assert reloaded is not first
+        assert "EDDS" in reloaded
@@ -17,6 +17,7 @@ from shared.ga_friendliness import (
     parse_timestamp,
     SCHEMA_VERSION,
 )
+from shared.ga_friendliness.content_hash import HASH_AIP, HASH_REVIEWS, review_set_hash
 
 
 @pytest.mark.unit
@@ -103,6 +104,18 @@ class TestStorageAirfieldStats:
         assert "EGKB" in icaos
         assert "LFAT" in icaos
 
+    def test_get_stats_batch(self, temp_storage, sample_airport_stats):
+        """Test reading stats for many airports at once."""
+        temp_storage.write_airfield_stats(sample_airport_stats)
+        temp_storage.write_airfield_stats(sample_airport_stats.model_copy(update={"icao": "LFAT"}))
+
+        # More ICAOs than one chunk, with duplicates and unknown codes
+        icaos = ["EGKB", "LFAT", "EGKB"] + [f"X{i:03d}" for i in range(600)]
+        result = temp_storage.get_airfield_stats_batch(icaos)
+        assert set(result) == {"EGKB", "LFAT"}
+        assert result["LFAT"].review_cost_score == 0.65
+        assert temp_storage.get_airfield_stats_batch([]) == {}
+
 
 @pytest.mark.unit
 class TestStorageReviewTags:
@@ -227,6 +240,35 @@ class TestStorageTimestamps:
         assert result is not None
 
 
+@pytest.mark.unit
+class TestStorageContentHashes:
+    """Tests for per-airport content hashes."""
+
+    def test_content_hash_roundtrip(self, temp_storage):
+        """Test hashes are stored per kind and airport."""
+        assert temp_storage.get_content_hash(HASH_REVIEWS, "EGKB") is None
+        
+        temp_storage.set_content_hash(HASH_REVIEWS, "EGKB", "abc")
+        temp_storage.set_content_hash(HASH_AIP, "EGKB", "def")
+        
+        assert temp_storage.get_content_hash(HASH_REVIEWS, "EGKB") == "abc"
+        assert temp_storage.get_content_hash(HASH_AIP, "egkb") == "def"
+        assert temp_storage.get_content_hash(HASH_REVIEWS, "LFAT") is None
+
+    def test_review_set_hash_is_order_independent(self, sample_reviews):
+        """Test the review hash depends on content, not order."""
+        assert review_set_hash(sample_reviews) == review_set_hash(list(reversed(sample_reviews)))
+        
+        edited = [r.model_copy(update={"review_text": r.review_text + "!"}) for r in sample_reviews]
+        assert review_set_hash(edited) != review_set_hash(sample_reviews)
+
+    def test_review_set_hash_mixed_none_ratings(self, sample_reviews):
+        """Test duplicate reviews with and without a rating can be hashed."""
+        review = sample_reviews[0]
+        duplicates = [review.model_copy(update={"rating": None}), review.model_copy(update={"rating": 4.0})]
+        assert review_set_hash(duplicates) == review_set_hash(list(reversed(duplicates)))
+
+
 @pytest.mark.unit
 class TestStorageResumeSupport:
     """Tests for resume support operations."""
@@ -0,0 +1,130 @@
+"""
+Unit tests for NotificationService connection pooling and in-memory cache.
+"""
+
+import os
+import sqlite3
+import tempfile
+import threading
+from pathlib import Path
+
+import pytest
+
+from shared.ga_notification_agent.connection_pool import ReadOnlyConnectionPool
+from shared.ga_notification_agent.service import NotificationService
+
+
+def create_notifications_db(path: Path, rows):
+    """Create a minimal ga_notifications.db with the given (icao, type, hours) rows."""
+    conn = sqlite3.connect(path)
+    conn.execute("""
+        CREATE TABLE IF NOT EXISTS ga_notification_requirements (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            icao TEXT NOT NULL,
+            rule_type TEXT,
+            notification_type TEXT,
+            hours_notice INTEGER,
+            operating_hours_start TEXT,
+            operating_hours_end TEXT,
+            weekday_rules TEXT,
+            schengen_rules TEXT,
+            contact_info TEXT,
+            summary TEXT,
+            raw_text TEXT,
+            confidence REAL,
+            llm_response TEXT,
+            created_utc TEXT,
+            UNIQUE(icao, rule_type)
+        )
+    """)
+    conn.execute("DELETE FROM ga_notification_requirements")
+    conn.executemany(
+        "INSERT INTO ga_notification_requirements (icao, rule_type, notification_type, hours_notice, summary, confidence) "
+        "VALUES (?, 'customs', ?, ?, ?, 0.9)",
+        [(icao, ntype, hours, f"{icao} summary") for icao, ntype, hours in rows],
+    )
+    conn.commit()
+    conn.close()
+
+
+@pytest.fixture
+def notifications_db():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = Path(tmpdir) / "ga_notifications.db"
+        create_notifications_db(path, [("LFRG", "hours", 24), ("EGKB", "h24", None), ("LFPT", "on_request", None)])
+        yield path
+
+
+@pytest.mark.unit
+class TestReadOnlyConnectionPool:
+    """Tests for ReadOnlyConnectionPool."""
+
+    def test_reuses_connections(self, notifications_db):
+        pool = ReadOnlyConnectionPool(str(notifications_db), size=2)
+        with pool.connection() as first:
+            pass
+        with pool.connection() as second:
+            assert second is first
+        pool.close()
+
+    def test_read_only(self, notifications_db):
+        pool = ReadOnlyConnectionPool(str(notifications_db))
+        with pytest.raises(sqlite3.OperationalError):
+            with pool.connection() as conn:
+                conn.execute("DELETE FROM ga_notification_requirements")
+
+    def test_concurrent_readers(self, notifications_db):
+        pool = ReadOnlyConnectionPool(str(notifications_db), size=2)
+        counts = []
+
+        def read():
+            for _ in range(20):
+                with pool.connection() as conn:
+                    counts.append(conn.execute("SELECT COUNT(*) FROM ga_notification_requirements").fetchone()[0])
+
+        threads = [threading.Thread(target=read) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert counts == [3] * 80
+
+
+@pytest.mark.unit
+class TestNotificationServiceBatch:
+    """Batch lookups with and without the in-memory cache."""
+
+    @pytest.mark.parametrize("cache_in_memory", [False, True])
+    def test_batch(self, notifications_db, cache_in_memory):
+        service = NotificationService(db_path=str(notifications_db), cache_in_memory=cache_in_memory)
+        result = service.get_notification_info_batch(["lfrg", "EGKB", "XXXX", "LFRG"])
+        assert set(result) == {"LFRG", "EGKB"}
+        assert result["LFRG"].hours_notice == 24
+        assert result["EGKB"].is_h24()
+        assert service.get_notification_info("lfpt").is_on_request()
+        assert service.get_notification_info_batch([]) == {}
+
+    def test_cache_reloads_when_file_changes(self, notifications_db):
+        service = NotificationService(db_path=str(notifications_db), cache_in_memory=True)
+        assert "LFRG" in service.get_notification_info_batch(["LFRG"])
+
+        create_notifications_db(notifications_db, [("EDDS", "hours", 12)])
+        stat = os.stat(notifications_db)
+        os.utime(notifications_db, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1_000_000_000))
+
+        assert service.get_notification_info_batch(["LFRG", "EDDS"]).keys() == {"EDDS"}
+
+    @pytest.mark.parametrize("cache_in_memory", [False, True])
+    def test_first_rule_type_wins(self, notifications_db, cache_in_memory):
+        conn = sqlite3.connect(notifications_db)
+        conn.execute(
+            "INSERT INTO ga_notification_requirements (icao, rule_type, notification_type, hours_notice) "
+            "VALUES ('LFRG', 'immigration', 'hours', 48)"
+        )
+        conn.commit()
+        conn.close()
+        service = NotificationService(db_path=str(notifications_db), cache_in_memory=cache_in_memory)
+
+        # "customs" sorts before "immigration", single and batch lookups agree
+        assert service.get_notification_info("LFRG").hours_notice == 24
+        assert service.get_notification_info_batch(["LFRG"])["LFRG"].hours_notice == 24
@@ -0,0 +1,56 @@
+"""
+Pytest fixtures for indexing tests.
+
+Uses lightweight airport stand-ins with real NavPoint geometry so the indexes
+can be checked against brute-force scans without loading airports.db.
+"""
+
+import random
+from types import SimpleNamespace
+from typing import List
+
+import pytest
+
+from euro_aip.models.navpoint import NavPoint
+
+
+def make_airport(ident: str, lat: float, lon: float, **attrs) -> SimpleNamespace:
+    """Create a minimal airport-like object."""
+    return SimpleNamespace(
+        ident=ident,
+        navpoint=NavPoint(latitude=lat, longitude=lon, name=ident),
+        latitude_deg=lat,
+        longitude_deg=lon,
+        **attrs,
+    )
+
+
+class FakeAirportCollection(list):
+    """List with the `get(ident)` lookup used by the indexes."""
+
+    def get(self, ident: str):
+        for airport in self:
+            if airport.ident == ident:
+                return airport
+        return None
+
+
+def make_model(airports: List[SimpleNamespace]) -> SimpleNamespace:
+    """Create a minimal model-like object exposing `airports`."""
+    return SimpleNamespace(airports=FakeAirportCollection(airports))
+
+
+@pytest.fixture(scope="session")
+def random_airports() -> List[SimpleNamespace]:
+    """A few thousand airports scattered over Europe (deterministic)."""
+    rng = random.Random(42)
+    countries = ["FR", "GB", "DE", "ES", "IT"]
+    return [
+        make_airport(
+            f"X{i:04d}",
+            rng.uniform(35.0, 70.0),
+            rng.uniform(-25.0, 40.0),
+            iso_country=countries[i % len(countries)],
+        )
+        for i in range(3000)
+    ]
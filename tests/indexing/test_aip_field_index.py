@@ -0,0 +1,101 @@
+"""
+Unit tests for the AIP field inverted index.
+
+Results are compared against the per-airport scan it replaces.
+"""
+
+import random
+from types import SimpleNamespace
+
+import pytest
+
+from shared.indexing.aip_field_index import AipFieldIndex
+from .conftest import make_airport
+
+NEGATIVE = ["nil", "none", "na", "n/a", "no", "not available", "unavailable"]
+
+
+def scan_matches(airport, field_name, value=None, operator="contains"):
+    """Reference implementation: the former per-airport scan."""
+    for entry in airport.aip_entries:
+        if entry.std_field != field_name:
+            continue
+        entry_value = entry.value.lower() if entry.value else ""
+        search_value = value.lower() if value else ""
+        if entry_value in NEGATIVE:
+            continue
+        if operator == "contains":
+            if search_value == "avgas" and field_name.lower() in ["fuel and oil types", "fuel types", "fuel"]:
+                if any(term in entry_value for term in ["avgas", "100ll", "100 ll", "100/ll"]):
+                    return True
+            elif search_value in entry_value:
+                return True
+        elif operator == "equals" and entry_value == search_value:
+            return True
+        elif operator == "not_empty" and entry_value:
+            return True
+        elif operator == "starts_with" and entry_value.startswith(search_value):
+            return True
+        elif operator == "ends_with" and entry_value.endswith(search_value):
+            return True
+    return False
+
+
+FIELD_VALUES = {
+    "Fuel and oil types": ["AVGAS 100LL", "100 LL, JET A-1", "Jet A1", "NIL", "Mogas", "100/LL only", None],
+    "Customs and immigration": ["H24", "O/R PPR 24 HR", "Not available", "HO", "On request", ""],
+    "Hotels": ["In the city", "At AD", "nil", "Hotels in vicinity", "N/A"],
+}
+
+
+@pytest.fixture(scope="module")
+def aip_airports():
+    rng = random.Random(11)
+    airports = []
+    for i in range(400):
+        entries = []
+        for field_name, values in FIELD_VALUES.items():
+            for _ in range(rng.randint(0, 2)):
+                entries.append(SimpleNamespace(std_field=field_name, value=rng.choice(values)))
+        airports.append(make_airport(f"A{i:03d}", 50.0, 5.0, aip_entries=entries))
+    return airports
+
+
+QUERIES = [
+    ("Fuel and oil types", "avgas", "contains"),
+    ("Fuel and oil types", "AVGAS", "contains"),
+    ("Fuel and oil types", "jet", "contains"),
+    ("Fuel and oil types", "a1", "contains"),
+    ("Fuel and oil types", "", "contains"),
+    ("Fuel and oil types", None, "not_empty"),
+    ("Fuel and oil types", "mogas", "equals"),
+    ("Customs and immigration", "h24", "equals"),
+    ("Customs and immigration", "o/r", "starts_with"),
+    ("Customs and immigration", "request", "ends_with"),
+    ("Customs and immigration", "", "equals"),
+    ("Customs and immigration", None, "not_empty"),
+    ("Customs and immigration", "24 hr", "contains"),
+    ("Hotels", "avgas", "contains"),
+    ("Hotels", "vicinity", "contains"),
+    ("Hotels", "x", "regex"),
+    ("Unknown field", "x", "contains"),
+]
+
+
+@pytest.mark.unit
+class TestAipFieldIndex:
+    """AipFieldIndex.match must agree with the per-airport scan."""
+
+    @pytest.mark.parametrize("field_name,value,operator", QUERIES)
+    def test_matches_scan(self, aip_airports, field_name, value, operator):
+        index = AipFieldIndex(aip_airports)
+        expected = {a.ident for a in aip_airports if scan_matches(a, field_name, value, operator)}
+        assert index.match(field_name, value, operator) == expected
+
+    def test_cached_result_is_stable(self, aip_airports):
+        index = AipFieldIndex(aip_airports)
+        first = index.match("Hotels", "vicinity", "contains")
+        assert index.match("Hotels", "VICINITY", "contains") is first
+
+    def test_fields(self, aip_airports):
+        assert AipFieldIndex(aip_airports).fields == sorted(FIELD_VALUES)
@@ -0,0 +1,151 @@
+"""
+Unit tests for the column-oriented feature table and FilterEngine's vectorized path.
+"""
+
+import random
+
+import pytest
+
+from shared.filtering import FilterEngine, FilterRegistry
+from shared.indexing import get_model_indexes
+from shared.indexing.feature_table import bitset_indices, bitset_membership, rows_to_bitset
+from shared.tool_context import ToolContext
+from .conftest import make_airport, make_model
+
+
+class FakeGAService:
+    """GA service stand-in exposing the methods used by the filters."""
+
+    def __init__(self, fees, hotels, restaurants):
+        self.fees = fees
+        self.hotels = hotels
+        self.restaurants = restaurants
+
+    def get_landing_fees_by_weight(self, mtow_kg):
+        return dict(self.fees)
+
+    def get_landing_fee_by_weight(self, icao, mtow_kg):
+        fee = self.fees.get(icao)
+        return {"fee": fee} if fee is not None else None
+
+    def get_icaos_by_hospitality(self, hotel=None, restaurant=None):
+        source, value = (self.hotels, hotel) if hotel is not None else (self.restaurants, restaurant)
+        if value == "at_airport":
+            return {icao for icao, info in source.items() if info == "at_airport"}
+        return {icao for icao, info in source.items() if info in ("at_airport", "vicinity")}
+
+    def get_summary_dict(self, icao, persona_id="ifr_touring_sr22"):
+        if icao not in self.hotels and icao not in self.restaurants:
+            return {"has_data": False}
+        return {
+            "has_data": True,
+            "hotel_info": self.hotels.get(icao, "unknown"),
+            "restaurant_info": self.restaurants.get(icao, "unknown"),
+        }
+
+
+@pytest.fixture(scope="module")
+def featured_context():
+    rng = random.Random(7)
+    airports = []
+    for i in range(1500):
+        airports.append(make_airport(
+            f"F{i:04d}",
+            rng.uniform(40.0, 60.0),
+            rng.uniform(-10.0, 20.0),
+            iso_country=rng.choice(["FR", "GB", "DE", "fr", None]),
+            procedures=[1] if rng.random() < 0.3 else [],
+            aip_entries=[1] if rng.random() < 0.6 else [],
+            has_hard_runway=rng.random() < 0.5,
+            point_of_entry=rng.random() < 0.2,
+            type=rng.choice(["small_airport", "medium_airport", "large_airport", None]),
+            avgas=rng.random() < 0.4,
+            jet_a=rng.random() < 0.3,
+            longest_runway_length_ft=rng.choice([None, 1500, 2600, 3000, 5000, 8000, 11000]),
+        ))
+    idents = [a.ident for a in airports]
+    info = ["at_airport", "vicinity", "none", "unknown"]
+    ga_service = FakeGAService(
+        fees={icao: float(rng.randint(5, 80)) for icao in rng.sample(idents, 600)},
+        hotels={icao: rng.choice(info) for icao in rng.sample(idents, 500)},
+        restaurants={icao: rng.choice(info) for icao in rng.sample(idents, 500)},
+    )
+    return ToolContext(model=make_model(airports), ga_friendliness_service=ga_service)
+
+
+FILTER_COMBINATIONS = [
+    {"country": "FR"},
+    {"country": "fr", "has_hard_runway": True},
+    {"has_procedures": False, "point_of_entry": True},
+    {"has_aip_data": True, "exclude_large_airports": True, "has_avgas": True},
+    {"min_runway_length_ft": 3000, "max_runway_length_ft": 8000},
+    {"max_runway_length_ft": "not-a-number"},
+    {"has_jet_a": True, "max_landing_fee": 30},
+    {"hotel": "vicinity"},
+    {"restaurant": "at_airport", "country": "DE"},
+    {"hotel": "sometimes"},
+    {"exclude_large_airports": False, "has_avgas": None},
+]
+
+
+@pytest.mark.unit
+class TestFeatureTableFilters:
+    """Vectorized filtering must match per-airport evaluation exactly."""
+
+    @pytest.mark.parametrize("filters", FILTER_COMBINATIONS)
+    def test_vectorized_matches_object_path(self, featured_context, filters):
+        engine = FilterEngine(context=featured_context)
+        airports = list(featured_context.model.airports)
+        resolved = [(FilterRegistry.get(name), value) for name, value in filters.items()]
+        expected = [a.ident for a in airports if engine._passes(a, resolved)]
+        assert [a.ident for a in engine.apply(airports, filters)] == expected
+
+    def test_subset_input_keeps_order(self, featured_context):
+        engine = FilterEngine(context=featured_context)
+        subset = list(featured_context.model.airports)[::7][::-1]
+        result = engine.apply(subset, {"has_hard_runway": True})
+        assert [a.ident for a in result] == [a.ident for a in subset if a.has_hard_runway]
+
+    def test_foreign_airports_use_object_path(self, featured_context):
+        engine = FilterEngine(context=featured_context)
+        outsider = make_airport("ZZZZ", 50.0, 5.0, iso_country="FR", procedures=[], aip_entries=[])
+        result = engine.apply([outsider], {"country": "FR"})
+        assert [a.ident for a in result] == ["ZZZZ"]
+
+
+@pytest.mark.unit
+class TestBitsets:
+    """Tests for bitset helpers and numeric columns."""
+
+    def test_roundtrip(self):
+        rows = [0, 3, 7, 8, 64, 1000]
+        assert bitset_indices(rows_to_bitset(rows)) == rows
+        assert bitset_indices(0) == []
+
+    def test_numeric_thresholds(self, featured_context):
+        table = get_model_indexes(featured_context.model).features
+        at_least = set(table.indices(table.runway_length.at_least(5000)))
+        expected = {
+            i for i, a in enumerate(table.airports)
+            if a.longest_runway_length_ft is not None and a.longest_runway_length_ft >= 5000
+        }
+        assert at_least == expected
+
+    def test_landing_fee_column_follows_data_version(self, featured_context):
+        table = get_model_indexes(featured_context.model).features
+        ga_service = FakeGAService(fees={"F0001": 10.0}, hotels={}, restaurants={})
+        ga_service.data_version = "v1"
+        assert set(table.indices(table.landing_fee(ga_service, 1000).at_most(50))) == {1}
+
+        # Same version: cached column even though the data changed underneath
+        ga_service.fees = {"F0002": 10.0}
+        assert set(table.indices(table.landing_fee(ga_service, 1000).at_most(50))) == {1}
+
+        # GA database reloaded: new version rebuilds the column
+        ga_service.data_version = "v2"
+        assert set(table.indices(table.landing_fee(ga_service, 1000).at_most(50))) == {2}
+
+    def test_bitset_membership(self):
+        contains = bitset_membership(rows_to_bitset([0, 5, 900]))
+        assert [row for row in range(2000) if contains(row)] == [0, 5, 900]
+        assert not bitset_membership(0)(3)
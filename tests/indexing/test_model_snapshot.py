@@ -0,0 +1,131 @@
+"""
+Unit tests for the prebuilt airports model snapshot.
+"""
+
+import os
+
+import pytest
+
+import shared.model_snapshot as model_snapshot
+from shared.indexing import get_model_indexes
+from shared.model_snapshot import load_airports_model, snapshot_file
+from .conftest import FakeAirportCollection, make_airport
+
+
+class FakeCollection(FakeAirportCollection):
+    """Airport collection with the `count()` used for logging."""
+
+    def count(self):
+        return len(self)
+
+
+class FakeModel:
+    """Model stand-in supporting country removal."""
+
+    def __init__(self, airports):
+        self.airports = FakeCollection(airports)
+
+    def remove_airports_by_country(self, country):
+        self.airports = FakeCollection(a for a in self.airports if a.iso_country != country)
+
+
+def airport(ident, lat, lon, country):
+    """Airport stand-in with the attributes read by all indexes."""
+    return make_airport(
+        ident, lat, lon,
+        iso_country=country, name=ident, municipality=None, iata_code=None,
+        procedures=[], aip_entries=[], runways=[], sources=[], has_hard_runway=True, point_of_entry=False,
+        type="large_airport", avgas=False, jet_a=True, longest_runway_length_ft=10000,
+    )
+
+
+class CountingStorage:
+    """DatabaseStorage stand-in counting full loads."""
+
+    loads = 0
+
+    def __init__(self, path):
+        self.path = path
+
+    def load_model(self):
+        CountingStorage.loads += 1
+        return FakeModel([
+            airport("LFPG", 49.01, 2.55, "FR"),
+            airport("EGLL", 51.47, -0.46, "GB"),
+            airport("UUEE", 55.97, 37.41, "RU"),
+        ])
+
+
+@pytest.fixture
+def airports_db(tmp_path, monkeypatch):
+    monkeypatch.setattr(model_snapshot, "DatabaseStorage", CountingStorage)
+    CountingStorage.loads = 0
+    path = tmp_path / "airports.db"
+    path.write_bytes(b"airports v1")
+    return path
+
+
+@pytest.mark.unit
+class TestModelSnapshot:
+    """Tests for load_airports_model with a snapshot directory."""
+
+    def test_second_load_uses_snapshot_with_indexes(self, airports_db, tmp_path):
+        snapshot_dir = tmp_path / "snapshot"
+        load_airports_model(airports_db, snapshot_dir)
+        assert snapshot_file(snapshot_dir).exists()
+
+        model = load_airports_model(airports_db, snapshot_dir)
+
+        assert CountingStorage.loads == 1
+        assert [a.ident for a in model.airports] == ["LFPG", "EGLL", "UUEE"]
+        indexes = get_model_indexes(model)
+        assert indexes._spatial is not None  # Prebuilt, not rebuilt lazily
+        assert indexes.airport("lfpg") is model.airports[0]
+
+    def test_source_change_invalidates_snapshot(self, airports_db, tmp_path):
+        snapshot_dir = tmp_path / "snapshot"
+        load_airports_model(airports_db, snapshot_dir)
+
+        # Same contents with a new mtime (e.g. copied into a container): still valid
+        stat = airports_db.stat()
+        os.utime(airports_db, ns=(stat.st_atime_ns, stat.st_mtime_ns + 10**9))
+        load_airports_model(airports_db, snapshot_dir)
+        assert CountingStorage.loads == 1
+
+        airports_db.write_bytes(b"airports v2")
+        load_airports_model(airports_db, snapshot_dir)
+        assert CountingStorage.loads == 2
+
+    def test_euro_aip_upgrade_invalidates_snapshot(self, airports_db, tmp_path, monkeypatch):
+        snapshot_dir = tmp_path / "snapshot"
+        monkeypatch.setattr(model_snapshot, "euro_aip_version", lambda: "1.0")
+        load_airports_model(airports_db, snapshot_dir)
+        load_airports_model(airports_db, snapshot_dir)
+        assert CountingStorage.loads == 1
+
+        monkeypatch.setattr(model_snapshot, "euro_aip_version", lambda: "1.1")
+        load_airports_model(airports_db, snapshot_dir)
+        assert CountingStorage.loads == 2
+
+    def test_excluded_countries_have_their_own_snapshot(self, airports_db, tmp_path):
+        snapshot_dir = tmp_path / "snapshot"
+        model = load_airports_model(airports_db, snapshot_dir, exclude_countries=["RU"])
+        assert [a.ident for a in model.airports] == ["LFPG", "EGLL"]
+
+        full = load_airports_model(airports_db, snapshot_dir)
+        assert full.airports.count() == 3
+        assert CountingStorage.loads == 2
+
+        again = load_airports_model(airports_db, snapshot_dir, exclude_countries=["ru"])
+        assert [a.ident for a in again.airports] == ["LFPG", "EGLL"]
+        assert CountingStorage.loads == 2
+
+    def test_unreadable_snapshot_falls_back(self, airports_db, tmp_path):
+        snapshot_dir = tmp_path / "snapshot"
+        snapshot_dir.mkdir()
+        snapshot_file(snapshot_dir).write_bytes(b"not a pickle")
+
+        model = load_airports_model(airports_db, snapshot_dir)
+
+        assert model.airports.count() == 3
+        assert CountingStorage.loads == 1
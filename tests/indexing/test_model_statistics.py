@@ -0,0 +1,131 @@
+"""
+Unit tests for the precomputed model statistics.
+
+Payloads must match what the statistics / filter endpoints used to compute
+per request, and the version must track the data.
+"""
+
+from types import SimpleNamespace
+
+import pytest
+
+from shared.indexing.model_statistics import ModelStatistics, length_distribution
+from .conftest import make_airport
+
+
+def procedure(procedure_type, approach_type=None):
+    return SimpleNamespace(
+        procedure_type=procedure_type,
+        approach_type=approach_type,
+        is_approach=lambda: procedure_type.lower() == "approach",
+    )
+
+
+def runway(length_ft=None, width_ft=None, surface=None, lighted=None):
+    return SimpleNamespace(length_ft=length_ft, width_ft=width_ft, surface=surface, lighted=lighted)
+
+
+def entry(section, std_field=None, source=None):
+    return SimpleNamespace(section=section, std_field=std_field, source=source)
+
+
+def airport(ident, country, procedures=(), runways=(), aip_entries=(), sources=(), point_of_entry=False, lat=48.0):
+    return make_airport(
+        ident, lat, 2.0,
+        iso_country=country,
+        procedures=list(procedures),
+        runways=list(runways),
+        aip_entries=list(aip_entries),
+        sources=list(sources),
+        point_of_entry=point_of_entry,
+    )
+
+
+@pytest.fixture
+def airports():
+    return [
+        airport(
+            "LFPG", "FR",
+            procedures=[procedure("Approach", "ils"), procedure("Approach", "rnav"), procedure("Departure")],
+            runways=[runway(13800, 200, "Asphalt", True), runway(8800, 150, "ASPHALT", False)],
+            aip_entries=[entry("AD 2.2", "Fuel", "uk_eaip"), entry("AD 2.3")],
+            sources=["worldairports", "uk_eaip"],
+            point_of_entry=True,
+        ),
+        airport(
+            "LFQA", "FR",
+            runways=[runway(2500, None, "grass", None)],
+            sources=["worldairports"],
+        ),
+        airport("EGKB", "GB", procedures=[procedure("Approach", "ils")], lat=None),
+        airport("ZZZZ", None),
+    ]
+
+
+@pytest.mark.unit
+class TestModelStatistics:
+    """Aggregates computed in one pass."""
+
+    def test_by_country(self, airports):
+        stats = ModelStatistics(airports)
+        by_country = {row["country"]: row for row in stats.by_country}
+        assert [row["country"] for row in stats.by_country] == ["FR", "GB", "Unknown"]
+        assert by_country["FR"]["total_airports"] == 2
+        assert by_country["FR"]["airports_with_runways"] == 2
+        assert by_country["FR"]["total_runways"] == 3
+        assert by_country["FR"]["border_crossing_airports"] == 1
+        assert by_country["GB"]["total_procedures"] == 1
+        assert stats.country_counts == {"FR": 2, "GB": 1}
+
+    def test_procedure_distribution(self, airports):
+        stats = ModelStatistics(airports)
+        assert stats.procedure_types == [{"type": "approach", "count": 3}, {"type": "departure", "count": 1}]
+        assert stats.procedure_distribution["approach_types"] == [
+            {"type": "ILS", "count": 2}, {"type": "RNAV", "count": 1},
+        ]
+
+    def test_aip_and_sources(self, airports):
+        stats = ModelStatistics(airports)
+        assert stats.aip_sections == [{"section": "AD 2.2", "count": 1}, {"section": "AD 2.3", "count": 1}]
+        assert stats.aip_fields == [{"field": "Fuel", "count": 1}]
+        assert stats.aip_data_distribution["sources"] == [{"source": "uk_eaip", "count": 1}]
+        assert stats.sources == [{"source": "uk_eaip", "count": 1}, {"source": "worldairports", "count": 2}]
+
+    def test_runways(self, airports):
+        stats = ModelStatistics(airports)
+        lengths = stats.runway_statistics["lengths"]
+        assert (lengths["min"], lengths["max"], lengths["count"]) == (2500, 13800, 3)
+        assert stats.runway_statistics["widths"]["count"] == 2
+        assert stats.runway_statistics["surfaces"] == [
+            {"surface": "asphalt", "count": 2}, {"surface": "grass", "count": 1},
+        ]
+        assert stats.runway_statistics["lighting"] == [
+            {"lighting": "lighted", "count": 1}, {"lighting": "unlighted", "count": 1},
+        ]
+        # Filter options only count lighted runways
+        assert stats.runway_characteristics["lighting"] == [{"lighting": "lighted", "count": 1}]
+        assert "distribution" not in stats.runway_characteristics["lengths"]
+
+    def test_data_quality(self, airports):
+        quality = ModelStatistics(airports).data_quality
+        assert quality["total_airports"] == 4
+        assert quality["coverage"]["coordinates"] == {"count": 3, "percentage": 75.0}
+        assert quality["coverage"]["complete_data"] == {"count": 1, "percentage": 25.0}
+
+    def test_empty_model(self):
+        stats = ModelStatistics([])
+        assert stats.by_country == []
+        assert stats.runway_statistics["lengths"]["average"] is None
+        assert stats.data_quality["coverage"]["runways"] == {"count": 0, "percentage": 0.0}
+
+    def test_length_distribution(self):
+        distribution = length_distribution([1000, 2000, 5000, 12000])
+        assert distribution == [
+            {"category": "Short (< 3000 ft)", "count": 2, "percentage": 50.0},
+            {"category": "Medium (3000-6000 ft)", "count": 1, "percentage": 25.0},
+            {"category": "Very Long (> 9000 ft)", "count": 1, "percentage": 25.0},
+        ]
+
+    def test_version_tracks_data(self, airports):
+        assert ModelStatistics(airports).version == ModelStatistics(list(airports)).version
+        assert ModelStatistics(airports).version != ModelStatistics(airports[:-1]).version
@@ -0,0 +1,85 @@
+"""
+Unit tests for the memoized procedure-line cache.
+"""
+
+import pytest
+
+from shared.indexing import ProcedureLineCache, get_model_indexes
+from .conftest import make_airport, make_model
+
+
+class CountingAirport:
+    """Airport stand-in that counts get_procedure_lines calls."""
+
+    def __init__(self, ident, fail=False):
+        self.ident = ident
+        self.fail = fail
+        self.calls = 0
+
+    def get_procedure_lines(self, distance_nm):
+        self.calls += 1
+        if self.fail:
+            raise ValueError("bad geometry")
+        return {"airport_ident": self.ident, "procedure_lines": [{"distance": distance_nm}]}
+
+
+@pytest.mark.unit
+class TestProcedureLineCache:
+    """Tests for ProcedureLineCache."""
+
+    def test_get_memoizes_per_distance(self):
+        cache = ProcedureLineCache()
+        airport = CountingAirport("EGKB")
+
+        first = cache.get(airport, 10.0)
+        assert cache.get(airport, 10.0) is first
+        assert cache.get(airport, 10.001) is first  # Rounded key
+        assert airport.calls == 1
+
+        assert cache.get(airport, 5.0)["procedure_lines"] == [{"distance": 5.0}]
+        assert airport.calls == 2
+
+    @pytest.mark.parametrize("count", [3, 32])
+    def test_get_many(self, count):
+        cache = ProcedureLineCache()
+        airports = [CountingAirport(f"X{i:03d}") for i in range(count)]
+
+        results, errors = cache.get_many(airports, 10.0)
+        assert errors == {}
+        assert set(results) == {a.ident for a in airports}
+        assert results["X001"] == {"airport_ident": "X001", "procedure_lines": [{"distance": 10.0}]}
+
+        again, _ = cache.get_many(airports, 10.0)
+        assert again == results
+        assert all(a.calls == 1 for a in airports)
+
+    def test_errors_not_cached(self):
+        cache = ProcedureLineCache()
+        good, bad = CountingAirport("EGKB"), CountingAirport("LFAT", fail=True)
+
+        results, errors = cache.get_many([good, bad], 10.0)
+        assert set(results) == {"EGKB"}
+        assert isinstance(errors["LFAT"], ValueError)
+
+        cache.get_many([good, bad], 10.0)
+        assert (good.calls, bad.calls) == (1, 2)
+
+    def test_lru_bound(self):
+        cache = ProcedureLineCache(max_entries=2)
+        airports = [CountingAirport(ident) for ident in ("A", "B", "C")]
+        cache.get_many(airports, 10.0)
+        assert len(cache) == 2
+
+        cache.get(airports[0], 10.0)  # Evicted, recomputed
+        assert airports[0].calls == 2
+
+
+@pytest.mark.unit
+class TestIdentLookup:
+    """Tests for ModelIndexes ICAO lookup."""
+
+    def test_airport_by_ident(self):
+        model = make_model([make_airport("EGKB", 51.3, 0.03), make_airport("LFAT", 50.5, 1.6)])
+        indexes = get_model_indexes(model)
+        assert indexes.airport("egkb ").ident == "EGKB"
+        assert indexes.airport("XXXX") is None
@@ -0,0 +1,110 @@
+"""
+Unit tests for the spatial-index backed route corridor search.
+"""
+
+import pytest
+
+from euro_aip.models.navpoint import NavPoint
+
+from shared.indexing import get_model_indexes
+from .conftest import make_airport, make_model
+
+
+def _brute_force_corridor(airports, start, end, distance_nm, samples=2000):
+    """Reference: min haversine distance to densely sampled points on the leg."""
+    from shared.indexing.route_corridor import _RoutePoint, _angular_distance, _intermediate_point
+    import math
+
+    a = _RoutePoint("A", math.radians(start.navpoint.latitude), math.radians(start.navpoint.longitude))
+    b = _RoutePoint("B", math.radians(end.navpoint.latitude), math.radians(end.navpoint.longitude))
+    d12 = _angular_distance(a.lat, a.lon, b.lat, b.lon)
+    points = [NavPoint(*_intermediate_point(a, b, d12, i / samples)) for i in range(samples + 1)]
+    result = {}
+    for airport in airports:
+        best = min(airport.navpoint.haversine_distance(p)[1] for p in points)
+        if best <= distance_nm:
+            result[airport.ident] = best
+    return result
+
+
+@pytest.fixture(scope="module")
+def corridor_model(random_airports):
+    airports = list(random_airports)
+    airports.append(make_airport("LFPG", 49.0097, 2.5479, iso_country="FR"))
+    airports.append(make_airport("BIRK", 64.1300, -21.9406, iso_country="IS"))
+    airports.append(make_airport("EDDM", 48.3538, 11.7861, iso_country="DE"))
+    return make_model(airports)
+
+
+@pytest.mark.unit
+class TestRouteCorridor:
+    """Tests for find_airports_near_route on ModelIndexes."""
+
+    @pytest.mark.parametrize("route,distance_nm", [
+        (("LFPG", "EDDM"), 30.0),
+        (("LFPG", "BIRK"), 50.0),  # long high-latitude leg (great circle bulges north)
+        (("EDDM", "LFPG"), 5.0),
+    ])
+    def test_matches_brute_force(self, corridor_model, route, distance_nm):
+        indexes = get_model_indexes(corridor_model)
+        start = corridor_model.airports.get(route[0])
+        end = corridor_model.airports.get(route[1])
+        expected = _brute_force_corridor(corridor_model.airports, start, end, distance_nm)
+
+        results = indexes.find_airports_near_route(list(route), distance_nm)
+        found = {item["airport"].ident: item["segment_distance_nm"] for item in results}
+
+        # Sampling reference is slightly pessimistic; tolerate airports right on the edge
+        edge_nm = distance_nm - 0.5
+        assert {ident for ident, d in expected.items() if d <= edge_nm} <= set(found)
+        assert all(d <= distance_nm for d in found.values())
+        assert all(found[ident] > edge_nm for ident in set(found) - set(expected))
+        for ident, d in found.items():
+            if ident in expected:
+                assert d == pytest.approx(expected[ident], abs=0.5)
+
+    def test_result_shape_and_order(self, corridor_model):
+        indexes = get_model_indexes(corridor_model)
+        results = indexes.find_airports_near_route(["LFPG", "EDDM"], 20.0)
+        assert results
+        assert [r["segment_distance_nm"] for r in results] == sorted(r["segment_distance_nm"] for r in results)
+        first = next(r for r in results if r["airport"].ident == "LFPG")
+        assert first["segment_distance_nm"] == 0.0
+        assert first["enroute_distance_nm"] == pytest.approx(0.0, abs=0.01)
+        assert first["closest_segment"] == ["LFPG", "EDDM"]
+        last = next(r for r in results if r["airport"].ident == "EDDM")
+        total_nm = corridor_model.airports.get("LFPG").navpoint.haversine_distance(
+            corridor_model.airports.get("EDDM").navpoint
+        )[1]
+        assert last["enroute_distance_nm"] == pytest.approx(total_nm, abs=0.5)
+
+    def test_multi_leg_closest_segment(self, corridor_model):
+        indexes = get_model_indexes(corridor_model)
+        results = indexes.find_airports_near_route(["BIRK", "LFPG", "EDDM"], 10.0)
+        by_ident = {r["airport"].ident: r for r in results}
+        assert by_ident["EDDM"]["closest_segment"] == ["LFPG", "EDDM"]
+        assert by_ident["BIRK"]["closest_segment"] == ["BIRK", "LFPG"]
+
+    def test_single_point_route(self, corridor_model):
+        indexes = get_model_indexes(corridor_model)
+        results = indexes.find_airports_near_route(["LFPG"], 40.0)
+        expected = {a.ident for a, _ in indexes.spatial.within_radius(49.0097, 2.5479, 40.0)}
+        assert {r["airport"].ident for r in results} == expected
+
+    def test_candidate_filter_applied_before_geometry(self, corridor_model):
+        indexes = get_model_indexes(corridor_model)
+        seen = []
+
+        def only_france(airport):
+            seen.append(airport.ident)
+            return airport.iso_country == "FR"
+
+        results = indexes.find_airports_near_route(["LFPG", "EDDM"], 30.0, candidate_filter=only_france)
+        assert results
+        assert all(r["airport"].iso_country == "FR" for r in results)
+        assert len(seen) == len(set(seen))  # each candidate evaluated once
+        assert len(seen) < len(corridor_model.airports)
+
+    def test_unknown_route_airports(self, corridor_model):
+        indexes = get_model_indexes(corridor_model)
+        assert indexes.find_airports_near_route(["ZZZZ"], 50.0) == []
@@ -0,0 +1,86 @@
+"""
+Unit tests for the airport typeahead search index.
+"""
+
+import pytest
+
+from shared.indexing import AirportSearchIndex
+from shared.indexing.search_index import normalize_text
+from .conftest import make_airport
+
+
+def named(ident, name, municipality=None, iata_code=None, runway_ft=None):
+    return make_airport(
+        ident, 50.0, 0.0,
+        name=name,
+        municipality=municipality,
+        iata_code=iata_code,
+        longest_runway_length_ft=runway_ft,
+    )
+
+
+AIRPORTS = [
+    named("EGLC", "London City Airport", "London", "LCY", 4948),
+    named("EGLL", "London Heathrow Airport", "London", "LHR", 12802),
+    named("EGKB", "London Biggin Hill Airport", "London", "BQH", 5932),
+    named("LSZH", "Zürich Airport", "Zurich", "ZRH", 12139),
+    named("LFPO", "Paris-Orly Airport", "Paris", "ORY", 11975),
+    named("EGLD", "Denham Aerodrome", "Denham"),
+    named("LFAT", "Le Touquet-Côte d'Opale Airport", "Le Touquet-Paris-Plage", "LTQ", 6070),
+]
+
+
+@pytest.fixture(scope="module")
+def index():
+    return AirportSearchIndex(AIRPORTS)
+
+
+def idents(results):
+    return [a.ident for a in results]
+
+
+@pytest.mark.unit
+class TestAirportSearchIndex:
+    """Tests for AirportSearchIndex."""
+
+    def test_normalize_text(self):
+        assert normalize_text("Zürich  Côte-d'Opale") == "ZURICH COTE D OPALE"
+        assert normalize_text(None) == ""
+
+    def test_exact_codes_rank_first(self, index):
+        assert idents(index.search("egkb"))[0] == "EGKB"
+        assert idents(index.search("LHR"))[0] == "EGLL"
+
+    def test_code_prefix(self, index):
+        # ICAO prefixes first, longest runway first within the same score
+        assert idents(index.search("EGL")) == ["EGLL", "EGLC", "EGLD"]
+
+    def test_name_words(self, index):
+        assert idents(index.search("london")) == ["EGLL", "EGKB", "EGLC"]
+        assert idents(index.search("biggin")) == ["EGKB"]
+        assert idents(index.search("hill lond")) == ["EGKB"]
+        assert idents(index.search("zurich")) == ["LSZH"]
+
+    def test_municipality_and_substring(self, index):
+        assert "LFAT" in idents(index.search("plage"))
+        assert idents(index.search("ouquet")) == ["LFAT"]  # Substring inside a word
+        assert idents(index.search("ondon")) == ["EGLL", "EGKB", "EGLC"]
+
+    def test_limit_and_empty(self, index):
+        assert len(index.search("london", limit=2)) == 2
+        assert index.search("   ") == []
+        assert index.search("nowhere") == []
+
+    def test_matches_substring_scan(self, random_airports):
+        """Every substring match of the old linear scan is still found."""
+        airports = [
+            named(a.ident, f"Field {a.ident[1:]} {a.iso_country}", f"Town{i % 50}")
+            for i, a in enumerate(random_airports[:500])
+        ]
+        index = AirportSearchIndex(airports)
+        for query in ["X012", "TOWN4", "WN12", "FIELD 03"]:
+            expected = {
+                a.ident for a in airports
+                if query in a.ident or query in a.name.upper() or query in a.municipality.upper()
+            }
+            assert set(idents(index.search(query, limit=len(airports)))) == expected
@@ -0,0 +1,90 @@
+"""
+Unit tests for the airport spatial index.
+"""
+
+import pytest
+
+from euro_aip.models.navpoint import NavPoint
+
+from shared.indexing import AirportSpatialIndex
+from .conftest import make_airport
+
+
+def _brute_force_radius(airports, lat, lon, radius_nm):
+    center = NavPoint(latitude=lat, longitude=lon)
+    return {
+        a.ident
+        for a in airports
+        if a.navpoint.haversine_distance(center)[1] <= radius_nm
+    }
+
+
+@pytest.mark.unit
+class TestSpatialIndexBbox:
+    """Tests for viewport (bbox) queries."""
+
+    @pytest.mark.parametrize("bbox", [
+        (51.0, 48.0, 3.0, -1.0),
+        (70.0, 35.0, 40.0, -25.0),
+        (45.25, 45.0, 10.5, 10.0),
+    ])
+    def test_matches_full_scan(self, random_airports, bbox):
+        north, south, east, west = bbox
+        index = AirportSpatialIndex(random_airports)
+        expected = {
+            a.ident for a in random_airports
+            if south <= a.navpoint.latitude <= north and west <= a.navpoint.longitude <= east
+        }
+        result = {a.ident for a in index.within_bbox(north, south, east, west)}
+        assert result == expected
+
+    def test_bounds_inclusive(self):
+        index = AirportSpatialIndex([make_airport("EDGE", 50.0, 2.0)])
+        assert [a.ident for a in index.within_bbox(50.0, 49.0, 2.0, 1.0)] == ["EDGE"]
+
+    def test_inverted_box_is_empty(self, random_airports):
+        index = AirportSpatialIndex(random_airports)
+        assert index.within_bbox(40.0, 50.0, 10.0, 0.0) == []
+
+    def test_airports_without_navpoint_skipped(self):
+        airports = [make_airport("LFPG", 49.0, 2.5)]
+        airports.append(make_airport("NONE", 0.0, 0.0))
+        airports[-1].navpoint = None
+        index = AirportSpatialIndex(airports)
+        assert len(index) == 1
+
+
+@pytest.mark.unit
+class TestSpatialIndexRadius:
+    """Tests for radius and nearest queries."""
+
+    @pytest.mark.parametrize("lat,lon,radius_nm", [
+        (48.85, 2.35, 50.0),
+        (64.0, -20.0, 120.0),
+        (52.0, 13.0, 5.0),
+        (45.0, 10.0, 500.0),
+    ])
+    def test_matches_full_scan(self, random_airports, lat, lon, radius_nm):
+        index = AirportSpatialIndex(random_airports)
+        result = index.within_radius(lat, lon, radius_nm)
+        assert {a.ident for a, _ in result} == _brute_force_radius(random_airports, lat, lon, radius_nm)
+        distances = [d for _, d in result]
+        assert distances == sorted(distances)
+
+    def test_wraps_antimeridian(self):
+        airports = [make_airport("EAST", 0.0, 179.9), make_airport("WEST", 0.0, -179.9)]
+        index = AirportSpatialIndex(airports)
+        result = {a.ident for a, _ in index.within_radius(0.0, 179.95, 30.0)}
+        assert result == {"EAST", "WEST"}
+
+    def test_nearest(self, random_airports):
+        index = AirportSpatialIndex(random_airports)
+        center = NavPoint(latitude=48.85, longitude=2.35)
+        expected = min(random_airports, key=lambda a: a.navpoint.haversine_distance(center)[1])
+        airport, distance_nm = index.nearest(48.85, 2.35, max_distance_nm=200.0)
+        assert airport.ident == expected.ident
+        assert distance_nm == pytest.approx(expected.navpoint.haversine_distance(center)[1])
+
+    def test_nearest_none_outside_radius(self):
+        index = AirportSpatialIndex([make_airport("FAR", 60.0, 20.0)])
+        assert index.nearest(40.0, 0.0, max_distance_nm=10.0) is None
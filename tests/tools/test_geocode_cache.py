@@ -0,0 +1,91 @@
+"""
+Unit tests for the geocode result cache.
+"""
+
+import threading
+import time
+
+import pytest
+
+from shared.geocode_cache import GeocodeCache
+
+PARIS = {"lat": 48.86, "lon": 2.35, "formatted": "Paris, France", "country_code": "fr"}
+
+
+class CountingFetcher:
+    """Fetch stand-in returning fixed results and counting calls."""
+
+    def __init__(self, results=None, delay_s=0.0, error=None):
+        self.results = results or {}
+        self.delay_s = delay_s
+        self.error = error
+        self.calls = []
+
+    def __call__(self, query):
+        self.calls.append(query)
+        if self.delay_s:
+            time.sleep(self.delay_s)
+        if self.error:
+            raise self.error
+        return self.results.get(query.lower())
+
+
+@pytest.mark.unit
+class TestGeocodeCache:
+    """Tests for GeocodeCache."""
+
+    def test_hit_after_fetch(self):
+        cache = GeocodeCache()
+        fetch = CountingFetcher({"paris": PARIS})
+
+        assert cache.get_or_fetch("Paris", fetch) == PARIS
+        assert cache.get_or_fetch("  paris ", fetch) == PARIS  # Normalized key
+        assert fetch.calls == ["Paris"]
+
+    def test_negative_caching_and_ttl(self):
+        cache = GeocodeCache(ttl_s=3600, negative_ttl_s=0)
+        fetch = CountingFetcher({"paris": PARIS})
+
+        assert cache.get_or_fetch("Nowhere", fetch) is None
+        assert cache.get_or_fetch("Nowhere", fetch) is None
+        assert len(fetch.calls) == 2  # Negative TTL expired immediately
+
+        cache.negative_ttl_s = 3600
+        cache.get_or_fetch("Atlantis", fetch)
+        cache.get_or_fetch("Atlantis", fetch)
+        assert fetch.calls.count("Atlantis") == 1
+
+    def test_errors_not_cached(self):
+        cache = GeocodeCache()
+        failing = CountingFetcher(error=OSError("timeout"))
+        with pytest.raises(OSError):
+            cache.get_or_fetch("Paris", failing)
+
+        assert cache.get_or_fetch("Paris", CountingFetcher({"paris": PARIS})) == PARIS
+
+    def test_persistent(self, tmp_path):
+        db_path = str(tmp_path / "geocode.db")
+        GeocodeCache(db_path).get_or_fetch("Paris", CountingFetcher({"paris": PARIS}))
+
+        fetch = CountingFetcher()
+        reopened = GeocodeCache(db_path)
+        assert reopened.get_or_fetch("PARIS", fetch) == PARIS
+        assert fetch.calls == []
+        assert reopened.purge_expired() == 0
+
+    def test_concurrent_lookups_coalesce(self):
+        cache = GeocodeCache()
+        fetch = CountingFetcher({"lyon": {"lat": 45.76, "lon": 4.84}}, delay_s=0.05)
+        results = []
+
+        threads = [
+            threading.Thread(target=lambda: results.append(cache.get_or_fetch("Lyon", fetch)))
+            for _ in range(8)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        assert len(fetch.calls) == 1
+        assert len(results) == 8 and all(r == {"lat": 45.76, "lon": 4.84} for r in results)
@@ -0,0 +1,144 @@
+"""
+Unit tests for latency spans, per-request traces and Prometheus output.
+"""
+
+import threading
+from concurrent.futures import ThreadPoolExecutor
+import contextvars
+
+import pytest
+
+from shared import tracing
+from shared.tracing import LatencyRegistry, span, start_trace, traced
+
+
+@pytest.fixture(autouse=True)
+def clean_registry():
+    tracing.registry.reset()
+    yield
+    tracing.registry.reset()
+
+
+@pytest.mark.unit
+class TestSpans:
+    def test_span_feeds_histogram_without_trace(self):
+        with span("geocode"):
+            pass
+        with span("geocode"):
+            pass
+        assert tracing.registry.summary()["geocode"]["count"] == 2
+
+    def test_trace_aggregates_by_name(self):
+        with start_trace() as trace:
+            tracing.record("filter_engine", 0.010)
+            tracing.record("filter_engine", 0.005)
+            tracing.record("serialize", 0.002)
+        assert trace.spans == {"filter_engine": (pytest.approx(0.015), 2), "serialize": (0.002, 1)}
+        assert tracing.current_trace() is None
+
+    def test_span_recorded_when_block_raises(self):
+        with start_trace() as trace, pytest.raises(ValueError):
+            with span("llm.planner"):
+                raise ValueError("boom")
+        assert "llm.planner" in trace.spans
+
+    def test_traced_decorator(self):
+        @traced("priority_engine")
+        def score(x):
+            return x * 2
+
+        with start_trace() as trace:
+            assert score(21) == 42
+        assert trace.spans["priority_engine"][1] == 1
+
+    def test_spans_from_copied_context_join_trace(self):
+        with start_trace() as trace:
+            with ThreadPoolExecutor(max_workers=2) as pool:
+                futures = [
+                    pool.submit(contextvars.copy_context().run, tracing.record, "tool.search_airports", 0.1)
+                    for _ in range(2)
+                ]
+                for future in futures:
+                    future.result()
+        assert trace.spans["tool.search_airports"][1] == 2
+
+    def test_server_timing_header(self):
+        with start_trace() as trace:
+            tracing.record("ga.batch", 0.0123)
+            tracing.record("serialize", 0.0045)
+        assert trace.server_timing(total_s=0.05) == "ga.batch;dur=12.3, serialize;dur=4.5, total;dur=50.0"
+
+
+@pytest.mark.unit
+class TestPrometheusOutput:
+    def test_cumulative_buckets_sum_and_count(self):
+        registry = LatencyRegistry()
+        registry.observe("latency_seconds", 0.003, span="rag.embed")
+        registry.observe("latency_seconds", 0.2, span="rag.embed")
+        registry.observe("latency_seconds", 60.0, span="rag.embed")
+        lines = registry.render_prometheus().splitlines()
+
+        assert lines[0] == "# TYPE latency_seconds histogram"
+        assert 'latency_seconds_bucket{span="rag.embed",le="0.0025"} 0' in lines
+        assert 'latency_seconds_bucket{span="rag.embed",le="0.005"} 1' in lines
+        assert 'latency_seconds_bucket{span="rag.embed",le="0.25"} 2' in lines
+        assert 'latency_seconds_bucket{span="rag.embed",le="30.0"} 2' in lines
+        assert 'latency_seconds_bucket{span="rag.embed",le="+Inf"} 3' in lines
+        assert 'latency_seconds_sum{span="rag.embed"} 60.203000' in lines
+        assert 'latency_seconds_count{span="rag.embed"} 3' in lines
+
+    def test_labels_are_escaped_and_sorted(self):
+        registry = LatencyRegistry()
+        registry.observe("req_seconds", 0.1, route='/api/"x"', method="GET")
+        text = registry.render_prometheus()
+        assert 'req_seconds_count{method="GET",route="/api/\\"x\\""} 1' in text
+
+    def test_concurrent_observations(self):
+        registry = LatencyRegistry()
+
+        def worker():
+            for _ in range(1000):
+                registry.observe("m", 0.01, span="s")
+
+        threads = [threading.Thread(target=worker) for _ in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert registry.summary("m")["s"]["count"] == 4000
+
+    def test_empty_registry_renders_nothing(self):
+        assert LatencyRegistry().render_prometheus() == ""
+
+    def test_multiproc_dir_aggregates_workers(self, tmp_path):
+        # Two registries stand in for two workers sharing METRICS_MULTIPROC_DIR
+        worker_a = LatencyRegistry(str(tmp_path), flush_interval_s=3600)
+        worker_b = LatencyRegistry(str(tmp_path), flush_interval_s=3600)
+        worker_a.observe("req_seconds", 0.1, route="/a")
+        worker_b.observe("req_seconds", 0.1, route="/a")
+        worker_b.observe("req_seconds", 0.2, route="/b")
+        worker_a.flush()
+        worker_b.flush()
+
+        for text in (worker_a.render_prometheus(), worker_b.render_prometheus()):
+            assert 'req_seconds_count{route="/a"} 2' in text
+            assert 'req_seconds_count{route="/b"} 1' in text
+            assert text.count("# TYPE req_seconds histogram") == 1
+
+    def test_observe_does_not_write(self, tmp_path):
+        worker_a = LatencyRegistry(str(tmp_path), flush_interval_s=3600)
+        worker_b = LatencyRegistry(str(tmp_path), flush_interval_s=3600)
+        worker_a.observe("m", 0.1, span="s")
+
+        # Written by the flush thread, not on the request path; rendering flushes the scraped worker
+        assert worker_b.render_prometheus() == ""
+        assert 'm_count{span="s"} 1' in worker_a.render_prometheus()
+        assert 'm_count{span="s"} 1' in worker_b.render_prometheus()
+
+    def test_flush_errors_are_logged(self, tmp_path):
+        blocker = tmp_path / "not-a-dir"
+        blocker.write_text("")
+        registry = LatencyRegistry(str(blocker / "metrics"), flush_interval_s=3600)
+        registry.observe("m", 0.1, span="s")
+        registry.flush()
+        assert registry.summary("m")["s"]["count"] == 1
@@ -0,0 +1,220 @@
+"""
+Unit tests for the web server rate-limit backends.
+"""
+
+import asyncio
+
+import pytest
+
+import web.server.rate_limit as rate_limit
+from web.server.rate_limit import (
+    InMemoryRateLimitBackend,
+    RateLimiter,
+    RedisRateLimitBackend,
+    RouteBudget,
+    create_rate_limit_backend,
+    route_budgets,
+)
+
+
+class FakeClock:
+    """Replaces time.time() in the rate_limit module."""
+
+    def __init__(self, now=960.0):  # Start of a 60s window
+        self.now = now
+
+    def time(self):
+        return self.now
+
+
+class FakeRedis:
+    """Redis client stand-in supporting pipeline().incr().expire().execute()."""
+
+    def __init__(self, fail=False):
+        self.counts = {}
+        self.ttls = {}
+        self.fail = fail
+
+    def pipeline(self):
+        return FakePipeline(self)
+
+
+class FakeAsyncRedis(FakeRedis):
+    """redis.asyncio stand-in: same counters, awaitable execute()."""
+
+    def pipeline(self):
+        return FakeAsyncPipeline(self)
+
+
+class FakePipeline:
+    def __init__(self, redis):
+        self.redis = redis
+        self.ops = []
+
+    def incr(self, key):
+        self.ops.append(("incr", key))
+
+    def get(self, key):
+        self.ops.append(("get", key))
+
+    def expire(self, key, seconds):
+        self.ops.append(("expire", key, seconds))
+
+    def execute(self):
+        if self.redis.fail:
+            raise ConnectionError("redis down")
+        results = []
+        for op in self.ops:
+            if op[0] == "incr":
+                self.redis.counts[op[1]] = self.redis.counts.get(op[1], 0) + 1
+                results.append(self.redis.counts[op[1]])
+            elif op[0] == "get":
+                count = self.redis.counts.get(op[1])
+                results.append(None if count is None else str(count).encode())
+            else:
+                self.redis.ttls[op[1]] = op[2]
+                results.append(True)
+        return results
+
+
+class FakeAsyncPipeline(FakePipeline):
+    async def execute(self):
+        return FakePipeline.execute(self)
+
+
+@pytest.fixture
+def clock(monkeypatch):
+    fake = FakeClock()
+    monkeypatch.setattr(rate_limit.time, "time", fake.time)
+    return fake
+
+
+@pytest.mark.unit
+class TestInMemoryRateLimitBackend:
+    """Tests for per-process counters."""
+
+    def test_limit_per_key(self, clock):
+        backend = InMemoryRateLimitBackend()
+
+        assert [backend.hit("1.2.3.4", 3, 60) for _ in range(4)] == [True, True, True, False]
+        assert backend.hit("5.6.7.8", 3, 60)
+
+    def test_previous_window_weighs_into_sliding_window(self, clock):
+        backend = InMemoryRateLimitBackend()
+        for _ in range(4):
+            backend.hit("1.2.3.4", 4, 60)
+
+        # Window boundary: the full previous window still overlaps, so no burst reset
+        clock.now += 60
+        assert not backend.hit("1.2.3.4", 4, 60)
+
+        # Halfway through: previous window counts for half (2 of 4)
+        clock.now += 30
+        assert [backend.hit("1.2.3.4", 4, 60) for _ in range(3)] == [True, True, False]
+
+    def test_expired_clients_are_swept(self, clock):
+        backend = InMemoryRateLimitBackend(sweep_interval_s=10)
+        backend.hit("1.2.3.4", 3, 60)
+        backend.hit("5.6.7.8", 3, 60)
+        assert len(backend) == 2
+
+        clock.now += 120
+        backend.hit("9.9.9.9", 3, 60)
+        assert len(backend) == 1
+
+
+@pytest.mark.unit
+class TestRedisRateLimitBackend:
+    """Tests for counters shared through Redis."""
+
+    def test_workers_share_counts(self, clock):
+        redis = FakeRedis()
+        worker_a = RedisRateLimitBackend(client=redis, async_client=FakeAsyncRedis())
+        worker_b = RedisRateLimitBackend(client=redis, async_client=FakeAsyncRedis())
+
+        assert worker_a.hit("1.2.3.4", 2, 60)
+        assert worker_b.hit("1.2.3.4", 2, 60)
+        assert not worker_a.hit("1.2.3.4", 2, 60)
+        assert all(ttl == 121 for ttl in redis.ttls.values())
+
+        # Previous window (3 hits, including the rejected one) counts for a third
+        clock.now += 100
+        assert worker_b.hit("1.2.3.4", 2, 60)
+        assert not worker_a.hit("1.2.3.4", 2, 60)
+
+    def test_unavailable_redis_allows_requests(self, clock):
+        backend = RedisRateLimitBackend(client=FakeRedis(fail=True), async_client=FakeAsyncRedis(fail=True))
+        assert all(backend.hit("1.2.3.4", 1, 60) for _ in range(3))
+        assert all(asyncio.run(backend.hit_async("1.2.3.4", 1, 60)) for _ in range(3))
+
+    def test_async_hit_uses_async_client(self, clock):
+        redis = FakeAsyncRedis()
+        backend = RedisRateLimitBackend(client=FakeRedis(fail=True), async_client=redis)
+
+        async def hits():
+            return [await backend.hit_async("1.2.3.4", 2, 60) for _ in range(3)]
+
+        assert asyncio.run(hits()) == [True, True, False]
+        assert all(ttl == 121 for ttl in redis.ttls.values())
+
+
+@pytest.mark.unit
+class TestRateLimiter:
+    """Tests for per-route budgets."""
+
+    def make_limiter(self):
+        return RateLimiter(
+            InMemoryRateLimitBackend(),
+            default=RouteBudget("default", (), 2, 60),
+            routes=route_budgets({
+                "chat": (["/api/aviation-agent/chat"], 1, 60),
+                "listing": (["/api/airports/"], 5, 60),
+            }),
+        )
+
+    def test_budget_by_longest_prefix(self):
+        limiter = self.make_limiter()
+
+        assert limiter.budget_for("/api/aviation-agent/chat/stream").name == "chat"
+        assert limiter.budget_for("/api/aviation-agent/quick-actions").name == "default"
+        assert limiter.budget_for("/api/airports").name == "listing"
+        assert limiter.budget_for("/api/airports/LFPG").name == "listing"
+        assert limiter.budget_for("/api/airportsx").name == "default"
+
+    def test_budgets_are_counted_separately(self, clock):
+        limiter = self.make_limiter()
+
+        assert limiter.check("1.2.3.4", "/api/aviation-agent/chat") == (True, limiter.routes[0])
+        allowed, budget = limiter.check("1.2.3.4", "/api/aviation-agent/chat/stream")
+        assert not allowed and budget.name == "chat"
+
+        # Chat budget exhausted; listings and other routes are unaffected
+        assert all(limiter.check("1.2.3.4", "/api/airports/")[0] for _ in range(5))
+        assert limiter.check("1.2.3.4", "/health")[0]
+
+    def test_check_async_matches_check(self, clock):
+        limiter = self.make_limiter()
+
+        async def checks():
+            return [(await limiter.check_async("1.2.3.4", "/api/aviation-agent/chat"))[0] for _ in range(2)]
+
+        assert asyncio.run(checks()) == [True, False]
+
+
+@pytest.mark.unit
+class TestCreateRateLimitBackend:
+    """Tests for backend selection from the environment."""
+
+    def test_default_is_in_memory(self, monkeypatch):
+        monkeypatch.delenv("RATE_LIMIT_BACKEND", raising=False)
+        assert isinstance(create_rate_limit_backend(), InMemoryRateLimitBackend)
+
+    def test_redis_requires_url(self, monkeypatch):
+        monkeypatch.setenv("RATE_LIMIT_BACKEND", "redis")
+        monkeypatch.delenv("RATE_LIMIT_REDIS_URL", raising=False)
+        with pytest.raises(ValueError):
+            create_rate_limit_backend()
+
+    def test_unknown_backend(self):
+        with pytest.raises(ValueError):
+            create_rate_limit_backend("memcached")
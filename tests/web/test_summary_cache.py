@@ -0,0 +1,123 @@
+"""
+Unit tests for the pre-encoded AirportSummary cache.
+
+Stitched JSON must be identical to serializing AirportSummary models directly.
+"""
+
+import json
+from types import SimpleNamespace
+
+import pytest
+
+from web.server.api.models import AirportSummary, GAFriendlySummary, NotificationSummary
+from web.server.api.summary_cache import AirportSummaryCache
+from web.server.api.wire_format import to_columnar
+
+
+def make_airport(ident, **overrides):
+    attrs = dict(
+        ident=ident,
+        name=f"Airport {ident} é",
+        latitude_deg=48.5,
+        longitude_deg=2.25,
+        iso_country="FR",
+        municipality=None,
+        point_of_entry=True,
+        procedures=[1, 2],
+        runways=[1],
+        aip_entries=[],
+        has_hard_runway=True,
+        has_lighted_runway=None,
+        has_soft_runway=False,
+        has_water_runway=False,
+        has_snow_runway=False,
+        longest_runway_length_ft=3200,
+    )
+    attrs.update(overrides)
+    return SimpleNamespace(**attrs)
+
+
+GA = {
+    "LFAA": GAFriendlySummary(features={"review_cost_score": 0.5}, persona_scores={"ifr_touring_sr22": 0.7}),
+}
+NOTIFICATIONS = {
+    "LFBB": NotificationSummary(notification_type="h24", is_h24=True, easiness_score=100.0),
+}
+
+
+def expected_json(airports, ga, notifications):
+    return json.loads(json.dumps([
+        AirportSummary.from_airport(a, ga.get(a.ident), notifications.get(a.ident)).model_dump(mode="json")
+        for a in airports
+    ]))
+
+
+@pytest.mark.unit
+class TestAirportSummaryCache:
+    """Tests for AirportSummaryCache."""
+
+    def test_encode_matches_models(self):
+        airports = [make_airport("LFAA"), make_airport("LFBB", procedures=[], point_of_entry=None), make_airport("LFCC")]
+        cache = AirportSummaryCache(airports)
+        calls = []
+
+        def fetch_ga(icaos):
+            calls.append(list(icaos))
+            return {icao: GA[icao] for icao in icaos if icao in GA}
+
+        body = cache.encode(
+            airports,
+            ga=("v1", fetch_ga),
+            notification=(None, lambda icaos: {i: NOTIFICATIONS[i] for i in icaos if i in NOTIFICATIONS}),
+        )
+        assert json.loads(body) == expected_json(airports, GA, NOTIFICATIONS)
+
+        # Versioned GA fragments are cached; only unseen ICAOs are fetched
+        cache.encode(airports[:2], ga=("v1", fetch_ga))
+        assert calls == [["LFAA", "LFBB", "LFCC"]]
+        cache.encode(airports[:1], ga=("v2", fetch_ga))
+        assert calls[-1] == ["LFAA"]
+
+    def test_without_sub_objects(self):
+        airports = [make_airport("LFAA")]
+        body = AirportSummaryCache(airports).encode(airports)
+        assert json.loads(body) == expected_json(airports, {}, {})
+        assert AirportSummaryCache([]).encode([]) == b"[]"
+
+    def test_columnar_matches_objects(self):
+        airports = [make_airport("LFAA"), make_airport("LFBB", municipality="Bâle")]
+        cache = AirportSummaryCache(airports)
+        sources = dict(
+            ga=("v1", lambda icaos: {i: GA[i] for i in icaos if i in GA}),
+            notification=("n1", lambda icaos: {i: NOTIFICATIONS[i] for i in icaos if i in NOTIFICATIONS}),
+        )
+
+        payload = json.loads(cache.encode(airports, columnar=True, **sources))
+        assert payload["format"] == "columnar"
+        expanded = [dict(zip(payload["fields"], row)) for row in payload["rows"]]
+        assert expanded == json.loads(cache.encode(airports, **sources))
+        assert json.loads(cache.encode([], columnar=True))["rows"] == []
+
+    def test_etag(self):
+        cache = AirportSummaryCache([make_airport("LFAA")])
+        etag = cache.etag("country=FR", "v1")
+        assert etag == cache.etag("country=FR", "v1")
+        assert etag != cache.etag("country=DE", "v1")
+        assert etag != cache.etag("country=FR", "v2")
+        assert cache.etag("country=FR", None) is None
+
+        # Dataset version follows the data, not the instance
+        other = AirportSummaryCache([make_airport("LFAA")])
+        assert other.etag("country=FR", "v1") == etag
+        changed = AirportSummaryCache([make_airport("LFAA", longest_runway_length_ft=4000)])
+        assert changed.etag("country=FR", "v1") != etag
+
+
+@pytest.mark.unit
+class TestToColumnar:
+    """Tests for the generic columnar encoder."""
+
+    def test_fields_in_first_seen_order(self):
+        payload = to_columnar([{"a": 1, "b": 2}, {"b": 3, "c": 4}])
+        assert payload == {"format": "columnar", "fields": ["a", "b", "c"], "rows": [[1, 2, None], [None, 3, 4]]}
+        assert to_columnar([])["rows"] == []
@@ -0,0 +1,42 @@
+"""
+Unit tests for quadtree tile parsing and bounds.
+"""
+
+import pytest
+from fastapi import HTTPException
+
+from web.server.api.tiles import MAX_TILE_ZOOM, parse_tile, tile_bbox
+
+
+@pytest.mark.unit
+class TestTiles:
+    """Tests for z/x/y tile math (must match the web and iOS clients)."""
+
+    def test_world_tile(self):
+        north, south, east, west = tile_bbox(0, 0, 0)
+        assert north == pytest.approx(85.0511, abs=1e-4)
+        assert south == pytest.approx(-85.0511, abs=1e-4)
+        assert (east, west) == (180.0, -180.0)
+
+    def test_children_partition_parent(self):
+        north, south, east, west = tile_bbox(5, 16, 10)
+        children = [tile_bbox(6, 32 + dx, 20 + dy) for dx in (0, 1) for dy in (0, 1)]
+
+        assert max(c[0] for c in children) == pytest.approx(north)
+        assert min(c[1] for c in children) == pytest.approx(south)
+        assert max(c[2] for c in children) == pytest.approx(east)
+        assert min(c[3] for c in children) == pytest.approx(west)
+
+    def test_tile_containing_paris(self):
+        # Standard slippy-map tile for 48.86N 2.35E at zoom 8
+        north, south, east, west = tile_bbox(8, 129, 88)
+        assert south <= 48.86 <= north
+        assert west <= 2.35 <= east
+
+    def test_parse_tile(self):
+        assert parse_tile("8/129/88") == (8, 129, 88)
+
+    @pytest.mark.parametrize("tile", ["8/129", "a/b/c", "8/256/0", "2/0/-1", f"{MAX_TILE_ZOOM + 1}/0/0"])
+    def test_parse_tile_rejects_invalid(self, tile):
+        with pytest.raises(HTTPException):
+            parse_tile(tile)
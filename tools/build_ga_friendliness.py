@@ -13,9 +13,13 @@ Options:
     --icaos               Comma-separated list of specific ICAOs
     --resume              Resume from last successful ICAO
     --cache-dir           Cache directory for downloads
-    --force-refresh       Force refresh of cached data
+    --force-refresh       Force refresh of cached data (and reprocess unchanged
+                          AIP fields / notification texts)
     --llm-model           LLM model to use (default: gpt-4o-mini)
     --mock-llm            Use mock LLM (no API calls)
+    --llm-concurrency     Concurrent LLM requests (default: 4)
+    --llm-rpm             LLM requests per minute across all workers (default: unlimited)
+    --reviews-per-call    Reviews of one airport per extraction call (default: 8, 1 = no packing)
     --failure-mode        How to handle failures: continue, fail_fast, skip
     --verbose, -v         Verbose output
     --dry-run             Don't write to database, just show what would be done
@@ -133,7 +137,7 @@ def parse_args() -> argparse.Namespace:
     proc_group.add_argument(
         "--force-refresh",
         action="store_true",
-        help="Force refresh of cached data",
+        help="Force refresh of cached data; also reprocesses airports whose AIP fields or notification text are unchanged",
     )
     proc_group.add_argument(
         "--parse-notifications",
@@ -164,6 +168,24 @@ def parse_args() -> argparse.Namespace:
         action="store_true",
         help="Use mock LLM (no API calls)",
     )
+    llm_group.add_argument(
+        "--llm-concurrency",
+        type=int,
+        default=4,
+        help="Concurrent LLM requests (default: 4)",
+    )
+    llm_group.add_argument(
+        "--llm-rpm",
+        type=float,
+        default=0.0,
+        help="LLM requests per minute across all workers, 0 = unlimited (default: 0)",
+    )
+    llm_group.add_argument(
+        "--reviews-per-call",
+        type=int,
+        default=8,
+        help="Reviews of one airport packed into one extraction call, 1 = no packing (default: 8)",
+    )
     llm_group.add_argument(
         "--api-key",
         type=str,
@@ -287,6 +309,9 @@ def main() -> int:
         llm_model=args.llm_model,
         llm_api_key=args.api_key,
         use_mock_llm=args.mock_llm,
+        llm_concurrency=args.llm_concurrency,
+        llm_requests_per_minute=args.llm_rpm,
+        llm_reviews_per_call=args.reviews_per_call,
         failure_mode=args.failure_mode,
         source_version=f"build-{datetime.now().strftime('%Y%m%d')}",
     )
@@ -368,6 +393,7 @@ def main() -> int:
             result = builder.update_aip_only(
                 airports_db=airports_db_source,
                 icaos=icaos,
+                force=args.force_refresh,
             )
 
             # Print summary
@@ -423,11 +449,12 @@ def main() -> int:
                 llm_api_key=args.api_key,
             )
             
-            # Score notifications
+            # Score notifications (unchanged texts are skipped unless --force-refresh)
             scores, parsed_rules = notification_scorer.load_and_score_from_airports_db(
                 args.airports_db,
                 icaos=icaos,
                 return_parsed=True,
+                known_hashes=None if args.force_refresh else notification_scorer.read_text_hashes(args.output),
             )
             
             # Write to database
@@ -514,6 +541,7 @@ def main() -> int:
                     args.airports_db,
                     icaos=notification_icaos,
                     return_parsed=True,
+                    known_hashes=None if args.force_refresh else notification_scorer.read_text_hashes(args.output),
                 )
                 
                 # Write to GA persona database (including detailed rules)
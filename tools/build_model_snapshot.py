@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+Prebuild the airports model snapshot used for fast server startup.
+
+Servers write the snapshot themselves on the first start after airports.db
+changes; run this after installing a new airports.db (or at image build time)
+so no server start pays the full load.
+
+Usage:
+    python tools/build_model_snapshot.py --airports-db data/airports.db --snapshot-dir out/model_snapshot
+    python tools/build_model_snapshot.py --exclude-countries RU    # web server variant
+
+Options:
+    --airports-db         Path to airports.db (default: AIRPORTS_DB)
+    --snapshot-dir        Snapshot directory (default: MODEL_SNAPSHOT_DIR)
+    --exclude-countries   Comma-separated ISO country codes removed from the model
+"""
+
+import argparse
+import logging
+import sys
+import time
+from pathlib import Path
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from shared.model_snapshot import load_airports_model, snapshot_file
+from shared.tool_context import get_tool_context_settings
+
+logging.basicConfig(
+    level=logging.INFO,
+    format="%(asctime)s - %(name)s - %(levelname)s - %(message)s",
+)
+logger = logging.getLogger(__name__)
+
+
+def parse_args() -> argparse.Namespace:
+    """Parse command line arguments."""
+    settings = get_tool_context_settings()
+    parser = argparse.ArgumentParser(
+        description="Prebuild the airports model snapshot",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__,
+    )
+    parser.add_argument(
+        "--airports-db",
+        type=Path,
+        default=settings.airports_db,
+        help="Path to airports.db (default: AIRPORTS_DB)",
+    )
+    parser.add_argument(
+        "--snapshot-dir",
+        type=Path,
+        default=settings.model_snapshot_dir,
+        help="Snapshot directory (default: MODEL_SNAPSHOT_DIR)",
+    )
+    parser.add_argument(
+        "--exclude-countries",
+        default="",
+        help="Comma-separated ISO country codes removed from the model (e.g. RU)",
+    )
+    return parser.parse_args()
+
+
+def main() -> int:
+    args = parse_args()
+    if not args.snapshot_dir:
+        logger.error("No snapshot directory: pass --snapshot-dir or set MODEL_SNAPSHOT_DIR")
+        return 1
+    if not args.airports_db.exists():
+        logger.error(f"Airports database not found: {args.airports_db}")
+        return 1
+
+    exclude_countries = [c.strip().upper() for c in args.exclude_countries.split(",") if c.strip()]
+    start = time.perf_counter()
+    model = load_airports_model(args.airports_db, args.snapshot_dir, exclude_countries)
+    path = snapshot_file(args.snapshot_dir, exclude_countries)
+    if not path.exists():
+        logger.error(f"Snapshot was not written: {path}")
+        return 1
+
+    logger.info(
+        f"Snapshot {path}: {model.airports.count()} airports, "
+        f"{path.stat().st_size / 1e6:.1f} MB, {time.perf_counter() - start:.1f}s"
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
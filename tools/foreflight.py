@@ -9,6 +9,11 @@ Purpose (two modes):
        - navdata/Approaches.kml → instrument procedure lines from the EuroAIP database
        - navdata/PointOfEntry.kml → border/point-of-entry airports
      - Intended as a visual overlay for ForeFlight maps.
+     - Pipeline mode (--workers N): per-country KML fragments are built in N worker
+       processes and streamed straight into NAME.zip (pack folder inside the zip).
+       If the navdata is byte-identical to the existing zip and neither --next-version
+       nor --expiration is given, the zip (manifest included) is left untouched;
+       otherwise the manifest is rewritten with a fresh effective/expiration date.
 
   2) Approach pack from Excel (command "approach"):
      - Builds a content pack containing a CSV of relevant custom navigation points
@@ -35,12 +40,16 @@ Database selection (aligned with tools/aip.py):
     otherwise use local airports.db if it exists; otherwise error.
   - If --database is provided without a value (-d): same behavior as above.
   - If --database PATH is provided: use the specified database file.
+  - With --snapshot-dir (default MODEL_SNAPSHOT_DIR env var) the model is loaded from
+    the prebuilt model snapshot when it matches the database (see
+    tools/build_model_snapshot.py), and the snapshot is written otherwise.
 
 Usage:
   # Map overlay content pack (procedures + points of entry)
   python tools/foreflight.py NAME
       [--next-version] [--expiration DAYS]
       [--procedure-distance NM]
+      [--workers N] [--snapshot-dir DIR]
       [--database [PATH]]
       [-v|--verbose]
 
@@ -62,6 +71,9 @@ Examples:
   # Control version, expiration, and procedure line length (nm)
   python tools/foreflight.py MyOverlay --next-version --expiration 180 --procedure-distance 8
 
+  # Parallel build into MyOverlay.zip, reusing the model snapshot (AIRAC regeneration)
+  python tools/foreflight.py MyOverlay --workers 8 --snapshot-dir out/model_snapshot --next-version
+
   # Build approach pack from Excel definitions
   python tools/foreflight.py CustomApproach -c approach --xlsx CustomApproach.xlsx --next-version -e 120
 
@@ -73,22 +85,32 @@ import sys
 import argparse
 import logging
 from pathlib import Path
-from typing import List, Optional, Dict, Any
+from typing import List, Optional, Dict, Any, Iterable, Tuple
 from pprint import pprint
+from xml.sax.saxutils import escape
 import simplekml
 import json
 import datetime
+import hashlib
+import multiprocessing
 import pandas as pd
 import os
+import zipfile
+from concurrent.futures import ProcessPoolExecutor
+from itertools import islice
 try:
     import openpyxl
 except ImportError:
     print("openpyxl is required for Excel processing. Install with: pip install openpyxl")
     sys.exit(1)
-from euro_aip.storage.database_storage import DatabaseStorage
 from euro_aip.models.euro_aip_model import EuroAipModel
 from euro_aip.models.navpoint import NavPoint
 
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from shared.model_snapshot import load_airports_model
+
 # Configure logging
 logging.basicConfig(
     level=logging.INFO,
@@ -96,6 +118,47 @@ logging.basicConfig(
 )
 logger = logging.getLogger(__name__)
 
+# Point of entry icon color by ICAO prefix (others blue)
+POE_COLORS = {
+    "LF": simplekml.Color.white,  # France
+    "EG": simplekml.Color.red,    # United Kingdom
+    "ED": simplekml.Color.black,  # Germany
+    "LE": simplekml.Color.orange, # Spain
+    "LI": simplekml.Color.green,  # Italy
+    # Add more countries as needed
+}
+POE_ICON_HREF = 'https://www.gstatic.com/mapspro/images/stock/503-wht-blank_maps.png'
+
+# Approach line color by approach type (others white)
+APPROACH_COLORS = {
+    'ILS': simplekml.Color.yellow,    # Instrument Landing System - highest precision
+    'RNP': simplekml.Color.blue,      # Required Navigation Performance
+    'RNAV': simplekml.Color.blue,     # Area Navigation
+    'LOC': simplekml.Color.orange,    # Localizer
+    'LDA': simplekml.Color.orange,    # Localizer Directional Aid
+    'SDF': simplekml.Color.orange,    # Simplified Directional Facility
+    'VOR': simplekml.Color.white,     # VHF Omnidirectional Range
+    'NDB': simplekml.Color.white,     # Non-Directional Beacon
+}
+APPROACH_LINE_WIDTH = 10
+
+# Manifest expiration when --expiration is not given
+DEFAULT_EXPIRATION_DAYS = 365
+
+def poe_description(airport) -> str:
+    """HTML description of a point of entry placemark."""
+    desc = f"<h2>{airport.name} ({airport.ident})</h2>"
+    if airport.municipality:
+        desc += f"<p>Location: {airport.municipality}</p>"
+    if airport.iso_country:
+        desc += f"<p>Country: {airport.iso_country}</p>"
+
+    # Add border crossing specific info if available
+    custom_entry = airport.get_aip_entry_for_field(302)
+    if custom_entry:
+        desc += f"<p>Custom and Immigrations:</p><p>{custom_entry.value}</p>"
+    return desc
+
 def _database_path(path: Optional[str]) -> str:
     """
     Resolve database path consistent with tools/aip.py:
@@ -117,6 +180,176 @@ def _database_path(path: Optional[str]) -> str:
         raise ValueError("No database file found (set AIRPORTS_DB or create airports.db)")
     return path
 
+# Pipeline mode (--workers): KML placemarks are built per country in worker
+# processes and streamed into the content pack zip in a fixed order, so the
+# output bytes (and their hashes) only change when the data does.
+
+KML_HEADER = (
+    '<?xml version="1.0" encoding="UTF-8"?>\n'
+    '<kml xmlns="http://www.opengis.net/kml/2.2" xmlns:gx="http://www.google.com/kml/ext/2.2">\n'
+    '<Document>\n'
+)
+KML_FOOTER = '</Document>\n</kml>\n'
+
+NAVDATA_FILES = {
+    'approaches': 'Approaches.kml',
+    'poe': 'PointOfEntry.kml',
+}
+
+# Model of a worker process (inherited from the parent with fork, else loaded once)
+_worker_model: Optional[EuroAipModel] = None
+
+def _init_pipeline_worker(db_path: str, snapshot_dir: Optional[str]):
+    global _worker_model
+    if _worker_model is None:
+        _worker_model = load_airports_model(Path(db_path), Path(snapshot_dir) if snapshot_dir else None)
+
+def kml_poe_placemark(airport) -> str:
+    """Point of entry placemark (same content as build_point_of_entry)."""
+    color = POE_COLORS.get(airport.ident[:2], simplekml.Color.blue)
+    return (
+        f'<Placemark><name>POE.{escape(airport.ident)}</name>'
+        f'<description>{escape(poe_description(airport))}</description>'
+        f'<Style><IconStyle><color>{color}</color><Icon><href>{escape(POE_ICON_HREF)}</href></Icon></IconStyle></Style>'
+        f'<Point><coordinates>{airport.longitude_deg},{airport.latitude_deg},0.0</coordinates></Point>'
+        f'</Placemark>\n'
+    )
+
+def kml_approach_placemarks(airport, distance_nm: float) -> List[str]:
+    """Approach line placemarks of an airport (same content as build_approaches)."""
+    placemarks = []
+    procedure_data = airport.get_procedure_lines(distance_nm=distance_nm)
+    for line_data in procedure_data['procedure_lines']:
+        try:
+            approach_type = line_data['approach_type']
+            color = APPROACH_COLORS.get(approach_type, simplekml.Color.white)
+            runway_end = line_data['runway_end']
+            approach_name = line_data['procedure_name'] or f"RWY{runway_end}"
+            name = f"{airport.ident} {approach_name}"
+            description = f"{airport.ident} {runway_end} {approach_name} ({approach_type})"
+            coords = (
+                f"{line_data['start_lon']},{line_data['start_lat']},0.0 "
+                f"{line_data['end_lon']},{line_data['end_lat']},0.0"
+            )
+            placemarks.append(
+                f'<Placemark><name>{escape(name)}</name>'
+                f'<description>{escape(description)}</description>'
+                f'<Style><LineStyle><color>{color}</color><width>{APPROACH_LINE_WIDTH}</width></LineStyle></Style>'
+                f'<LineString><coordinates>{coords}</coordinates></LineString>'
+                f'</Placemark>\n'
+            )
+        except (ValueError, KeyError) as e:
+            logger.warning(f"Error processing approach for {airport.ident} {line_data.get('runway_end')}: {e}")
+    return placemarks
+
+def build_country_fragment(task: Tuple[str, str, List[str], float]) -> bytes:
+    """KML placemarks of one navdata file for one country (runs in a worker)."""
+    kind, country, idents, distance_nm = task
+    placemarks = []
+    for ident in idents:
+        airport = _worker_model.airports.get(ident)
+        if kind == 'poe':
+            placemarks.append(kml_poe_placemark(airport))
+        else:
+            placemarks.extend(kml_approach_placemarks(airport, distance_nm))
+    logger.debug(f'Built {len(placemarks)} {kind} placemarks for {country or "unknown country"}')
+    return ''.join(placemarks).encode('utf-8')
+
+def read_zip_hashes(zip_path: Path, name: str) -> Tuple[Dict[str, str], Optional[Dict[str, Any]]]:
+    """sha256 of each navdata entry of an existing content pack zip, and its manifest."""
+    if not zip_path.exists():
+        return {}, None
+    hashes = {}
+    manifest = None
+    with zipfile.ZipFile(zip_path) as zf:
+        for info in zf.infolist():
+            if info.filename == f'{name}/manifest.json':
+                manifest = json.loads(zf.read(info))
+            elif info.filename.startswith(f'{name}/navdata/'):
+                digest = hashlib.sha256()
+                with zf.open(info) as f:
+                    for chunk in iter(lambda: f.read(1 << 20), b''):
+                        digest.update(chunk)
+                hashes[info.filename] = digest.hexdigest()
+    return hashes, manifest
+
+class ContentPackPipeline:
+    """
+    Parallel builder of the database content pack navdata.
+
+    Usage:
+        pipeline = ContentPackPipeline(model, db_path, snapshot_dir, workers=8, procedure_distance=10.0)
+        with zipfile.ZipFile(path, 'w', compression=zipfile.ZIP_DEFLATED) as zf:
+            hashes = pipeline.write_navdata(zf, 'PointOfEntry')
+    """
+
+    def __init__(self, model: EuroAipModel, db_path: str, snapshot_dir: Optional[str],
+                 workers: int, procedure_distance: float):
+        self.model = model
+        self.db_path = db_path
+        self.snapshot_dir = snapshot_dir
+        self.workers = workers
+        self.procedure_distance = procedure_distance
+
+    def tasks(self) -> List[Tuple[str, str, List[str], float]]:
+        """(kind, country, idents, distance) per navdata file and country, in output order."""
+        groups = {
+            'approaches': self.model.airports.with_procedures().all(),
+            'poe': [
+                a for a in self.model.airports.border_crossings().all()
+                if a.latitude_deg and a.longitude_deg
+            ],
+        }
+        logger.info(
+            f"Found {len(groups['approaches'])} airports with procedures and "
+            f"{len(groups['poe'])} border crossing airports with coordinates"
+        )
+        tasks = []
+        for kind, airports in groups.items():
+            by_country: Dict[str, List[str]] = {}
+            for airport in airports:
+                by_country.setdefault(airport.iso_country or '', []).append(airport.ident)
+            for country in sorted(by_country):
+                tasks.append((kind, country, sorted(by_country[country]), self.procedure_distance))
+        return tasks
+
+    def write_navdata(self, zf: zipfile.ZipFile, name: str) -> Dict[str, str]:
+        """Stream every navdata file into the zip; returns {entry name: sha256}."""
+        global _worker_model
+        # Forked workers inherit the loaded model instead of loading it again
+        _worker_model = self.model
+        methods = multiprocessing.get_all_start_methods()
+        context = multiprocessing.get_context('fork' if 'fork' in methods else 'spawn')
+        tasks = self.tasks()
+
+        hashes: Dict[str, str] = {}
+        with ProcessPoolExecutor(
+            max_workers=self.workers,
+            mp_context=context,
+            initializer=_init_pipeline_worker,
+            initargs=(self.db_path, self.snapshot_dir),
+        ) as pool:
+            # map() yields in task order while workers run ahead
+            results = zip(tasks, pool.map(build_country_fragment, tasks))
+            for kind, filename in NAVDATA_FILES.items():
+                entry = f'{name}/navdata/{filename}'
+                count = sum(1 for task in tasks if task[0] == kind)
+                digest = hashlib.sha256()
+                with zf.open(entry, 'w') as out:
+                    for chunk in self._kml_chunks(fragment for _, fragment in islice(results, count)):
+                        digest.update(chunk)
+                        out.write(chunk)
+                hashes[entry] = digest.hexdigest()
+                logger.info(f'Streamed {entry}')
+        return hashes
+
+    @staticmethod
+    def _kml_chunks(fragments: Iterable[bytes]) -> Iterable[bytes]:
+        yield KML_HEADER.encode('utf-8')
+        yield from fragments
+        yield KML_FOOTER.encode('utf-8')
+
+
 class Command:
     """Command-line interface for ForeFlight export functionality."""
     
@@ -128,14 +361,14 @@ class Command:
             args: Command line arguments
         """
         self.args = args
-        db_path = _database_path(args.database)
-        self.storage = DatabaseStorage(db_path)
+        self.db_path = _database_path(args.database)
         self.model = None
 
     def load_model(self):
-        """Load the EuroAipModel from the database."""
-        logger.info(f"Loading model from database: {self.args.database}")
-        self.model = self.storage.load_model()
+        """Load the EuroAipModel from the database (or its matching model snapshot)."""
+        logger.info(f"Loading model from database: {self.db_path}")
+        snapshot_dir = Path(self.args.snapshot_dir) if self.args.snapshot_dir else None
+        self.model = load_airports_model(Path(self.db_path), snapshot_dir)
         logger.info(f"Loaded model with {len(self.model.airports)} airports and {len(self.model.get_all_border_crossing_points())} border crossing entries")
 
     def build_point_of_entry(self, dest: str):
@@ -146,16 +379,6 @@ class Command:
         # Create KML document
         kml = simplekml.Kml()
         
-        # Define colors for different countries
-        icao_to_color = {
-            "LF": simplekml.Color.white,  # France
-            "EG": simplekml.Color.red,    # United Kingdom
-            "ED": simplekml.Color.black,  # Germany
-            "LE": simplekml.Color.orange, # Spain
-            "LI": simplekml.Color.green,  # Italy
-            # Add more countries as needed
-        }
-
         # Get border crossing airports from the model
         border_airports = self.model.airports.border_crossings().all()
         logger.info(f"Found {len(border_airports)} border crossing airports")
@@ -167,7 +390,7 @@ class Command:
                 
             ident = airport.ident
             prefix = ident[:2]
-            color = icao_to_color.get(prefix, simplekml.Color.blue)
+            color = POE_COLORS.get(prefix, simplekml.Color.blue)
             
             # Create NavPoint
             point = NavPoint(
@@ -182,20 +405,8 @@ class Command:
             
             # Set style
             p.style.iconstyle.color = color
-            p.style.iconstyle.icon.href = 'https://www.gstatic.com/mapspro/images/stock/503-wht-blank_maps.png'
-            
-            # Add description
-            desc = f"<h2>{airport.name} ({ident})</h2>"
-            if airport.municipality:
-                desc += f"<p>Location: {airport.municipality}</p>"
-            if airport.iso_country:
-                desc += f"<p>Country: {airport.iso_country}</p>"
-            
-            # Add border Acrossing specific info if available
-            custom_entry = airport.get_aip_entry_for_field(302)
-            if custom_entry:
-                desc += f"<p>Custom and Immigrations:</p><p>{custom_entry.value}</p>"
-            p.description = desc
+            p.style.iconstyle.icon.href = POE_ICON_HREF
+            p.description = poe_description(airport)
 
         logger.info(f'Writing {dest}')
         kml.save(dest)
@@ -210,18 +421,6 @@ class Command:
         # Create KML document
         kml = simplekml.Kml()
         
-        # Define colors for different approach types
-        approach_colors = {
-            'ILS': simplekml.Color.yellow,    # Instrument Landing System - highest precision
-            'RNP': simplekml.Color.blue,      # Required Navigation Performance
-            'RNAV': simplekml.Color.blue,     # Area Navigation
-            'LOC': simplekml.Color.orange,    # Localizer
-            'LDA': simplekml.Color.orange,    # Localizer Directional Aid
-            'SDF': simplekml.Color.orange,    # Simplified Directional Facility
-            'VOR': simplekml.Color.white,     # VHF Omnidirectional Range
-            'NDB': simplekml.Color.white,     # Non-Directional Beacon
-        }
-
         # Get airports with procedures
         airports_with_procedures = self.model.airports.with_procedures().all()
         logger.info(f"Found {len(airports_with_procedures)} airports with procedures")
@@ -239,7 +438,7 @@ class Command:
                 approach_type = line_data['approach_type']
                 
                 # Get color for the approach type
-                color = approach_colors.get(approach_type, simplekml.Color.white)
+                color = APPROACH_COLORS.get(approach_type, simplekml.Color.white)
                 
                 # Log the selection for debugging
                 if airport.ident in ['LFAC', 'LFOK']:
@@ -255,7 +454,7 @@ class Command:
                               (line_data['end_lon'], line_data['end_lat'])]
                     )
                     line.style.linestyle.color = color
-                    line.style.linestyle.width = 10
+                    line.style.linestyle.width = APPROACH_LINE_WIDTH
                     
                 except (ValueError, KeyError) as e:
                     logger.warning(f"Error processing approach for {airport.ident} {line_data['runway_end']}: {e}")
@@ -282,6 +481,28 @@ class Command:
 
         # Create or update manifest
         manifest_file = pack_dir / 'manifest.json'
+        existing = None
+        if manifest_file.exists():
+            with open(manifest_file, 'r') as f:
+                existing = json.load(f)
+        manifest_data = self.database_manifest(existing)
+
+        with open(manifest_file, 'w') as f:
+            json.dump(manifest_data, f, indent=2)
+        logger.info(f'Writing {manifest_file}')
+
+        # Build KML files
+        self.build_approaches(str(nav_dir / 'Approaches.kml'))
+        self.build_point_of_entry(str(nav_dir / 'PointOfEntry.kml'))
+
+    def expiration_days(self) -> int:
+        """Requested manifest expiration (days from now)."""
+        if self.args.expiration is None:
+            return DEFAULT_EXPIRATION_DAYS
+        return int(self.args.expiration)
+
+    def database_manifest(self, existing: Optional[Dict[str, Any]]) -> Dict[str, Any]:
+        """Manifest of the database content pack, keeping (or incrementing) an existing version."""
         manifest_data = {
             'name': 'Point of Entry',
             'abbreviation': 'POE.V2',
@@ -289,27 +510,60 @@ class Command:
             'organizationName': 'flyfun.aero'
         }
 
-        if manifest_file.exists():
-            with open(manifest_file, 'r') as f:
-                existing = json.load(f)
+        if existing:
             manifest_data['version'] = existing['version']
             if self.args.next_version:
                 manifest_data['version'] += 1
                 logger.info(f'Incrementing version to {manifest_data["version"]}')
 
         manifest_data['effectiveDate'] = datetime.datetime.now().isoformat()
-        days = int(self.args.expiration)
+        days = self.expiration_days()
         manifest_data['expirationDate'] = (
             datetime.datetime.now() + datetime.timedelta(days=days)
         ).isoformat()
+        return manifest_data
 
-        with open(manifest_file, 'w') as f:
-            json.dump(manifest_data, f, indent=2)
-        logger.info(f'Writing {manifest_file}')
+    def build_database_content_pack_zip(self):
+        """
+        Build the database content pack into NAME.zip with KML built in parallel.
 
-        # Build KML files
-        self.build_approaches(str(nav_dir / 'Approaches.kml'))
-        self.build_point_of_entry(str(nav_dir / 'PointOfEntry.kml'))
+        Navdata entries are streamed into a temporary zip and hashed on the way.
+        If every entry matches the existing zip and no new version or expiration
+        was requested, nothing is replaced. Otherwise the manifest (version,
+        effective and expiration dates) is written last and the zip replaced.
+        """
+        if not self.model:
+            self.load_model()
+
+        name = self.args.name
+        zip_path = Path(f'{name}.zip')
+        previous_hashes, existing = read_zip_hashes(zip_path, name)
+        if existing is None and (Path(name) / 'manifest.json').exists():
+            with open(Path(name) / 'manifest.json', 'r') as f:
+                existing = json.load(f)
+
+        pipeline = ContentPackPipeline(
+            self.model,
+            self.db_path,
+            self.args.snapshot_dir,
+            self.args.workers,
+            self.args.procedure_distance,
+        )
+        tmp_path = zip_path.with_name(f'{zip_path.name}.{os.getpid()}.tmp')
+        try:
+            with zipfile.ZipFile(tmp_path, 'w', compression=zipfile.ZIP_DEFLATED) as zf:
+                hashes = pipeline.write_navdata(zf, name)
+                manifest_requested = self.args.next_version or self.args.expiration is not None
+                if hashes == previous_hashes and existing and not manifest_requested:
+                    logger.info(f'Navdata unchanged, keeping {zip_path} (version {existing["version"]})')
+                    return
+                manifest_data = self.database_manifest(existing)
+                zf.writestr(f'{name}/manifest.json', json.dumps(manifest_data, indent=2))
+            os.replace(tmp_path, zip_path)
+            logger.info(f'Writing {zip_path} (version {manifest_data["version"]})')
+        finally:
+            if tmp_path.exists():
+                tmp_path.unlink()
 
     def build_approach_content_pack(self):
         """Build a ForeFlight content pack from Excel approach definition."""
@@ -344,7 +598,7 @@ class Command:
                 logger.info(f'Incrementing version to {manifest_data["version"]}')
 
         manifest_data['effectiveDate'] = datetime.datetime.now().isoformat()
-        days = int(self.args.expiration)
+        days = self.expiration_days()
         manifest_data['expirationDate'] = (
             datetime.datetime.now() + datetime.timedelta(days=days)
         ).isoformat()
@@ -475,6 +729,8 @@ class Command:
         if self.args.command == 'approach':
             self.build_approach_content_pack()
             self.describe_waypoints()
+        elif self.args.workers:
+            self.build_database_content_pack_zip()
         else:
             self.build_database_content_pack()
 
@@ -549,7 +805,7 @@ def main():
     parser = argparse.ArgumentParser(description='ForeFlight export tool')
     parser.add_argument('name', help='Name of the content pack')
     parser.add_argument('-n', '--next-version', help='Increment version', action='store_true')
-    parser.add_argument('-e', '--expiration', help='Expiration in days', default=365, type=int)
+    parser.add_argument('-e', '--expiration', help=f'Expiration in days (default: {DEFAULT_EXPIRATION_DAYS})', default=None, type=int)
     parser.add_argument('-v', '--verbose', help='Verbose output', action='store_true')
     
     # Command-specific arguments
@@ -566,8 +822,14 @@ def main():
     parser.add_argument('--describe', help='Describe information about list of waypoints (comma-separated, for approach command)')
     parser.add_argument('--procedure-distance', help='Distance in nautical miles for procedure lines (default: 10.0)', 
                        default=10.0, type=float)
+    parser.add_argument('-w', '--workers', type=int, default=None,
+                       help='Build KML in N worker processes and write NAME.zip (airports command; 0 = one per CPU)')
+    parser.add_argument('--snapshot-dir', default=os.environ.get('MODEL_SNAPSHOT_DIR'),
+                       help='Model snapshot directory (default: MODEL_SNAPSHOT_DIR; unset = load airports.db)')
     
     args = parser.parse_args()
+    if args.workers == 0:
+        args.workers = os.cpu_count() or 1
     
     if args.verbose:
         logging.getLogger().setLevel(logging.DEBUG)
@@ -393,6 +393,8 @@ def main(argv: Optional[List[str]] = None) -> int:
                    help="Path for vector database (local mode). Defaults to cache/rules_vector_db or VECTOR_DB_PATH env var")
     p.add_argument("--vector-db-url", default=None,
                    help="URL for ChromaDB service (service mode, takes precedence over --vector-db-path). Can also use VECTOR_DB_URL env var")
+    p.add_argument("--vector-index-path", default=None,
+                   help="Also export an in-process vector index (used instead of ChromaDB by web/MCP servers). Can also use VECTOR_INDEX_PATH env var")
     p.add_argument("--embedding-model", default="text-embedding-3-small",
                    help="Embedding model for RAG (default: text-embedding-3-small, OpenAI model)")
     
@@ -509,7 +511,8 @@ def main(argv: Optional[List[str]] = None) -> int:
                 vector_db_url=vector_db_url,
                 embedding_model=args.embedding_model,
                 force_rebuild=True,  # Always rebuild to ensure new embeddings are used
-                build_answer_embeddings=True  # Build answer embeddings for comparison feature
+                build_answer_embeddings=True,  # Build answer embeddings for comparison feature
+                vector_index_path=args.vector_index_path or os.environ.get("VECTOR_INDEX_PATH"),
             )
             # Handle both dict (new) and int (legacy) return types
             if isinstance(result, dict):
@@ -0,0 +1,153 @@
+/**
+ * AirportTileLoader - Viewport airport loading by fixed quadtree tiles
+ *
+ * The viewport is covered by z/x/y tiles (see utils/tiles.ts) that are fetched
+ * and cached independently, so panning back over an area or zooming within the
+ * same tile level costs no request:
+ * - LRU cache of tile results per filter set (entries expire after TILE_TTL_MS)
+ * - One in-flight request per tile, shared by overlapping loads
+ * - Tile requests no longer needed by the latest viewport are aborted
+ * - Results of superseded loads are dropped (load resolves to null)
+ */
+
+import type { Airport, BoundingBox, FilterConfig } from '../store/types';
+import type { APIAdapter } from './api-adapter';
+import { tileId, tilesForBounds, tileZoomForMapZoom } from '../utils/tiles';
+import type { TileKey } from '../utils/tiles';
+
+// Matches the server's tile Cache-Control max-age
+const TILE_TTL_MS = 5 * 60 * 1000;
+
+interface CachedTile {
+  airports: Airport[];
+  loadedAt: number;
+}
+
+interface InFlightTile {
+  promise: Promise<Airport[]>;
+  controller: AbortController;
+}
+
+export class AirportTileLoader {
+  private cache = new Map<string, CachedTile>(); // Insertion order = LRU order
+  private inFlight = new Map<string, InFlightTile>();
+  private generation = 0;
+
+  /**
+   * @param api API adapter used for tile requests
+   * @param tileLimit Max airports per tile (largest runways first, as the server orders them)
+   * @param maxTiles Max cached tiles across all filter sets
+   */
+  constructor(
+    private api: APIAdapter,
+    private tileLimit: number = 250,
+    private maxTiles: number = 256
+  ) {}
+
+  /**
+   * Airports for a viewport if every covering tile is cached, otherwise null
+   */
+  getCached(bounds: BoundingBox, mapZoom: number, filters: Partial<FilterConfig>): Airport[] | null {
+    const results: Airport[][] = [];
+    for (const key of this.tileKeys(bounds, mapZoom, filters).keys) {
+      const cached = this.getTile(key);
+      if (!cached) return null;
+      results.push(cached);
+    }
+    return this.merge(results);
+  }
+
+  /**
+   * Load airports for a viewport
+   * @returns Airports in the covering tiles, or null if a newer load superseded this one
+   */
+  async load(bounds: BoundingBox, mapZoom: number, filters: Partial<FilterConfig>): Promise<Airport[] | null> {
+    const generation = ++this.generation;
+    const { tiles, keys } = this.tileKeys(bounds, mapZoom, filters);
+
+    // Cancel tile requests the new viewport does not need
+    const wanted = new Set(keys);
+    this.inFlight.forEach((entry, key) => {
+      if (!wanted.has(key)) {
+        entry.controller.abort();
+        this.inFlight.delete(key);
+      }
+    });
+
+    let results: Airport[][];
+    try {
+      results = await Promise.all(tiles.map((tile, i) => this.loadTile(keys[i], tile, filters)));
+    } catch (error) {
+      if (generation !== this.generation) return null;
+      throw error;
+    }
+    if (generation !== this.generation) return null;
+    return this.merge(results);
+  }
+
+  /**
+   * Drop all cached tiles (e.g. after data changes)
+   */
+  clear(): void {
+    this.inFlight.forEach(entry => entry.controller.abort());
+    this.inFlight.clear();
+    this.cache.clear();
+  }
+
+  private tileKeys(bounds: BoundingBox, mapZoom: number, filters: Partial<FilterConfig>): { tiles: TileKey[]; keys: string[] } {
+    const tiles = tilesForBounds(bounds, tileZoomForMapZoom(mapZoom));
+    const filterKey = JSON.stringify(filters, Object.keys(filters).sort());
+    return { tiles, keys: tiles.map(tile => `${filterKey}|${tileId(tile)}`) };
+  }
+
+  private getTile(key: string): Airport[] | null {
+    const cached = this.cache.get(key);
+    if (!cached) return null;
+    if (Date.now() - cached.loadedAt > TILE_TTL_MS) {
+      this.cache.delete(key);
+      return null;
+    }
+    // Move to most recently used
+    this.cache.delete(key);
+    this.cache.set(key, cached);
+    return cached.airports;
+  }
+
+  private loadTile(key: string, tile: TileKey, filters: Partial<FilterConfig>): Promise<Airport[]> {
+    const cached = this.getTile(key);
+    if (cached) return Promise.resolve(cached);
+
+    const pending = this.inFlight.get(key);
+    if (pending) return pending.promise;
+
+    const controller = new AbortController();
+    const promise = this.api
+      .getAirportsByTile(tile, { ...filters, limit: this.tileLimit }, controller.signal)
+      .then(airports => {
+        this.cache.set(key, { airports, loadedAt: Date.now() });
+        if (this.cache.size > this.maxTiles) {
+          // Evict least recently used
+          this.cache.delete(this.cache.keys().next().value as string);
+        }
+        return airports;
+      })
+      .finally(() => {
+        if (this.inFlight.get(key)?.controller === controller) {
+          this.inFlight.delete(key);
+        }
+      });
+    this.inFlight.set(key, { promise, controller });
+    return promise;
+  }
+
+  /**
+   * Union of tile results (airports on shared tile edges appear once), largest runways first
+   */
+  private merge(results: Airport[][]): Airport[] {
+    const byIdent = new Map<string, Airport>();
+    results.forEach(airports => airports.forEach(airport => byIdent.set(airport.ident, airport)));
+    return Array.from(byIdent.values()).sort(
+      (a, b) => (b.longest_runway_length_ft || 0) - (a.longest_runway_length_ft || 0)
+    );
+  }
+}
@@ -4,6 +4,8 @@
  */
 
 import type { Airport, FilterConfig, GAConfig, AirportGAScore, AirportGASummary, Persona, BoundingBox } from '../store/types';
+import { tileId } from '../utils/tiles';
+import type { TileKey } from '../utils/tiles';
 
 /**
  * Standard API response format
@@ -46,6 +48,46 @@ export interface LocateResponse {
   visualization?: any;
 }
 
+/**
+ * Compact columnar payload: field names once, one value array per object
+ * (see web/server/api/wire_format.py)
+ */
+export interface ColumnarPayload {
+  format: 'columnar';
+  fields: string[];
+  rows: unknown[][];
+}
+
+/**
+ * Check whether a response value is a columnar payload
+ */
+export function isColumnar(value: unknown): value is ColumnarPayload {
+  return (
+    typeof value === 'object' &&
+    value !== null &&
+    (value as ColumnarPayload).format === 'columnar' &&
+    Array.isArray((value as ColumnarPayload).rows)
+  );
+}
+
+/**
+ * Expand a columnar payload back into an array of objects.
+ * Plain arrays are returned unchanged.
+ */
+export function decodeColumnar<T>(value: ColumnarPayload | T[]): T[] {
+  if (!isColumnar(value)) {
+    return Array.isArray(value) ? value : [];
+  }
+  const { fields, rows } = value;
+  return rows.map(row => {
+    const item: Record<string, unknown> = {};
+    for (let i = 0; i < fields.length; i++) {
+      item[fields[i]] = row[i];
+    }
+    return item as T;
+  });
+}
+
 /**
  * API Adapter class
  */
@@ -91,11 +133,11 @@ export class APIAdapter {
     
     try {
       const response = await fetch(url, {
+        ...options,
         headers: {
           'Content-Type': 'application/json',
           ...options.headers
-        },
-        ...options
+        }
       });
       
       if (!response.ok) {
@@ -104,7 +146,10 @@ export class APIAdapter {
       
       return await response.json();
     } catch (error) {
-      console.error('API request failed:', error);
+      // Aborted requests (superseded viewport loads) are expected, not failures
+      if ((error as any)?.name !== 'AbortError') {
+        console.error('API request failed:', error);
+      }
       throw error;
     }
   }
@@ -114,14 +159,14 @@ export class APIAdapter {
    */
   async getAirports(filters: Partial<FilterConfig> = {}): Promise<APIResponse<Airport[]>> {
     const params = this.transformFiltersToParams(filters);
-    const queryString = params.toString();
-    const endpoint = `/api/airports/${queryString ? '?' + queryString : ''}`;
+    params.set('format', 'columnar');
+    const endpoint = `/api/airports/?${params.toString()}`;
 
-    const data = await this.request<Airport[]>(endpoint);
+    const data = decodeColumnar(await this.request<ColumnarPayload | Airport[]>(endpoint));
 
     return {
-      data: Array.isArray(data) ? data : [],
-      count: Array.isArray(data) ? data.length : 0
+      data,
+      count: data.length
     };
   }
 
@@ -134,16 +179,33 @@ export class APIAdapter {
   ): Promise<APIResponse<Airport[]>> {
     const params = this.transformFiltersToParams(filters);
     params.set('bbox', `${bounds.north},${bounds.south},${bounds.east},${bounds.west}`);
+    params.set('format', 'columnar');
 
     const endpoint = `/api/airports/?${params.toString()}`;
-    const data = await this.request<Airport[]>(endpoint);
+    const data = decodeColumnar(await this.request<ColumnarPayload | Airport[]>(endpoint));
 
     return {
-      data: Array.isArray(data) ? data : [],
-      count: Array.isArray(data) ? data.length : 0
+      data,
+      count: data.length
     };
   }
 
+  /**
+   * Get airports in one quadtree tile (cacheable by URL, see utils/tiles.ts)
+   */
+  async getAirportsByTile(
+    tile: TileKey,
+    filters: Partial<FilterConfig> = {},
+    signal?: AbortSignal
+  ): Promise<Airport[]> {
+    const params = this.transformFiltersToParams(filters);
+    params.set('tile', tileId(tile));
+    params.set('format', 'columnar');
+
+    const endpoint = `/api/airports/?${params.toString()}`;
+    return decodeColumnar(await this.request<ColumnarPayload | Airport[]>(endpoint, { signal }));
+  }
+
   /**
    * Search airports by query
    */
@@ -277,13 +339,22 @@ export class APIAdapter {
    */
   async getBulkProcedureLines(airports: string[], distanceNm: number = 10.0): Promise<Record<string, any>> {
     const endpoint = '/api/airports/bulk/procedure-lines';
-    return await this.request(endpoint, {
+    const result = await this.request<Record<string, any>>(endpoint, {
       method: 'POST',
       body: JSON.stringify({
         airports,
-        distance_nm: distanceNm
+        distance_nm: distanceNm,
+        format: 'columnar'
       })
     });
+
+    // Expand each airport's columnar procedure lines back into objects
+    for (const data of Object.values(result)) {
+      if (data && isColumnar(data.procedure_lines)) {
+        data.procedure_lines = decodeColumnar(data.procedure_lines);
+      }
+    }
+    return result;
   }
   
   /**
@@ -5,20 +5,35 @@
 
 import type { Airport, LegendMode, Highlight, RouteState, GAFriendlySummary } from '../store/types';
 import { useStore } from '../store/store';
+import { ClusterIndex } from '../utils/marker-clusters';
 
 // Leaflet types (will be imported when Leaflet is available)
 declare const L: any;
 type LeafletMap = any; // Leaflet Map type
 
+// Above this many airports, markers are drawn on a shared canvas and clustered when zoomed out
+const CANVAS_MARKER_THRESHOLD = 500;
+
+// Canvas markers are never clustered from this zoom level on
+const CLUSTER_MAX_ZOOM = 9;
+
+// Grid cell size for clustering (pixels at the current zoom)
+const CLUSTER_CELL_PX = 60;
+
 /**
  * Marker style configuration
  */
 interface MarkerStyle {
   color: string;
   radius: number;
-  icon: any; // Leaflet Icon
 }
 
+/**
+ * 'dom': one L.marker with a divIcon per airport (small result sets)
+ * 'canvas': circle markers on a canvas renderer, clustered below CLUSTER_MAX_ZOOM
+ */
+type MarkerRenderMode = 'dom' | 'canvas';
+
 /**
  * Visualization Engine class
  */
@@ -35,6 +50,12 @@ export class VisualizationEngine {
   private routeLine: any = null;
   private routeMarkers: any[] = [];
   private highlights: globalThis.Map<string, any> = new globalThis.Map();
+
+  private renderMode: MarkerRenderMode = 'dom';
+  private canvasRenderer: any = null;
+  private clusterLayer: any = null;
+  private clusterIndex: ClusterIndex | null = null;
+  private airportPopup: any = null; // Shared popup for canvas markers, filled on click
   
   /**
    * Initialize map and layers
@@ -59,10 +80,19 @@ export class VisualizationEngine {
     // We want highlights (reference points) below airport markers so legend colors are visible
     this.highlightLayer = L.layerGroup().addTo(this.map); // Reference points (locate center, route airports)
     this.airportLayer = L.layerGroup().addTo(this.map);   // Airport markers (on top of highlights)
+    this.clusterLayer = L.layerGroup().addTo(this.map);   // Airport clusters (canvas mode)
     this.procedureLayer = L.layerGroup().addTo(this.map); // Procedure lines
     this.routeLayer = L.layerGroup().addTo(this.map);     // Route lines
     this.overlayLayer = L.layerGroup().addTo(this.map);   // Other overlays
     
+    // Canvas mode: one canvas for all airport markers, clusters recomputed per zoom level
+    this.canvasRenderer = L.canvas({ padding: 0.5 });
+    this.clusterIndex = new ClusterIndex(
+      (lat, lng, zoom) => this.map.project([lat, lng], zoom),
+      CLUSTER_CELL_PX
+    );
+    this.map.on('zoomend', () => this.refreshClusters());
+    
     // Add scale control
     L.control.scale().addTo(this.map);
     
@@ -74,14 +104,23 @@ export class VisualizationEngine {
    */
   updateMarkers(airports: Airport[], legendMode: LegendMode, shouldFitBounds: boolean = false): void {
     if (!this.map || !this.airportLayer) return;
+
+    // Switching render mode rebuilds all markers; otherwise existing markers are restyled in place
+    const renderMode: MarkerRenderMode = airports.length > CANVAS_MARKER_THRESHOLD ? 'canvas' : 'dom';
+    if (renderMode !== this.renderMode) {
+      this.clearAirportMarkers();
+      this.renderMode = renderMode;
+    }
     
     const currentIcaos = new Set(this.markers.keys());
     const newIcaos = new Set(airports.map(a => a.ident));
+    let membershipChanged = false;
     
     // Remove markers not in new list
     currentIcaos.forEach(icao => {
       if (!newIcaos.has(icao)) {
         this.removeMarker(icao);
+        membershipChanged = true;
       }
     });
     
@@ -93,8 +132,18 @@ export class VisualizationEngine {
       } else {
         // Add new marker
         this.addMarker(airport, legendMode);
+        membershipChanged = true;
       }
     });
+
+    if (this.renderMode === 'canvas' && membershipChanged && this.clusterIndex) {
+      // Positions from the markers (airports without coordinates have none)
+      this.clusterIndex.setPoints(Array.from(this.markers.entries()).map(([icao, e]) => {
+        const { lat, lng } = e.marker.getLatLng();
+        return { id: icao, lat, lng };
+      }));
+      this.refreshClusters();
+    }
     
     // Fit bounds if requested and we have markers
     if (shouldFitBounds && this.markers.size > 0) {
@@ -112,9 +161,14 @@ export class VisualizationEngine {
     if (!airport.latitude_deg || !airport.longitude_deg) return;
     
     const style = this.getMarkerStyle(airport, legendMode);
+
+    if (this.renderMode === 'canvas') {
+      this.addCanvasMarker(airport, style);
+      return;
+    }
     
     const marker = L.marker([airport.latitude_deg, airport.longitude_deg], {
-      icon: style.icon
+      icon: this.createMarkerIcon(style)
     });
     
     marker.bindPopup(this.createPopup(airport));
@@ -134,6 +188,47 @@ export class VisualizationEngine {
     });
   }
   
+  /**
+   * Add canvas circle marker (no DOM node; shown by refreshClusters; popup built on click)
+   */
+  private addCanvasMarker(airport: Airport, style: MarkerStyle): void {
+    const marker = L.circleMarker([airport.latitude_deg, airport.longitude_deg], {
+      renderer: this.canvasRenderer,
+      radius: style.radius,
+      fillColor: style.color,
+      fillOpacity: 1,
+      color: '#ffffff',
+      weight: 2
+    });
+
+    marker.on('click', () => this.openCanvasMarkerPopup(airport.ident));
+
+    this.markers.set(airport.ident, {
+      marker,
+      airport,
+      style
+    });
+  }
+
+  /**
+   * Open the shared popup for a canvas marker and dispatch the airport click
+   */
+  private openCanvasMarkerPopup(icao: string): void {
+    const entry = this.markers.get(icao);
+    if (!entry || !this.map) return;
+
+    if (!this.airportPopup) {
+      this.airportPopup = L.popup();
+    }
+    this.airportPopup
+      .setLatLng(entry.marker.getLatLng())
+      .setContent(this.createPopup(entry.airport))
+      .openOn(this.map);
+
+    const event = new CustomEvent('airport-click', { detail: entry.airport });
+    window.dispatchEvent(event);
+  }
+  
   /**
    * Update marker appearance (without recreating)
    */
@@ -142,10 +237,16 @@ export class VisualizationEngine {
     if (!entry) return;
     
     const newStyle = this.getMarkerStyle(airport, legendMode);
+    entry.airport = airport; // Lazily built popups show current data
     
     // Only update if style changed
     if (entry.style.color !== newStyle.color || entry.style.radius !== newStyle.radius) {
-      entry.marker.setIcon(newStyle.icon);
+      if (this.renderMode === 'canvas') {
+        // Repaints the canvas (batched per frame), no DOM work
+        entry.marker.setStyle({ fillColor: newStyle.color, radius: newStyle.radius });
+      } else {
+        entry.marker.setIcon(this.createMarkerIcon(newStyle));
+      }
       entry.style = newStyle;
     }
   }
@@ -160,6 +261,89 @@ export class VisualizationEngine {
       this.markers.delete(icao);
     }
   }
+
+  /**
+   * Show canvas markers and clusters for the current zoom level
+   */
+  private refreshClusters(): void {
+    if (!this.map || !this.clusterLayer) return;
+    this.clusterLayer.clearLayers();
+    if (this.renderMode !== 'canvas' || !this.clusterIndex) return;
+
+    const zoom = this.map.getZoom();
+    const clustered = new Set<string>();
+    if (zoom < CLUSTER_MAX_ZOOM) {
+      this.clusterIndex.getClusters(zoom).forEach(cluster => {
+        if (cluster.ids.length > 1) {
+          cluster.ids.forEach(id => clustered.add(id));
+          this.addClusterMarker(cluster.ids, cluster.lat, cluster.lng);
+        }
+      });
+    }
+
+    this.markers.forEach((entry, icao) => {
+      const visible = !clustered.has(icao);
+      const onMap = this.airportLayer.hasLayer(entry.marker);
+      if (visible && !onMap) {
+        this.airportLayer.addLayer(entry.marker);
+      } else if (!visible && onMap) {
+        this.airportLayer.removeLayer(entry.marker);
+      }
+    });
+  }
+
+  /**
+   * Add a cluster marker (count badge); clicking zooms to its airports
+   */
+  private addClusterMarker(icaos: string[], lat: number, lng: number): void {
+    const count = icaos.length;
+    const size = count < 10 ? 28 : count < 100 ? 36 : 44;
+    const icon = L.divIcon({
+      className: 'airport-cluster',
+      html: `<div style="
+        width: ${size}px;
+        height: ${size}px;
+        line-height: ${size - 4}px;
+        background-color: rgba(0, 123, 255, 0.75);
+        border: 2px solid white;
+        border-radius: 50%;
+        box-shadow: 0 2px 4px rgba(0,0,0,0.3);
+        color: white;
+        font-size: 12px;
+        font-weight: bold;
+        text-align: center;
+      ">${count}</div>`,
+      iconSize: [size, size],
+      iconAnchor: [size / 2, size / 2]
+    });
+
+    const marker = L.marker([lat, lng], { icon });
+    marker.on('click', () => {
+      const latLngs = icaos
+        .map(icao => this.markers.get(icao))
+        .filter(entry => entry != null)
+        .map(entry => entry!.marker.getLatLng());
+      this.map.fitBounds(L.latLngBounds(latLngs).pad(0.1), { maxZoom: CLUSTER_MAX_ZOOM });
+    });
+    marker.addTo(this.clusterLayer);
+  }
+
+  /**
+   * Remove all airport markers and clusters (e.g. when switching render mode)
+   */
+  private clearAirportMarkers(): void {
+    if (this.airportLayer) {
+      this.airportLayer.clearLayers();
+    }
+    if (this.clusterLayer) {
+      this.clusterLayer.clearLayers();
+    }
+    if (this.airportPopup && this.map) {
+      this.map.closePopup(this.airportPopup);
+    }
+    this.clusterIndex?.setPoints([]);
+    this.markers.clear();
+  }
   
   /**
    * Get marker style based on legend mode
@@ -234,7 +418,15 @@ export class VisualizationEngine {
         break;
     }
 
-    const icon = L.divIcon({
+    return { color, radius };
+  }
+
+  /**
+   * DOM icon for a marker style (DOM render mode)
+   */
+  private createMarkerIcon(style: MarkerStyle): any {
+    const { color, radius } = style;
+    return L.divIcon({
       className: 'airport-marker',
       html: `<div style="
         width: ${radius * 2}px; 
@@ -247,8 +439,6 @@ export class VisualizationEngine {
       iconSize: [radius * 2, radius * 2],
       iconAnchor: [radius, radius]
     });
-    
-    return { color, radius, icon };
   }
   
   /**
@@ -703,8 +893,8 @@ export class VisualizationEngine {
         return;
       }
       
-      const group = L.featureGroup(markers);
-      const bounds = group.getBounds();
+      // From positions, so markers hidden in clusters (not on the map) count too
+      const bounds = L.latLngBounds(markers.map(m => m.getLatLng()));
       
       // Ensure bounds are valid
       if (!bounds.isValid()) {
@@ -746,13 +936,10 @@ export class VisualizationEngine {
    * Clear all markers
    */
   clearMarkers(): void {
-    if (this.airportLayer) {
-      this.airportLayer.clearLayers();
-    }
+    this.clearAirportMarkers();
     if (this.procedureLayer) {
       this.procedureLayer.clearLayers();
     }
-    this.markers.clear();
     this.procedureLines.clear();
   }
   
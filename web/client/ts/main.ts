@@ -5,6 +5,7 @@
 
 import { useStore } from './store/store';
 import { APIAdapter } from './adapters/api-adapter';
+import { AirportTileLoader } from './adapters/airport-tile-loader';
 import { VisualizationEngine } from './engines/visualization-engine';
 import { UIManager } from './managers/ui-manager';
 import { LLMIntegration } from './adapters/llm-integration';
@@ -33,6 +34,7 @@ declare global {
 class Application {
   private store: typeof useStore;
   private apiAdapter: APIAdapter;
+  private tileLoader: AirportTileLoader;
   private visualizationEngine: VisualizationEngine;
   private uiManager: UIManager;
   private llmIntegration: LLMIntegration;
@@ -50,6 +52,7 @@ class Application {
 
     // Initialize API adapter
     this.apiAdapter = new APIAdapter('');
+    this.tileLoader = new AirportTileLoader(this.apiAdapter, Application.VIEWPORT_AIRPORT_LIMIT);
 
     // Initialize visualization engine
     this.visualizationEngine = new VisualizationEngine();
@@ -711,21 +714,28 @@ class Application {
           }
         }, 300); // Debounce 300ms
 
-        // Debounce viewport-based airport loading (500ms)
+        // Viewport-based airport loading: immediate when all tiles are cached,
+        // otherwise debounced so quick successive moves send one set of requests
         if (viewportLoadTimeout) {
           clearTimeout(viewportLoadTimeout);
         }
 
-        viewportLoadTimeout = window.setTimeout(() => {
-          const bounds = map.getBounds();
-          const bbox: BoundingBox = {
-            north: bounds.getNorth(),
-            south: bounds.getSouth(),
-            east: bounds.getEast(),
-            west: bounds.getWest()
-          };
-          this.fetchAirportsInViewport(bbox);
-        }, 500); // Debounce 500ms for API calls
+        const bounds = map.getBounds();
+        const bbox: BoundingBox = {
+          north: bounds.getNorth(),
+          south: bounds.getSouth(),
+          east: bounds.getEast(),
+          west: bounds.getWest()
+        };
+        const zoom = map.getZoom();
+        const filters = (this.store as any).getState().filters;
+        if (this.tileLoader.getCached(bbox, zoom, filters)) {
+          this.fetchAirportsInViewport(bbox, zoom);
+        } else {
+          viewportLoadTimeout = window.setTimeout(() => {
+            this.fetchAirportsInViewport(bbox, zoom);
+          }, 300); // Debounce 300ms for API calls
+        }
       });
     }
   }
@@ -843,16 +853,16 @@ class Application {
       west: bounds.getWest()
     };
 
-    await this.fetchAirportsInViewport(bbox);
+    await this.fetchAirportsInViewport(bbox, map.getZoom());
   }
 
-  // Limit for viewport-based airport loading (lower than default to improve performance)
-  private static readonly VIEWPORT_AIRPORT_LIMIT = 500;
+  // Limit per viewport tile (lower than default to improve performance; see AirportTileLoader)
+  private static readonly VIEWPORT_AIRPORT_LIMIT = 250;
 
   /**
-   * Fetch airports within the current viewport bounds
+   * Fetch airports within the current viewport bounds (by cached quadtree tiles)
    */
-  private async fetchAirportsInViewport(bbox: BoundingBox): Promise<void> {
+  private async fetchAirportsInViewport(bbox: BoundingBox, zoom: number): Promise<void> {
     const store = this.store as any;
     const state = store.getState();
 
@@ -864,11 +874,15 @@ class Application {
     try {
       // Set flag to prevent fitBounds during viewport loading
       this.isViewportLoading = true;
-      store.getState().setLoading(true);
-      // Use viewport-specific limit for better performance
-      const filters = { ...state.filters, limit: Application.VIEWPORT_AIRPORT_LIMIT };
-      const response = await this.apiAdapter.getAirportsByBounds(bbox, filters);
-      store.getState().setAirports(response.data);
+      const cached = this.tileLoader.getCached(bbox, zoom, state.filters);
+      if (!cached) {
+        store.getState().setLoading(true);
+      }
+      const airports = cached ?? await this.tileLoader.load(bbox, zoom, state.filters);
+      // null: superseded by a newer viewport load, which will set the airports
+      if (airports !== null) {
+        store.getState().setAirports(airports);
+      }
     } catch (error: any) {
       console.error('Error loading airports in viewport:', error);
       // Don't show error to user for viewport loading - just log it
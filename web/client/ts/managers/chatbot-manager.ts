@@ -169,7 +169,9 @@ export class ChatbotManager {
         credentials: 'include',
         body: JSON.stringify({ 
           messages,
-          persona_id: personaId
+          persona_id: personaId,
+          // Fewer, larger message events and a final_answer without already-streamed fields
+          stream_mode: 'coalesced'
         }),
         signal: controller.signal
       });
@@ -234,6 +236,18 @@ export class ChatbotManager {
     messageDiv.appendChild(thinkingSection);
     messageDiv.appendChild(contentDiv);
 
+    // Re-render the answer at most once per frame, however many chunks arrive in it
+    let renderScheduled = false;
+    const scheduleAnswerRender = () => {
+      if (renderScheduled) return;
+      renderScheduled = true;
+      requestAnimationFrame(() => {
+        renderScheduled = false;
+        contentDiv.innerHTML = this.formatMessage(messageContent);
+        this.scrollToBottom();
+      });
+    };
+
     const reader = response.body?.getReader();
     const decoder = new TextDecoder();
 
@@ -324,16 +338,12 @@ export class ChatbotManager {
               // Even if it's just whitespace, show it - formatting will handle it
               if (chunk !== null && chunk !== undefined) {
                 contentDiv.style.display = 'block';
-                contentDiv.innerHTML = this.formatMessage(messageContent);
-                console.log('ChatbotManager: Updated message content', {
-                  chunkLength: chunk.length,
-                  chunk: chunk.substring(0, 50) + (chunk.length > 50 ? '...' : ''),
-                  totalLength: messageContent.length,
-                  hasContent: messageContent.trim().length > 0
-                });
+                scheduleAnswerRender();
               }
+              break;
 
-              this.scrollToBottom();
+            case 'final_answer':
+              // Coalesced mode: state only has fields not already streamed (see data.streamed)
               break;
 
             case 'ui_payload':
@@ -8,6 +8,9 @@ import type { AppState, FilterConfig, LegendMode, Airport } from '../store/types
 import { APIAdapter } from '../adapters/api-adapter';
 import { geocodeCache } from '../utils/geocode-cache';
 
+// Delay between the last keystroke and the search request
+const SEARCH_DEBOUNCE_MS = 200;
+
 /**
  * UI Manager class
  */
@@ -16,6 +19,8 @@ export class UIManager {
   private apiAdapter: APIAdapter;
   private unsubscribe: (() => void) | null = null;
   private debounceTimeouts: Map<string, number> = new Map();
+  // Incremented per text search; responses of superseded searches are dropped
+  private searchSequence = 0;
 
   constructor(store: typeof useStore, apiAdapter: APIAdapter) {
     this.store = store;
@@ -641,10 +646,10 @@ export class UIManager {
           clearTimeout(existingTimeout);
         }
 
-        // Debounce search execution
+        // Debounce search execution (server search is index-backed, keep typeahead snappy)
         const timeout = setTimeout(() => {
           this.handleSearch(target.value.trim());
-        }, 500);
+        }, SEARCH_DEBOUNCE_MS);
 
         this.debounceTimeouts.set('search', timeout);
       });
@@ -1267,8 +1272,12 @@ export class UIManager {
     this.store.getState().setLoading(true);
     this.store.getState().setError(null);
 
+    const sequence = ++this.searchSequence;
     try {
       const response = await this.apiAdapter.searchAirports(trimmedQuery, 50);
+      if (sequence !== this.searchSequence) {
+        return; // A newer search is in flight
+      }
 
       if (response.data.length > 0) {
         // Text search found results
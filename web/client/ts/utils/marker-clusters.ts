@@ -0,0 +1,90 @@
+/**
+ * Grid clustering for map markers.
+ *
+ * Points are bucketed into fixed-size pixel cells at the current zoom (one pass,
+ * O(n)); a cell with several points becomes a cluster placed at their centroid.
+ * Results are cached per zoom level until the point set changes.
+ */
+
+export interface ClusterPoint {
+  id: string;
+  lat: number;
+  lng: number;
+}
+
+export interface MarkerCluster {
+  ids: string[];
+  lat: number;
+  lng: number;
+}
+
+/**
+ * Projects lat/lng to pixel coordinates at a zoom level (e.g. Leaflet's map.project)
+ */
+export type ProjectFn = (lat: number, lng: number, zoom: number) => { x: number; y: number };
+
+/**
+ * Group points sharing a `cellSizePx` grid cell at `zoom`.
+ * Single-point cells are returned as clusters of one.
+ */
+export function gridCluster(
+  points: ClusterPoint[],
+  project: ProjectFn,
+  zoom: number,
+  cellSizePx: number
+): MarkerCluster[] {
+  const cells = new Map<string, { ids: string[]; latSum: number; lngSum: number }>();
+
+  for (const point of points) {
+    const { x, y } = project(point.lat, point.lng, zoom);
+    const key = `${Math.floor(x / cellSizePx)}:${Math.floor(y / cellSizePx)}`;
+    let cell = cells.get(key);
+    if (!cell) {
+      cell = { ids: [], latSum: 0, lngSum: 0 };
+      cells.set(key, cell);
+    }
+    cell.ids.push(point.id);
+    cell.latSum += point.lat;
+    cell.lngSum += point.lng;
+  }
+
+  const clusters: MarkerCluster[] = [];
+  cells.forEach(cell => {
+    clusters.push({
+      ids: cell.ids,
+      lat: cell.latSum / cell.ids.length,
+      lng: cell.lngSum / cell.ids.length
+    });
+  });
+  return clusters;
+}
+
+/**
+ * Per-zoom cache of grid clusters for one point set.
+ */
+export class ClusterIndex {
+  private points: ClusterPoint[] = [];
+  private byZoom = new Map<number, MarkerCluster[]>();
+
+  constructor(private project: ProjectFn, private cellSizePx: number) {}
+
+  /**
+   * Replace the point set (drops cached zoom levels)
+   */
+  setPoints(points: ClusterPoint[]): void {
+    this.points = points;
+    this.byZoom.clear();
+  }
+
+  /**
+   * Clusters at a zoom level
+   */
+  getClusters(zoom: number): MarkerCluster[] {
+    let clusters = this.byZoom.get(zoom);
+    if (!clusters) {
+      clusters = gridCluster(this.points, this.project, zoom, this.cellSizePx);
+      this.byZoom.set(zoom, clusters);
+    }
+    return clusters;
+  }
+}
@@ -0,0 +1,88 @@
+/**
+ * Quadtree (Web Mercator z/x/y) tiles for viewport airport loading.
+ *
+ * Same numbering as the OSM base layer and web/server/api/tiles.py: x grows
+ * east from -180°, y grows south from 85.0511°N.
+ */
+
+import type { BoundingBox } from '../store/types';
+
+export interface TileKey {
+  z: number;
+  x: number;
+  y: number;
+}
+
+// Latitude limit of the Web Mercator square
+const MAX_MERCATOR_LAT = 85.0511;
+
+// Tile levels used for airport loading (server accepts up to 12)
+const MIN_TILE_ZOOM = 3;
+const MAX_TILE_ZOOM = 10;
+
+/**
+ * Tile level for a map zoom: tiles ~4x the screen tile size, so a viewport spans a few of them
+ */
+export function tileZoomForMapZoom(mapZoom: number): number {
+  return Math.max(MIN_TILE_ZOOM, Math.min(MAX_TILE_ZOOM, Math.floor(mapZoom) - 2));
+}
+
+/**
+ * "z/x/y" (the server's tile parameter, also the cache key)
+ */
+export function tileId(tile: TileKey): string {
+  return `${tile.z}/${tile.x}/${tile.y}`;
+}
+
+function lngToTileX(lng: number, z: number): number {
+  const n = 2 ** z;
+  return Math.min(n - 1, Math.max(0, Math.floor(((lng + 180) / 360) * n)));
+}
+
+function latToTileY(lat: number, z: number): number {
+  const n = 2 ** z;
+  const clamped = Math.max(-MAX_MERCATOR_LAT, Math.min(MAX_MERCATOR_LAT, lat));
+  const rad = (clamped * Math.PI) / 180;
+  const y = ((1 - Math.log(Math.tan(rad) + 1 / Math.cos(rad)) / Math.PI) / 2) * n;
+  return Math.min(n - 1, Math.max(0, Math.floor(y)));
+}
+
+function tileYToLat(y: number, z: number): number {
+  const n = Math.PI - (2 * Math.PI * y) / 2 ** z;
+  return (180 / Math.PI) * Math.atan(Math.sinh(n));
+}
+
+/**
+ * Tiles at level z covering a bounding box (longitudes clamped to [-180, 180])
+ */
+export function tilesForBounds(bounds: BoundingBox, z: number): TileKey[] {
+  const west = Math.max(-180, bounds.west);
+  const east = Math.min(180, bounds.east);
+  if (west > east || bounds.south > bounds.north) return [];
+
+  const xMin = lngToTileX(west, z);
+  const xMax = lngToTileX(east, z);
+  const yMin = latToTileY(bounds.north, z);
+  const yMax = latToTileY(bounds.south, z);
+
+  const tiles: TileKey[] = [];
+  for (let x = xMin; x <= xMax; x++) {
+    for (let y = yMin; y <= yMax; y++) {
+      tiles.push({ z, x, y });
+    }
+  }
+  return tiles;
+}
+
+/**
+ * Geographic bounds of a tile
+ */
+export function tileBounds(tile: TileKey): BoundingBox {
+  const n = 2 ** tile.z;
+  return {
+    north: tileYToLat(tile.y, tile.z),
+    south: tileYToLat(tile.y + 1, tile.z),
+    west: (tile.x / n) * 360 - 180,
+    east: ((tile.x + 1) / n) * 360 - 180
+  };
+}
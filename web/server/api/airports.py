@@ -1,7 +1,9 @@
 #!/usr/bin/env python3
 
-from fastapi import APIRouter, Query, HTTPException, Request, Path, Body
+from fastapi import APIRouter, Query, HTTPException, Request, Response, Path, Body
+from fastapi.concurrency import run_in_threadpool
 from typing import List, Optional, Dict, Any, Union, TypeAlias
+from urllib.parse import urlencode
 import logging
 
 from euro_aip.models.euro_aip_model import EuroAipModel
@@ -13,6 +15,12 @@ from . import notifications
 from shared.airport_tools import find_airports_near_location
 from shared.tool_context import ToolContext
 from shared.filtering import FilterEngine
+from shared.indexing import get_model_indexes
+from shared.tracing import span
+from .dataset_cache import etag_matches
+from .summary_cache import AirportSummaryCache, SubObjectSource
+from .tiles import TILE_CACHE_MAX_AGE_S, parse_tile, tile_bbox
+from .wire_format import COLUMNAR_FORMAT, JSON_FORMAT, to_columnar, validate_format
 
 # Type alias for route airports (can be ICAO codes or NavPoint objects)
 Route: TypeAlias = List[Union[str, NavPoint]]
@@ -24,10 +32,40 @@ router = APIRouter()
 # Global model reference
 model: Optional[EuroAipModel] = None
 
+# Pre-encoded AirportSummary rows for the current model
+summary_cache: Optional[AirportSummaryCache] = None
+
+# Data version used when a sub-object service is not configured (stable, never cached data)
+UNAVAILABLE_VERSION = "unavailable"
+
 def set_model(m: EuroAipModel):
     """Set the global model reference."""
-    global model
+    global model, summary_cache
     model = m
+    summary_cache = AirportSummaryCache(m.airports)
+
+
+def _ga_source() -> SubObjectSource:
+    """GA summary source for the summary cache: (data version, batch fetcher)."""
+    ga_service = get_ga_service()
+    if not ga_service or not ga_service.enabled:
+        return UNAVAILABLE_VERSION, lambda icaos: {}
+    return ga_service.data_version, ga_service.get_summaries_batch
+
+
+def _notification_source() -> SubObjectSource:
+    """Notification summary source for the summary cache: (data version, batch fetcher)."""
+    try:
+        version = notifications.get_notification_service().data_version
+    except (RuntimeError, AttributeError):
+        version = UNAVAILABLE_VERSION
+    return version, _get_notification_summaries_batch
+
+
+def warm_summary_cache() -> None:
+    """Encode all airport summaries (and cacheable GA/notification data) at startup."""
+    if summary_cache is not None:
+        summary_cache.warm(ga=_ga_source(), notification=_notification_source())
 
 
 def _get_notification_summaries_batch(icaos: List[str]) -> Dict[str, NotificationSummary]:
@@ -56,64 +94,28 @@ def _get_notification_summaries_batch(icaos: List[str]) -> Dict[str, Notificatio
         return {}
 
 
-def _matches_aip_field(airport: Airport, field_name: str, value: Optional[str] = None, operator: str = "contains") -> bool:
+def _aip_field_matches(field_name: str, value: Optional[str] = None, operator: str = "contains") -> frozenset:
     """
-    Check if an airport matches AIP field criteria.
-    
+    ICAO codes of airports matching AIP field criteria.
+
     Args:
-        airport: Airport object to check
         field_name: Standardized AIP field name
         value: Value to search for (optional for not_empty operator)
         operator: Comparison operator
-        
+
     Returns:
-        True if airport matches the criteria
+        Set of matching ICAO codes (looked up in the model's AIP field index)
     """
-    # Get all entries for this field
-    field_entries = [entry for entry in airport.aip_entries if entry.std_field == field_name]
-    
-    if not field_entries:
-        return False
-    
-    # Check each entry value
-    for entry in field_entries:
-        entry_value = entry.value.lower() if entry.value else ""
-        search_value = value.lower() if value else ""
-        
-        # Handle negative values that should return False
-        if entry_value in ["nil", "none", "na", "n/a", "no", "not available", "unavailable"]:
-            continue  # Skip this entry, it's a negative value
-        
-        if operator == "contains":
-            # Special handling for AVGAS detection
-            if search_value == "avgas" and field_name.lower() in ["fuel and oil types", "fuel types", "fuel"]:
-                # Check for various AVGAS/100LL variations
-                if any(avgas_term in entry_value for avgas_term in ["avgas", "100ll", "100 ll", "100/ll"]):
-                    return True
-            else:
-                # Standard contains logic
-                if search_value in entry_value:
-                    return True
-        elif operator == "equals":
-            if entry_value == search_value:
-                return True
-        elif operator == "not_empty":
-            # Enhanced not_empty logic - exclude negative values
-            if entry_value and entry_value not in ["nil", "none", "na", "n/a", "no", "not available", "unavailable", ""]:
-                return True
-        elif operator == "starts_with":
-            if entry_value.startswith(search_value):
-                return True
-        elif operator == "ends_with":
-            if entry_value.endswith(search_value):
-                return True
-    
-    return False
+    return get_model_indexes(model).aip_fields.match(field_name, value, operator)
 
 # API models are now imported from ../models
 
+# Filtering, route and locate handlers are CPU-bound (and locate/search may block
+# on geocoding), so they are plain `def`: FastAPI runs them in its threadpool
+# instead of on the event loop, which keeps chat streams and other requests moving.
+
 @router.get("/", response_model=List[AirportSummary])
-async def get_airports(
+def get_airports(
     request: Request,
     country: Optional[str] = Query(None, description="Filter by ISO country code", max_length=3),
     has_procedures: Optional[bool] = Query(None, description="Filter airports with procedures"),
@@ -134,21 +136,45 @@ async def get_airports(
     # Notification data integration
     include_notification: bool = Query(True, description="Include notification requirements for legend coloring"),
     # Viewport-based filtering
-    bbox: Optional[str] = Query(None, description="Bounding box: north,south,east,west (decimal degrees)")
+    bbox: Optional[str] = Query(None, description="Bounding box: north,south,east,west (decimal degrees)"),
+    tile: Optional[str] = Query(None, description="Quadtree tile z/x/y (Web Mercator), cacheable alternative to bbox", max_length=20),
+    # Wire format
+    format: str = Query(JSON_FORMAT, description="Response format: json (array of objects) or columnar (field names + row arrays)", max_length=20),
 ):
     """Get a list of airports with optional filtering."""
     if not model:
         raise HTTPException(status_code=500, detail="Model not loaded")
+    response_format = validate_format(format)
     
     # Validate offset against actual data size
     if offset >= model.airports.count():
         raise HTTPException(status_code=400, detail="Offset too large")
+    tile_bounds = tile_bbox(*parse_tile(tile)) if tile else None
+
+    # The response only depends on the query and the data versions: answer
+    # If-None-Match before doing any filtering. Hospitality filters read GA data
+    # even when GA sub-objects are not included.
+    ga_source = _ga_source() if (include_ga or hotel or restaurant) else None
+    notification_source = _notification_source() if include_notification else None
+    query = urlencode(sorted(request.query_params.multi_items()))
+    etag = summary_cache.etag(
+        query,
+        *(source[0] for source in (ga_source, notification_source) if source is not None),
+    )
+    # Tile URLs are stable across pans, so their responses may be served from
+    # cache for a while; other queries always revalidate
+    cache_control = f"public, max-age={TILE_CACHE_MAX_AGE_S}" if tile_bounds else "no-cache"
+    if etag and etag_matches(request, etag):
+        return Response(status_code=304, headers={"ETag": etag, "Cache-Control": cache_control})
 
     # Start with queryable collection
     airports = model.airports
 
-    # Apply bounding box filter if provided (viewport-based loading)
-    if bbox:
+    # Apply tile or bounding box filter if provided (viewport-based loading)
+    if tile_bounds:
+        in_view = get_model_indexes(model).spatial.within_bbox(*tile_bounds)
+        airports = type(airports)(in_view)
+    elif bbox:
         try:
             parts = bbox.split(",")
             if len(parts) != 4:
@@ -159,12 +185,10 @@ async def get_airports(
             if south > north:
                 raise HTTPException(status_code=400, detail="bbox south must be <= north")
 
-            # Filter airports within bounding box
-            airports = airports.filter(lambda a:
-                a.navpoint is not None and
-                south <= a.navpoint.latitude <= north and
-                west <= a.navpoint.longitude <= east
-            )
+            # Look up airports within bounding box via the spatial index,
+            # keeping a queryable collection for the filters below
+            in_view = get_model_indexes(model).spatial.within_bbox(north, south, east, west)
+            airports = type(airports)(in_view)
         except ValueError:
             raise HTTPException(status_code=400, detail="bbox values must be valid numbers")
 
@@ -209,7 +233,8 @@ async def get_airports(
 
     # Apply AIP field filtering
     if aip_field:
-        airports = airports.filter(lambda a: _matches_aip_field(a, aip_field, aip_value, aip_operator))
+        matching_icaos = _aip_field_matches(aip_field, aip_value, aip_operator)
+        airports = airports.filter(lambda a: a.ident in matching_icaos)
     
     # Always sort by longest runway length (descending) to prioritize larger airports
     # Airports without runway data will be sorted last
@@ -218,33 +243,18 @@ async def get_airports(
     # Apply pagination and get results
     airports = airports.skip(offset).take(limit).all()
     
-    # Get list of ICAOs for batch fetching
-    icaos = [a.ident for a in airports]
-
-    # Get GA data if requested and service is available
-    ga_data: Dict[str, GAFriendlySummary] = {}
-    if include_ga:
-        ga_service = get_ga_service()
-        if ga_service and ga_service.enabled:
-            ga_data = ga_service.get_summaries_batch(icaos)
-
-    # Get notification data if requested
-    notification_data: Dict[str, NotificationSummary] = {}
-    if include_notification:
-        notification_data = _get_notification_summaries_batch(icaos)
-
-    # Convert to response format using factory methods
-    return [
-        AirportSummary.from_airport(
-            airport,
-            ga_data.get(airport.ident),
-            notification_data.get(airport.ident),
-        )
-        for airport in airports
-    ]
+    # Stitch pre-encoded summary rows with (cached) GA and notification data
+    body = summary_cache.encode(
+        airports,
+        ga=ga_source if include_ga else None,
+        notification=notification_source,
+        columnar=response_format == COLUMNAR_FORMAT,
+    )
+    headers = {"ETag": etag, "Cache-Control": cache_control} if etag else None
+    return Response(content=body, media_type="application/json", headers=headers)
 
 @router.get("/route-search")
-async def get_airports_near_route(
+def get_airports_near_route(
     request: Request,
     airports: str = Query(..., description="Comma-separated list of ICAO airport codes defining the route", max_length=200),
     segment_distance_nm: float = Query(50.0, description="Max perpendicular distance from route (NM)", ge=0.1, le=500.0),
@@ -298,9 +308,6 @@ async def get_airports_near_route(
     # Resolve effective segment distance (support legacy query param)
     effective_segment_distance_nm = legacy_distance_nm if legacy_distance_nm is not None else segment_distance_nm
     
-    # Find airports near the route
-    nearby_airports = model.find_airports_near_route(route_airports, effective_segment_distance_nm)
-
     # Build filters dict for FilterEngine
     filters: Dict[str, Any] = {}
     if country:
@@ -327,7 +334,11 @@ async def get_airports_near_route(
     ctx = ToolContext(model=model, ga_friendliness_service=get_ga_service())
     filter_engine = FilterEngine(context=ctx)
 
-    # Extract airports, apply filters, then reconstruct items
+    # Find airports near the route. No pre-filter before the geometry here:
+    # total_nearby counts every corridor airport, before any filter
+    nearby_airports = ctx.indexes.find_airports_near_route(route_airports, effective_segment_distance_nm)
+
+    # Extract airports, apply filters (vectorized), then reconstruct items
     airport_to_item = {item['airport'].ident: item for item in nearby_airports}
     airports_only = [item['airport'] for item in nearby_airports]
     filtered_airport_objects = filter_engine.apply(airports_only, filters)
@@ -337,9 +348,10 @@ async def get_airports_near_route(
 
     # Apply AIP field filtering (not in FilterEngine - special case)
     if aip_field:
+        matching_icaos = _aip_field_matches(aip_field, aip_value, aip_operator)
         filtered_airports = [
             item for item in filtered_airports
-            if _matches_aip_field(item['airport'], aip_field, aip_value, aip_operator)
+            if item['airport'].ident in matching_icaos
         ]
 
     # Get list of ICAOs for batch fetching
@@ -350,12 +362,14 @@ async def get_airports_near_route(
     if include_ga:
         ga_service = get_ga_service()
         if ga_service and ga_service.enabled:
-            ga_data = ga_service.get_summaries_batch(icaos)
+            with span("ga.batch"):
+                ga_data = ga_service.get_summaries_batch(icaos)
 
     # Get notification data if requested
     notification_data: Dict[str, NotificationSummary] = {}
     if include_notification:
-        notification_data = _get_notification_summaries_batch(icaos)
+        with span("notification.batch"):
+            notification_data = _get_notification_summaries_batch(icaos)
 
     # Convert to response format
     result = []
@@ -394,7 +408,7 @@ async def get_airports_near_route(
     }
 
 @router.get("/locate")
-async def locate_airports(
+def locate_airports(
     request: Request,
     q: Optional[str] = Query(None, description="Free-text location to search around", max_length=200),
     radius_nm: float = Query(50.0, description="Max distance from location (NM)", ge=0.1, le=500.0),
@@ -472,7 +486,8 @@ async def locate_airports(
     airports_list = result.get("airports") or []
     if include_notification and airports_list:
         icaos = [apt.get("ident") for apt in airports_list if apt.get("ident")]
-        notification_data = _get_notification_summaries_batch(icaos)
+        with span("notification.batch"):
+            notification_data = _get_notification_summaries_batch(icaos)
         for apt in airports_list:
             icao = apt.get("ident")
             if icao and icao in notification_data:
@@ -714,11 +729,12 @@ async def get_airport_procedure_lines(
     if not model:
         raise HTTPException(status_code=500, detail="Model not loaded")
 
-    airport = model.airports.where(ident=icao.upper()).first()
+    indexes = get_model_indexes(model)
+    airport = indexes.airport(icao)
     if not airport:
         raise HTTPException(status_code=404, detail=f"Airport {icao} not found")
     
-    return airport.get_procedure_lines(distance_nm)
+    return indexes.procedure_lines.get(airport, distance_nm)
 
 @router.post("/bulk/procedure-lines")
 async def get_bulk_procedure_lines(
@@ -731,37 +747,51 @@ async def get_bulk_procedure_lines(
     
     airports = body.airports
     distance_nm = body.distance_nm
+    columnar = validate_format(body.format) == COLUMNAR_FORMAT
     
     logger.debug(f"Bulk procedure lines request: {len(airports)} airports, distance_nm={distance_nm}")
-    
-    result = {}
 
-    for icao in airports:
-        airport = model.airports.where(ident=icao.upper()).first()
+    # Geometry is memoized per (icao, distance); misses are computed in a worker
+    # thread so large cold requests do not block the event loop
+    return await run_in_threadpool(_bulk_procedure_lines, airports, distance_nm, columnar)
+
+
+def _bulk_procedure_lines(icaos: List[str], distance_nm: float, columnar: bool) -> Dict[str, Any]:
+    """ICAO -> procedure lines result for the bulk endpoint."""
+    indexes = get_model_indexes(model)
+
+    result = {}
+    with_procedures = []
+    for icao in icaos:
+        icao = icao.upper()
+        airport = indexes.airport(icao)
         if not airport:
-            result[icao.upper()] = {"procedure_lines": [], "error": "Airport not found"}
-            continue
-        
-        # Skip airports without procedures - no need to compute procedure lines
-        if not airport.procedures:
-            result[icao.upper()] = {
-                "airport_ident": icao.upper(),
-                "procedure_lines": []
+            result[icao] = {"procedure_lines": [], "error": "Airport not found"}
+        elif not airport.procedures:
+            # Skip airports without procedures - no need to compute procedure lines
+            result[icao] = {"airport_ident": icao, "procedure_lines": []}
+        else:
+            result[icao] = None  # Keep request order
+            with_procedures.append(airport)
+
+    lines, errors = indexes.procedure_lines.get_many(with_procedures, distance_nm)
+    for icao, error in errors.items():
+        # Log error but continue with other airports
+        logger.warning(f"Error getting procedure lines for {icao}: {error}")
+        result[icao] = {"procedure_lines": [], "error": str(error)}
+
+    for icao, procedure_lines in lines.items():
+        if columnar and isinstance(procedure_lines.get("procedure_lines"), list):
+            procedure_lines = {
+                **procedure_lines,
+                "procedure_lines": to_columnar(procedure_lines["procedure_lines"]),
             }
-            continue
-        
-        try:
-            procedure_lines = airport.get_procedure_lines(distance_nm)
-            result[icao.upper()] = procedure_lines
-        except Exception as e:
-            # Log error but continue with other airports
-            logger.warning(f"Error getting procedure lines for {icao}: {e}")
-            result[icao.upper()] = {"procedure_lines": [], "error": str(e)}
-    
+        result[icao] = procedure_lines
+
     return result
 
 @router.get("/search/{query}")
-async def search_airports(
+def search_airports(
     request: Request,
     query: str = Path(..., description="Search query", max_length=100, min_length=1),
     limit: int = Query(20, description="Maximum number of results", ge=1, le=100)
@@ -770,18 +800,11 @@ async def search_airports(
     if not model:
         raise HTTPException(status_code=500, detail="Model not loaded")
     
-    query_upper = query.upper()
-    results = []
-
-    # First try direct database search
-    for airport in model.airports:
-        if (query_upper in airport.ident or 
-            (airport.name and query_upper in airport.name.upper()) or 
-            (airport.iata_code and query_upper in airport.iata_code) or
-            (airport.municipality and query_upper in airport.municipality.upper())):
-            results.append(AirportSummary.from_airport(airport))
-            if len(results) >= limit:
-                break
+    # First try the ranked code/name/municipality index
+    results = [
+        AirportSummary.from_airport(airport)
+        for airport in get_model_indexes(model).search.search(query, limit)
+    ]
     
     # If no results found, try geocoding via Geoapify
     if not results:
@@ -797,7 +820,7 @@ async def search_airports(
                 # Look up actual airport object from model
                 icao = apt_data.get("ident")
                 if icao:
-                    airport = model.airports.where(ident=icao).first()
+                    airport = get_model_indexes(model).airport(icao)
                     if airport:
                         results.append(AirportSummary.from_airport(airport))
     
@@ -17,6 +17,7 @@ from shared.aviation_agent.adapters import (
     ChatResponse,
     build_agent,
     build_chat_response,
+    coalesce_stream,
     run_aviation_agent,
     stream_aviation_agent,
 )
@@ -156,7 +157,9 @@ async def aviation_agent_chat_stream(
         async def event_generator():
             final_state = None
             run_id = None
-            try:
+
+            async def agent_events():
+                nonlocal final_state, run_id
                 async for event in stream_aviation_agent(
                     messages,
                     graph,
@@ -167,7 +170,7 @@ async def aviation_agent_chat_stream(
                     event_name = event.get("event")
                     event_data = event.get("data", {})
 
-                    # Capture final state when graph completes
+                    # Capture final state when graph completes (full state, before any compaction)
                     if event_name == "final_answer":
                         final_state = event_data.get("state")
                     
@@ -175,7 +178,16 @@ async def aviation_agent_chat_stream(
                     if event_name == "done":
                         run_id = event_data.get("run_id")
 
-                    yield f"event: {event_name}\ndata: {json.dumps(event_data, ensure_ascii=False)}\n\n"
+                    yield event
+
+            events = agent_events()
+            if request.stream_mode == "coalesced":
+                events = coalesce_stream(events)
+
+            try:
+                async for event in events:
+                    event_data = event.get("data", {})
+                    yield f"event: {event.get('event')}\ndata: {json.dumps(event_data, ensure_ascii=False)}\n\n"
             finally:
                 # After streaming completes, log conversation using captured state
                 try:
@@ -192,7 +204,7 @@ async def aviation_agent_chat_stream(
                             log_dir=log_dir,
                             run_id=run_id,
                         )
-                        logger.info("Conversation logged successfully")
+                        logger.info("Conversation queued for logging")
                     else:
                         logger.warning("Final state not captured during streaming, skipping conversation logging")
                 except Exception as e:
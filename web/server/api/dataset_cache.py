@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""
+JSON responses computed once per airports dataset.
+
+Statistics dashboards and filter options depend only on the loaded model. Their
+payloads come from ModelStatistics (computed when the model is indexed); this
+cache encodes each payload once per dataset version and serves the bytes with
+an ETag and a long-lived Cache-Control, answering If-None-Match with 304.
+A new dataset version (new airports.db) drops every cached body.
+"""
+import threading
+from typing import Any, Callable, Dict, Optional
+
+from fastapi import Request, Response
+
+from .summary_cache import encode_json
+
+# Browsers and proxies may reuse these for an hour, then revalidate (cheap 304)
+DATASET_CACHE_MAX_AGE_S = 3600
+
+
+def etag_matches(request: Request, etag: str) -> bool:
+    """Check If-None-Match against an ETag (weak comparison)."""
+    header = request.headers.get("if-none-match")
+    if not header:
+        return False
+    candidates = [c.strip().removeprefix("W/") for c in header.split(",")]
+    return "*" in candidates or etag in candidates
+
+
+class DatasetResponseCache:
+    """
+    Encoded JSON bodies keyed by dataset version and endpoint name.
+
+    Usage:
+        cache = DatasetResponseCache()
+        return cache.response(request, stats.version, "by-country", lambda: stats.by_country)
+    """
+
+    def __init__(self):
+        self._version: Optional[str] = None
+        self._bodies: Dict[str, bytes] = {}
+        self._lock = threading.Lock()
+
+    def body(self, version: str, name: str, build: Callable[[], Any]) -> bytes:
+        with self._lock:
+            if version != self._version:
+                self._version = version
+                self._bodies = {}
+            body = self._bodies.get(name)
+        if body is None:
+            body = encode_json(build()).encode("utf-8")
+            with self._lock:
+                if version == self._version:
+                    self._bodies[name] = body
+        return body
+
+    def response(self, request: Request, version: str, name: str, build: Callable[[], Any]) -> Response:
+        headers = {
+            "ETag": f'"{version}-{name}"',
+            "Cache-Control": f"public, max-age={DATASET_CACHE_MAX_AGE_S}",
+        }
+        if etag_matches(request, headers["ETag"]):
+            return Response(status_code=304, headers=headers)
+        return Response(content=self.body(version, name, build), media_type="application/json", headers=headers)
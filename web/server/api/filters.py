@@ -1,10 +1,19 @@
 #!/usr/bin/env python3
+"""
+Filter options for the UI (countries, procedure types, AIP fields, ...).
+
+Options are derived from the precomputed model statistics
+(shared.indexing.ModelStatistics) and served from memory with ETag /
+long-lived Cache-Control keyed on the dataset version (see dataset_cache.py).
+"""
 
 from fastapi import APIRouter, HTTPException, Request
-from typing import List, Dict, Any, Set
+from typing import List, Dict, Any
 import logging
 
 from euro_aip.models.euro_aip_model import EuroAipModel
+from shared.indexing import ModelStatistics, get_model_indexes
+from .dataset_cache import DatasetResponseCache
 
 logger = logging.getLogger(__name__)
 
@@ -13,6 +22,9 @@ router = APIRouter(tags=["filters"])
 # Global model reference
 model: EuroAipModel = None
 
+# Encoded responses for the current dataset version
+response_cache = DatasetResponseCache()
+
 def set_model(m: EuroAipModel):
     """Set the global model reference."""
     global model
@@ -45,37 +57,31 @@ def format_country_name_for_display(country_name: str) -> str:
     
     return " ".join(formatted_words)
 
-@router.get("/countries")
-async def get_available_countries(request: Request):
-    """Get list of available countries with airport counts."""
+def get_statistics() -> ModelStatistics:
+    """Precomputed aggregates of the loaded model."""
     if not model:
         raise HTTPException(status_code=500, detail="Model not loaded")
-    
+    return get_model_indexes(model).statistics
+
+def build_countries(stats: ModelStatistics) -> List[Dict[str, Any]]:
+    """Countries with airport counts, sorted by priority then display name."""
     # Import CountryMapper fresh to get latest mappings
     from euro_aip.utils.country_mapper import CountryMapper
     country_mapper = CountryMapper()
-    
-    countries = {}
-    for airport in model.airports:
-        if airport.iso_country:
-            if airport.iso_country not in countries:
-                countries[airport.iso_country] = 0
-            countries[airport.iso_country] += 1
-    
-    # Create list with priority sorting
+
     country_list = [
         {
-            "code": code, 
+            "code": code,
             "name": format_country_name_for_display(country_mapper.get_country_name(code)) or code,
             "count": count,
             "priority": country_mapper.get_country_priority(code)
         }
-        for code, count in countries.items()
+        for code, count in stats.country_counts.items()
     ]
-    
+
     # Sort by priority first, then by name for countries with same priority
     country_list.sort(key=lambda x: (x["priority"], x["name"]))
-    
+
     # Remove priority from response (it was only used for sorting)
     return [
         {
@@ -86,149 +92,62 @@ async def get_available_countries(request: Request):
         for country in country_list
     ]
 
+def build_all_filters(stats: ModelStatistics) -> Dict[str, Any]:
+    """All filter options in one payload."""
+    return {
+        "countries": build_countries(stats),
+        "procedure_types": stats.procedure_types,
+        "aip_sections": stats.aip_sections,
+        "aip_fields": stats.aip_fields,
+        "sources": stats.sources,
+        "runway_characteristics": stats.runway_characteristics,
+        "border_crossing": model.get_border_crossing_statistics()
+    }
+
+@router.get("/countries")
+async def get_available_countries(request: Request):
+    """Get list of available countries with airport counts."""
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "countries", lambda: build_countries(stats))
+
 @router.get("/procedure-types")
 async def get_available_procedure_types(request: Request):
     """Get list of available procedure types with counts."""
-    if not model:
-        raise HTTPException(status_code=500, detail="Model not loaded")
-    
-    procedure_types = {}
-    for airport in model.airports:
-        for procedure in airport.procedures:
-            proc_type = procedure.procedure_type.lower()
-            if proc_type not in procedure_types:
-                procedure_types[proc_type] = 0
-            procedure_types[proc_type] += 1
-    
-    return [
-        {"type": proc_type, "count": count}
-        for proc_type, count in sorted(procedure_types.items())
-    ]
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "procedure-types", lambda: stats.procedure_types)
 
 @router.get("/aip-sections")
 async def get_available_aip_sections(request: Request):
     """Get list of available AIP sections with counts."""
-    if not model:
-        raise HTTPException(status_code=500, detail="Model not loaded")
-    
-    sections = {}
-    for airport in model.airports:
-        for entry in airport.aip_entries:
-            section = entry.section
-            if section not in sections:
-                sections[section] = 0
-            sections[section] += 1
-    
-    return [
-        {"section": section, "count": count}
-        for section, count in sorted(sections.items())
-    ]
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "aip-sections", lambda: stats.aip_sections)
 
 @router.get("/aip-fields")
 async def get_available_aip_fields(request: Request):
     """Get list of available AIP standardized fields with counts."""
-    if not model:
-        raise HTTPException(status_code=500, detail="Model not loaded")
-    
-    fields = {}
-    for airport in model.airports:
-        for entry in airport.aip_entries:
-            if entry.std_field:
-                field = entry.std_field
-                if field not in fields:
-                    fields[field] = 0
-                fields[field] += 1
-    
-    return [
-        {"field": field, "count": count}
-        for field, count in sorted(fields.items())
-    ]
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "aip-fields", lambda: stats.aip_fields)
 
 @router.get("/sources")
 async def get_available_sources(request: Request):
     """Get list of available data sources with counts."""
-    if not model:
-        raise HTTPException(status_code=500, detail="Model not loaded")
-    
-    sources = {}
-    for airport in model.airports:
-        for source in airport.sources:
-            if source not in sources:
-                sources[source] = 0
-            sources[source] += 1
-    
-    return [
-        {"source": source, "count": count}
-        for source, count in sorted(sources.items())
-    ]
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "sources", lambda: stats.sources)
 
 @router.get("/runway-characteristics")
 async def get_runway_characteristics(request: Request):
     """Get runway characteristics statistics."""
-    if not model:
-        raise HTTPException(status_code=500, detail="Model not loaded")
-    
-    runway_lengths = []
-    runway_surfaces = {}
-    runway_lighting = {}
-
-    for airport in model.airports:
-        for runway in airport.runways:
-            # Length statistics
-            if runway.length_ft:
-                runway_lengths.append(runway.length_ft)
-            
-            # Surface types
-            if runway.surface:
-                surface = runway.surface.lower()
-                if surface not in runway_surfaces:
-                    runway_surfaces[surface] = 0
-                runway_surfaces[surface] += 1
-            
-            # Lighting
-            if runway.lighted:
-                lighting = "lighted" if runway.lighted else "unlighted"
-                if lighting not in runway_lighting:
-                    runway_lighting[lighting] = 0
-                runway_lighting[lighting] += 1
-    
-    return {
-        "lengths": {
-            "min": min(runway_lengths) if runway_lengths else None,
-            "max": max(runway_lengths) if runway_lengths else None,
-            "average": sum(runway_lengths) / len(runway_lengths) if runway_lengths else None,
-            "count": len(runway_lengths)
-        },
-        "surfaces": [
-            {"surface": surface, "count": count}
-            for surface, count in sorted(runway_surfaces.items())
-        ],
-        "lighting": [
-            {"lighting": lighting, "count": count}
-            for lighting, count in sorted(runway_lighting.items())
-        ]
-    }
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "runway-characteristics", lambda: stats.runway_characteristics)
 
 @router.get("/border-crossing")
 async def get_border_crossing_statistics(request: Request):
     """Get border crossing statistics."""
-    if not model:
-        raise HTTPException(status_code=500, detail="Model not loaded")
-    
-    return model.get_border_crossing_statistics()
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "border-crossing", model.get_border_crossing_statistics)
 
 @router.get("/all")
 async def get_all_filters(request: Request):
     """Get all available filter options in one call."""
-    if not model:
-        raise HTTPException(status_code=500, detail="Model not loaded")
-    
-    return {
-        "countries": await get_available_countries(request),
-        "procedure_types": await get_available_procedure_types(request),
-        "aip_sections": await get_available_aip_sections(request),
-        "aip_fields": await get_available_aip_fields(request),
-        "sources": await get_available_sources(request),
-        "runway_characteristics": await get_runway_characteristics(request),
-        "border_crossing": await get_border_crossing_statistics(request)
-    } 
\ No newline at end of file
+    stats = get_statistics()
+    return response_cache.response(request, stats.version, "all", lambda: build_all_filters(stats))
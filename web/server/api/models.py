@@ -406,4 +406,5 @@ class BulkProcedureLinesRequest(BaseModel):
     """Request model for bulk procedure lines endpoint."""
     
     airports: List[str] = Field(..., description="List of ICAO airport codes", min_length=1)
-    distance_nm: float = Field(10.0, description="Distance in nautical miles for procedure lines", ge=0.1, le=100.0)
\ No newline at end of file
+    distance_nm: float = Field(10.0, description="Distance in nautical miles for procedure lines", ge=0.1, le=100.0)
+    format: str = Field("json", description="Response format for procedure_lines: json (objects) or columnar (field names + row arrays)", max_length=20)
\ No newline at end of file
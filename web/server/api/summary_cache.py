@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+Pre-encoded JSON cache for AirportSummary rows.
+
+The airports model is static between deployments, so each airport's summary is
+serialized once and kept as a JSON fragment. GA and notification sub-objects are
+cached separately, keyed by their service's data version. Listing responses are
+built by joining fragments instead of building and serializing Pydantic models
+for every row.
+"""
+import hashlib
+import json
+import logging
+import threading
+from typing import Callable, Dict, Iterable, List, Mapping, Optional, Tuple
+
+from pydantic import BaseModel
+
+from euro_aip.models.airport import Airport
+from shared.tracing import span
+from .models import AirportSummary
+from .wire_format import COLUMNAR_FORMAT
+
+logger = logging.getLogger(__name__)
+
+# Fetches sub-objects for a batch of ICAOs (missing ICAOs have no data)
+SubObjectFetcher = Callable[[List[str]], Mapping[str, BaseModel]]
+# (data_version or None if not cacheable, fetcher)
+SubObjectSource = Tuple[Optional[str], SubObjectFetcher]
+
+NULL = "null"
+
+SUB_OBJECT_FIELDS = ("ga", "notification")
+# Columnar field order: summary fields as declared, sub-objects last
+SUMMARY_FIELDS = [name for name in AirportSummary.model_fields if name not in SUB_OBJECT_FIELDS]
+COLUMNAR_FIELDS = SUMMARY_FIELDS + list(SUB_OBJECT_FIELDS)
+
+
+def encode_json(value) -> str:
+    """Encode like Starlette's JSONResponse (compact, UTF-8, no NaN)."""
+    return json.dumps(value, ensure_ascii=False, allow_nan=False, separators=(",", ":"))
+
+
+# Columnar response prefix, up to (not including) the rows
+_COLUMNAR_HEADER = encode_json({"format": COLUMNAR_FORMAT, "fields": COLUMNAR_FIELDS})[:-1]
+
+
+class _FragmentTable:
+    """ICAO -> JSON fragment for one sub-object type, valid for one data version."""
+
+    def __init__(self):
+        self.version: Optional[str] = None
+        self.fragments: Dict[str, str] = {}
+        self.lock = threading.Lock()
+
+    def get(self, icaos: Iterable[str], source: SubObjectSource) -> Dict[str, str]:
+        version, fetch = source
+        icaos = list(icaos)
+        if version is None:
+            return self._encode(icaos, fetch)  # No stable version - never cache
+
+        with self.lock:
+            if version != self.version:
+                self.version = version
+                self.fragments = {}
+            fragments = self.fragments
+        missing = [icao for icao in icaos if icao not in fragments]
+        if missing:
+            encoded = self._encode(missing, fetch)
+            with self.lock:
+                if self.version == version:
+                    fragments.update(encoded)
+            return {icao: fragments.get(icao, encoded.get(icao, NULL)) for icao in icaos}
+        return fragments
+
+    @staticmethod
+    def _encode(icaos: List[str], fetch: SubObjectFetcher) -> Dict[str, str]:
+        objects = fetch(icaos) if icaos else {}
+        return {
+            icao: encode_json(objects[icao].model_dump(mode="json")) if icao in objects else NULL
+            for icao in icaos
+        }
+
+
+class AirportSummaryCache:
+    """
+    Cached AirportSummary JSON for one model.
+
+    Usage:
+        cache = AirportSummaryCache(model.airports)
+        body = cache.encode(airports, ga=(ga_version, fetch_ga), notification=None)
+        columnar = cache.encode(airports, ga=(ga_version, fetch_ga), columnar=True)
+        etag = cache.etag(request.url.query, ga_version, notification_version)
+    """
+
+    def __init__(self, airports: Iterable[Airport]):
+        self._airports = airports
+        self._base: Dict[str, str] = {}
+        self._base_columns: Dict[str, str] = {}
+        self._base_lock = threading.Lock()
+        self._dataset_version: Optional[str] = None
+        self._ga = _FragmentTable()
+        self._notification = _FragmentTable()
+
+    def _base_fragment(self, airport: Airport) -> str:
+        """Summary JSON without the closing brace and the ga/notification fields."""
+        fragment = self._base.get(airport.ident)
+        if fragment is None:
+            summary = self._summary(airport)
+            fragment = encode_json(summary)[:-1]
+            self._base[airport.ident] = fragment
+        return fragment
+
+    def _base_columns_fragment(self, airport: Airport) -> str:
+        """Summary values array (SUMMARY_FIELDS order) without the closing bracket."""
+        fragment = self._base_columns.get(airport.ident)
+        if fragment is None:
+            summary = self._summary(airport)
+            fragment = encode_json([summary[name] for name in SUMMARY_FIELDS])[:-1]
+            self._base_columns[airport.ident] = fragment
+        return fragment
+
+    @staticmethod
+    def _summary(airport: Airport) -> Dict:
+        return AirportSummary.from_airport(airport).model_dump(mode="json", exclude=set(SUB_OBJECT_FIELDS))
+
+    @property
+    def dataset_version(self) -> str:
+        """Hash of all base summaries; identical across workers serving the same data."""
+        if self._dataset_version is None:
+            with self._base_lock:
+                if self._dataset_version is None:
+                    digest = hashlib.sha1()
+                    for airport in sorted(self._airports, key=lambda a: a.ident):
+                        digest.update(self._base_fragment(airport).encode("utf-8"))
+                    self._dataset_version = digest.hexdigest()[:16]
+                    logger.info(f"Airport summary cache built: {len(self._base)} airports")
+        return self._dataset_version
+
+    def etag(self, query: str, *versions: Optional[str]) -> Optional[str]:
+        """
+        ETag for a listing response, or None if any sub-object source has no version.
+
+        Args:
+            query: Canonical query string of the request
+            versions: Data versions of every sub-object source included in the response
+        """
+        if any(version is None for version in versions):
+            return None
+        key = "|".join([self.dataset_version, query, *versions])
+        return f'"{hashlib.sha1(key.encode("utf-8")).hexdigest()}"'
+
+    def encode(
+        self,
+        airports: List[Airport],
+        ga: Optional[SubObjectSource] = None,
+        notification: Optional[SubObjectSource] = None,
+        columnar: bool = False,
+    ) -> bytes:
+        """
+        AirportSummary rows, in the given order.
+
+        Returns a JSON array of objects, or with columnar=True a columnar object
+        whose rows follow COLUMNAR_FIELDS.
+        """
+        icaos = [airport.ident for airport in airports]
+        ga_fragments: Dict[str, str] = {}
+        notification_fragments: Dict[str, str] = {}
+        if ga:
+            with span("ga.batch"):
+                ga_fragments = self._ga.get(icaos, ga)
+        if notification:
+            with span("notification.batch"):
+                notification_fragments = self._notification.get(icaos, notification)
+
+        with span("serialize"):
+            if columnar:
+                rows = [
+                    f'{self._base_columns_fragment(airport)},{ga_fragments.get(airport.ident, NULL)},'
+                    f'{notification_fragments.get(airport.ident, NULL)}]'
+                    for airport in airports
+                ]
+                return (_COLUMNAR_HEADER + ',"rows":[' + ",".join(rows) + "]}").encode("utf-8")
+
+            rows = [
+                f'{self._base_fragment(airport)},"ga":{ga_fragments.get(airport.ident, NULL)},'
+                f'"notification":{notification_fragments.get(airport.ident, NULL)}}}'
+                for airport in airports
+            ]
+            return ("[" + ",".join(rows) + "]").encode("utf-8")
+
+    def warm(self, ga: Optional[SubObjectSource] = None, notification: Optional[SubObjectSource] = None) -> None:
+        """Encode every airport (and cacheable sub-objects) now."""
+        _ = self.dataset_version
+        icaos = [airport.ident for airport in self._airports]
+        for airport in self._airports:
+            self._base_columns_fragment(airport)
+        if ga and ga[0] is not None:
+            self._ga.get(icaos, ga)
+        if notification and notification[0] is not None:
+            self._notification.get(icaos, notification)
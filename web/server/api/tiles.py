@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""
+Quadtree (Web Mercator z/x/y) tiles for viewport airport loading.
+
+Clients load the map by fixed tiles instead of arbitrary viewport boxes, so the
+same tile is requested with the same URL whichever way the map was panned and
+responses can be cached (browser, proxy, client tile caches). Tile numbering is
+the usual slippy-map scheme used by the OSM base layer: x grows east from
+-180°, y grows south from the top of the Mercator square (85.0511°N).
+
+Clients implement the same math: tilesForBounds in web/client/ts/utils/tiles.ts
+and MapTile in app/FlyFunEuroAIP/App/Models/MapTypes.swift.
+"""
+import math
+from typing import Tuple
+
+from fastapi import HTTPException
+
+# Deepest tile level accepted (airport density does not need finer tiles)
+MAX_TILE_ZOOM = 12
+
+# Browser/proxy cache lifetime for tile responses (data versions change rarely)
+TILE_CACHE_MAX_AGE_S = 300
+
+
+def parse_tile(tile: str) -> Tuple[int, int, int]:
+    """
+    Parse "z/x/y", or 400 if malformed or out of range.
+    """
+    try:
+        z, x, y = (int(part) for part in tile.split("/"))
+    except ValueError:
+        raise HTTPException(status_code=400, detail="tile must be z/x/y integers")
+    if not 0 <= z <= MAX_TILE_ZOOM:
+        raise HTTPException(status_code=400, detail=f"tile zoom must be between 0 and {MAX_TILE_ZOOM}")
+    if not (0 <= x < 2 ** z and 0 <= y < 2 ** z):
+        raise HTTPException(status_code=400, detail="tile x/y out of range for its zoom")
+    return z, x, y
+
+
+def _tile_latitude(y: int, z: int) -> float:
+    """Latitude of the north edge of tile row y."""
+    n = math.pi - 2.0 * math.pi * y / 2 ** z
+    return math.degrees(math.atan(math.sinh(n)))
+
+
+def tile_bbox(z: int, x: int, y: int) -> Tuple[float, float, float, float]:
+    """Tile bounds as (north, south, east, west) in degrees (the bbox parameter order)."""
+    n = 2 ** z
+    west = x / n * 360.0 - 180.0
+    east = (x + 1) / n * 360.0 - 180.0
+    return _tile_latitude(y, z), _tile_latitude(y + 1, z), east, west
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+"""
+Compact (columnar) wire format for bulk endpoints.
+
+A list of objects that all share the same keys is sent as the key names once
+plus one array of values per object:
+
+    {"format": "columnar", "fields": ["ident", "name"], "rows": [["EGKB", "Biggin Hill"], ...]}
+
+This removes the repeated key names, which make up most of the size of large
+airport and procedure-line responses. Clients expand rows back into objects
+(see decodeColumnar in web/client/ts/adapters/api-adapter.ts and ColumnarJSON
+in app/FlyFunEuroAIP/App/Networking).
+"""
+from typing import Any, Dict, Iterable, List, Mapping, Optional
+
+from fastapi import HTTPException
+
+JSON_FORMAT = "json"
+COLUMNAR_FORMAT = "columnar"
+RESPONSE_FORMATS = (JSON_FORMAT, COLUMNAR_FORMAT)
+
+
+def validate_format(response_format: str) -> str:
+    """Normalized response format, or 400 if unsupported."""
+    normalized = response_format.lower()
+    if normalized not in RESPONSE_FORMATS:
+        raise HTTPException(
+            status_code=400,
+            detail=f"format must be one of: {', '.join(RESPONSE_FORMATS)}",
+        )
+    return normalized
+
+
+def to_columnar(records: Iterable[Mapping[str, Any]], fields: Optional[List[str]] = None) -> Dict[str, Any]:
+    """
+    Columnar form of a list of dicts.
+
+    Args:
+        records: Objects to encode
+        fields: Column order; defaults to all keys in first-seen order.
+            Keys missing from a record are encoded as null.
+    """
+    records = list(records)
+    if fields is None:
+        fields = list(dict.fromkeys(key for record in records for key in record))
+    return {
+        "format": COLUMNAR_FORMAT,
+        "fields": fields,
+        "rows": [[record.get(field) for field in fields] for record in records],
+    }
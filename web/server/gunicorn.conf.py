@@ -0,0 +1,46 @@
+"""
+Gunicorn configuration for running the web server with several workers.
+
+    cd web/server && gunicorn -c gunicorn.conf.py main:app
+
+The airports model is loaded once in the master (preload_model) and shared
+copy-on-write by the forked workers, so extra workers cost their per-process
+services rather than another copy of the model. With more than one worker,
+set RATE_LIMIT_BACKEND=redis so rate limits count requests across workers,
+and METRICS_MULTIPROC_DIR when METRICS_ENABLED so /metrics aggregates workers.
+
+Environment:
+    WEB_WORKERS     Number of worker processes (default: 1)
+    HOST / PORT     Bind address (default: 0.0.0.0:8000)
+    WEB_TIMEOUT     Worker timeout in seconds (default: 120, chat streams are long)
+    METRICS_MULTIPROC_DIR  Shared directory for per-worker latency histograms
+                    (emptied at start so totals don't carry over from the last run)
+"""
+import os
+from pathlib import Path
+
+bind = f"{os.getenv('HOST', '0.0.0.0')}:{os.getenv('PORT', '8000')}"
+workers = int(os.getenv("WEB_WORKERS", "1"))
+worker_class = "uvicorn.workers.UvicornWorker"
+timeout = int(os.getenv("WEB_TIMEOUT", "120"))
+graceful_timeout = 30
+
+# Import main (and load the model) before forking
+preload_app = True
+
+accesslog = None  # Requests are logged by the app's middleware
+loglevel = "info"
+
+
+def on_starting(server):
+    """Drop the histogram files of the previous run."""
+    multiproc_dir = os.getenv("METRICS_MULTIPROC_DIR")
+    if multiproc_dir:
+        for path in Path(multiproc_dir).glob("latency.*"):
+            path.unlink(missing_ok=True)
+
+
+def when_ready(server):
+    """Load the model in the master (app already imported, no worker forked yet)."""
+    import main
+    main.preload_model()
@@ -19,7 +19,7 @@ load_component_env(component_dir)
 
 from fastapi import FastAPI, HTTPException, Request
 from fastapi.staticfiles import StaticFiles
-from fastapi.responses import FileResponse, JSONResponse
+from fastapi.responses import FileResponse, JSONResponse, PlainTextResponse
 from fastapi.exceptions import RequestValidationError
 from fastapi.middleware.cors import CORSMiddleware
 from fastapi.middleware.trustedhost import TrustedHostMiddleware
@@ -28,11 +28,14 @@ from contextlib import asynccontextmanager
 import uvicorn
 import logging
 from datetime import datetime
+import gc
+import hmac
 import time
 
 from euro_aip.models.euro_aip_model import EuroAipModel
 
-# Import security configuration (values only)
+# Import security configuration (values only; optional settings are read with getattr)
+import security_config
 from security_config import (
     ALLOWED_ORIGINS, ALLOWED_HOSTS, RATE_LIMIT_WINDOW, RATE_LIMIT_MAX_REQUESTS,
     FORCE_HTTPS, SECURITY_HEADERS, LOG_LEVEL, LOG_FORMAT
@@ -41,7 +44,13 @@ from security_config import (
 # Import API routes
 from api import airports, procedures, filters, statistics, rules, aviation_agent_chat, ga_friendliness, notifications
 
-from shared.tool_context import ToolContext
+from rate_limit import DEFAULT_ROUTE_BUDGETS, RateLimiter, RouteBudget, create_rate_limit_backend, route_budgets
+
+from shared.aviation_agent.adapters import close_log_writers
+from shared.indexing import get_model_indexes
+from shared.model_snapshot import load_airports_model
+from shared.tool_context import ToolContext, get_tool_context_settings
+from shared import tracing
 
 # Configure logging with file output (and optionally stderr for debugger)
 # Use /app/logs in Docker, /tmp/flyfun-logs for local development
@@ -86,33 +95,41 @@ if log_to_stderr:
 # Global ToolContext (created at startup)
 _tool_context: Optional[ToolContext] = None
 
-# Simple rate limiting storage
-request_counts = {}
+# Countries removed from the model served by the web app
+WEB_EXCLUDE_COUNTRIES = ("RU",)
 
-def check_rate_limit(client_ip: str) -> bool:
-    """Simple rate limiting implementation."""
-    global request_counts
-    current_time = time.time()
-    
-    # Clean old entries
-    request_counts = {ip: (count, timestamp) for ip, (count, timestamp) in request_counts.items() 
-                     if current_time - timestamp < RATE_LIMIT_WINDOW}
-    
-    if client_ip not in request_counts:
-        request_counts[client_ip] = (1, current_time)
-        return True
-    
-    count, timestamp = request_counts[client_ip]
-    
-    if current_time - timestamp > RATE_LIMIT_WINDOW:
-        request_counts[client_ip] = (1, current_time)
-        return True
-    
-    if count >= RATE_LIMIT_MAX_REQUESTS:
-        return False
-    
-    request_counts[client_ip] = (count + 1, timestamp)
-    return True
+# Model loaded before forking workers (see preload_model / gunicorn.conf.py)
+_preloaded_model: Optional[EuroAipModel] = None
+
+# Per-route, per-client rate limits (in-process counters, or Redis when running several workers)
+rate_limiter = RateLimiter(
+    create_rate_limit_backend(),
+    default=RouteBudget("default", (), RATE_LIMIT_MAX_REQUESTS, RATE_LIMIT_WINDOW),
+    routes=route_budgets(getattr(security_config, "RATE_LIMIT_ROUTE_BUDGETS", DEFAULT_ROUTE_BUDGETS)),
+)
+
+def preload_model() -> EuroAipModel:
+    """
+    Load the airports model and its indexes in the gunicorn master before workers fork.
+
+    Workers then share the model's pages copy-on-write instead of each holding
+    its own copy; only services with connections or threads (sqlite, RAG) are
+    created per worker in lifespan.
+    """
+    global _preloaded_model
+    if _preloaded_model is None:
+        settings = get_tool_context_settings()
+        _preloaded_model = load_airports_model(
+            settings.airports_db,
+            snapshot_dir=settings.model_snapshot_dir,
+            exclude_countries=WEB_EXCLUDE_COUNTRIES,
+        )
+        get_model_indexes(_preloaded_model).warm()
+        # Exclude everything loaded so far from garbage collection: collections in
+        # the workers would otherwise write to (and so copy) every shared page
+        gc.freeze()
+        logger.info(f"Preloaded model with {_preloaded_model.airports.count()} airports")
+    return _preloaded_model
 
 @asynccontextmanager
 async def lifespan(app: FastAPI):
@@ -129,15 +146,17 @@ async def lifespan(app: FastAPI):
             load_airports=True,
             load_rules=True,
             load_notifications=True,
-            load_ga_friendliness=True
+            load_ga_friendliness=True,
+            exclude_countries=WEB_EXCLUDE_COUNTRIES,  # Applied before the model snapshot is written
+            model=_preloaded_model,
         )
-        
-        # Apply custom logic to model
-        _tool_context.model.remove_airports_by_country("RU")
         logger.info(f"Loaded model with {_tool_context.model.airports.count()} airports")
         
         # All derived fields are now updated automatically in load_model()
         logger.info("Model loaded with all derived fields updated")
+
+        # Build in-memory indexes (spatial, ...) now that the model is final
+        _tool_context.indexes.warm()
         
         # Make model available to API routes (extract from ToolContext)
         airports.set_model(_tool_context.model)
@@ -167,6 +186,8 @@ async def lifespan(app: FastAPI):
             )
             ga_friendliness.set_service(web_ga_service)
             if web_ga_service.enabled:
+                # Load persona score matrix now instead of on the first /api/airports request
+                web_ga_service.load_score_matrix()
                 logger.info("GA Friendliness service enabled (readonly)")
             else:
                 logger.info("GA Friendliness service disabled")
@@ -182,6 +203,9 @@ async def lifespan(app: FastAPI):
             logger.info("Notification service not available")
             # Set None explicitly so API knows it's not available (instead of lazy creation)
 
+        # Pre-encode airport summaries now that GA and notification services are set
+        airports.warm_summary_cache()
+
         logger.info("Application startup complete")
         
     except Exception as e:
@@ -192,6 +216,8 @@ async def lifespan(app: FastAPI):
     
     # Shutdown
     logger.info("Shutting down Euro AIP Airport Explorer...")
+    # Write conversation/feedback logs still queued in the background writer
+    close_log_writers()
     # ToolContext and its services will be cleaned up automatically
 
 # Create FastAPI app with lifespan context manager
@@ -213,17 +239,33 @@ async def add_security_headers(request: Request, call_next):
     
     return response
 
-# Add request logging middleware
+# Add request logging and tracing middleware
 @app.middleware("http")
 async def log_requests(request: Request, call_next):
     start_time = time.time()
-    response = await call_next(request)
+    # Spans recorded while handling the request (threadpool handlers included)
+    with tracing.start_trace() as trace:
+        response = await call_next(request)
     process_time = time.time() - start_time
     
+    # Label by route template so path parameters don't create new series
+    route = request.scope.get("route")
+    tracing.registry.observe(
+        tracing.REQUEST_METRIC,
+        process_time,
+        method=request.method,
+        route=getattr(route, "path", "unmatched"),
+        status=str(response.status_code),
+    )
+    # Streaming responses: covers the work done before the first byte
+    response.headers["Server-Timing"] = trace.server_timing(total_s=process_time)
+    
     client_ip = request.client.host if request.client else "unknown"
+    spans = " ".join(f"{name}={total:.3f}s" for name, (total, _) in trace.spans.items())
     logger.info(
         f"{request.method} {request.url.path} - "
         f"{response.status_code} - {process_time:.3f}s - {client_ip}"
+        + (f" - {spans}" if spans else "")
     )
     return response
 
@@ -232,11 +274,13 @@ async def log_requests(request: Request, call_next):
 async def rate_limit_middleware(request: Request, call_next):
     client_ip = request.client.host if request.client else "unknown"
     
-    if not check_rate_limit(client_ip):
-        logger.warning(f"Rate limit exceeded for IP: {client_ip}")
+    allowed, budget = await rate_limiter.check_async(client_ip, request.url.path)
+    if not allowed:
+        logger.warning(f"Rate limit exceeded for IP: {client_ip} ({budget.name})")
         return JSONResponse(
             status_code=429,
-            content={"detail": "Too many requests. Please try again later."}
+            content={"detail": "Too many requests. Please try again later."},
+            headers={"Retry-After": str(int(budget.window_s))},
         )
     
     response = await call_next(request)
@@ -357,8 +401,29 @@ async def health_check():
         "timestamp": datetime.utcnow().isoformat()
     }
 
+# Latency histograms (spans and requests) in Prometheus text format, opt-in.
+# Histograms are per process: with several gunicorn workers, METRICS_MULTIPROC_DIR
+# must be set so every worker serves the totals of all workers; without it a
+# scrape only sees the worker that served it (successive scrapes look like
+# counter resets), so only single-worker deployments are scrapeable.
+# The endpoint has no user auth: set METRICS_TOKEN (Bearer) or keep it internal.
+if os.getenv("METRICS_ENABLED", "false").lower() in ("1", "true", "yes"):
+    if int(os.getenv("WEB_WORKERS", "1")) > 1 and not tracing.registry.multiproc_dir:
+        logger.warning("METRICS_ENABLED with several workers but no METRICS_MULTIPROC_DIR: /metrics is per worker")
+    _metrics_token = os.getenv("METRICS_TOKEN")
+
+    @app.get("/metrics", include_in_schema=False)
+    def metrics(request: Request):
+        """Prometheus scrape endpoint (sync: FastAPI runs it in the threadpool, off the event loop)."""
+        if _metrics_token and not hmac.compare_digest(
+            request.headers.get("authorization", ""), f"Bearer {_metrics_token}"
+        ):
+            raise HTTPException(status_code=401, detail="Unauthorized")
+        return PlainTextResponse(tracing.render_prometheus(), media_type="text/plain; version=0.0.4")
+
 if __name__ == "__main__":
-    # show environment variables
+    # Development server (single process, auto-reload); production runs
+    # gunicorn with gunicorn.conf.py for several workers
     uvicorn.run(
         "main:app",
         host=os.getenv("HOST", "0.0.0.0"),
@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""
+Pluggable rate limiting for the web server.
+
+`RateLimiter` maps a request path to a route budget (e.g. the chat endpoint
+gets far fewer requests than the airport listings) and counts hits per
+(budget, client) in a backend:
+
+- `InMemoryRateLimitBackend`: default, per process
+- `RedisRateLimitBackend`: shared by all workers and containers (see gunicorn.conf.py)
+
+Both backends use a sliding-window counter: the request count of the current
+fixed window plus the previous window's count weighted by how much of it still
+overlaps the sliding window. Each hit is O(1); there is no per-request scan of
+all clients.
+
+Configure with RATE_LIMIT_BACKEND=memory|redis and RATE_LIMIT_REDIS_URL.
+"""
+import logging
+import os
+import threading
+import time
+from abc import ABC, abstractmethod
+from dataclasses import dataclass
+from typing import Any, Dict, Iterable, Mapping, Optional, Sequence, Tuple
+
+logger = logging.getLogger(__name__)
+
+# Redis key namespace (one key per budget, client and window)
+REDIS_KEY_PREFIX = "flyfun:ratelimit"
+
+# How often the in-memory backend drops expired clients (amortized over hits)
+SWEEP_INTERVAL_S = 60.0
+
+# Budgets used when security_config does not define RATE_LIMIT_ROUTE_BUDGETS:
+# name -> (path prefixes, max requests, window seconds)
+DEFAULT_ROUTE_BUDGETS: Dict[str, Tuple[Sequence[str], int, float]] = {
+    "chat": (["/api/aviation-agent/chat"], 20, 60),
+    "listing": (["/api/airports", "/api/filters", "/api/statistics"], 300, 60),
+}
+
+
+def sliding_window_estimate(previous: int, current: int, now: float, window_s: float) -> float:
+    """Requests in the sliding window ending now, from two fixed-window counts."""
+    elapsed = (now % window_s) / window_s
+    return previous * (1.0 - elapsed) + current
+
+
+class RateLimitBackend(ABC):
+    """Counts requests per key and decides whether one more is allowed."""
+
+    @abstractmethod
+    def hit(self, key: str, limit: int, window_s: float) -> bool:
+        """Record one request for key; False if it exceeds `limit` per `window_s`."""
+
+    async def hit_async(self, key: str, limit: int, window_s: float) -> bool:
+        """hit() for the request middleware; backends doing network I/O override it."""
+        return self.hit(key, limit, window_s)
+
+
+class InMemoryRateLimitBackend(RateLimitBackend):
+    """Per-process counters (single worker deployments)."""
+
+    def __init__(self, sweep_interval_s: float = SWEEP_INTERVAL_S) -> None:
+        # key -> (window index, count in window, count in previous window, expires at)
+        self._counts: Dict[str, Tuple[int, int, int, float]] = {}
+        self._lock = threading.Lock()
+        self._sweep_interval_s = sweep_interval_s
+        self._next_sweep = 0.0
+
+    def hit(self, key: str, limit: int, window_s: float) -> bool:
+        now = time.time()
+        window = int(now // window_s)
+        with self._lock:
+            if now >= self._next_sweep:
+                self._sweep(now)
+
+            entry = self._counts.get(key)
+            if entry is None or entry[0] < window - 1:
+                current, previous = 0, 0
+            elif entry[0] == window - 1:
+                current, previous = 0, entry[1]
+            else:
+                current, previous = entry[1], entry[2]
+
+            # Rejected requests are not counted, so a client over budget recovers
+            allowed = sliding_window_estimate(previous, current, now, window_s) < limit
+            if allowed:
+                current += 1
+            # Entry matters until the next window no longer overlaps this one
+            self._counts[key] = (window, current, previous, (window + 2) * window_s)
+            return allowed
+
+    def _sweep(self, now: float) -> None:
+        """Drop clients whose counts no longer affect any window."""
+        self._counts = {k: v for k, v in self._counts.items() if v[3] > now}
+        self._next_sweep = now + self._sweep_interval_s
+
+    def __len__(self) -> int:
+        return len(self._counts)
+
+
+class RedisRateLimitBackend(RateLimitBackend):
+    """
+    Counters in Redis, shared by all workers.
+
+    One round trip per request: INCR the current window's key (expiring after
+    two windows) and GET the previous one. Rejected requests count too. If Redis
+    is unreachable, requests are allowed (the limiter must not take the site down).
+    The middleware uses hit_async (redis.asyncio) so the round trip never blocks
+    the event loop; hit() is the blocking variant for scripts and tests.
+    """
+
+    def __init__(self, url: Optional[str] = None, client: Any = None, async_client: Any = None):
+        """
+        Args:
+            url: Redis URL (e.g. redis://redis:6379/0)
+            client: Existing blocking redis client (takes precedence over url)
+            async_client: Existing redis.asyncio client (takes precedence over url)
+        """
+        if client is None or async_client is None:
+            if not url:
+                raise ValueError("RedisRateLimitBackend requires a url or clients")
+            import redis  # Optional dependency, only needed for this backend
+            import redis.asyncio
+            if client is None:
+                client = redis.Redis.from_url(url, socket_timeout=0.5, socket_connect_timeout=0.5)
+            if async_client is None:
+                async_client = redis.asyncio.Redis.from_url(url, socket_timeout=0.5, socket_connect_timeout=0.5)
+        self.client = client
+        self.async_client = async_client
+
+    @staticmethod
+    def _queue(pipe: Any, key: str, window: int, window_s: float) -> None:
+        current_key = f"{REDIS_KEY_PREFIX}:{key}:{window}"
+        pipe.incr(current_key)
+        pipe.expire(current_key, int(2 * window_s) + 1)
+        pipe.get(f"{REDIS_KEY_PREFIX}:{key}:{window - 1}")
+
+    @staticmethod
+    def _allowed(results: Sequence[Any], limit: int, now: float, window_s: float) -> bool:
+        current, _, previous = results
+        # `current` includes this request
+        return sliding_window_estimate(int(previous or 0), int(current) - 1, now, window_s) < limit
+
+    def hit(self, key: str, limit: int, window_s: float) -> bool:
+        now = time.time()
+        try:
+            pipe = self.client.pipeline()
+            self._queue(pipe, key, int(now // window_s), window_s)
+            results = pipe.execute()
+        except Exception as e:
+            logger.warning(f"Rate limit backend unavailable, allowing request: {e}")
+            return True
+        return self._allowed(results, limit, now, window_s)
+
+    async def hit_async(self, key: str, limit: int, window_s: float) -> bool:
+        now = time.time()
+        try:
+            pipe = self.async_client.pipeline()
+            self._queue(pipe, key, int(now // window_s), window_s)
+            results = await pipe.execute()
+        except Exception as e:
+            logger.warning(f"Rate limit backend unavailable, allowing request: {e}")
+            return True
+        return self._allowed(results, limit, now, window_s)
+
+
+@dataclass(frozen=True)
+class RouteBudget:
+    """Request budget for a group of routes, counted per client."""
+    name: str
+    prefixes: Tuple[str, ...]
+    limit: int
+    window_s: float
+
+    def matches(self, path: str) -> Optional[int]:
+        """Length of the longest prefix matching path (at a segment boundary), or None."""
+        best = None
+        for prefix in self.prefixes:
+            prefix = prefix.rstrip("/")
+            if path == prefix or path.startswith(prefix + "/"):
+                if best is None or len(prefix) > best:
+                    best = len(prefix)
+        return best
+
+
+def route_budgets(config: Mapping[str, Tuple[Sequence[str], int, float]]) -> Tuple[RouteBudget, ...]:
+    """Budgets from the security_config format: name -> (prefixes, max requests, window seconds)."""
+    return tuple(
+        RouteBudget(name, tuple(prefixes), int(limit), float(window_s))
+        for name, (prefixes, limit, window_s) in config.items()
+    )
+
+
+class RateLimiter:
+    """Per-route, per-client rate limits on top of a backend."""
+
+    def __init__(self, backend: RateLimitBackend, default: RouteBudget, routes: Iterable[RouteBudget] = ()):
+        """
+        Args:
+            backend: Counter storage
+            default: Budget for paths matching no route budget
+            routes: Route budgets; the longest matching prefix wins
+        """
+        self.backend = backend
+        self.default = default
+        self.routes = tuple(routes)
+
+    def budget_for(self, path: str) -> RouteBudget:
+        """Budget applying to a request path."""
+        best, best_len = self.default, -1
+        for budget in self.routes:
+            length = budget.matches(path)
+            if length is not None and length > best_len:
+                best, best_len = budget, length
+        return best
+
+    def check(self, client: str, path: str) -> Tuple[bool, RouteBudget]:
+        """Record a request; returns (allowed, budget it was counted against)."""
+        budget = self.budget_for(path)
+        allowed = self.backend.hit(f"{budget.name}:{client}", budget.limit, budget.window_s)
+        return allowed, budget
+
+    async def check_async(self, client: str, path: str) -> Tuple[bool, RouteBudget]:
+        """check() without blocking the event loop (request middleware)."""
+        budget = self.budget_for(path)
+        allowed = await self.backend.hit_async(f"{budget.name}:{client}", budget.limit, budget.window_s)
+        return allowed, budget
+
+
+def create_rate_limit_backend(
+    backend: Optional[str] = None,
+    redis_url: Optional[str] = None,
+) -> RateLimitBackend:
+    """
+    Backend from arguments or RATE_LIMIT_BACKEND / RATE_LIMIT_REDIS_URL.
+
+    Raises:
+        ValueError: Unknown backend name or redis backend without URL
+    """
+    backend = (backend or os.getenv("RATE_LIMIT_BACKEND", "memory")).lower()
+    if backend == "memory":
+        return InMemoryRateLimitBackend()
+    if backend == "redis":
+        return RedisRateLimitBackend(url=redis_url or os.getenv("RATE_LIMIT_REDIS_URL"))
+    raise ValueError(f"Unknown rate limit backend: {backend}")